@@ -69,6 +69,7 @@
  *
  *   16/11/2022 Array
  *   26/01/2025 Array_of_bytes_view
+ *   18/10/2026 Spsc_ring
  *
  ****************************************************************************/
 #include <tuple>    // std::tie
@@ -78,8 +79,11 @@
 #include <type_traits>
 #include <iterator> // begin/end
 #include <initializer_list>
+#include <span>
+#include <stdint.h>
 #include "atd_algorithm.h"
 #include "atd_type_traits.h"
+#include "atd_math.h"	// is_power_of_two
 
 namespace atd{
 
@@ -310,6 +314,287 @@ Circular_array<T, N>::eread(T* b, size_type n)
 }
 
 
+/***************************************************************************
+ *				SPSC RING
+ ***************************************************************************/
+// Ring buffer de un único productor y un único consumidor (Single Producer
+// Single Consumer). Está pensado para pasar datos entre una ISR y el
+// programa principal sin tener que deshabilitar las interrupciones.
+//
+// Los índices head_ (solo lo modifica el productor) y tail_ (solo lo
+// modifica el consumidor) se incrementan sin hacer módulo N: 
+// size() = head_ - tail_ funciona aunque den la vuelta ya que N es potencia
+// de 2. Para acceder a data_ se enmascaran con N - 1.
+//
+// (RRR) ¿Por qué no basta con volatile?
+//	 volatile garantiza el orden entre accesos volatile, pero data_ no es
+//	 volatile (queremos poder guardar structs y usar std::copy). Por eso
+//	 antes de publicar un índice ponemos una barrera del compilador:
+//	 primero se escribe (o lee) el dato y después se actualiza el índice.
+//	 Y lo mismo al revés: después de leer el índice del otro ponemos otra
+//	 barrera para que el compilador no adelante la lectura (o escritura)
+//	 de data_ antes de haber comprobado que el otro ya ha terminado con
+//	 ese elemento.
+//
+// Si N <= 128 los índices son de 1 byte, y leerlos y escribirlos es atómico
+// en el avr. Si N > 128 los índices son de 2 bytes: el programa principal
+// lee el índice que modifica la ISR hasta obtener dos veces el mismo valor,
+// pero la ISR podría leer a medias el índice que está modificando el
+// programa principal. En ese caso el programa principal tiene que
+// deshabilitar las interrupciones al llamar a las funciones que modifican
+// su índice.
+//
+// Funciones del productor: push, push_n, free_span, commit.
+// Funciones del consumidor: pop, pop_n, peek, consume.
+template <typename T, size_t N>
+class Spsc_ring{
+public:
+    static_assert(is_power_of_two(N), "N must be a power of 2");
+    static_assert(N <= 32768, "N too big");
+
+// Types
+    using value_type = T;
+    using size_type  = std::conditional_t<(N <= 128), uint8_t, uint16_t>;
+
+// Construcción
+    Spsc_ring() = default;
+
+    // Vacía el buffer.
+    // precondicion: ni el productor ni el consumidor lo están usando.
+    void reset() { head_ = 0; tail_ = 0; }
+
+// Info
+    static constexpr size_type capacity() {return N;}
+
+    // Número de elementos pendientes de leer
+    size_type size() const 
+    { return static_cast<size_type>(load(head_) - load(tail_)); }
+
+    // Número de elementos que se pueden escribir
+    size_type available() const {return capacity() - size();}
+
+    bool empty() const {return size() == 0;}
+    bool full() const {return size() == capacity();}
+
+// Productor
+    // Devuelve false si está lleno
+    bool push(const T& x);
+
+    // Escribe todos los elementos de x[0, n) que quepan.
+    // Devuelve el número de elementos escritos.
+    // (RRR) Publicamos head_ una única vez al final.
+    size_type push_n(const T* x, size_type n);
+
+    // Si está lleno descarta el elemento más antiguo.
+    // Devuelve false si ha descartado algún elemento.
+    // CUIDADO: modifica tail_ así que el consumidor no puede estar
+    // ejecutándose (deshabilitar las interrupciones si el consumidor es una
+    // ISR).
+    bool push_overwrite(const T& x);
+
+    // Zona contigua libre donde el productor puede escribir directamente
+    // (zero-copy). Una vez escritos n elementos hay que llamar a commit(n).
+    std::span<T> free_span();
+    void commit(size_type n);
+
+// Consumidor
+    // Devuelve false si está vacío
+    bool pop(T& x);
+
+    // Lee hasta n elementos almacenándolos en x[0, n).
+    // Devuelve el número de elementos leídos.
+    size_type pop_n(T* x, size_type n);
+
+    // Zona contigua con los siguientes elementos a leer (zero-copy).
+    // Puede contener menos de size() elementos si los datos dan la vuelta.
+    // Una vez procesados n elementos hay que llamar a consume(n).
+    std::span<const T> peek() const;
+    void consume(size_type n);
+
+private:
+// Data
+    T data_[N];
+    volatile size_type head_ = 0; // lo modifica el productor
+    volatile size_type tail_ = 0; // lo modifica el consumidor
+
+    static constexpr size_type mask = N - 1;
+
+// Helpers
+    static void barrier() { asm volatile("" : : : "memory"); }
+
+    static size_type load(const volatile size_type& i);
+
+    size_type free_contiguous(size_type h) const;
+};
+
+
+template <typename T, size_t N>
+inline Spsc_ring<T, N>::size_type 
+	Spsc_ring<T, N>::load(const volatile size_type& i)
+{
+    if constexpr (sizeof(size_type) == 1)
+	return i;
+
+    else {
+	size_type x = i;
+	size_type y = i;
+	while (x != y){
+	    x = y;
+	    y = i;
+	}
+
+	return x;
+    }
+}
+
+// Número de elementos que se pueden escribir a partir de h sin dar la vuelta
+template <typename T, size_t N>
+inline Spsc_ring<T, N>::size_type 
+	Spsc_ring<T, N>::free_contiguous(size_type h) const
+{
+    size_type t = load(tail_);
+    barrier(); // no escribir en data_ antes de leer tail_
+
+    size_type n = static_cast<size_type>(N - static_cast<size_type>(h - t));
+    size_type to_end = static_cast<size_type>(N - (h & mask));
+
+    return (n < to_end? n: to_end);
+}
+
+template <typename T, size_t N>
+bool Spsc_ring<T, N>::push(const T& x)
+{
+    size_type h = head_;
+    size_type t = load(tail_);
+    barrier(); // no escribir en data_ antes de leer tail_
+
+    if (static_cast<size_type>(h - t) == N)
+	return false;
+
+    data_[h & mask] = x;
+    barrier();
+    head_ = static_cast<size_type>(h + 1); // después de escribir el dato
+
+    return true;
+}
+
+
+template <typename T, size_t N>
+Spsc_ring<T, N>::size_type Spsc_ring<T, N>::push_n(const T* x, size_type n)
+{
+    size_type h = head_;
+    size_type t = load(tail_);
+    barrier(); // no escribir en data_ antes de leer tail_
+
+    size_type free = static_cast<size_type>(N - static_cast<size_type>(h - t));
+    if (n > free)
+	n = free;
+
+    for (size_type i = 0; i < n; ++i){
+	data_[h & mask] = x[i];
+	++h;
+    }
+
+    barrier();
+    head_ = h; // después de escribir los datos
+
+    return n;
+}
+
+
+template <typename T, size_t N>
+bool Spsc_ring<T, N>::push_overwrite(const T& x)
+{
+    bool res = !full();
+    if (!res)
+	tail_ = static_cast<size_type>(tail_ + 1);
+
+    push(x);
+    return res;
+}
+
+
+template <typename T, size_t N>
+inline std::span<T> Spsc_ring<T, N>::free_span()
+{
+    size_type h = head_;
+    return std::span<T>{&data_[h & mask], free_contiguous(h)};
+}
+
+
+// precondicion: n <= free_span().size()
+template <typename T, size_t N>
+inline void Spsc_ring<T, N>::commit(size_type n)
+{
+    barrier();
+    head_ = static_cast<size_type>(head_ + n);
+}
+
+
+template <typename T, size_t N>
+bool Spsc_ring<T, N>::pop(T& x)
+{
+    size_type t = tail_;
+    size_type h = load(head_);
+    barrier(); // no leer data_ antes de leer head_
+
+    if (h == t)
+	return false;
+
+    x = data_[t & mask];
+    barrier();
+    tail_ = static_cast<size_type>(t + 1); // después de leer el dato
+
+    return true;
+}
+
+
+template <typename T, size_t N>
+Spsc_ring<T, N>::size_type Spsc_ring<T, N>::pop_n(T* x, size_type n)
+{
+    size_type t = tail_;
+    size_type h = load(head_);
+    barrier(); // no leer data_ antes de leer head_
+
+    size_type sz = static_cast<size_type>(h - t);
+    if (n > sz)
+	n = sz;
+
+    for (size_type i = 0; i < n; ++i){
+	x[i] = data_[t & mask];
+	++t;
+    }
+
+    barrier();
+    tail_ = t; // después de leer los datos
+
+    return n;
+}
+
+
+template <typename T, size_t N>
+std::span<const T> Spsc_ring<T, N>::peek() const
+{
+    size_type t = tail_;
+    size_type h = load(head_);
+    barrier(); // no leer data_ antes de leer head_
+
+    size_type sz = static_cast<size_type>(h - t);
+    size_type to_end = static_cast<size_type>(N - (t & mask));
+
+    return std::span<const T>{&data_[t & mask], (sz < to_end? sz: to_end)};
+}
+
+
+// precondicion: n <= peek().size()
+template <typename T, size_t N>
+inline void Spsc_ring<T, N>::consume(size_type n)
+{
+    barrier();
+    tail_ = static_cast<size_type>(tail_ + n);
+}
+
+
 /***************************************************************************
  *				LINEAR ARRAY
  ***************************************************************************/
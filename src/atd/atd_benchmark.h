@@ -0,0 +1,202 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ATD_BENCHMARK_H__
+#define __ATD_BENCHMARK_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Micro-benchmarks.
+ *
+ *    Muchas veces hay que medir cuánto tarda una función ("es más rápido
+ *    así" sin medirlo no vale nada). Benchmark ejecuta una función
+ *    `nsamples` veces midiendo cada ejecución con un `Clock` y devuelve
+ *    el mínimo, la mediana y el máximo.
+ *
+ *    El Clock es un static interface que tiene que suministrar:
+ *	    static void start();    // empieza a medir
+ *	    static uint32_t stop(); // devuelve los ticks desde start()
+ *
+ *    En el avr el Clock será el Timer1 sin prescaler (Cycle_counter1),
+ *    siendo los ticks ciclos de reloj. En el ordenador basta con un Clock
+ *    que use std::chrono (ver pc_test/benchmark). De esta forma el mismo
+ *    código de benchmark se puede compilar como pc_test y cargarlo en el
+ *    avr.
+ *
+ *    Al construir el Benchmark se mide el overhead de llamar a
+ *    start/stop (midiendo una función vacía) y se resta de todas las
+ *    medidas.
+ *
+ *    Los resultados se imprimen en una línea fácil de parsear:
+ *		bench <nombre> <min> <mediana> <max>
+ *
+ *  - EJEMPLO:
+ *	    test::Benchmark<Micro::Cycle_counter1> bench{uart};
+ *	    bench.run("to_chars", []{ ... });
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <cstdint>
+#include <ostream>
+
+namespace test{
+
+// Para que el compilador no elimine el cálculo que se quiere medir.
+template <typename T>
+inline void do_not_optimize(const T& x)
+{ asm volatile("" : : "r"(&x) : "memory"); }
+
+
+struct Benchmark_result{
+    uint32_t min;
+    uint32_t median;
+    uint32_t max;
+};
+
+
+template <typename Clock, uint8_t nsamples0 = 9>
+class Benchmark{
+public:
+// Types
+    using Result = Benchmark_result;
+    static constexpr uint8_t nsamples = nsamples0;
+
+    static_assert(nsamples > 0, "nsamples can't be 0");
+
+// Constructor
+    explicit Benchmark(std::ostream& out0) : out_{&out0}
+    { calibrate(); }
+
+// Info
+    // Ticks que cuesta medir (ya restados de todas las medidas)
+    uint32_t overhead() const {return overhead_;}
+
+// Medidas
+    // Mide f sin imprimir nada
+    template <typename F>
+    Result measure(F&& f);
+
+    // Mide f e imprime el resultado
+    template <typename F>
+    Result run(const char* name, F&& f);
+
+    static void print(std::ostream& out, const char* name, const Result& res);
+
+private:
+// Data
+    std::ostream* out_;
+    uint32_t overhead_ = 0;
+
+    uint32_t sample_[nsamples];
+
+// Helpers
+    void calibrate();
+
+    template <typename F>
+    void take_samples(F& f);
+
+    void sort_samples();
+};
+
+
+template <typename C, uint8_t N>
+template <typename F>
+inline void Benchmark<C, N>::take_samples(F& f)
+{
+    for (uint8_t k = 0; k < nsamples; ++k){
+	C::start();
+	f();
+	sample_[k] = C::stop();
+    }
+}
+
+// Son pocas muestras: basta con inserción
+template <typename C, uint8_t N>
+void Benchmark<C, N>::sort_samples()
+{
+    for (uint8_t i = 1; i < nsamples; ++i){
+	uint32_t x = sample_[i];
+	uint8_t j = i;
+	for (; j > 0 and sample_[j - 1] > x; --j)
+	    sample_[j] = sample_[j - 1];
+
+	sample_[j] = x;
+    }
+}
+
+// El overhead es lo mínimo que se tarda en medir una función vacía
+template <typename C, uint8_t N>
+void Benchmark<C, N>::calibrate()
+{
+    overhead_ = 0;
+    auto empty = []{};
+    take_samples(empty);
+    sort_samples();
+    overhead_ = sample_[0];
+}
+
+
+template <typename C, uint8_t N>
+template <typename F>
+typename Benchmark<C, N>::Result Benchmark<C, N>::measure(F&& f)
+{
+    take_samples(f);
+
+    for (uint8_t k = 0; k < nsamples; ++k){
+	if (sample_[k] > overhead_)
+	    sample_[k] -= overhead_;
+	else
+	    sample_[k] = 0;
+    }
+
+    sort_samples();
+
+    return Result{sample_[0], sample_[nsamples / 2], sample_[nsamples - 1]};
+}
+
+
+template <typename C, uint8_t N>
+template <typename F>
+inline typename Benchmark<C, N>::Result
+		Benchmark<C, N>::run(const char* name, F&& f)
+{
+    Result res = measure(f);
+    print(*out_, name, res);
+
+    return res;
+}
+
+template <typename C, uint8_t N>
+void Benchmark<C, N>::print(std::ostream& out, const char* name,
+							const Result& res)
+{
+    out << "bench " << name << ' ' << res.min << ' ' << res.median << ' '
+	<< res.max << '\n';
+}
+
+
+}// namespace test
+
+#endif
+
+
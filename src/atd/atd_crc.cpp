@@ -25,6 +25,7 @@
  * HISTORIA
  *    Manuel Perez
  *    25/02/2023 CRC7 (experimentando)
+ *    18/10/2026 CRC7 admite más de 255 bytes
  *  
  ****************************************************************************/
 #include "atd_crc.h"
@@ -46,8 +47,8 @@ uint8_t CRC7(std::span<const uint8_t> data)
     
     uint8_t crc = 0;
 
-    for (uint8_t i = 0; i < data.size(); ++i){
-	crc ^= data[i];
+    for (uint8_t x : data){
+	crc ^= x;
 
 	for (uint8_t j = 0; j < 8; ++j){
 	    // if (most_significant_bit_of(crc)_is_one()) 
@@ -30,6 +30,8 @@
  *    Manuel Perez
  *    25/02/2023 CRC7 (experimentando)
  *    22/08/2023 CRC8 
+ *    18/10/2026 CRC_table: versiones con tablas (16 ó 256 entradas)
+ *		 CRC16_CCITT y CRC32
  *
  ****************************************************************************/
 
@@ -38,6 +40,7 @@
 #include <iterator>
 
 #include "atd_bit.h"
+#include "atd_rom.h"
 
 namespace atd{
 
@@ -128,6 +131,247 @@ inline uint8_t CRC8_Maxim(const uint8_t* data, size_t N)
     return CRC8<0x31, true, true, true>(d.first(N)); 
 }
 
+
+/***************************************************************************
+ *			    CRC GENÉRICO
+ *
+ * Las funciones anteriores procesan bit a bit cada byte (8 iteraciones de
+ * shift/xor por byte). Para acelerar el cálculo se pueden usar tablas:
+ *	+ tabla de 16 entradas : procesa 4 bits de golpe (2 accesos por byte).
+ *	+ tabla de 256 entradas: procesa 8 bits de golpe (1 acceso por byte).
+ *
+ * Las tablas se generan en tiempo de compilación (constexpr), pudiéndose
+ * guardar en PROGMEM:
+ *
+ *	constexpr atd::CRC8_Maxim_table<256, myu::ROM_read> crc8 PROGMEM{};
+ *	...
+ *	atd::CRC8_Maxim(crc8, data);
+ *
+ * Notación:
+ *	Int	  = registro donde calculamos el CRC (uint8_t, uint16_t o
+ *		    uint32_t).
+ *	g	  = polinomio generador sin el bit de mayor grado.
+ *	reflected = procesamos los bits de cada byte empezando por el LSB. En
+ *		    este caso `g` tiene que estar reflejado.
+ *		    Ejemplo: CRC8_<0x31, true, true> == reflected con g = 0x8C
+ *
+ ***************************************************************************/
+namespace impl_of{
+// Desplaza nbits el registro crc dividiendo por g
+template <Type::Integer Int, Int g, bool reflected>
+constexpr Int crc_shift(Int crc, uint8_t nbits)
+{
+    constexpr Int msb = Int{1} << (sizeof(Int) * 8 - 1);
+
+    for (uint8_t j = 0; j < nbits; ++j){
+	if constexpr (reflected){
+	    if (crc & Int{1})
+		crc = static_cast<Int>((crc >> 1) ^ g);
+	    else
+		crc = static_cast<Int>(crc >> 1);
+	}
+	else {
+	    if (crc & msb)
+		crc = static_cast<Int>((crc << 1) ^ g);
+	    else
+		crc = static_cast<Int>(crc << 1);
+	}
+    }
+
+    return crc;
+}
+
+}// impl_of
+
+
+// Actualiza el CRC `crc` con los bytes de data (versión bit a bit).
+// Al ser constexpr sirve para calcular CRCs en tiempo de compilación.
+template <Type::Integer Int, Int g, bool reflected>
+constexpr Int CRC_update(Int crc, std::span<const uint8_t> data)
+{
+    constexpr uint8_t shift = sizeof(Int) * 8 - 8;
+
+    for (uint8_t x : data){
+	if constexpr (reflected)
+	    crc ^= x;
+	else
+	    crc ^= static_cast<Int>(Int{x} << shift);
+
+	crc = impl_of::crc_shift<Int, g, reflected>(crc, 8);
+    }
+
+    return crc;
+}
+
+
+// Tabla para calcular el CRC de N = 16 ó 256 entradas.
+// Read es la función para leer de la ROM (en caso de que la tabla se
+// guarde en PROGMEM).
+template <Type::Integer Int, Int g, bool reflected,
+	  size_t N = 256,
+	  typename Read = RAM_read>
+class CRC_table{
+public:
+// Types
+    using value_type = Int;
+    using size_type  = size_t;
+
+    static_assert(N == 16 or N == 256, "Only tables of 16 or 256 entries");
+
+// Constructor
+    constexpr CRC_table() : data{}
+    { 
+	for (size_type i = 0; i < N; ++i)
+	    data[i] = entry(i);
+    }
+
+// Dimensions
+    constexpr static size_type size() {return N;}
+
+// Element access
+    Int operator[](size_type i) const {
+	Read read;
+	return read(data[i]); 
+    }
+
+// CRC
+    // Actualiza el CRC `crc` con el byte x
+    Int update(Int crc, uint8_t x) const;
+
+    // Actualiza el CRC `crc` con los bytes de data
+    Int update(Int crc, std::span<const uint8_t> data) const
+    {
+	for (uint8_t x : data)
+	    crc = update(crc, x);
+
+	return crc;
+    }
+
+// Data
+    // Como en ROM_array, data no es private para poder inicializarla en
+    // PROGMEM. No leer directamente, usar operator[].
+    Int data[N];
+
+private:
+    static constexpr uint8_t nbits_Int   = sizeof(Int) * 8;
+    static constexpr uint8_t nbits_index = (N == 16? 4: 8);
+
+    static constexpr Int entry(size_type i)
+    {
+	if constexpr (reflected)
+	    return impl_of::crc_shift<Int, g, true>
+				    (static_cast<Int>(i), nbits_index);
+	else
+	    return impl_of::crc_shift<Int, g, false>
+		(static_cast<Int>(Int(i) << (nbits_Int - nbits_index))
+							    , nbits_index);
+    }
+
+    Int update_nibble(Int crc, uint8_t n) const
+    {
+	if constexpr (reflected)
+	    return static_cast<Int>((crc >> 4) ^ (*this)[(crc ^ n) & 0x0F]);
+	else
+	    return static_cast<Int>((crc << 4) ^
+		    (*this)[((crc >> (nbits_Int - 4)) ^ n) & 0x0F]);
+    }
+};
+
+
+template <Type::Integer Int, Int g, bool reflected, size_t N, typename Read>
+inline Int CRC_table<Int, g, reflected, N, Read>::update(Int crc, uint8_t x) const
+{
+    if constexpr (N == 256){
+	if constexpr (reflected)
+	    return static_cast<Int>((crc >> 8) ^ (*this)[(crc ^ x) & 0xFF]);
+	else
+	    return static_cast<Int>((crc << 8) ^
+			    (*this)[((crc >> (nbits_Int - 8)) ^ x) & 0xFF]);
+    }
+
+    else { // N == 16
+	if constexpr (reflected){
+	    crc = update_nibble(crc, x & 0x0F);
+	    return update_nibble(crc, x >> 4);
+	}
+	else {
+	    crc = update_nibble(crc, x >> 4);
+	    return update_nibble(crc, x & 0x0F);
+	}
+    }
+}
+
+
+/***************************************************************************
+ *			    CRC CONCRETOS
+ ***************************************************************************/
+// CRC7
+// ----
+// Es el CRC7 anterior (g(x) = x^7 + x^3 + 1) calculado en el registro de 8
+// bits desplazado: crc7 << 1. De ahí g = 0x89 << 1 = 0x12 (eliminando el
+// bit 8)
+template <size_t N = 256, typename Read = RAM_read>
+using CRC7_table = CRC_table<uint8_t, 0x12, false, N, Read>;
+
+template <size_t N, typename Read>
+inline uint8_t CRC7(const CRC7_table<N, Read>& table
+		    , std::span<const uint8_t> data)
+{ return table.update(0, data) >> 1; }
+
+
+// CRC8_Maxim
+// ----------
+// Es CRC8<0x31, true, true>: reflejando 0x31 queda 0x8C.
+template <size_t N = 256, typename Read = RAM_read>
+using CRC8_Maxim_table = CRC_table<uint8_t, 0x8C, true, N, Read>;
+
+template <size_t N, typename Read>
+inline uint8_t CRC8_Maxim(const CRC8_Maxim_table<N, Read>& table
+			  , std::span<const uint8_t> data)
+{ return table.update(0, data); }
+
+
+// CRC16_CCITT
+// -----------
+// Generador: g(x) = x^16 + x^12 + x^5 + 1 (0x1021), valor inicial 0
+// (XMODEM). Es el usado por la SD card para los bloques de datos.
+inline constexpr uint16_t CRC16_CCITT(std::span<const uint8_t> data)
+{ return CRC_update<uint16_t, 0x1021, false>(0, data); }
+
+template <size_t N = 256, typename Read = RAM_read>
+using CRC16_CCITT_table = CRC_table<uint16_t, 0x1021, false, N, Read>;
+
+template <size_t N, typename Read>
+inline uint16_t CRC16_CCITT(const CRC16_CCITT_table<N, Read>& table
+			    , std::span<const uint8_t> data)
+{ return table.update(0, data); }
+
+
+// CRC32
+// -----
+// El de IEEE 802.3 (zip, png...): g = 0x04C11DB7 reflejado = 0xEDB88320, 
+// valor inicial 0xFFFFFFFF y se invierte el resultado.
+// Para calcular el CRC de un fichero por trozos usar CRC32_update.
+inline constexpr uint32_t CRC32_update(uint32_t crc
+				      , std::span<const uint8_t> data)
+{ return ~CRC_update<uint32_t, 0xEDB88320, true>(~crc, data); }
+
+inline constexpr uint32_t CRC32(std::span<const uint8_t> data)
+{ return CRC32_update(0, data); }
+
+template <size_t N = 256, typename Read = RAM_read>
+using CRC32_table = CRC_table<uint32_t, 0xEDB88320, true, N, Read>;
+
+template <size_t N, typename Read>
+inline uint32_t CRC32_update(const CRC32_table<N, Read>& table
+			     , uint32_t crc, std::span<const uint8_t> data)
+{ return ~table.update(~crc, data); }
+
+template <size_t N, typename Read>
+inline uint32_t CRC32(const CRC32_table<N, Read>& table
+		      , std::span<const uint8_t> data)
+{ return CRC32_update(table, 0, data); }
+
 }// namespace
 
 
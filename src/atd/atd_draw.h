@@ -40,9 +40,13 @@
  * HISTORIA
  *    Manuel Perez
  *    30/08/2024 Primeros experimentos
+ *    18/10/2026 write(Bitmatrix_col_1bit): escritura directa de los bytes
+ *               cuando el glyph está alineado; write(m, p0, string_view)
  *
  ****************************************************************************/
 #include <type_traits>
+#include <string_view>
+#include <algorithm>	// min
 
 #include "atd_bit_matrix.h"
 #include "atd_math.h"	// ceil_division
@@ -51,25 +55,78 @@ namespace atd{
 
 // Bitmatrix_col_1bit
 // ------------------
-// Escribe el caracter c en el byte más próximo al bit (i, j) 
-// usando la fuente Font.
-// precondition: (i, j) son unsigned ==> i >= 0 and j >= 0
-//		(¿modificarlo para que admita signed? De momento no)
+namespace impl_of{
+// Copia el glyph del caracter c en buf[0, Font::cols * Font::rows_in_bytes)
+// Si la fuente lo permite, con una sola lectura de bloque de la ROM.
+template <typename Font>
+inline void glyph_read(char c, uint8_t* buf)
+{
+    if constexpr (requires {Font::glyph.read_row(0, buf);})
+	Font::glyph.read_row(Font::index(c), buf);
+
+    else{
+	auto letter = Font::glyph.row(Font::index(c));
+	for (auto p = letter.begin(); p != letter.end(); ++p, ++buf)
+	    *buf = *p;
+    }
+}
+
+// Escribe el glyph en el bitmatrix, estando el glyph alineado con los bytes
+// del bitmatrix (p0.i múltiplo de 8). Escribe directamente en los bytes de
+// las columnas.
+//  I0     = byte de la columna donde empieza el glyph (= p0.i / 8)
+//  j0     = primera columna
+//  ncols  = número de columnas del glyph a escribir
+//  nbytes = número de bytes de cada columna a escribir (de arriba a abajo)
 template <typename Font, size_t NR, size_t NC>
-void write(Bitmatrix_col_1bit<NR, NC>& m, 
+void write_glyph_aligned(Bitmatrix_col_1bit<NR, NC>& m,
+		typename Bitmatrix_col_1bit<NR, NC>::index_type I0,
+		typename Bitmatrix_col_1bit<NR, NC>::index_type j0,
+		uint8_t ncols, uint8_t nbytes, const uint8_t* glyph)
+{
+    // Los glyphs girados a la derecha empiezan cada columna por el byte
+    // de ABAJO: el byte de arriba es el último de la columna.
+    const uint8_t* col = glyph + Font::rows_in_bytes - 1;
+    auto q = m.col_begin(j0) + I0;
+    constexpr auto col_size = Bitmatrix_col_1bit<NR, NC>::rows_in_bytes();
+
+    if (nbytes == Font::rows_in_bytes){ // caso habitual: no se recorta
+	for (uint8_t j = 0; j < ncols; ++j, col += Font::rows_in_bytes,
+					    q += col_size){
+	    for (uint8_t I = 0; I < Font::rows_in_bytes; ++I)
+		q[I] = col[-I];
+	}
+
+	return;
+    }
+
+    for (uint8_t j = 0; j < ncols; ++j, col += Font::rows_in_bytes,
+					q += col_size){
+	for (uint8_t I = 0; I < nbytes; ++I)
+	    q[I] = col[-I];
+    }
+}
+
+// Número de bytes de cada columna del glyph que caben en m si lo escribimos
+// a partir del byte I0
+template <typename Font, size_t NR, size_t NC>
+inline uint8_t glyph_nbytes_aligned(const Bitmatrix_col_1bit<NR, NC>& m,
+		typename Bitmatrix_col_1bit<NR, NC>::index_type I0)
+{
+    using Index = typename Bitmatrix_col_1bit<NR, NC>::index_type;
+    return std::min<Index>(Font::rows_in_bytes, m.rows_in_bytes() - I0);
+}
+
+// Escribe el glyph byte a byte. Funciona para cualquier p0.i (esté o no
+// alineado con los bytes del bitmatrix).
+// precondition: p0 está dentro de m
+template <typename Font, size_t NR, size_t NC>
+void write_glyph_bytewise(Bitmatrix_col_1bit<NR, NC>& m, 
 	    const typename Bitmatrix_col_1bit<NR, NC>::Coord_ij& p0, 
 	    char ic)
-    requires requires 
-	    {	Font::is_by_columns; 
-		Font::is_turned_to_the_right;
-		Font::is_ASCII_font;
-	    }
 {
     using Index = typename Bitmatrix_col_1bit<NR, NC>::index_type;
 
-    if (p0.i >= m.rows() or p0.j >=  m.cols())
-	return;
-
     auto letter = Font::glyph.row(Font::index(ic));
     auto c = letter.begin();
 
@@ -96,6 +153,90 @@ void write(Bitmatrix_col_1bit<NR, NC>& m,
     }
 }
 
+}// impl_of
+
+
+// Escribe el caracter c en el byte más próximo al bit (i, j) 
+// usando la fuente Font.
+// precondition: (i, j) son unsigned ==> i >= 0 and j >= 0
+//		(¿modificarlo para que admita signed? De momento no)
+//
+// Si p0.i es múltiplo de 8 (el caso habitual: escribir en una página del
+// SDD1306) lee el glyph de golpe y lo copia directamente en los bytes de las
+// columnas.
+template <typename Font, size_t NR, size_t NC>
+void write(Bitmatrix_col_1bit<NR, NC>& m, 
+	    const typename Bitmatrix_col_1bit<NR, NC>::Coord_ij& p0, 
+	    char ic)
+    requires requires 
+	    {	Font::is_by_columns; 
+		Font::is_turned_to_the_right;
+		Font::is_ASCII_font;
+	    }
+{
+    using Index = typename Bitmatrix_col_1bit<NR, NC>::index_type;
+
+    if (p0.i >= m.rows() or p0.j >=  m.cols())
+	return;
+
+    if (p0.i % 8 != 0){
+	impl_of::write_glyph_bytewise<Font>(m, p0, ic);
+	return;
+    }
+
+    Index I0 = p0.i / 8;
+    uint8_t glyph[Font::cols * Font::rows_in_bytes];
+    impl_of::glyph_read<Font>(ic, glyph);
+
+    impl_of::write_glyph_aligned<Font>(m, I0, p0.j,
+		    std::min<Index>(Font::cols, m.cols() - p0.j),
+		    impl_of::glyph_nbytes_aligned<Font>(m, I0),
+		    glyph);
+}
+
+
+// Escribe la cadena s a partir de p0 (en una línea, sin saltos de línea).
+// Lo que no quepa en m no se escribe.
+// El recorte se calcula una sola vez para toda la cadena.
+template <typename Font, size_t NR, size_t NC>
+void write(Bitmatrix_col_1bit<NR, NC>& m, 
+	    typename Bitmatrix_col_1bit<NR, NC>::Coord_ij p0, 
+	    std::string_view s)
+    requires requires 
+	    {	Font::is_by_columns; 
+		Font::is_turned_to_the_right;
+		Font::is_ASCII_font;
+	    }
+{
+    using Index = typename Bitmatrix_col_1bit<NR, NC>::index_type;
+
+    if (p0.i >= m.rows() or p0.j >=  m.cols())
+	return;
+
+    // Número de caracteres que caben (el último puede quedar cortado)
+    Index nchars = ceil_division<Index>(m.cols() - p0.j, Font::cols);
+    if (s.size() < nchars)
+	nchars = s.size();
+
+    if (p0.i % 8 != 0){
+	for (Index k = 0; k < nchars; ++k, p0.j += Font::cols)
+	    impl_of::write_glyph_bytewise<Font>(m, p0, s[k]);
+
+	return;
+    }
+
+    Index I0 = p0.i / 8;
+    uint8_t nbytes = impl_of::glyph_nbytes_aligned<Font>(m, I0);
+    uint8_t glyph[Font::cols * Font::rows_in_bytes];
+
+    for (Index k = 0; k < nchars; ++k, p0.j += Font::cols){
+	impl_of::glyph_read<Font>(s[k], glyph);
+	impl_of::write_glyph_aligned<Font>(m, I0, p0.j,
+			std::min<Index>(Font::cols, m.cols() - p0.j),
+			nbytes, glyph);
+    }
+}
+
 
 // Bitmatrix_row_1bit
 // ------------------
@@ -41,6 +41,7 @@
  *    27/06/2024 multiply(x).by_ten_to_the(n);
  *               divide  (x).by_ten_to_the(n);
  *    29/09/2024 ceil_division
+ *    18/10/2026 is_power_of_two, ceil_power_of_two
  *
  ****************************************************************************/
 #include <cstdlib>
@@ -105,6 +106,23 @@ inline constexpr int exponent_of_power_of_ten(Int x, int exp = 0)
 
 }
 
+// El 1 == 2^0 es potencia de 2.
+template <typename Int>
+inline constexpr bool is_power_of_two(Int x)
+{ return x != 0 and (x & (x - 1)) == 0; }
+
+// Devuelve la menor potencia de 2 >= x (= std::bit_ceil)
+// precondicion: el resultado cabe en Int.
+template <typename Int>
+inline constexpr Int ceil_power_of_two(Int x)
+{
+    Int res{1};
+    while (res < x)
+	res <<= 1;
+
+    return res;
+}
+
 
 
 
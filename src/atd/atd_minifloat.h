@@ -85,12 +85,14 @@
  *    Manuel Perez
  *    18/10/2023 Versión mínima, para probar.
  *    27/06/2024 integer_part
+ *    18/10/2026 print_as_decimal_negative_exponent: to_chars
  *
  ****************************************************************************/
 #include <limits>
 #include <algorithm>
 #include <type_traits>	// common_type
 #include <tuple>	// std::tie
+#include <charconv>	// to_chars
 			
 #include "atd_concepts.h"
 #include "atd_math.h"
@@ -841,46 +843,42 @@ void print_as_decimal_positive_exponent(Out& out, const Minifloat<Rep, E_t>& f)
 
 // Idea: descomponer el número de `n` cifras en `ndigits + ndecimals`
 // donde `ndigits` da el número de cifras enteras que tiene.
+// Las cifras las obtenemos con to_chars (sin dividir).
 template <typename Out, Type::Integer Rep, Type::Integer E_t>
 void print_as_decimal_negative_exponent(Out& out, const Minifloat<Rep, E_t>& f)
 {
-    auto x = f.significand();
-
-    if constexpr (std::is_signed_v<Rep>){
-	if (x < 0){
-	    out << '-';
-	    x = -x;
-	}
+    // + 1 por el signo
+    char digits[std::numeric_limits<Rep>::digits10 + 2];
+    char* p0 = digits;
+    char* pe = std::to_chars(digits, digits + sizeof(digits),
+						    f.significand()).ptr;
+    if (*p0 == '-'){
+	out << '-';
+	++p0;
     }
 
-    E_t n = number_of_digits(x);
-
+    E_t n = static_cast<E_t>(pe - p0);
     E_t ndecimals = -f.exponent();
-    E_t ndigits   = n > ndecimals? (n - ndecimals): 0;
-    
-    for (E_t i = 0; i < ndigits; ++i, --n){ 
-	auto digit{x / ten_to_the<Rep>(n - 1)}; // digit = most_significant_digit(x);
-	out << write_as_int(digit);
-	x -= digit * ten_to_the<Rep>(n - 1);   // remove_most_significant_digit(x);
-    }
 
+    char* pd = pe; // donde empiezan los decimales
+    if (n > ndecimals){
+	pd = pe - ndecimals;
+	for (char* p = p0; p != pd; ++p)
+	    out << *p;
+    }
 
-    if (ndigits == 0)   // TODO: los americanos no escriben el 0. (???)
-	out << '0';
+    else{
+	pd = p0;
+	out << '0';	// TODO: los americanos no escriben el 0. (???)
+    }
 
     out << '.'; // TODO: meter esto en atd_locale.h
 
-    n = number_of_digits(x);
-    while (n < ndecimals){
+    for (; n < ndecimals; ++n)
 	out << '0';
-	--ndecimals;
-    }
 
-    for (E_t i = 0; i < ndecimals; ++i, --n){ // TODO: idéntico al bucle anterior. Meterlo en función. Pero ¿qué nombre?
-	auto digit{x / ten_to_the<Rep>(n - 1)}; // digit = most_significant_digit(x);
-	out << write_as_int(digit);
-	x -= digit * ten_to_the<Rep>(n - 1);   // remove_most_significant_digit(x);
-    }
+    for (; pd != pe; ++pd)
+	out << *pd;
 }
 
 // Imprime el número como decimal. 
@@ -42,6 +42,8 @@
  *               Cambio nombre de Progmem a ROM (es más general y refleja el
  *               hecho de que se trata de memoria de solo lectura).
  *    12/08/2024 ROM_biarray	
+ *    18/10/2026 RAM_read
+ *               ROM_biarray::read_row
  *
  ****************************************************************************/
 /***************************************************************************
@@ -133,6 +135,27 @@ private:
 /***************************************************************************
  *				    ROM
  ***************************************************************************/
+// Read
+// ----
+// Función Read para cuando los datos no están en la ROM sino en RAM (en el
+// ordenador o si no queremos gastar PROGMEM en una tabla pequeña).
+//
+// Opcionalmente Read puede suministrar `copy(dst, src, n)` que copia de
+// golpe n elementos (el equivalente a memcpy_P). Si no la suministra se
+// copian elemento a elemento.
+struct RAM_read{
+    template <typename T>
+    constexpr T operator()(const T& x) const { return x; }
+
+    template <typename T>
+    constexpr void copy(T* dst, const T* src, size_t n) const
+    {
+	for (size_t i = 0; i < n; ++i)
+	    dst[i] = src[i];
+    }
+};
+
+
 // One element
 // -----------
 template <typename T, typename Read>
@@ -250,6 +273,10 @@ public:
     const_Row row(Ind i) const
 	{ return const_Row{*this, index(i, 0), index(i + 1, 0)};}
 
+    // Copia la fila i en dst[0, cols()). Si Read lo permite lo hace con
+    // una única lectura de bloque de la ROM.
+    void read_row(Ind i, T* dst) const;
+
 // Unidimensional access
     const_iterator begin() const {return const_iterator{*this, 0};}
     const_iterator end() const {return const_iterator{*this, size()};}
@@ -269,6 +296,21 @@ public:
     size_type index(Ind i, Ind j) const { return i * cols() + j; }
 };
 
+template <typename T, size_t nr, size_t nc, typename Read>
+void ROM_biarray<T, nr, nc, Read>::read_row(Ind i, T* dst) const
+{
+    Read read;
+    const T* src = &data[index(i, 0)];
+
+    if constexpr (requires {read.copy(dst, src, nc);})
+	read.copy(dst, src, nc);
+
+    else {
+	for (size_type j = 0; j < nc; ++j)
+	    dst[j] = read(src[j]);
+    }
+}
+
 
 }// namespace
 
@@ -39,10 +39,12 @@
  *	05/01/2023 Simplifico implementación Generic_time_view con requires
  *		   y renombro a Date_time_view
  *	07/01/2023 Date_time/Time_ms
+ *	18/10/2026 Date_time sin mktime/localtime_r (aritmética de calendario)
  *
  *
  ****************************************************************************/
 #include <ctime>
+#include <cstdint>
 #include <ostream>
 #include <istream>
 #include <iomanip>
@@ -162,6 +164,42 @@ struct Generic_time_traits{
     static constexpr int weekday_max = 6;
 };
 
+/***************************************************************************
+ *			    CALENDARIO <-> time_t
+ ***************************************************************************/
+// (RRR) mktime/localtime_r normalizan el std::tm, consultan la zona horaria
+//	 y el horario de verano. Son caras y arrastran mucho código de la
+//	 libc. Nuestros relojes trabajan en UTC así que basta con la
+//	 aritmética de calendario de std::chrono (O(1), sin bucles).
+namespace impl_of{
+// Día (contado desde 1970-01-01) en el que empieza a contar time_t.
+// avr-libc empieza a contar el 1 de enero de 2000 (UNIX_OFFSET).
+#ifdef UNIX_OFFSET
+inline constexpr int32_t time_t_epoch_in_days = UNIX_OFFSET / 86400L;
+#else
+inline constexpr int32_t time_t_epoch_in_days = 0;
+#endif
+
+inline constexpr int32_t seconds_per_day = 86400L;
+}// impl_of
+
+// Convierte la fecha (UTC) en time_t. No valida la fecha: si los campos
+// están fuera de rango se suman tal cual (como hace mktime).
+inline std::time_t to_time_t(int year, int month, int day,
+			     int hours, int minutes, int seconds)
+{
+    std::chrono::year_month_day ymd{std::chrono::year{year},
+			    std::chrono::month{static_cast<unsigned>(month)},
+			    std::chrono::day{1}};
+
+    int32_t d = std::chrono::sys_days{ymd}.time_since_epoch().count()
+		+ (day - 1) - impl_of::time_t_epoch_in_days;
+
+    return static_cast<std::time_t>(d) * impl_of::seconds_per_day
+	    + hours * 3600L + minutes * 60L + seconds;
+}
+
+
 // Unifico el interfaz de std::tm a mi interfaz genérico.
 // (RRR) Quiero poder poner en hora los relojes Clock_s, ... y sinceramente
 //	 me resulta un lío recordar el interfaz de funciones de C para manejar
@@ -169,17 +207,15 @@ struct Generic_time_traits{
 //	 de manejar.
 class Date_time{
 public:
-    Date_time() {tm_.tm_isdst = -1; } // -1 = desconozco su valor
-				     //	     Que lo calcule mktime cuando se
-				     //	     llame.
+    Date_time() {tm_.tm_isdst = 0; } // trabajamos siempre en UTC
+
 // Machine form
-    // CUIDADO: la inversa de mktime es localtime_r!!!
-    void from_time_t(const std::time_t& t) { ::localtime_r(&t, &tm_); }
-    // (RRR) Esta función es de consulta, tiene que ser const. El problema es
-    //	     que mktime modifica tm_. Aunque al principio intenté dejarla como
-    //	     no const, eso se propaga por el resto del código generando código
-    //	     muy raro. Tiene que ser const!!!
-    std::time_t to_time_t() const { return ::mktime(&((tm&)tm_));}
+    // Las dos funciones consideran que la hora es UTC.
+    void from_time_t(const std::time_t& t);
+
+    std::time_t to_time_t() const 
+    { return atd::to_time_t(year(), month(), day(), 
+			    hours(), minutes(), seconds()); }
 
 // Human form
     int seconds() const { return tm_.tm_sec; }
@@ -210,6 +246,34 @@ private:
     std::tm tm_;   
 };
 
+inline void Date_time::from_time_t(const std::time_t& t)
+{
+    // (RRR) En el ordenador time_t tiene signo: redondeamos hacia -infinito
+    int32_t d = static_cast<int32_t>(t / impl_of::seconds_per_day);
+    int32_t s = static_cast<int32_t>(t % impl_of::seconds_per_day);
+    if (s < 0){
+	s += impl_of::seconds_per_day;
+	--d;
+    }
+
+    std::chrono::sys_days sd{std::chrono::days{d + impl_of::time_t_epoch_in_days}};
+    std::chrono::year_month_day ymd{sd};
+
+    tm_.tm_year = static_cast<int>(ymd.year()) - 1900;
+    tm_.tm_mon  = static_cast<int>(static_cast<unsigned>(ymd.month())) - 1;
+    tm_.tm_mday = static_cast<int>(static_cast<unsigned>(ymd.day()));
+    tm_.tm_wday = static_cast<int>(std::chrono::weekday{sd}.c_encoding());
+    tm_.tm_yday = static_cast<int>((sd - std::chrono::sys_days{
+			    std::chrono::year_month_day{ymd.year(), 
+			    std::chrono::month{1}, std::chrono::day{1}}}).count());
+
+    tm_.tm_hour = static_cast<int>(s / 3600);
+    s %= 3600;
+    tm_.tm_min  = static_cast<int>(s / 60);
+    tm_.tm_sec  = static_cast<int>(s % 60);
+    tm_.tm_isdst = 0;
+}
+
 
 
 
@@ -25,6 +25,7 @@
 #include <alp_test.h>
 #include <alp_string.h>
 #include <vector>
+#include <random>
 
 #include <cstddef>
 #include <iostream> 
@@ -488,6 +489,140 @@ void test_array_of_bytes_view()
 
 
 
+// Simulamos un productor (la ISR) y un consumidor (el programa principal)
+// ejecutándose de forma intercalada: en cada paso uno de los dos realiza
+// una operación al azar. El consumidor comprueba que recibe la secuencia
+// 0, 1, 2, ... sin perder ni duplicar nada.
+template <typename T, size_t N>
+void test_spsc_ring_stress(uint32_t nsteps)
+{
+    using Ring = atd::Spsc_ring<T, N>;
+    using size_type = typename Ring::size_type;
+
+    Ring ring;
+    std::mt19937 gen{N};
+
+    uint32_t next_push = 0;
+    uint32_t next_pop  = 0;
+    bool ok = true;
+
+    auto check = [&](const T& x) {
+	if (static_cast<uint32_t>(x) != next_pop)
+	    ok = false;
+	++next_pop;
+    };
+
+    T buf[N];
+
+    for (uint32_t step = 0; step < nsteps and ok; ++step){
+	size_type n = static_cast<size_type>(gen() % (N + 1));
+
+	switch (gen() % 6){
+	    break; case 0: // push
+		if (ring.push(T(next_push)))
+		    ++next_push;
+		else if (!ring.full()) ok = false;
+
+	    break; case 1:{ // push_n
+		for (size_type i = 0; i < n; ++i)
+		    buf[i] = T(next_push + i);
+		size_type avail = ring.available();
+		size_type m = ring.push_n(buf, n);
+		if (m != std::min(n, avail)) ok = false;
+		next_push += m;
+	    }
+
+	    break; case 2:{ // free_span/commit
+		auto span = ring.free_span();
+		size_type m = std::min<size_type>(n, span.size());
+		for (size_type i = 0; i < m; ++i)
+		    span[i] = T(next_push + i);
+		ring.commit(m);
+		next_push += m;
+	    }
+
+	    break; case 3:{ // pop
+		T x;
+		if (ring.pop(x)) check(x);
+		else if (!ring.empty()) ok = false;
+	    }
+
+	    break; case 4:{ // pop_n
+		size_type sz = ring.size();
+		size_type m = ring.pop_n(buf, n);
+		if (m != std::min(n, sz)) ok = false;
+		for (size_type i = 0; i < m; ++i)
+		    check(buf[i]);
+	    }
+
+	    break; case 5:{ // peek/consume
+		auto span = ring.peek();
+		size_type m = std::min<size_type>(n, span.size());
+		for (size_type i = 0; i < m; ++i)
+		    check(span[i]);
+		ring.consume(m);
+	    }
+	}
+
+	if (ring.size() != next_push - next_pop or ring.size() > N)
+	    ok = false;
+    }
+
+    CHECK_TRUE(ok, "stress");
+    CHECK_TRUE(next_pop > 4 * N, "stress: indices wrap around");
+}
+
+struct Sample{
+    uint16_t value;
+    uint8_t channel;
+
+    Sample() = default;
+    explicit Sample(uint32_t x) 
+	: value{static_cast<uint16_t>(x)}, channel{static_cast<uint8_t>(x >> 16)}
+    { }
+    explicit operator uint32_t() const 
+    { return value + (static_cast<uint32_t>(channel) << 16); }
+};
+
+void test_spsc_ring()
+{
+    test::interface("Spsc_ring");
+
+    atd::Spsc_ring<uint8_t, 4> ring;
+    CHECK_TRUE(ring.empty() and !ring.full() and ring.capacity() == 4, "empty");
+    CHECK_TRUE(sizeof(ring) == 4 + 2, "sizeof");
+
+    uint8_t x[] = {1, 2, 3, 4, 5};
+    CHECK_TRUE(ring.push_n(x, 5) == 4, "push_n");
+    CHECK_TRUE(ring.full() and !ring.push(6), "full");
+
+    uint8_t y[4]{};
+    CHECK_TRUE(ring.pop_n(y, 3) == 3, "pop_n");
+    CHECK_TRUE(y[0] == 1 and y[1] == 2 and y[2] == 3, "pop_n");
+
+    // head_ = 4, tail_ = 3: la zona libre contigua es [0, 3)
+    CHECK_TRUE(ring.free_span().size() == 3, "free_span");
+    CHECK_TRUE(ring.push(5) and ring.push(6), "push");
+    CHECK_TRUE(ring.peek().size() == 1 and ring.peek()[0] == 4, "peek");
+    ring.consume(1);
+    CHECK_TRUE(ring.peek().size() == 2 and ring.peek()[1] == 6, "peek");
+
+    CHECK_TRUE(ring.push_overwrite(7), "push_overwrite");
+    CHECK_TRUE(ring.push(8) and !ring.push_overwrite(9), "push_overwrite");
+    uint8_t z;
+    CHECK_TRUE(ring.pop(z) and z == 6, "push_overwrite");
+
+    ring.reset();
+    CHECK_TRUE(ring.empty() and ring.size() == 0, "reset");
+
+    test_spsc_ring_stress<uint32_t, 8>(100'000);
+    test_spsc_ring_stress<uint32_t, 128>(100'000);
+    test_spsc_ring_stress<Sample, 256>(100'000);
+    static_assert(sizeof(atd::Spsc_ring<uint8_t, 128>::size_type) == 1);
+    static_assert(sizeof(atd::Spsc_ring<uint8_t, 256>::size_type) == 2);
+}
+
+
 int main()
 {
 try{
@@ -498,6 +633,7 @@ try{
     test_array();
     test_array_view();
     test_array_of_bytes_view();
+    test_spsc_ring();
 
 }catch(std::exception& e)
 {
@@ -0,0 +1,105 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../atd_benchmark.h"
+#include "pru_benchmark_clock.h"
+
+#include <alp_test.h>
+#include <iostream>
+#include <sstream>
+
+using namespace test;
+
+using Stub_clock = pru::Stub_clock;
+
+void test_benchmark()
+{
+    test::interface("Benchmark");
+
+    Stub_clock::overhead = 5;
+    std::ostringstream out;
+    test::Benchmark<Stub_clock, 5> bench{out};
+    CHECK_TRUE(bench.overhead() == 5, "overhead");
+
+    {// tiempo constante
+	auto res = bench.run("const", []{ Stub_clock::tick(100); });
+	CHECK_TRUE(res.min == 100 and res.median == 100 and res.max == 100,
+								    "run");
+	CHECK_TRUE(out.str() == "bench const 100 100 100\n", "print");
+    }
+
+    {// tiempos desordenados
+	const uint32_t t[] = {30, 10, 50, 20, 40};
+	int k = 0;
+	auto res = bench.measure([&]{ Stub_clock::tick(t[k++]); });
+	CHECK_TRUE(res.min == 10 and res.median == 30 and res.max == 50,
+								"measure");
+    }
+
+    {// nunca devuelve valores negativos
+	auto res = bench.measure([]{});
+	CHECK_TRUE(res.min == 0 and res.max == 0, "empty");
+    }
+}
+
+
+// Benchmarks de ejemplo: este mismo código se puede compilar para el avr
+// cambiando el Clock por Micro::Cycle_counter1 y el ostream por UART.
+template <typename Clock>
+void benchmarks(std::ostream& out)
+{
+    test::Benchmark<Clock> bench{out};
+
+    volatile uint16_t a = 1234;
+    volatile uint16_t b = 56;
+
+    bench.run("div_u16", [&]{
+	uint16_t q = a / b;
+	test::do_not_optimize(q);
+    });
+
+    bench.run("mul_u16", [&]{
+	uint16_t q = a * b;
+	test::do_not_optimize(q);
+    });
+
+    bench.run("loop_100", [&]{
+	uint16_t s = 0;
+	for (uint8_t i = 0; i < 100; ++i)
+	    s += a;
+	test::do_not_optimize(s);
+    });
+}
+
+int main()
+{
+try{
+    test::header("atd_benchmark");
+
+    test_benchmark();
+    
+    std::cout << "\nHost_clock (ns):\n";
+    benchmarks<pru::Host_clock>(std::cout);
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __PRU_BENCHMARK_CLOCK_H__
+#define __PRU_BENCHMARK_CLOCK_H__
+/****************************************************************************
+ *
+ * DESCRIPCION
+ *	Clocks para poder compilar en el ordenador los benchmarks escritos
+ *	para el avr (donde el Clock es Cycle_counter1).
+ *
+ *	Stub_clock  : reloj simulado. Cada llamada a tick(n) avanza n ticks.
+ *		      El resultado es determinista, sirve para probar
+ *		      test::Benchmark.
+ *
+ *	Host_clock  : mide nanosegundos con std::chrono::steady_clock. Sirve
+ *		      para seguir la evolución de un algoritmo en el ordenador.
+ *
+ * HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <cstdint>
+#include <chrono>
+
+namespace pru{ // de pruebas
+
+struct Stub_clock{
+    // Ticks que cuesta start + stop
+    inline static uint32_t overhead = 0;
+
+    static void start() {t0_ = now_;}
+    static uint32_t stop() {return now_ - t0_ + overhead;}
+
+    static void tick(uint32_t n) {now_ += n;}
+
+private:
+    inline static uint32_t now_ = 0;
+    inline static uint32_t t0_  = 0;
+};
+
+
+struct Host_clock{
+    using clock = std::chrono::steady_clock;
+
+    static void start() {t0_ = clock::now();}
+
+    static uint32_t stop()
+    {
+	auto t1 = clock::now();
+	return static_cast<uint32_t>(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0_).count());
+    }
+
+private:
+    inline static clock::time_point t0_;
+};
+
+} // namespace
+
+#endif
@@ -22,6 +22,8 @@
 
 #include <iostream> 
 #include <span>
+#include <chrono>
+#include <vector>
 
 #include <alp_test.h>
 #include <alp_string.h>
@@ -84,6 +86,174 @@ void test_crc8_Maxim()
 }
 
 
+
+// Mensaje estándar para comprobar los CRC ("check" de los catálogos de CRC)
+constexpr uint8_t check_msg[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+// Los CRC bit a bit son constexpr
+static_assert(atd::CRC16_CCITT(check_msg) == 0x31C3);
+static_assert(atd::CRC32(check_msg) == 0xCBF43926);
+
+constexpr atd::CRC7_table<16>  crc7_16{};
+constexpr atd::CRC7_table<256> crc7_256{};
+constexpr atd::CRC8_Maxim_table<16>  crc8_16{};
+constexpr atd::CRC8_Maxim_table<256> crc8_256{};
+constexpr atd::CRC16_CCITT_table<16>  crc16_16{};
+constexpr atd::CRC16_CCITT_table<256> crc16_256{};
+constexpr atd::CRC32_table<16>  crc32_16{};
+constexpr atd::CRC32_table<256> crc32_256{};
+
+void test_crc7_table()
+{
+    test::interface("CRC7_table");
+
+    // CMD0 y CMD8 de la SD card: el último byte del comando es (crc << 1) | 1
+    uint8_t cmd0[] = {0x40, 0x00, 0x00, 0x00, 0x00};
+    uint8_t cmd8[] = {0x48, 0x00, 0x00, 0x01, 0xAA};
+
+    CHECK_TRUE(atd::CRC7(cmd0) == 0x4A, "CRC7(CMD0)");
+    CHECK_TRUE(atd::CRC7(crc7_16, cmd0) == 0x4A, "CRC7<16>(CMD0)");
+    CHECK_TRUE(atd::CRC7(crc7_256, cmd0) == 0x4A, "CRC7<256>(CMD0)");
+    CHECK_TRUE(atd::CRC7(crc7_16, cmd8) == 0x43, "CRC7<16>(CMD8)");
+    CHECK_TRUE(atd::CRC7(crc7_256, cmd8) == 0x43, "CRC7<256>(CMD8)");
+}
+
+void test_crc8_Maxim_table()
+{
+    test::interface("CRC8_Maxim_table");
+
+    CHECK_TRUE(atd::CRC8_Maxim(crc8_16, check_msg) == 0xA1, "CRC8_Maxim<16>");
+    CHECK_TRUE(atd::CRC8_Maxim(crc8_256, check_msg) == 0xA1, "CRC8_Maxim<256>");
+
+    uint8_t msg[] = {0x28, 0xFF, 0x6E, 0x6E, 0x02, 0x17, 0x05};
+    CHECK_TRUE(atd::CRC8_Maxim(crc8_16, msg) == 0x8C, "CRC8_Maxim<16>");
+    CHECK_TRUE(atd::CRC8_Maxim(crc8_256, msg) == 0x8C, "CRC8_Maxim<256>");
+}
+
+void test_crc16_CCITT()
+{
+    test::interface("CRC16_CCITT");
+
+    CHECK_TRUE(atd::CRC16_CCITT(crc16_16, check_msg) == 0x31C3, "CRC16<16>");
+    CHECK_TRUE(atd::CRC16_CCITT(crc16_256, check_msg) == 0x31C3, "CRC16<256>");
+
+    // Bloque de la SD card de 512 bytes a 0xFF
+    std::vector<uint8_t> block(512, 0xFF);
+    CHECK_TRUE(atd::CRC16_CCITT(block) == 0x7FA1, "CRC16(block)");
+    CHECK_TRUE(atd::CRC16_CCITT(crc16_256, block) == 0x7FA1, "CRC16<256>(block)");
+}
+
+void test_crc32()
+{
+    test::interface("CRC32");
+
+    CHECK_TRUE(atd::CRC32(crc32_16, check_msg) == 0xCBF43926, "CRC32<16>");
+    CHECK_TRUE(atd::CRC32(crc32_256, check_msg) == 0xCBF43926, "CRC32<256>");
+
+    // Por trozos
+    std::span<const uint8_t> msg{check_msg};
+    uint32_t crc = atd::CRC32_update(0, msg.first(4));
+    crc = atd::CRC32_update(crc, msg.subspan(4));
+    CHECK_TRUE(crc == 0xCBF43926, "CRC32_update");
+
+    crc = atd::CRC32_update(crc32_16, 0, msg.first(5));
+    crc = atd::CRC32_update(crc32_16, crc, msg.subspan(5));
+    CHECK_TRUE(crc == 0xCBF43926, "CRC32_update<16>");
+}
+
+
+// Comparamos todas las versiones con la bit a bit
+void test_tables_vs_bitwise()
+{
+    test::interface("CRC_table vs bitwise");
+
+    std::vector<uint8_t> msg(300);
+    for (size_t i = 0; i < msg.size(); ++i)
+	msg[i] = static_cast<uint8_t>(i * 37 + 11);
+
+    bool ok = true;
+    for (size_t n = 0; n < msg.size(); ++n){
+	std::span<const uint8_t> d{msg.data(), n};
+
+	uint8_t c7 = atd::CRC7(d);
+	uint8_t c8 = atd::CRC8_Maxim(d);
+	uint16_t c16 = atd::CRC16_CCITT(d);
+	uint32_t c32 = atd::CRC32(d);
+
+	if (atd::CRC7(crc7_16, d) != c7 or atd::CRC7(crc7_256, d) != c7 or
+	    atd::CRC8_Maxim(crc8_16, d) != c8 or 
+	    atd::CRC8_Maxim(crc8_256, d) != c8 or
+	    atd::CRC16_CCITT(crc16_16, d) != c16 or
+	    atd::CRC16_CCITT(crc16_256, d) != c16 or
+	    atd::CRC32(crc32_16, d) != c32 or
+	    atd::CRC32(crc32_256, d) != c32)
+	    ok = false;
+    }
+
+    CHECK_TRUE(ok, "tables == bitwise");
+}
+
+
+/***************************************************************************
+ *				BENCHMARK
+ * En el ordenador no podemos contar ciclos del avr: medimos ns/byte, que
+ * da la proporción entre las distintas versiones. El coste en flash es el
+ * tamaño de la tabla (el código de cada versión es del mismo orden).
+ ***************************************************************************/
+template <typename F>
+void benchmark(const char* name, size_t table_size, F f)
+{
+    std::vector<uint8_t> msg(4096);
+    for (size_t i = 0; i < msg.size(); ++i)
+	msg[i] = static_cast<uint8_t>(i * 13 + 7);
+
+    constexpr int ntimes = 200;
+    volatile uint32_t res = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < ntimes; ++i)
+	res = res + f(std::span<const uint8_t>{msg});
+    auto t1 = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    std::cout << name << ": " << ns / (ntimes * msg.size()) << " ns/byte; "
+	      << table_size << " bytes de tabla\n";
+}
+
+void benchmark()
+{
+    test::interface("Benchmark");
+
+    benchmark("CRC7        bitwise", 0, 
+	    [](auto d) {return atd::CRC7(d);});
+    benchmark("CRC7        <16>   ", sizeof(crc7_16),
+	    [](auto d) {return atd::CRC7(crc7_16, d);});
+    benchmark("CRC7        <256>  ", sizeof(crc7_256),
+	    [](auto d) {return atd::CRC7(crc7_256, d);});
+
+    benchmark("CRC8_Maxim  bitwise", 0, 
+	    [](auto d) {return atd::CRC8_Maxim(d);});
+    benchmark("CRC8_Maxim  <16>   ", sizeof(crc8_16),
+	    [](auto d) {return atd::CRC8_Maxim(crc8_16, d);});
+    benchmark("CRC8_Maxim  <256>  ", sizeof(crc8_256),
+	    [](auto d) {return atd::CRC8_Maxim(crc8_256, d);});
+
+    benchmark("CRC16_CCITT bitwise", 0, 
+	    [](auto d) {return atd::CRC16_CCITT(d);});
+    benchmark("CRC16_CCITT <16>   ", sizeof(crc16_16),
+	    [](auto d) {return atd::CRC16_CCITT(crc16_16, d);});
+    benchmark("CRC16_CCITT <256>  ", sizeof(crc16_256),
+	    [](auto d) {return atd::CRC16_CCITT(crc16_256, d);});
+
+    benchmark("CRC32       bitwise", 0, 
+	    [](auto d) {return atd::CRC32(d);});
+    benchmark("CRC32       <16>   ", sizeof(crc32_16),
+	    [](auto d) {return atd::CRC32(crc32_16, d);});
+    benchmark("CRC32       <256>  ", sizeof(crc32_256),
+	    [](auto d) {return atd::CRC32(crc32_256, d);});
+}
+
+
 int main()
 {
 try{
@@ -91,6 +261,13 @@ try{
     
     test_crc7();
     test_crc8_Maxim();
+    test_crc7_table();
+    test_crc8_Maxim_table();
+    test_crc16_CCITT();
+    test_crc32();
+    test_tables_vs_bitwise();
+
+    benchmark();
 
 }catch(std::exception& e)
 {
@@ -0,0 +1,162 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <alp_test.h>
+#include <alp_string.h>
+#include <iostream>
+#include <chrono>
+#include <string_view>
+
+#include "../../atd_bit_matrix.h"
+#include "../../atd_draw.h"
+
+#include "my_rom.h"
+#include "../../../rom/rom_font_dogica_8x8_cr.h"
+#include "../../../rom/rom_font_PerfectDOSVGA437_8x15_cr.h"
+
+using namespace test;
+
+using Font8x8  = rom::font_dogica_8x8_cr::Font;
+using Font8x15 = rom::font_PerfectDOSVGA437_8x15_cr::Font;
+
+using BM = atd::Bitmatrix_col_1bit<64, 128>;
+using Coord_ij = BM::Coord_ij;
+
+constexpr std::string_view msg = "Hello, world! 0123456789";
+
+bool operator==(const BM& a, const BM& b)
+{
+    for (uint16_t I = 0; I < a.rows_in_bytes(); ++I)
+	for (uint16_t j = 0; j < a.cols_in_bytes(); ++j)
+	    if (a.read_byte(I, j) != b.read_byte(I, j))
+		return false;
+
+    return true;
+}
+
+// Escribe msg carácter a carácter con la implementación byte a byte
+template <typename Font>
+void write_bytewise(BM& m, Coord_ij p0, std::string_view s)
+{
+    for (char c : s){
+	if (p0.j >= m.cols())
+	    return;
+
+	atd::impl_of::write_glyph_bytewise<Font>(m, p0, c);
+	p0.j += Font::cols;
+    }
+}
+
+template <typename Font>
+void test_write(const char* name)
+{
+    test::interface(name);
+
+    BM m0, m1, m2;
+
+    // Probamos todas las posiciones (alineadas o no) de la primera columna,
+    // y desplazamientos horizontales para que se corte el final
+    for (uint16_t i = 0; i < m0.rows(); ++i){
+	for (uint16_t j = 0; j < Font::cols; j += 3){
+	    m0.clear(); m1.clear(); m2.clear();
+
+	    write_bytewise<Font>(m0, Coord_ij{i, j}, msg);
+
+	    Coord_ij p{i, j};
+	    for (char c : msg){
+		atd::write<Font>(m1, p, c);
+		p.j += Font::cols;
+	    }
+
+	    atd::write<Font>(m2, Coord_ij{i, j}, msg);
+
+	    CHECK_TRUE(m0 == m1, "write(char)");
+	    CHECK_TRUE(m0 == m2, "write(string_view)");
+	}
+    }
+}
+
+
+// Benchmark
+// ---------
+template <typename F>
+double ns_per_char(F f, uint32_t nchars)
+{
+    using namespace std::chrono;
+
+    constexpr int N = 20000;
+    auto t0 = steady_clock::now();
+    for (int k = 0; k < N; ++k)
+	f();
+    auto t1 = steady_clock::now();
+
+    return duration<double, std::nano>(t1 - t0).count() / (double(N) * nchars);
+}
+
+// Para que el compilador no elimine el trabajo
+volatile uint8_t sink;
+
+template <typename Font>
+void benchmark(const char* name)
+{
+    BM m;
+    Coord_ij p0{8, 0};
+    uint32_t n = 128 / Font::cols;	// caracteres que caben en una línea
+    std::string_view s = msg.substr(0, n);
+
+    double t0 = ns_per_char([&]{
+		    write_bytewise<Font>(m, p0, s);
+		    sink = m.read_byte(1, 0);}, s.size());
+
+    double t1 = ns_per_char([&]{
+		    Coord_ij p = p0;
+		    for (char c : s){
+			atd::write<Font>(m, p, c);
+			p.j += Font::cols;
+		    }
+		    sink = m.read_byte(1, 0);}, s.size());
+
+    double t2 = ns_per_char([&]{
+		    atd::write<Font>(m, p0, s);
+		    sink = m.read_byte(1, 0);}, s.size());
+
+    std::cout << name << ":\n"
+	      << "\tbyte a byte      : " << t0 << " ns/char\n"
+	      << "\twrite(char)      : " << t1 << " ns/char (x" << t0 / t1 << ")\n"
+	      << "\twrite(string_view): " << t2 << " ns/char (x" << t0 / t2 << ")\n";
+}
+
+
+int main()
+{
+try{
+    test::header("atd_draw");
+
+    test_write<Font8x8>("write (8x8)");
+    test_write<Font8x15>("write (8x15)");
+
+    benchmark<Font8x8>("dogica 8x8");
+    benchmark<Font8x15>("PerfectDOSVGA437 8x15");
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
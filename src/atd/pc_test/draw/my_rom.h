@@ -0,0 +1,47 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __MY_ROM_H__
+#define __MY_ROM_H__
+
+#include <cstring>
+
+// ----------------------------------------------
+// Funciones que dependen de la gestión de la ROM
+namespace my{
+struct ROM_read{
+    template <typename T>
+    T operator()(const T& x) const
+    { return x; }
+
+    // Equivalente a memcpy_P
+    template <typename T>
+    void copy(T* dst, const T* src, size_t n) const
+    { std::memcpy(dst, src, n * sizeof(T)); }
+};
+} // my
+#define PROGMEM
+#define MCU my
+// ----------------------------------------------
+
+
+
+#endif
@@ -273,6 +273,22 @@ void test_date_time()
     CHECK_TRUE(t.minutes() == 22, "minutes");
     CHECK_TRUE(t.seconds() == 32, "seconds");
 
+// Comparamos con gmtime_r
+    bool ok = true;
+    for (std::time_t x = -5'000'000'000; x < 5'000'000'000; x += 7'777'777){
+	std::tm tm0;
+	::gmtime_r(&x, &tm0);
+	t.from_time_t(x);
+
+	if (t.year() != tm0.tm_year + 1900 or t.month() != tm0.tm_mon + 1 or
+	    t.day() != tm0.tm_mday or t.weekday() != tm0.tm_wday or
+	    t.hours() != tm0.tm_hour or t.minutes() != tm0.tm_min or
+	    t.seconds() != tm0.tm_sec or t.to_time_t() != x){
+	    ok = false;
+	    break;
+	}
+    }
+    CHECK_TRUE(ok, "from_time_t/to_time_t == gmtime_r");
 }
 
 std::ostream& operator<<(std::ostream& out, const atd::Time_ms& t)
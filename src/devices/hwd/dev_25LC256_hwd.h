@@ -87,7 +87,7 @@ public:
     /// FUNDAMENTAL: para que write funcione es necesario haber llamado
     /// antes a write_enable(). En caso contrario, esta función no escribirá
     /// nada.
-    uint8_t write(Address address, uint8_t* buf, uint8_t n);
+    uint8_t write(Address address, const uint8_t* buf, uint8_t n);
 
     /// Set the write enable latch.
     void write_enable() { write_cmd(WREN); }
@@ -252,7 +252,7 @@ EEPROM_25LC256<no_CS, no_WP, no_HOLD>::read(Address address,
 //  escrito leyendo la memoria.
 template <uint8_t no_CS, uint8_t no_WP, uint8_t no_HOLD>
 uint8_t EEPROM_25LC256<no_CS, no_WP, no_HOLD>::
-			    write(Address address, uint8_t* buf, uint8_t n)
+			    write(Address address, const uint8_t* buf, uint8_t n)
 {
     Select select{*this};
 
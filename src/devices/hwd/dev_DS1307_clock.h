@@ -31,6 +31,7 @@
  *  - HISTORIA:
  *    Manuel Perez
  *    25/12/2020 v0.0
+ *    18/10/2026 to_time_t sin mktime
  *
  ****************************************************************************/
 #include "dev_DS1307_hwd.h"
@@ -159,8 +160,8 @@ std::tm DS1307_clock<TWI>::to_tm(const Time_point& t)
 template <typename TWI>
 inline time_t DS1307_clock<TWI>::to_time_t(const Time_point& t0)
 {
-    std::tm tm0 = to_tm(t0);
-    return ::mktime(&tm0);
+    return atd::to_time_t(2000 + t0.year, t0.month, t0.date,
+			  t0.hours, t0.minutes, t0.seconds);
 }
 
 
@@ -35,6 +35,7 @@
  * HISTORIA
  *    Manuel Perez
  *    29/08/2023 Escrito
+ *    18/10/2026 Interfaz no bloqueante: start_conversion/poll/collect
  *
  ****************************************************************************/
 #include <stdint.h> 
@@ -170,6 +171,20 @@ public:
     // TODO
     // static Result read_power_supply();
     
+    // Igual que convert_T pero para todos los sensores conectados al bus
+    // (usa skip_rom). Todos los sensores convierten a la vez.
+    static Result convert_T_all();
+
+    // ¿Han acabado todos los sensores la conversión?
+    // Genera un read time slot: mientras algún sensor esté convirtiendo
+    // lee 0. No bloquea (tarda lo que un read time slot, unos 70 us).
+    // Solo es válido si después de convert_T no se ha hablado con ningún
+    // otro dispositivo del bus (y no funciona con parasite power).
+    static bool is_conversion_done() {return One_wire::read_bit() != 0;}
+
+    // Tiempo máximo que tarda la conversión (tCONV en la datasheet)
+    static constexpr uint16_t conversion_time_ms(Resolution res);
+    
 
     // TODO: nombre mal puesto. Esta función lo que hace es esperar a que el
     // DS18B20 haya acabado de ejecutar el comando solicitado. Si lo acaba
@@ -219,6 +234,33 @@ DS18B20<M,OW>::Result
 }
 
 
+template <typename M, typename OW>
+DS18B20<M,OW>::Result DS18B20<M,OW>::convert_T_all()
+{
+    if (!One_wire::reset())
+	return Result::not_found;
+
+    One_wire::skip_rom();
+    One_wire::write(0x44);
+
+    return Result::ok;
+}
+
+
+template <typename M, typename OW>
+inline constexpr uint16_t DS18B20<M,OW>::conversion_time_ms(Resolution res)
+{
+    switch (res){
+	break; case Resolution::bits_9 : return 94;  // 93.75 ms
+	break; case Resolution::bits_10: return 188; // 187.5 ms
+	break; case Resolution::bits_11: return 375;
+	break; case Resolution::bits_12: return 750;
+    }
+
+    return 750;
+}
+
+
 template <typename M, typename OW>
 DS18B20<M,OW>::Result DS18B20<M,OW>::
 	write_scratchpad(int8_t TH, int8_t TL, Resolution res) const
@@ -278,7 +320,7 @@ DS18B20<M,OW>::wait_until(const uint16_t& time_out_ms) const
     uint16_t t = 0;
 
     // Esperamos a que haga la conversión antes de devolver control
-    while (One_wire::read_bit() == 0){// == 0 means 'in progress'
+    while (!is_conversion_done()){
 	Micro::wait_ms(1);
 	++t;
 	if (t > time_out_ms)
@@ -324,6 +366,44 @@ public:
     //	2) Han transcurrido time_out_ms milisegundos
     Celsius read_temperature(const uint16_t& time_out_ms);
 
+// Interfaz no bloqueante
+    // La conversión tarda hasta 750 ms. En lugar de esperar con
+    // read_temperature, podemos:
+    //	1) start_conversion(): pedir la conversión.
+    //	2) poll(): hacer otras cosas mientras preguntamos si ha acabado.
+    //	3) collect(): leer la temperatura.
+    //
+    // Si hay N sensores en el bus, start_conversion_all() hace que todos
+    // conviertan a la vez: leerlos todos cuesta un tiempo de conversión y
+    // no N.
+    //
+    // Ejemplo:
+    //	    Sensor::start_conversion_all();
+    //	    while (!Sensor::poll()) { ... }
+    //	    for (uint8_t i = 0; i < N; ++i)
+    //		T[i] = sensor[i].collect();
+    //
+    Result start_conversion();
+    static Result start_conversion_all() {return Base::convert_T_all();}
+
+    // ¿Ha acabado la conversión? 
+    // Pregunta al bus (ver is_conversion_done), devolviendo el control
+    // inmediatamente. Solo es válida si no se ha hablado con ningún otro
+    // dispositivo del bus después de start_conversion.
+    static bool poll() {return Base::is_conversion_done();}
+
+    // ¿Ha acabado la conversión?
+    // No usa el bus: compara el tiempo transcurrido desde start_conversion
+    // (que tiene que medir el cliente) con el tiempo máximo de conversión
+    // de la resolución `res`. Útil si hay que hablar con otros dispositivos
+    // mientras se convierte.
+    static bool poll(uint16_t elapsed_ms, Resolution res = Resolution::bits_12)
+    {return elapsed_ms >= Base::conversion_time_ms(res);}
+
+    // Lee la temperatura medida (sin esperar). 
+    // Precondición: la conversión ha acabado (poll() == true).
+    Celsius collect();
+
 // Gestión de errores
     // Devuelve el resulta_las_operation de la ultima función llamada 
     Result result_last_operation() const {return result_;}
@@ -339,12 +419,27 @@ template <typename M, typename OW>
 DS18B20<M, OW>::Celsius 
 DS18B20<M, OW>::read_temperature(const uint16_t& time_out_ms)
 {
-    result_ = Base::convert_T();
+    result_ = start_conversion();
     if (result_ != Result::ok)
 	return Celsius{-1};
 
     result_ = Base::wait_until(time_out_ms);
 
+    return collect();
+}
+
+
+template <typename M, typename OW>
+inline DS18B20<M, OW>::Result DS18B20<M, OW>::start_conversion()
+{
+    result_ = Base::convert_T();
+    return result_;
+}
+
+
+template <typename M, typename OW>
+DS18B20<M, OW>::Celsius DS18B20<M, OW>::collect()
+{
     Scratchpad s;
     result_ = Base::read_scratchpad(s);
     if (result_ != Result::ok)
@@ -34,12 +34,16 @@
  * HISTORIA
  *    Manuel Perez
  *    08/08/2024 Escrito
+ *    18/10/2026 SDD1306_framebuffer
  *
  ****************************************************************************/
 #include <cstdint>
 #include <span>
+#include <algorithm>	// min/max
 
 #include <atd_coordinates.h>
+#include <atd_bit_matrix.h>
+#include <atd_draw.h>
 
 #include <mcu_concepts.h>
 #include <mcu_TWI_master_ioxtream.h>
@@ -682,6 +686,326 @@ using SDD1306_I2C_128x32 = SDD1306_I2C_driver<Cfg, 128, 32>;
 template <typename Cfg>
 using SDD1306_I2C_128x64 = SDD1306_I2C_driver<Cfg, 128, 64>;
 
+
+/***************************************************************************
+ *			    SDD1306_framebuffer
+ ***************************************************************************/
+// Framebuffer del SDD1306 que recuerda qué ha cambiado.
+//
+// Cada vez que se modifica el framebuffer se marca como sucio (dirty) el
+// rango de columnas modificado de cada página. `flush` solo envía al display
+// los bytes sucios: define la ventana con hv_mode_column/page_address y
+// envía los bytes en ráfagas tan grandes como permita el buffer del
+// TWI_master. Cambiar un dígito de un reloj cuesta unas decenas de bytes y
+// no los 1024 bytes de toda la pantalla.
+//
+// El framebuffer es un Bitmatrix_col_1bit ya que guarda los bytes por
+// columnas igual que la GDDRAM del SDD1306 en vertical addressing mode.
+//
+// band_npages
+// -----------
+// Un atmega328 solo tiene 2 kB de RAM: no puede guardar los 1024 bytes de
+// una pantalla de 128x64. Para él se puede definir un framebuffer de
+// `band_npages` páginas (una banda horizontal de la pantalla). La banda se
+// mueve con `band(page0)`. Forma de uso:
+//
+//	SDD1306_framebuffer<Display, 1> fb; // 128 bytes
+//
+//	for (uint8_t p = 0; p < Display::npages; ++p){
+//	    fb.band(p);
+//	    fb.mark_all_dirty();
+//	    draw(fb);	// dibuja lo que caiga en esta banda
+//	    fb.flush();
+//	}
+//
+// Todas las coordenadas (PageCol) son globales de la pantalla: lo que caiga
+// fuera de la banda se ignora.
+//
+template <typename Display0, uint8_t band_npages0 = Display0::npages>
+class SDD1306_framebuffer{
+public:
+// Types
+    using Display	    = Display0;
+    using PageCol	    = atd::PageCol<uint8_t>;
+    using PageCol_rectangle = atd::PageCol_rectangle<uint8_t>;
+
+// Cfg
+    static constexpr uint8_t ncols	 = Display::ncols;
+    static constexpr uint8_t npages	 = Display::npages;
+    static constexpr uint8_t band_npages = band_npages0;
+
+    static_assert(0 < band_npages and band_npages <= npages);
+
+    using Bitmatrix = atd::Bitmatrix_col_1bit<8 * band_npages, ncols>;
+    using Coord_ij  = typename Bitmatrix::Coord_ij;
+
+    // Número de bytes de GDDRAM que se envían en cada transacción TWI
+    // (el primero es el control byte)
+    static constexpr uint8_t burst_size = Display::TWI_master::buffer_size - 1;
+    static_assert(burst_size > 0);
+
+    // Coste aproximado (en bytes en el bus) de definir una ventana:
+    // comando (address + control + 8 bytes) + address y control de los datos
+    static constexpr uint8_t window_cost = 12;
+
+// Constructor
+    // El framebuffer empieza borrado y todo sucio (la primera vez que se
+    // haga flush se envía entero)
+    SDD1306_framebuffer() { fill(0); }
+
+// Banda
+    // Primera página de la banda
+    uint8_t page0() const {return page0_;}
+
+    // Mueve la banda para que empiece en la página page0.
+    // Borra el contenido del framebuffer y lo marca como limpio.
+    // Precondición: se ha hecho flush (si no se pierde lo que quede sucio).
+    void band(uint8_t page0);
+
+    // ¿Está la página `page` dentro de la banda?
+    bool contains(uint8_t page) const 
+    { return page0_ <= page and page < page0_ + band_npages; }
+
+// Acceso
+    // Escribe el byte x en la posición p. Solo lo marca como sucio si
+    // cambia el valor.
+    void write_byte(uint8_t x, const PageCol& p);
+    uint8_t read_byte(const PageCol& p) const;
+
+    // Rellena la banda con el byte x (marcándola toda como sucia)
+    void fill(uint8_t x);
+    void clear() {fill(0);}
+
+    // Escribe el caracter c en la posición pos (esquina superior izda.).
+    // Devuelve la posición donde escribir el siguiente caracter.
+    // Precondición: pos está dentro de la banda. La parte del caracter que
+    // quede por debajo de la banda no se dibuja.
+    template <typename Font>
+    PageCol print(const PageCol& pos, char c);
+
+    // Acceso directo a la matriz de bits (en coordenadas locales a la
+    // banda). Quien la modifique tiene que llamar a mark_dirty.
+    Bitmatrix& bitmatrix() {return m_;}
+    const Bitmatrix& bitmatrix() const {return m_;}
+
+// Dirty
+    void mark_dirty(const PageCol_rectangle& r);
+    void mark_all_dirty();
+
+    bool is_dirty() const;
+    bool is_dirty(uint8_t page) const;
+
+    // Envía al display las partes sucias del framebuffer.
+    // Devuelve false si falla la comunicación con el display, en cuyo caso
+    // deja el framebuffer sucio (se puede volver a intentar).
+    bool flush();
+
+private:
+// Data
+    Bitmatrix m_;
+    uint8_t page0_ = 0;
+
+    // Columnas sucias [c0, c1] de cada página de la banda.
+    // Página limpia: c0 > c1
+    uint8_t dirty_c0_[band_npages];
+    uint8_t dirty_c1_[band_npages];
+
+// Helpers
+    void mark_clean(uint8_t i)
+    {
+	dirty_c0_[i] = ncols;
+	dirty_c1_[i] = 0;
+    }
+
+    void mark_dirty_local(uint8_t i, uint8_t c0, uint8_t c1)
+    {
+	dirty_c0_[i] = std::min(dirty_c0_[i], c0);
+	dirty_c1_[i] = std::max(dirty_c1_[i], c1);
+    }
+
+    uint8_t dirty_ncols(uint8_t i) const 
+    { return is_dirty(i)? dirty_c1_[i] - dirty_c0_[i] + 1: 0; }
+
+    // Envía la ventana [i0, i1] x [c0, c1] (i0, i1 páginas locales)
+    bool flush(uint8_t i0, uint8_t i1, uint8_t c0, uint8_t c1);
+};
+
+
+template <typename D, uint8_t N>
+void SDD1306_framebuffer<D, N>::band(uint8_t page0)
+{
+    page0_ = page0;
+    fill(0);
+
+    for (uint8_t i = 0; i < band_npages; ++i)
+	mark_clean(i);
+}
+
+template <typename D, uint8_t N>
+inline 
+void SDD1306_framebuffer<D, N>::write_byte(uint8_t x, const PageCol& p)
+{
+    if (!contains(p.page) or p.col >= ncols)
+	return;
+
+    uint8_t i = p.page - page0_;
+    if (m_.read_byte(i, p.col) == x)
+	return;
+
+    m_.write_byte(x, i, p.col);
+    mark_dirty_local(i, p.col, p.col);
+}
+
+template <typename D, uint8_t N>
+inline 
+uint8_t SDD1306_framebuffer<D, N>::read_byte(const PageCol& p) const
+{ return m_.read_byte(p.page - page0_, p.col); }
+
+template <typename D, uint8_t N>
+void SDD1306_framebuffer<D, N>::fill(uint8_t x)
+{
+    for (uint8_t j = 0; j < ncols; ++j)
+	for (uint8_t i = 0; i < band_npages; ++i)
+	    m_.write_byte(x, i, j);
+
+    mark_all_dirty();
+}
+
+template <typename D, uint8_t N>
+    template <typename Font>
+auto SDD1306_framebuffer<D, N>::print(const PageCol& pos, char c) -> PageCol
+{
+    if (!contains(pos.page) or pos.col >= ncols)
+	return pos;
+
+    using Index = typename Bitmatrix::index_type;
+    Index i = 8 * (pos.page - page0_);
+    atd::write<Font>(m_, Coord_ij{i, pos.col}, c);
+
+    uint8_t page1 = pos.page + Font::rows_in_bytes - 1;
+    uint8_t col1  = pos.col + Font::cols - 1;
+    mark_dirty(PageCol_rectangle{pos, {page1, col1}});
+
+    return {pos.page, static_cast<uint8_t>(col1 + 1)};
+}
+
+
+template <typename D, uint8_t N>
+void SDD1306_framebuffer<D, N>::mark_dirty(const PageCol_rectangle& r)
+{
+    if (r.p0.col >= ncols)
+	return;
+
+    uint8_t c1 = std::min<uint8_t>(r.p1.col, ncols - 1);
+
+    for (uint8_t page = r.p0.page; page <= r.p1.page; ++page){
+	if (contains(page))
+	    mark_dirty_local(page - page0_, r.p0.col, c1);
+    }
+}
+
+template <typename D, uint8_t N>
+void SDD1306_framebuffer<D, N>::mark_all_dirty()
+{
+    for (uint8_t i = 0; i < band_npages; ++i){
+	dirty_c0_[i] = 0;
+	dirty_c1_[i] = ncols - 1;
+    }
+}
+
+template <typename D, uint8_t N>
+inline bool SDD1306_framebuffer<D, N>::is_dirty(uint8_t i) const
+{ return dirty_c0_[i] <= dirty_c1_[i]; }
+
+template <typename D, uint8_t N>
+bool SDD1306_framebuffer<D, N>::is_dirty() const
+{
+    for (uint8_t i = 0; i < band_npages; ++i)
+	if (is_dirty(i))
+	    return true;
+
+    return false;
+}
+
+
+// Páginas consecutivas sucias se envían en la misma ventana (la unión de sus
+// columnas) siempre que eso cueste menos que abrir una ventana nueva.
+template <typename D, uint8_t N>
+bool SDD1306_framebuffer<D, N>::flush()
+{
+    uint8_t i0 = 0;
+    while (i0 < band_npages){
+	if (!is_dirty(i0)){
+	    ++i0;
+	    continue;
+	}
+
+	uint8_t i1 = i0;
+	uint8_t c0 = dirty_c0_[i0];
+	uint8_t c1 = dirty_c1_[i0];
+
+	while (i1 + 1 < band_npages and is_dirty(i1 + 1)){
+	    uint8_t d0 = std::min(c0, dirty_c0_[i1 + 1]);
+	    uint8_t d1 = std::max(c1, dirty_c1_[i1 + 1]);
+
+	    uint16_t merged = (i1 - i0 + 2) * (d1 - d0 + 1);
+	    uint16_t split  = (i1 - i0 + 1) * (c1 - c0 + 1) 
+			    + dirty_ncols(i1 + 1) + window_cost;
+
+	    if (merged > split)
+		break;
+
+	    c0 = d0;
+	    c1 = d1;
+	    ++i1;
+	}
+
+	if (!flush(i0, i1, c0, c1))
+	    return false;
+
+	for (uint8_t i = i0; i <= i1; ++i)
+	    mark_clean(i);
+
+	i0 = i1 + 1;
+    }
+
+    return true;
+}
+
+
+// En vertical addressing mode la GDDRAM se rellena por columnas, que es
+// como están almacenados los bytes en el Bitmatrix_col_1bit.
+template <typename D, uint8_t N>
+bool SDD1306_framebuffer<D, N>::flush(uint8_t i0, uint8_t i1, 
+				      uint8_t c0, uint8_t c1)
+{
+    uint8_t p0 = page0_ + i0;
+    uint8_t p1 = page0_ + i1;
+    Display::vertical_mode(PageCol{p0, c0}, PageCol{p1, c1});
+
+    uint8_t buf[burst_size];
+    uint8_t n = 0;
+
+    for (uint8_t j = c0; j <= c1; ++j){
+	for (uint8_t i = i0; i <= i1; ++i){
+	    buf[n] = m_.read_byte(i, j);
+	    ++n;
+
+	    if (n == burst_size){
+		if (Display::gddram_write({buf, n}) != n)
+		    return false;
+		n = 0;
+	    }
+	}
+    }
+
+    if (n != 0 and Display::gddram_write({buf, n}) != n)
+	return false;
+
+    return true;
+}
+
+
 }// namespace
  
 
@@ -60,6 +60,8 @@
  *    Manuel Perez
  *    11/02/2023 Escrito.
  *    11/01/2025 Generalizado para poder usar tanto atmega328 y atmega4809.
+ *    18/10/2026 Multiple_read/Multiple_write (CMD18/CMD25)
+ *    18/10/2026 Los bloques se leen/escriben con SPI::read/write(span).
  *
  ****************************************************************************/
 
@@ -448,6 +450,12 @@ public:
 	return err;
     }
 
+    // Multiple_write: la tarjeta acepta el bloque. No se pide el status
+    // hasta finalizar la sesión.
+    static Write_return data_accepted(const R1& r1, 
+				      const Data_response_token& dt)
+    { return dt_error(r1, dt); }
+
     // este será el caso en el que todo vaya bien (o falle R2)
     static Write_return send_status(const R1& r1, 
 				    const Data_response_token& dt,
@@ -542,11 +550,6 @@ public:
     //	       Read_return  = resultado de la operación
     static Read_return read(const Address&, Block);
 
-    // TODO: de momento no implemento multiple_read ya que el micro que estoy
-    // usando es el ATMEGA32 y solo tiene 2kB de RAM: ya va mal leyendo 1
-    // block.
-    // static Read_return multiple_read(const Address&, Block);
-
     // Escribe el bloque en la dirección indicada
     //	    Block	= array con los datos a escribir
     //
@@ -554,8 +557,18 @@ public:
     //	    Write_return = resultado de la operación
     static Write_return write(const Address&, const Block);
 
-    // TODO: mismo comentario que multiple_read
-    // static Write_return multiple_write(const Address&, const Block);
+    // Lectura/escritura de bloques consecutivos (CMD18/CMD25).
+    // (RRR) ¿Por qué sesiones y no multiple_read(addr, Block)?
+    //	     El atmega328 solo tiene 2kB de RAM: no podemos pasarle un array
+    //	     de varios bloques. Lo que hacemos es abrir una sesión que
+    //	     mantiene seleccionada la SD card y le vamos pidiendo/pasando los
+    //	     bloques de uno en uno, ahorrándonos el comando, la respuesta y
+    //	     (al escribir) el send_status de cada bloque.
+    //
+    //	     Mientras exista la sesión no se puede usar ningún otro
+    //	     dispositivo conectado al SPI (la SD card está seleccionada).
+    class Multiple_read;
+    class Multiple_write;
 
     // TODO:
     // erase_and_write_protect_management: 7.2.5
@@ -753,9 +766,17 @@ private:
 
 // Implementation of write function
     static uint8_t send_write_single_block(const Address& addr);
-    static void send_data_block(const Block b);
+    static void send_data_block(const Block b, uint8_t start_token = 0xFE);
     static Data_response_token read_response_send_data_block();
 
+// Implementation of multiple read/write
+    static uint8_t send_read_multiple_block(const Address& addr);
+    static uint8_t send_write_multiple_block(const Address& addr);
+    static uint8_t send_set_wr_blk_erase_count(uint32_t nblocks);
+    static R1 send_stop_transmission();
+    static void send_stop_tran_token();
+    static bool wait_while_busy();
+
 
 // Helpers
     template <typename T>
@@ -803,14 +824,11 @@ inline uint16_t SDCard<Cfg>::SPI_read_uint16_t()
 template <typename Cfg>
 inline uint32_t SDCard<Cfg>::SPI_read_uint32_t()
 {
-    uint8_t b[4];
+    uint8_t b[4]; // b[0] = MSByte
 
-    b[3] = SPI::read();
-    b[2] = SPI::read();
-    b[1] = SPI::read();
-    b[0] = SPI::read();
+    SPI::read(b);
 
-    return atd::concat_bytes<uint32_t>(b[3], b[2], b[1], b[0]);
+    return atd::concat_bytes<uint32_t>(b[0], b[1], b[2], b[3]);
 }
 
 
@@ -1371,8 +1389,7 @@ SDCard<Cfg>::Read_return
 	return Read_return::data_error_token(r);
 
 
-    for (Block::size_type i = 0; i < block_size; ++i)
-	b[i] = SPI::read();
+    SPI::read(b);
 
     uint16_t crc = SPI_read_uint16_t();
     (void) crc;
@@ -1453,13 +1470,13 @@ SDCard<Cfg>::Data_response_token
 
 
 // 7.3.3.2@physical_layer
+// start_token: 0xFE en CMD24, 0xFC en CMD25
 template<typename Cfg>
-void SDCard<Cfg>::send_data_block(const Block b)
+void SDCard<Cfg>::send_data_block(const Block b, uint8_t start_token)
 {
-    SPI::write(0xFE); // start block token
+    SPI::write(start_token); // start block token
 		      
-    for (Block::size_type i = 0; i < b.size(); ++i)
-	SPI::write(b[i]);
+    SPI::write(b);
 
     SPI_write_uint16_t(0xFFFF); // CRC 
 				// Da lo mismo su valor, ya que está configurado 
@@ -1468,6 +1485,307 @@ void SDCard<Cfg>::send_data_block(const Block b)
 }
 
 
+/***************************************************************************
+ *			    MULTIPLE READ/WRITE
+ ***************************************************************************/
+template<typename Cfg>
+uint8_t SDCard<Cfg>::send_read_multiple_block(const Address& addr)
+{
+    send(18u, addr);
+    return read_R1();
+}
+
+template<typename Cfg>
+uint8_t SDCard<Cfg>::send_write_multiple_block(const Address& addr)
+{
+    send(25u, addr);
+    return read_R1();
+}
+
+// 4.3.4@physical_layer (ACMD23)
+//	Indica a la tarjeta cuántos bloques vamos a escribir para que los borre
+//	antes de escribirlos (pre-erase). Es una sugerencia: si escribimos
+//	menos bloques los no escritos quedan con un valor indefinido.
+//	Solo se usan los bits [22:0].
+//
+// return: R1 response
+template<typename Cfg>
+uint8_t SDCard<Cfg>::send_set_wr_blk_erase_count(uint32_t nblocks)
+{
+    send(55u);
+    uint8_t r1 = read_R1();
+    if (r1 > 1)
+	return r1;
+
+    send(23u, nblocks & 0x007FFFFFu);
+    return read_R1();
+}
+
+// 7.2.3@physical_layer
+//	CMD12 para la transmisión de datos. Mientras se envía el comando la
+//	tarjeta sigue enviando datos, por eso no podemos llamar a 
+//	send(cmd, arg) que espera a recibir 0xFF antes de enviar el comando.
+//
+// 7.3.2.2@physical_layer: la respuesta es R1b. 
+// Antes de R1 la tarjeta envía un `stuff byte` que hay que descartar.
+template<typename Cfg>
+SDCard<Cfg>::R1 SDCard<Cfg>::send_stop_transmission()
+{
+    SPI_write_uint8_t(12u | 0x40u);	
+    SPI_write_uint32_t(0x00);
+    SPI_write_uint8_t(0x01u);
+
+    SPI::read(); // stuff byte
+
+    R1 r1{read_R1()};
+
+    if (!wait_while_busy())
+	return R1{R1::invalid_value()};
+
+    return r1;
+}
+
+// 7.3.3.2@physical_layer
+//	"Stop Tran" token = 0xFD. Después del token la tarjeta envía un byte
+//	(Nbr) y luego mantiene la línea a 0 mientras está ocupada.
+template<typename Cfg>
+void SDCard<Cfg>::send_stop_tran_token()
+{
+    SPI::write(0xFD);
+    SPI::read(); // Nbr
+}
+
+// Mientras la tarjeta está ocupada devuelve 0x00 (busy token)
+// return: true si deja de estar busy; false si timeout.
+template<typename Cfg>
+bool SDCard<Cfg>::wait_while_busy()
+{
+    constexpr uint16_t n = time_as_number_of_transfers<timeout_write_busy>();
+    for (uint16_t i = 0; i < n; ++i) {
+	if (SPI::read() != 0x00) 
+	    return true;
+    }
+
+    return false;
+}
+
+
+/***************************************************************************
+ *			    MULTIPLE_READ
+ *
+ * Ejemplo:
+ *	{
+ *	SDCard::Multiple_read sd{addr};
+ *	if (!sd.ok()) ... error
+ *
+ *	while (...){
+ *	    auto r = sd.read(block);
+ *	    ...
+ *	}
+ *	} // <-- el destructor envía CMD12 y deselecciona la tarjeta
+ *
+ ***************************************************************************/
+template<typename Cfg>
+class SDCard<Cfg>::Multiple_read{
+public:
+// Constructor
+    explicit Multiple_read(const Address& addr);
+    ~Multiple_read() { stop(); }
+
+    Multiple_read(const Multiple_read&) = delete;
+    Multiple_read& operator=(const Multiple_read&) = delete;
+
+// Read
+    // Lee el siguiente bloque
+    Read_return read(Block b);
+
+    // Finaliza la sesión (CMD12). Después de llamar a esta función no se
+    // pueden leer más bloques.
+    R1 stop();
+
+// Info
+    // ¿Se ha abierto correctamente la sesión?
+    bool ok() const {return r1_.ok() and is_open_;}
+
+    R1 r1() const {return r1_;}
+
+    bool is_open() const {return is_open_;}
+
+    // Número de bloques leídos hasta el momento
+    Address nblocks() const {return nblocks_;}
+
+private:
+// Data
+    Address nblocks_;
+    R1 r1_;
+    bool is_open_;
+};
+
+template<typename Cfg>
+SDCard<Cfg>::Multiple_read::Multiple_read(const Address& addr)
+    : nblocks_{0}, r1_{0}, is_open_{false}
+{
+    SPI_cfg();
+    SPI_select::select();
+
+    r1_ = R1{send_read_multiple_block(addr)};
+
+    if (r1_.is_an_error())
+	SPI_select::deselect();
+    else
+	is_open_ = true;
+}
+
+template<typename Cfg>
+SDCard<Cfg>::Read_return SDCard<Cfg>::Multiple_read::read(Block b)
+{
+    if (!is_open_)
+	return Read_return::r1_error(r1_);
+
+    Read_return res = read_data_block(b);
+    if (res.ok())
+	++nblocks_;
+
+    return res;
+}
+
+template<typename Cfg>
+SDCard<Cfg>::R1 SDCard<Cfg>::Multiple_read::stop()
+{
+    if (!is_open_)
+	return r1_;
+
+    r1_ = send_stop_transmission();
+    SPI_select::deselect();
+    is_open_ = false;
+
+    return r1_;
+}
+
+
+/***************************************************************************
+ *			    MULTIPLE_WRITE
+ *
+ * Ejemplo:
+ *	{
+ *	SDCard::Multiple_write sd{addr, nblocks}; // nblocks = pre-erase
+ *	if (!sd.ok()) ... error
+ *
+ *	for (...){
+ *	    auto r = sd.write(block);
+ *	    ...
+ *	}
+ *
+ *	auto r = sd.stop(); // opcional, lo llama el destructor
+ *	}
+ *
+ ***************************************************************************/
+template<typename Cfg>
+class SDCard<Cfg>::Multiple_write{
+public:
+// Constructor
+    // nblocks_pre_erase: si es != 0 envía ACMD23 antes de CMD25 indicando
+    // a la tarjeta cuántos bloques vamos a escribir. 
+    explicit Multiple_write(const Address& addr, uint32_t nblocks_pre_erase = 0);
+    ~Multiple_write() { stop(); }
+
+    Multiple_write(const Multiple_write&) = delete;
+    Multiple_write& operator=(const Multiple_write&) = delete;
+
+// Write
+    // Escribe el siguiente bloque
+    Write_return write(const Block b);
+
+    // Finaliza la sesión enviando el `stop tran` token. 
+    // Devuelve el resultado de send_status().
+    Write_return stop();
+
+// Info
+    // ¿Se ha abierto correctamente la sesión?
+    bool ok() const {return r1_.ok() and is_open_;}
+
+    R1 r1() const {return r1_;}
+
+    bool is_open() const {return is_open_;}
+
+    // Número de bloques escritos hasta el momento
+    Address nblocks() const {return nblocks_;}
+
+private:
+// Data
+    Address nblocks_;
+    R1 r1_;
+    bool is_open_;
+};
+
+template<typename Cfg>
+SDCard<Cfg>::Multiple_write::
+	    Multiple_write(const Address& addr, uint32_t nblocks_pre_erase)
+    : nblocks_{0}, r1_{0}, is_open_{false}
+{
+    SPI_cfg();
+    SPI_select::select();
+
+    if (nblocks_pre_erase != 0){
+	r1_ = R1{send_set_wr_blk_erase_count(nblocks_pre_erase)};
+	if (r1_.is_an_error()){
+	    SPI_select::deselect();
+	    return;
+	}
+    }
+
+    r1_ = R1{send_write_multiple_block(addr)};
+
+    if (r1_.is_an_error())
+	SPI_select::deselect();
+    else
+	is_open_ = true;
+}
+
+
+// 7.2.4@physical_layer
+template<typename Cfg>
+SDCard<Cfg>::Write_return 
+	SDCard<Cfg>::Multiple_write::write(const Block b)
+{
+    if (!is_open_)
+	return Write_return::r1_error(r1_);
+
+    send_data_block(b, 0xFC);
+    Data_response_token dt = read_response_send_data_block();
+    if (dt.is_an_error())
+	return Write_return::dt_error(r1_, dt);
+
+    ++nblocks_;
+    return Write_return::data_accepted(r1_, dt);
+}
+
+// 7.2.4@physical_layer
+//	"If an error occurs during a multiple block write operation, the host
+//	should stop the transmission using CMD12... the host can query the
+//	card status with CMD13". En caso de error o no, lo más sencillo es
+//	enviar siempre el `stop tran` token y pedir el status.
+template<typename Cfg>
+SDCard<Cfg>::Write_return SDCard<Cfg>::Multiple_write::stop()
+{
+    if (!is_open_)
+	return Write_return::r1_error(r1_);
+
+    send_stop_tran_token();
+    bool not_busy = wait_while_busy();
+
+    SPI_select::deselect();
+    is_open_ = false;
+
+    if (!not_busy)
+	return Write_return::dt_error(r1_, Data_response_token::timeout_error());
+
+    R2 r2 = send_status();
+    return Write_return::send_status(r1_, 
+			Data_response_token::valid(0x05), r2);
+}
+
+
 } // namespace hwd
 }// namespace
 
@@ -0,0 +1,156 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../dev_DS18B20.h"
+
+#include <alp_test.h>
+#include <alp_string.h>
+
+#include <iostream>
+#include <vector>
+#include <array>
+
+using namespace test;
+
+// One_wire simulado
+// -----------------
+// Registra los bytes escritos en el bus (y los reset). Los sensores
+// convierten durante `conversion_slots` read slots.
+struct One_wire{
+    struct Device{ uint8_t id; };
+
+    inline static std::vector<int> log; // -1 = reset
+    inline static uint16_t conversion_slots = 0;
+    inline static uint16_t nread_bits = 0;
+    inline static std::array<uint8_t, 9> scratchpad{};
+    inline static uint8_t iread = 0;
+
+    static void clear() { log.clear(); nread_bits = 0; iread = 0;}
+
+    static bool reset() {log.push_back(-1); iread = 0; return true;}
+    static void match_rom(const Device& dev) {write(0x55); write(dev.id);}
+    static void skip_rom() {write(0xCC);}
+    static void write(uint8_t x) 
+    {
+	log.push_back(x);
+	if (x == 0x44)
+	    conversion_slots = 5;
+    }
+
+    static uint8_t read_bit()
+    {
+	++nread_bits;
+	if (conversion_slots > 0){
+	    --conversion_slots;
+	    return 0;
+	}
+	return 1;
+    }
+
+    static uint8_t read() {return scratchpad[iread++];}
+};
+
+struct Micro{
+    static void wait_ms(uint16_t) { }
+};
+
+using Sensor = dev::DS18B20<Micro, One_wire>;
+using Resolution = Sensor::Resolution;
+
+void scratchpad(uint8_t T0, uint8_t T1)
+{
+    auto& s = One_wire::scratchpad;
+    s = {T0, T1, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10, 0};
+    s[8] = atd::CRC8_Maxim(s.data(), 8);
+}
+
+void test_non_blocking()
+{
+    test::interface("start_conversion/poll/collect");
+
+    std::array<Sensor, 3> sensor;
+    for (uint8_t i = 0; i < sensor.size(); ++i)
+	sensor[i].bind(One_wire::Device{uint8_t(i + 1)});
+
+// start_conversion_all: un único convert_T para todos
+    One_wire::clear();
+    CHECK_TRUE(Sensor::start_conversion_all() == Sensor::Result::ok, 
+							"start_conversion_all");
+    CHECK_TRUE((One_wire::log == std::vector<int>{-1, 0xCC, 0x44}), 
+							"start_conversion_all");
+
+// poll no bloquea: un read slot por llamada
+    uint16_t n = 0;
+    while (!Sensor::poll())
+	++n;
+
+    CHECK_TRUE(n == 5 and One_wire::nread_bits == 6, "poll");
+
+// collect
+    scratchpad(0x91, 0x01); // 25.0625 ºC
+    auto T0 = Sensor::Scratchpad::temperature(0x91, 0x01, Resolution::bits_12);
+    for (auto& s: sensor){
+	One_wire::clear();
+	auto T = s.collect();
+	CHECK_TRUE(s.last_operation_is_ok(), "collect");
+	CHECK_TRUE(T == T0, "collect");
+	CHECK_TRUE(One_wire::log.size() == 4 and One_wire::log[0] == -1 and
+		   One_wire::log[1] == 0x55 and One_wire::log[3] == 0xBE, 
+								"collect");
+    }
+
+    One_wire::scratchpad[8] ^= 1;
+    sensor[0].collect();
+    CHECK_TRUE(sensor[0].result_last_operation() == Sensor::Result::wrong_CRC,
+								"wrong_CRC");
+
+// start_conversion: solo un sensor
+    One_wire::clear();
+    CHECK_TRUE(sensor[1].start_conversion() == Sensor::Result::ok, 
+							    "start_conversion");
+    CHECK_TRUE((One_wire::log == std::vector<int>{-1, 0x55, 2, 0x44}), 
+							    "start_conversion");
+
+// poll por tiempo
+    CHECK_TRUE(!Sensor::poll(93, Resolution::bits_9), "poll(ms)");
+    CHECK_TRUE(Sensor::poll(94, Resolution::bits_9), "poll(ms)");
+    CHECK_TRUE(!Sensor::poll(749), "poll(ms)");
+    CHECK_TRUE(Sensor::poll(750), "poll(ms)");
+
+// read_temperature sigue funcionando igual
+    scratchpad(0x50, 0x05); // 85 ºC
+    auto T = sensor[2].read_temperature(1000);
+    CHECK_TRUE(sensor[2].last_operation_is_ok(), "read_temperature");
+    CHECK_TRUE(T == Sensor::Celsius{85}, "read_temperature");
+}
+
+
+int main()
+{
+try{
+    test::header("DS18B20");
+
+    test_non_blocking();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
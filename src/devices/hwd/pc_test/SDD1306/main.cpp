@@ -0,0 +1,206 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "pru_SDD1306.h"
+#include "../../dev_SDD1306.h"
+
+#include <alp_test.h>
+#include <alp_string.h>
+
+#include <iostream>
+#include <array>
+#include <span>
+
+using namespace test;
+
+using SDD = pru::SDD1306_simulator;
+using TWI_master = pru::TWI_master<32>;
+
+struct Cfg{
+    using TWI_master = ::TWI_master;
+    static constexpr TWI_master::Address twi_address = 0x3C;
+};
+
+using Display = dev::SDD1306_I2C_128x64<Cfg>;
+using PageCol = Display::PageCol;
+
+
+// Fuente de prueba de 8x16 (2 páginas): el byte k del caracter c vale
+// c + 7*k
+struct Font{
+    static constexpr bool is_by_columns{};
+    static constexpr bool is_turned_to_the_right{};
+    static constexpr bool is_ASCII_font{};
+
+    static constexpr uint8_t index(char c) {return c - 32;}
+
+    static constexpr uint8_t rows = 16;
+    static constexpr uint8_t cols = 8;
+    static constexpr uint8_t bytes_in_a_column = 2;
+    static constexpr uint8_t rows_in_bytes = 2;
+
+    struct Glyph{
+	std::array<uint8_t, cols * rows_in_bytes> data;
+
+	std::span<const uint8_t> row(uint8_t i)
+	{
+	    for (uint8_t k = 0; k < data.size(); ++k)
+		data[k] = static_cast<uint8_t>(i + 32 + 7 * k);
+
+	    return data;
+	}
+    };
+
+    inline static Glyph glyph;
+};
+
+
+// ¿Coincide la GDDRAM con el framebuffer?
+template <typename FB>
+bool is_equal(const FB& fb)
+{
+    for (uint8_t i = 0; i < FB::band_npages; ++i){
+	uint8_t page = fb.page0() + i;
+	for (uint8_t j = 0; j < FB::ncols; ++j)
+	    if (SDD::gddram(page, j) != fb.read_byte(PageCol{page, j}))
+		return false;
+    }
+
+    return true;
+}
+
+
+void test_framebuffer()
+{
+    test::interface("SDD1306_framebuffer");
+
+    SDD::reset();
+    dev::SDD1306_framebuffer<Display> fb;
+
+    CHECK_TRUE(fb.is_dirty(), "constructor");
+
+    // patrón inicial: pantalla entera
+    for (uint8_t page = 0; page < Display::npages; ++page)
+	for (uint8_t col = 0; col < Display::ncols; ++col)
+	    fb.write_byte(page * 31 + col, PageCol{page, col});
+
+    SDD::reset_stats();
+    CHECK_TRUE(fb.flush(), "flush");
+    CHECK_TRUE(!fb.is_dirty(), "flush");
+    CHECK_TRUE(is_equal(fb), "full flush");
+    CHECK_TRUE(TWI_master::max_msg_size <= TWI_master::buffer_size,
+						    "burst <= buffer_size");
+    uint32_t nfull = SDD::nbytes();
+
+    // Sin cambios no se envía nada
+    fb.write_byte(fb.read_byte(PageCol{3, 10}), PageCol{3, 10});
+    CHECK_TRUE(!fb.is_dirty(), "write same value");
+    SDD::reset_stats();
+    CHECK_TRUE(fb.flush(), "flush");
+    CHECK_TRUE(SDD::nbytes() == 0, "empty flush");
+
+    // Cambiamos un dígito del reloj
+    SDD::reset_stats();
+    PageCol next = fb.print<Font>(PageCol{2, 40}, '7');
+    CHECK_TRUE(next.page == 2 and next.col == 48, "print");
+    CHECK_TRUE(fb.is_dirty(2) and fb.is_dirty(3) and !fb.is_dirty(4),
+								"is_dirty");
+    CHECK_TRUE(fb.flush(), "flush");
+    CHECK_TRUE(is_equal(fb), "digit flush");
+    uint32_t ndigit = SDD::nbytes();
+    CHECK_TRUE(ndigit < 2 * Font::cols * Font::rows_in_bytes, "digit cost");
+
+    // Dos zonas alejadas en páginas consecutivas: ventanas independientes
+    SDD::reset_stats();
+    fb.write_byte(0xAA, PageCol{5, 0});
+    fb.write_byte(0xBB, PageCol{6, 127});
+    CHECK_TRUE(fb.flush(), "flush");
+    CHECK_TRUE(is_equal(fb), "two windows");
+    CHECK_TRUE(SDD::nbytes() < 2 * (fb.window_cost + 4), "two windows cost");
+
+    // Páginas consecutivas con columnas parecidas: una ventana
+    SDD::reset_stats();
+    fb.write_byte(0x11, PageCol{0, 64});
+    fb.write_byte(0x22, PageCol{1, 65});
+    CHECK_TRUE(fb.flush(), "flush");
+    CHECK_TRUE(is_equal(fb), "merged window");
+    CHECK_TRUE(SDD::ntransactions() == 2, "merged window");
+
+    std::cout << "full screen: " << nfull << " bytes; one digit: "
+	      << ndigit << " bytes\n";
+}
+
+
+void test_band()
+{
+    test::interface("SDD1306_framebuffer (band)");
+
+    SDD::reset();
+    dev::SDD1306_framebuffer<Display, 1> fb;
+    std::cout << "sizeof(framebuffer band) = " << sizeof(fb) << '\n';
+    CHECK_TRUE(sizeof(fb) <= Display::ncols + 2 + 1, "RAM");
+
+    // Dibujamos toda la pantalla banda a banda
+    for (uint8_t page = 0; page < Display::npages; ++page){
+	fb.band(page);
+	CHECK_TRUE(!fb.is_dirty(), "band");
+	fb.mark_all_dirty();
+
+	for (uint8_t p = 0; p < Display::npages; ++p) // lo de fuera se ignora
+	    for (uint8_t col = 0; col < Display::ncols; ++col)
+		fb.write_byte(p ^ col, PageCol{p, col});
+
+	CHECK_TRUE(fb.flush(), "flush");
+    }
+
+    bool ok = true;
+    for (uint8_t page = 0; page < Display::npages; ++page)
+	for (uint8_t col = 0; col < Display::ncols; ++col)
+	    if (SDD::gddram(page, col) != (page ^ col))
+		ok = false;
+
+    CHECK_TRUE(ok, "band by band");
+
+    // Actualizamos solo un dígito
+    SDD::reset_stats();
+    fb.band(4);
+    fb.print<Font>(PageCol{4, 100}, '3');
+    CHECK_TRUE(fb.flush(), "flush");
+    CHECK_TRUE(SDD::gddram(4, 100) == fb.read_byte(PageCol{4, 100}) and
+	       SDD::gddram(4, 107) == fb.read_byte(PageCol{4, 107}),
+							    "band digit");
+    CHECK_TRUE(SDD::gddram(3, 100) == (3 ^ 100) and
+	       SDD::gddram(4, 99) == (4 ^ 99),  "band digit");
+}
+
+
+int main()
+{
+try{
+    test::header("SDD1306");
+
+    test_framebuffer();
+    test_band();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
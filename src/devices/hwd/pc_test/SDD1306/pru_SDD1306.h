@@ -0,0 +1,220 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __PRU_SDD1306_H__
+#define __PRU_SDD1306_H__
+/****************************************************************************
+ *
+ * DESCRIPCION
+ *	SDD1306 simulado para poder probar SDD1306_framebuffer en el
+ *	ordenador.
+ *
+ *	TWI_master síncrono: cada transacción se entrega al SDD1306 simulado
+ *	al enviar el STOP. Cuenta el número de bytes que pasan por el bus
+ *	(incluyendo el byte de dirección) para poder medir el coste de los
+ *	flush.
+ *
+ *	El SDD1306 simulado solo implementa los comandos de direccionamiento
+ *	(0x20, 0x21 y 0x22) y la escritura en la GDDRAM. El resto de comandos
+ *	los ignora.
+ *
+ * HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <ostream>
+
+namespace pru{ // de pruebas
+
+class SDD1306_simulator{
+public:
+    static constexpr uint8_t ncols  = 128;
+    static constexpr uint8_t npages = 8;
+
+    static void reset()
+    {
+	for (auto& page: gddram_)
+	    page.fill(0);
+
+	mode_ = 0;
+	c0_ = col_ = 0; c1_ = ncols - 1;
+	p0_ = page_ = 0; p1_ = npages - 1;
+	reset_stats();
+    }
+
+    static uint8_t gddram(uint8_t page, uint8_t col)
+    { return gddram_[page][col]; }
+
+    // Recibe una transacción TWI completa
+    static void receive(const std::vector<uint8_t>& msg)
+    {
+	++ntransactions_;
+	if (msg.empty())
+	    return;
+
+	if (msg[0] == 0x40){
+	    for (size_t i = 1; i < msg.size(); ++i)
+		write_gddram(msg[i]);
+	}
+
+	else if (msg[0] == 0x00)
+	    commands(msg);
+    }
+
+// Estadística
+    static uint32_t nbytes() {return nbytes_;}
+    static uint32_t ntransactions() {return ntransactions_;}
+    static void add_bytes(uint32_t n) {nbytes_ += n;}
+
+    static void reset_stats() {nbytes_ = 0; ntransactions_ = 0;}
+
+private:
+    inline static std::array<std::array<uint8_t, ncols>, npages> gddram_;
+
+    inline static uint8_t mode_ = 0; // 0 = horizontal; 1 = vertical
+    inline static uint8_t c0_ = 0, c1_ = ncols - 1, col_ = 0;
+    inline static uint8_t p0_ = 0, p1_ = npages - 1, page_ = 0;
+
+    inline static uint32_t nbytes_ = 0;
+    inline static uint32_t ntransactions_ = 0;
+
+    static void write_gddram(uint8_t x)
+    {
+	gddram_[page_][col_] = x;
+
+	if (mode_ == 0){
+	    if (col_ == c1_){
+		col_ = c0_;
+		page_ = (page_ == p1_? p0_: page_ + 1);
+	    }
+	    else ++col_;
+	}
+	else {
+	    if (page_ == p1_){
+		page_ = p0_;
+		col_ = (col_ == c1_? c0_: col_ + 1);
+	    }
+	    else ++page_;
+	}
+    }
+
+    // Número de argumentos de cada comando
+    static uint8_t nargs(uint8_t cmd)
+    {
+	switch(cmd){
+	    case 0x21: case 0x22:
+		return 2;
+
+	    case 0x20: case 0x81: case 0x8D: case 0xA8:
+	    case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+		return 1;
+	}
+
+	return 0;
+    }
+
+    static void commands(const std::vector<uint8_t>& msg)
+    {
+	for (size_t i = 1; i < msg.size(); ){
+	    uint8_t cmd = msg[i];
+
+	    if (cmd == 0x20)
+		mode_ = msg[i + 1];
+
+	    else if (cmd == 0x21){
+		c0_ = col_ = msg[i + 1];
+		c1_ = msg[i + 2];
+	    }
+
+	    else if (cmd == 0x22){
+		p0_ = page_ = msg[i + 1];
+		p1_ = msg[i + 2];
+	    }
+
+	    i += 1 + nargs(cmd);
+	}
+    }
+};
+
+
+// TWI_master conectado al SDD1306_simulator.
+// Solo implementa lo que necesita TWI_master_ioxtream para escribir.
+template <uint8_t buffer_size0>
+struct TWI_master{
+    using Address    = uint8_t;
+    using streamsize = uint8_t;
+    enum class iostate : uint8_t {idle, read_or_write, writing};
+
+    static constexpr bool is_twi_master = true;
+    static constexpr streamsize buffer_size = buffer_size0;
+
+    inline static iostate state_ = iostate::idle;
+    inline static std::vector<uint8_t> msg_;
+
+    // Tamaño de la mayor transacción enviada (tiene que entrar en el
+    // buffer)
+    inline static size_t max_msg_size = 0;
+
+    static void reset() {state_ = iostate::idle; msg_.clear();}
+
+    static void send_start() { state_ = iostate::read_or_write; }
+    static void send_repeated_start() { send_start(); }
+
+    static void send_stop()
+    {
+	if (msg_.size() > max_msg_size)
+	    max_msg_size = msg_.size();
+
+	SDD1306_simulator::add_bytes(1 + msg_.size()); // + address
+	SDD1306_simulator::receive(msg_);
+	msg_.clear();
+	state_ = iostate::idle;
+    }
+
+    static streamsize write_to(Address, const uint8_t* buf, streamsize n)
+    {
+	state_ = iostate::writing;
+	return write(buf, n);
+    }
+
+    static streamsize write(const uint8_t* buf, streamsize n)
+    {
+	msg_.insert(msg_.end(), buf, buf + n);
+	return n;
+    }
+
+    static uint16_t wait_while_busy(uint16_t = 0) {return 1;}
+
+    static bool is_idle() {return state_ == iostate::idle;}
+    static bool is_busy() {return false;}
+    static bool is_waiting() {return false;}
+    static bool is_writing() {return state_ == iostate::writing;}
+    static bool read_or_write() {return state_ == iostate::read_or_write;}
+    static bool error() {return false;}
+};
+
+} // namespace
+
+#endif
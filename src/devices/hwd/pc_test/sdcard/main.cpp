@@ -0,0 +1,210 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../dev_sdcard.h"
+#include "pru_sdcard.h"
+
+#include <alp_test.h>
+#include <alp_string.h>
+
+#include <iostream>
+#include <array>
+
+using namespace test;
+
+using SD = pru::SDCard_simulator;
+
+struct SDCard_cfg{
+    using Micro = pru::Micro;
+    using SPI = pru::SPI_master;
+    using SPI_select = pru::SPI_select;
+    static constexpr uint32_t SPI_frequency = 2'000'000;
+};
+
+using SDCard = dev::hwd::SDCard<SDCard_cfg>;
+using Block = std::array<uint8_t, SDCard::block_size>;
+
+// Número de bloques que leemos/escribimos en cada prueba
+constexpr uint32_t nblocks = 64;
+
+// Muestra los bytes transferidos por el SPI y el throughput equivalente
+void print_throughput(const char* name, uint32_t nbytes)
+{
+    uint32_t payload = nblocks * SDCard::block_size;
+    double t = (nbytes * 8.0) / SDCard_cfg::SPI_frequency; // en segundos
+
+    std::cout << name << ": " << nbytes << " bytes transferidos; "
+	      << (nbytes * 100.0) / payload << "% del payload; "
+	      << payload / t << " bytes/s (SCK = "
+	      << SDCard_cfg::SPI_frequency << " Hz)\n";
+}
+
+bool is_block(const Block& b, uint32_t addr)
+{
+    for (uint16_t i = 0; i < b.size(); ++i)
+	if (b[i] != SD::value(addr, i))
+	    return false;
+
+    return true;
+}
+
+void fill_block(Block& b, uint32_t addr)
+{
+    for (uint16_t i = 0; i < b.size(); ++i)
+	b[i] = static_cast<uint8_t>(addr + 3 * i);
+}
+
+bool is_filled_block(uint32_t addr)
+{
+    for (uint16_t i = 0; i < SDCard::block_size; ++i)
+	if (SD::value(addr, i) != static_cast<uint8_t>(addr + 3 * i))
+	    return false;
+
+    return true;
+}
+
+uint32_t test_single_read(uint32_t addr0)
+{
+    SD::reset_stats();
+
+    Block b;
+    for (uint32_t i = 0; i < nblocks; ++i){
+	CHECK_TRUE(SDCard::read(addr0 + i, b).ok(), "read");
+	CHECK_TRUE(is_block(b, addr0 + i), "read");
+    }
+
+    return SD::nbytes();
+}
+
+uint32_t test_multiple_read(uint32_t addr0)
+{
+    SD::reset_stats();
+
+    {
+    SDCard::Multiple_read sd{addr0};
+    CHECK_TRUE(sd.ok(), "Multiple_read");
+
+    Block b;
+    for (uint32_t i = 0; i < nblocks; ++i){
+	CHECK_TRUE(sd.read(b).ok(), "Multiple_read::read");
+	CHECK_TRUE(is_block(b, addr0 + i), "Multiple_read::read");
+    }
+
+    CHECK_TRUE(sd.nblocks() == nblocks, "Multiple_read::nblocks");
+    CHECK_TRUE(sd.stop().ok(), "Multiple_read::stop");
+    CHECK_TRUE(!sd.is_open(), "Multiple_read::is_open");
+    }
+
+    uint32_t nbytes = SD::nbytes();
+
+    // Después de la sesión la SD card tiene que seguir funcionando
+    Block b;
+    CHECK_TRUE(SDCard::read(addr0 + 1000, b).ok(), "read after stop");
+    CHECK_TRUE(is_block(b, addr0 + 1000), "read after stop");
+
+    return nbytes;
+}
+
+void test_read()
+{
+    test::interface("Multiple_read");
+
+    SD::reset();
+    uint32_t nsingle   = test_single_read(100);
+    uint32_t nmultiple = test_multiple_read(100);
+
+    CHECK_TRUE(nmultiple < nsingle, "Multiple_read throughput");
+
+    print_throughput("read           ", nsingle);
+    print_throughput("Multiple_read  ", nmultiple);
+}
+
+
+uint32_t test_single_write(uint32_t addr0)
+{
+    SD::reset_stats();
+
+    Block b;
+    for (uint32_t i = 0; i < nblocks; ++i){
+	fill_block(b, addr0 + i);
+	CHECK_TRUE(SDCard::write(addr0 + i, b).ok(), "write");
+	CHECK_TRUE(is_filled_block(addr0 + i), "write");
+    }
+
+    return SD::nbytes();
+}
+
+
+uint32_t test_multiple_write(uint32_t addr0)
+{
+    SD::reset_stats();
+
+    SDCard::Multiple_write sd{addr0, nblocks};
+    CHECK_TRUE(sd.ok(), "Multiple_write");
+    CHECK_TRUE(SD::pre_erase() == nblocks, "Multiple_write (ACMD23)");
+
+    Block b;
+    for (uint32_t i = 0; i < nblocks; ++i){
+	fill_block(b, addr0 + i);
+	CHECK_TRUE(sd.write(b).ok(), "Multiple_write::write");
+	CHECK_TRUE(is_filled_block(addr0 + i), "Multiple_write::write");
+    }
+
+    CHECK_TRUE(sd.nblocks() == nblocks, "Multiple_write::nblocks");
+    CHECK_TRUE(sd.stop().ok(), "Multiple_write::stop");
+    CHECK_TRUE(!sd.is_open(), "Multiple_write::is_open");
+
+    return SD::nbytes();
+}
+
+void test_write()
+{
+    test::interface("Multiple_write");
+
+    SD::reset();
+    uint32_t nsingle   = test_single_write(200);
+    uint32_t nmultiple = test_multiple_write(400);
+
+    CHECK_TRUE(nmultiple < nsingle, "Multiple_write throughput");
+
+    print_throughput("write          ", nsingle);
+    print_throughput("Multiple_write ", nmultiple);
+
+    // La SD card tiene que seguir funcionando
+    Block b;
+    CHECK_TRUE(SDCard::read(401, b).ok(), "read after Multiple_write");
+    CHECK_TRUE(is_block(b, 401), "read after Multiple_write");
+}
+
+
+int main()
+{
+try{
+    test::header("SDCard");
+
+    test_read();
+    test_write();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
+
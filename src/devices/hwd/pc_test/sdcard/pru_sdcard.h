@@ -0,0 +1,365 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __PRU_SDCARD_H__
+#define __PRU_SDCARD_H__
+/****************************************************************************
+ *
+ * DESCRIPCION
+ *	SD card simulada para poder probar dev::SDCard en el ordenador.
+ *
+ *	Simula la SD card a nivel de bytes SPI: cada SPI::write/read es una
+ *	transferencia de un byte. Cuenta el número de bytes transferidos para
+ *	poder medir el rendimiento (bytes por bloque) de las distintas
+ *	formas de leer/escribir.
+ *
+ *	Solo implementa los comandos que usa SDCard para leer/escribir:
+ *	    CMD12, CMD13, CMD17, CMD18, CMD24, CMD25, CMD55 y ACMD23
+ *
+ * HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <array>
+#include <span>
+
+namespace pru{ // de pruebas
+
+class SDCard_simulator{
+public:
+    static constexpr uint16_t block_size = 512;
+    using Block = std::array<uint8_t, block_size>;
+
+// Cfg
+    // Número de bytes que la tarjeta responde `busy` después de escribir un
+    // bloque (simula el tiempo de programación de la flash)
+    inline static uint16_t write_busy_bytes = 8;
+
+    // Número de bytes 0xFF que envía antes del start token al leer (Nac).
+    // El primer bloque después de un comando tarda más (la tarjeta tiene
+    // que acceder a la flash); en CMD18 los siguientes bloques ya están
+    // preparados.
+    inline static uint16_t read_access_bytes  = 64;
+    inline static uint16_t read_latency_bytes = 2;
+
+// Estado
+    static void reset()
+    {
+	out_.clear();
+	cmd_n_ = 0;
+	state_ = State::idle;
+	app_cmd_ = false;
+	selected_ = false;
+	nbytes_ = 0;
+	ncommands_ = 0;
+	pre_erase_ = 0;
+	data_.clear();
+    }
+
+    static void select() {selected_ = true;}
+    static void deselect() {selected_ = false;}
+
+    // Transfiere un byte en los dos sentidos
+    static uint8_t transfer(uint8_t in)
+    {
+	++nbytes_;
+
+	if (!selected_)
+	    return 0xFF;
+
+	uint8_t res = next_out();
+	receive(in);
+
+	return res;
+    }
+
+// Contenido de la tarjeta
+    static uint8_t value(uint32_t addr, uint16_t i)
+    {
+	auto p = data_.find(addr);
+	if (p != data_.end())
+	    return p->second[i];
+
+	return default_value(addr, i);
+    }
+
+    static uint8_t default_value(uint32_t addr, uint16_t i)
+    { return static_cast<uint8_t>(addr * 7 + i); }
+
+// Estadística
+    static uint32_t nbytes() {return nbytes_;}
+    static uint32_t ncommands() {return ncommands_;}
+    static uint32_t pre_erase() {return pre_erase_;}
+
+    static void reset_stats() { nbytes_ = 0; ncommands_ = 0;}
+
+private:
+    enum class State{ idle,
+		      read_multiple,
+		      wait_write_single_token,
+		      wait_write_multiple_token,
+		      receiving_block};
+
+// Data
+    inline static std::deque<uint8_t> out_;
+    inline static std::array<uint8_t, 6> cmd_;
+    inline static uint8_t cmd_n_ = 0;
+    inline static State state_ = State::idle;
+    inline static bool multiple_ = false; // receiving_block de CMD25?
+    inline static bool app_cmd_ = false;
+    inline static bool selected_ = false;
+
+    inline static uint32_t addr_ = 0;
+    inline static Block block_;
+    inline static uint16_t nblock_ = 0; // bytes recibidos del bloque
+
+    inline static std::map<uint32_t, Block> data_;
+
+    inline static uint32_t nbytes_ = 0;
+    inline static uint32_t ncommands_ = 0;
+    inline static uint32_t pre_erase_ = 0;
+
+// Output
+    static uint8_t next_out()
+    {
+	if (out_.empty() and state_ == State::read_multiple)
+	    push_block(addr_++, read_latency_bytes);
+
+	if (out_.empty())
+	    return 0xFF;
+
+	uint8_t x = out_.front();
+	out_.pop_front();
+	return x;
+    }
+
+    static void push_block(uint32_t addr, uint16_t latency)
+    {
+	for (uint16_t i = 0; i < latency; ++i)
+	    out_.push_back(0xFF);
+
+	out_.push_back(0xFE);
+
+	for (uint16_t i = 0; i < block_size; ++i)
+	    out_.push_back(value(addr, i));
+
+	out_.push_back(0x00); // CRC (no se valida)
+	out_.push_back(0x00);
+    }
+
+    static void push_R1(uint8_t r1)
+    {
+	out_.push_back(0xFF); // Ncr
+	out_.push_back(r1);
+    }
+
+    static void push_busy()
+    {
+	for (uint16_t i = 0; i < write_busy_bytes; ++i)
+	    out_.push_back(0x00);
+    }
+
+// Input
+    static void receive(uint8_t in)
+    {
+	if (state_ == State::receiving_block){
+	    receive_block(in);
+	    return;
+	}
+
+	if (state_ == State::wait_write_single_token or
+	    state_ == State::wait_write_multiple_token){
+	    if (receive_token(in))
+		return;
+	}
+
+	receive_cmd(in);
+    }
+
+    static bool receive_token(uint8_t in)
+    {
+	if (in == 0xFE and state_ == State::wait_write_single_token){
+	    multiple_ = false;
+	    state_ = State::receiving_block;
+	    nblock_ = 0;
+	    return true;
+	}
+
+	if (in == 0xFC and state_ == State::wait_write_multiple_token){
+	    multiple_ = true;
+	    state_ = State::receiving_block;
+	    nblock_ = 0;
+	    return true;
+	}
+
+	if (in == 0xFD and state_ == State::wait_write_multiple_token){
+	    out_.push_back(0xFF); // Nbr
+	    push_busy();
+	    state_ = State::idle;
+	    return true;
+	}
+
+	return false;
+    }
+
+    static void receive_block(uint8_t in)
+    {
+	if (nblock_ < block_size)
+	    block_[nblock_] = in;
+
+	++nblock_;
+
+	if (nblock_ == block_size + 2){ // + CRC
+	    data_[addr_] = block_;
+	    ++addr_;
+
+	    out_.push_back(0xE5); // data accepted
+	    push_busy();
+
+	    if (multiple_)
+		state_ = State::wait_write_multiple_token;
+	    else
+		state_ = State::idle;
+	}
+    }
+
+    static void receive_cmd(uint8_t in)
+    {
+	if (cmd_n_ == 0 and (in & 0xC0) != 0x40)
+	    return;
+
+	cmd_[cmd_n_++] = in;
+
+	if (cmd_n_ == 6){
+	    cmd_n_ = 0;
+	    execute_cmd();
+	}
+    }
+
+    static void execute_cmd()
+    {
+	++ncommands_;
+
+	uint8_t cmd = cmd_[0] & 0x3F;
+	uint32_t arg = (uint32_t{cmd_[1]} << 24) | (uint32_t{cmd_[2]} << 16)
+		     | (uint32_t{cmd_[3]} << 8)  | uint32_t{cmd_[4]};
+
+	bool app_cmd = app_cmd_;
+	app_cmd_ = false;
+
+	switch (cmd){
+	    break; case 12: // STOP_TRANSMISSION
+		out_.clear();
+		state_ = State::idle;
+		out_.push_back(0xFF); // stuff byte
+		out_.push_back(0x00); // R1
+		push_busy();
+
+	    break; case 13: // SEND_STATUS
+		push_R1(0x00);
+		out_.push_back(0x00); // R2
+
+	    break; case 17: // READ_SINGLE_BLOCK
+		push_R1(0x00);
+		push_block(arg, read_access_bytes);
+
+	    break; case 18: // READ_MULTIPLE_BLOCK
+		push_R1(0x00);
+		push_block(arg, read_access_bytes);
+		addr_ = arg + 1;
+		state_ = State::read_multiple;
+
+	    break; case 23: // ACMD23
+		if (app_cmd){
+		    pre_erase_ = arg;
+		    push_R1(0x00);
+		}
+		else
+		    push_R1(0x04); // illegal command
+
+	    break; case 24: // WRITE_BLOCK
+		push_R1(0x00);
+		addr_ = arg;
+		state_ = State::wait_write_single_token;
+
+	    break; case 25: // WRITE_MULTIPLE_BLOCK
+		push_R1(0x00);
+		addr_ = arg;
+		state_ = State::wait_write_multiple_token;
+
+	    break; case 55: // APP_CMD
+		app_cmd_ = true;
+		push_R1(0x00);
+
+	    break; default:
+		push_R1(0x04); // illegal command
+	}
+    }
+};
+
+
+// SPI master conectado a SDCard_simulator
+struct SPI_master{
+    template <typename Cfg>
+    static void cfg() { }
+
+    static void default_transfer_value(uint8_t x) {default_value_ = x;}
+
+    template <uint32_t freq>
+    static void SCK_frequency_in_hz() { }
+
+    static void turn_on() { }
+
+    static void write(uint8_t x) { SDCard_simulator::transfer(x); }
+    static uint8_t read() { return SDCard_simulator::transfer(default_value_);}
+
+    static void write(std::span<const uint8_t> out)
+    { for (uint8_t x: out) write(x); }
+
+    static void read(std::span<uint8_t> in)
+    { for (uint8_t& x: in) x = read(); }
+
+    inline static uint8_t default_value_ = 0xFF;
+};
+
+struct SPI_select{
+    static void init() {deselect();}
+    static void select() { SDCard_simulator::select(); }
+    static void deselect() { SDCard_simulator::deselect(); }
+
+    SPI_select() {select();}
+    ~SPI_select() {deselect();}
+};
+
+struct Micro{
+    static void wait_ms(uint16_t) { }
+    static void wait_us(uint16_t) { }
+};
+
+} // namespace
+
+#endif
+
+
@@ -29,11 +29,15 @@
  *
  *   - HISTORIA:
  *           Manuel Perez- 14/10/2019 v0.0
+ *           18/10/2026 xsputn
+ *           18/10/2026 Escritura no bloqueante página a página (ver
+ *                      EEPROM_lineal). xsgetn.
  *
  ****************************************************************************/
 #include <iostream>
 #include "dev_EEPROM_lineal.h"
 #include <string.h>
+#include <algorithm>	// min
 
 
 namespace dev{
@@ -56,6 +60,13 @@ namespace dev{
  *	+ Si se está usando como de entrada, no se puede llamar overflow
  *	(ni ninguna función de acceso a la put area).
  *
+ *  Cuando se llena el put area se graba solo la primera página que haya en
+ *  él y se devuelve el control sin esperar a que la eeprom termine de
+ *  grabarla: mientras tanto el programa puede seguir escribiendo en el
+ *  buffer. Solo se espera si se vuelve a llenar el buffer antes de que la
+ *  eeprom haya terminado (o al hacer sync/close). Cuanto mayor sea
+ *  BUFFER_SIZE (hasta el tamaño de página) menos se esperará.
+ *
  */
 template <typename EEPROM, uint8_t BUFFER_SIZE = 8>
 class EEPROM_streambuf : public std::streambuf {
@@ -101,6 +112,20 @@ protected:
     // salvo cuando c == traits::eof() en cuyo caso devuelve traits::not_eof(c))
     virtual int_type overflow(int_type c = traits_type::eof()) override;
 
+    // Writes up to n characters to the output sequence as if by repeated
+    // calls to sputc(c).
+    // Las cadenas que no entran en el buffer las escribimos directamente en
+    // la eeprom (de página en página) sin pasar por el buffer.
+    // Returns: the number of characters written.
+    virtual std::streamsize xsputn(const char_type* s, std::streamsize n) override;
+
+    // Reads up to n characters from the input sequence as if by repeated
+    // calls to sbumpc().
+    // Lo que no entra en el buffer lo leemos directamente de la eeprom con
+    // un único comando de lectura secuencial.
+    // Returns: the number of characters read.
+    virtual std::streamsize xsgetn(char_type* s, std::streamsize n) override;
+
     // Ensures that at least one character is avaible in the input area by
     // updating the pointers to the input area and reading more data in from
     // the input sequence. Returns the value of that character on success or
@@ -160,6 +185,17 @@ private:
     }
 
 
+    // Escribe [p, p + n) en la eeprom, como mucho hasta el final de la
+    // página. Si la eeprom está grabando la página anterior, espera.
+    // Returns: número de bytes escritos (0 en caso de error).
+    size_type write_some(const char_type* p, size_type n);
+
+    // Graba la primera página del put area (sin esperar a que la eeprom la
+    // grabe), dejando el resto en el buffer.
+    // Returns: -1 on failure 
+    int commit_put_area();
+
+    // Vuelca todo el put area.
     // Returns: -1 on failure 
     int sync_put_area();
     int sync_get_area();
@@ -214,37 +250,19 @@ int EEPROM_streambuf<E, P>::sync_put_area()
     if (!eeprom_.good())
 	return -1;
 
-    if (pptr() == pbase())
-	return 0;
-
-    uint8_t* pb = reinterpret_cast<uint8_t*>(pbase());
-    uint8_t* pp = reinterpret_cast<uint8_t*>(pptr());
+    int n = 0;
+    while (pptr() != pbase()){
+	int m = commit_put_area();
+	if (m == -1)
+	    return -1;
 
-    size_type n0 = static_cast<size_type>(pp - pb);
-    size_type n = eeprom_.write(address_, pb, n0);
-
-    address_ += n;
-
-    if (n != n0){
-	// TODO: es más eficiente hacer un copy directo (sé fijo que no se
-	// van a overlap), pero tengo que escribir esa función y probarla.
-	// Este caso es de esperar que apenas se dé (???). De momento no
-	// pierdo tiempo con él.
-	size_type resto = pptr() - pbase()  - n;
-	memmove(pbase(), pbase() + n, resto);
-
-	put_area(resto);
-
-
-	return -1;
+	n += m;
     }
 
-    reset_put_area();
-
     if (!eeprom_.good())
 	return -1;
 
-    return static_cast<int>(n);
+    return n;
 }
 
 
@@ -252,10 +270,14 @@ template <typename E, uint8_t P>
 typename EEPROM_streambuf<E,P>::int_type 
 EEPROM_streambuf<E, P>::overflow(int_type c)
 { 
-    if (pptr() == nullptr or sync_put_area() == -1)
+    if (pptr() == nullptr)
+	return traits_type::eof();
+
+    // Hacemos hueco grabando una página (sin esperar a que se grabe)
+    if (pptr() == epptr() and commit_put_area() == -1)
 	return traits_type::eof();
 
-    if (is_eof(c))
+    if (traits_type::eq_int_type(c, traits_type::eof()))
 	return traits_type::not_eof(c);
 
     *pptr() = c;
@@ -265,6 +287,125 @@ EEPROM_streambuf<E, P>::overflow(int_type c)
 }
 
 
+template <typename E, uint8_t P>
+std::streamsize EEPROM_streambuf<E, P>::xsputn(const char_type* s, 
+						    std::streamsize n)
+{
+    if (pptr() == nullptr)
+	return 0;
+
+    std::streamsize escritos = 0;
+
+    while (escritos < n){
+	// 1. Llenamos el buffer
+	std::streamsize len = std::min<std::streamsize>(epptr() - pptr(), 
+							n - escritos);
+	memcpy(pptr(), s + escritos, len);
+	pbump(len);
+	escritos += len;
+
+	if (escritos == n)
+	    return escritos;
+
+	// 2. Buffer lleno: hacemos hueco
+	if (commit_put_area() == -1)
+	    return escritos;
+
+	// 3. Si el buffer está vacío, lo que no entra en él lo escribimos
+	// directamente
+	while (pptr() == pbase() and n - escritos >= buffer_size()){
+	    size_type m = write_some(s + escritos, 
+		static_cast<size_type>(std::min<std::streamsize>(n - escritos,
+						    eeprom_.page_size())));
+	    if (m == 0)
+		return escritos;
+
+	    escritos += m;
+	}
+    }
+
+    return escritos;
+}
+
+
+template <typename E, uint8_t P>
+typename EEPROM_streambuf<E, P>::size_type 
+EEPROM_streambuf<E, P>::write_some(const char_type* p, size_type n)
+{
+    const uint8_t* q = reinterpret_cast<const uint8_t*>(p);
+
+    size_type m = eeprom_.write(address_, q, n);
+
+    if (m == 0 and eeprom_.good()){ // está grabando la página anterior
+	if (!eeprom_.wait_while_busy())
+	    return 0;
+
+	m = eeprom_.write(address_, q, n);
+    }
+
+    address_ += m;
+
+    return m;
+}
+
+
+template <typename E, uint8_t P>
+int EEPROM_streambuf<E, P>::commit_put_area() 
+{
+    size_type n0 = static_cast<size_type>(pptr() - pbase());
+    if (n0 == 0)
+	return 0;
+
+    size_type n = write_some(pbase(), n0);
+    if (n == 0)
+	return -1;
+
+    size_type resto = n0 - n;
+    memmove(pbase(), pbase() + n, resto);
+    put_area(resto);
+
+    return static_cast<int>(n);
+}
+
+
+template <typename E, uint8_t P>
+std::streamsize EEPROM_streambuf<E, P>::xsgetn(char_type* s, 
+						    std::streamsize n)
+{
+    if (gptr() == nullptr)
+	return 0;
+
+    // 1. Lo que haya en la get area
+    std::streamsize leidos = std::min<std::streamsize>(egptr() - gptr(), n);
+    memcpy(s, gptr(), leidos);
+    gbump(leidos);
+
+    // 2. Lo que no entra en el buffer lo leemos directamente (un único
+    // comando de lectura secuencial)
+    if (n - leidos >= buffer_size() and eeprom_.good()){
+	size_type m = eeprom_.read(address_, reinterpret_cast<uint8_t*>(s + leidos),
+		static_cast<size_type>(std::min<std::streamsize>(n - leidos, 
+						    eeprom_.max_address())));
+	address_ += m;
+	leidos += m;
+    }
+
+    // 3. El resto a través del buffer
+    while (leidos < n){
+	if (traits_type::eq_int_type(underflow(), traits_type::eof()))
+	    break;
+
+	std::streamsize len = std::min<std::streamsize>(egptr() - gptr(), 
+							    n - leidos);
+	memcpy(s + leidos, gptr(), len);
+	gbump(len);
+	leidos += len;
+    }
+
+    return leidos;
+}
+
+
 // precondicion: gptr() != nullptr
 template <typename E, uint8_t P>
 int EEPROM_streambuf<E, P>::sync_get_area() 
@@ -36,20 +36,17 @@
  *     Esta clase se encarga de convertir la memoria paginada de las EEPROM 
  *     particulares en memoria lineal, más sencilla de manejar.
  *  
- * - TODO:
- *	+ la función write no tiene por qué escribir todo lo que se le pide.
- *	Esta clase la vamos a usar desde un eeprom_iostream que contiene un
- *	buffer. La idea es volcar parte de ese buffer haciendo hueco para que
- *	el programa pueda continuar escribiendo. Si write intenta volcar todo
- *	el buffer se va a quedar esperando a guardar todas las páginas que
- *	tenga (tarda hasta 5ms). Es mejor que cuando se llama a write escriba
- *	la página en la que está y devuelva el control. De esa forma hace
- *	hueco en el buffer. Cuando eeprom_iostream vuelva a llamar a write lo
- *	mas seguro es que ya hayan pasado esos 5 ms de escritura con lo que
- *	podrá hacer otra petición de escritura de otra pagina. (y si no han
- *	pasado los 5 ms habrá pasado algo de tiempo con lo que el programa
- *	tendrá que esperar menos a que la eeprom escriba la pagina. Más
- *	eficiente!!!) Cambiar write e iostreams para que funcione así.
+ * - ESCRITURA NO BLOQUEANTE
+ *	La EEPROM tarda hasta 5 ms en grabar una página. Si `write` intentase
+ *	volcar todo lo que se le pide se quedaría esperando a que se grabasen
+ *	todas las páginas. Por eso `write` escribe solo la página en la que
+ *	está y devuelve el control inmediatamente: mientras la EEPROM graba
+ *	esa página el programa puede continuar (por ejemplo, llenando el
+ *	buffer de EEPROM_streambuf). Cuando se vuelva a llamar a `write` lo más
+ *	seguro es que ya hayan pasado esos 5 ms; si no es así, `write` no
+ *	espera: devuelve 0 (y `is_busy() == true`).
+ *
+ *	Si se quiere escribir todo de una vez (bloqueando) usar `write_all`.
  *
  * - HISTORIA:
  *   Manuel Perez:
@@ -57,6 +54,7 @@
  *    19/09/2019 v0.2: Añado el buffer interno de escritura.		    
  *    14/10/2019 v0.3: Descompongo la clase en EEPROM_lineal y
  *		       EEPROM_iostream.
+ *    18/10/2026 write no bloqueante (página a página): is_busy, write_all.
  *
  ****************************************************************************/
 #include <algorithm>
@@ -141,11 +139,12 @@ public:
     size_type read(const Address& address, uint8_t* buf, size_type n);
 
 
-    /// Intenta escribir los n bytes del buffer buf, a partir de la dirección 
-    /// de memoria indicada address. En caso de llegar al final, deja de
-    /// escribir. Si el número de bytes a escribir es grande, esta función
-    /// puede tardar bastante, ya que tiene que ir escribiendo página a página
-    /// la EEPROM (y puede llegar a tardar 5ms)
+    /// Escribe como mucho n bytes del buffer buf a partir de la dirección
+    /// address, sin pasar del final de la página en la que está address.
+    /// No espera a que la EEPROM grabe la página: devuelve el control
+    /// inmediatamente. Si la EEPROM está ocupada grabando la página
+    /// anterior no escribe nada y devuelve 0 (no es un error: good() sigue
+    /// siendo true y is_busy() es true).
     /// Devuelve el número de bytes escritos. En caso de llegar al final de la
     /// memoria, marca el estado como end_memory() (state != good)
     //
@@ -159,7 +158,36 @@ public:
     // Opto por elegir la segunda opción. A fin de cuentas, si el usuario
     // quiere escribir los datos parece mejor opción escribir todo lo que se
     // pueda ya que de perder datos así se perderían los menos posible.
-    size_type write(Address address, uint8_t* buf, size_type n);
+    size_type write(Address address, const uint8_t* buf, size_type n);
+
+    /// Intenta escribir los n bytes del buffer buf, a partir de la dirección 
+    /// de memoria indicada address. En caso de llegar al final, deja de
+    /// escribir. Si el número de bytes a escribir es grande, esta función
+    /// puede tardar bastante, ya que tiene que ir escribiendo página a página
+    /// la EEPROM (y cada página puede llegar a tardar 5ms)
+    /// Devuelve el número de bytes escritos.
+    size_type write_all(Address address, const uint8_t* buf, size_type n);
+
+    /// ¿Está la EEPROM grabando una página? 
+    /// Lee el status register, no bloquea.
+    bool is_busy() 
+    {
+	cfg();
+	return eeprom_.write_in_process(eeprom_.read_status_register());
+    }
+
+    /// Espera a que la EEPROM termine de grabar la página.
+    /// Devuelve false si la memoria no responde (marcando no_response()).
+    bool wait_while_busy()
+    {
+	cfg();
+	if (!wait_until_write_in_process_end()){
+	    setstate(State::no_responsebit);
+	    return false;
+	}
+
+	return true;
+    }
 
 
     /// Hace eeprom[address... address + n) = value.
@@ -188,6 +216,10 @@ public:
     constexpr static size_type max_address() 
     {return EEPROM::max_address();}
 
+    /// Número de bytes que tiene cada página.
+    constexpr static size_type page_size()
+    {return EEPROM::page_size();}
+
 private:
     // Dispositivo real en el que almacenamos los datos
     EEPROM eeprom_;
@@ -216,9 +248,12 @@ private:
 
     // Escribe el bufer buf a partir del address como mucho n bytes. 
     // Precondición: [address, address + n) están dentro de una misma página.
-    // Devuelve true si todo va bien, false en caso de que la memoria no
-    // responde. En este caso también marca el bit no_responsebit del state_.
-    bool write_page(Address address, uint8_t* buf, size_type n);
+    // Precondición: la EEPROM no está ocupada grabando otra página.
+    void write_page(Address address, const uint8_t* buf, size_type n);
+
+    // Número de bytes que quedan desde address hasta el final de su página.
+    size_type page_left(Address address)
+    { return eeprom_.page_size() - pos_page(address); }
 
     // Primer intento de controlar si la memoria responde o no. Básicamente
     // espero un número de ciclos determinado como mucho. Si no responde en
@@ -243,7 +278,9 @@ private:
 	return true;
     }
 
-    size_type write_unguarded(Address address, uint8_t* buf, size_type n);
+    // Recorta n para no escribir fuera de la memoria.
+    // Devuelve false si address está fuera de la memoria.
+    bool clip_to_memory(Address address, size_type& n);
 
     void setstate(State state) {state_ |= state;}
 };
@@ -272,33 +309,20 @@ EEPROM_lineal<E>::read(const Address& address, uint8_t* buf, size_type n)
 
 
 template <typename E>
-bool EEPROM_lineal<E>::write_page(Address address, uint8_t* buf, size_type n)
+inline void EEPROM_lineal<E>::write_page(Address address, const uint8_t* buf, size_type n)
 {
-    if (!wait_until_write_in_process_end()){
-	setstate(State::no_responsebit);
-	return false;
-    }
-
     eeprom_.write_enable();
     eeprom_.write(address, buf, n);
-
-    return true;
 }
 
 
 template <typename E>
-typename EEPROM_lineal<E>::size_type 
-EEPROM_lineal<E>::write(Address address, uint8_t* buf0, size_type N)
+bool EEPROM_lineal<E>::clip_to_memory(Address address, size_type& N)
 {
-    if (!good())
-	return 0;
-
-    cfg();
-
     // Garantizamos no escribir fuera de la memoria
     if (address > eeprom_.max_address()){
 	setstate(State::end_memorybit);
-	return 0;
+	return false;
     }
 
     // N = std::min(N, eeprom_.max_address() + 1 - address);
@@ -307,45 +331,51 @@ EEPROM_lineal<E>::write(Address address, uint8_t* buf0, size_type N)
 	setstate(State::end_memorybit);
     }
 
-    return write_unguarded(address, buf0, N);
+    return true;
 }
 
 
-// precondition: eeprom configurada y en bien conectada.
-// precondition: address + N <= eeprom_.max_address() + 1
 template <typename E>
-typename EEPROM_lineal<E>::size_type EEPROM_lineal<E>::write_unguarded(
-    Address address, uint8_t* buf0, size_type N)
+typename EEPROM_lineal<E>::size_type 
+EEPROM_lineal<E>::write(Address address, const uint8_t* buf, size_type N)
 {
+    if (!good() or N == 0)
+	return 0;
 
-    // 1.- Escribimos lo que queda en la pagina actual
-    uint8_t* buf = buf0;
-    size_type n = std::min(N, eeprom_.page_size() - pos_page(address));
-    
-    if (!write_page(address, buf, n))
+    if (!clip_to_memory(address, N))
 	return 0;
 
-    address += n;
-    buf += n;
-    N -= n;
-    
+    if (is_busy())
+	return 0;
 
-    // 2.- Escribimos las páginas completas que haya
-    while (N >= eeprom_.page_size()){
-	if (!write_page(address, buf, eeprom_.page_size()))
-	    return buf - buf0;
+    size_type n = std::min(N, page_left(address));
+    write_page(address, buf, n);
 
-	address += eeprom_.page_size();
-	buf += eeprom_.page_size();
-	N -= eeprom_.page_size();
-    }
+    return n;
+}
 
-    // 3.- Escribimos lo que queda (que no llega a una página entera)
-    if (N > 0){
-	if (!write_page(address, buf, N))
-	    return buf - buf0;
 
-	buf += N;
+template <typename E>
+typename EEPROM_lineal<E>::size_type 
+EEPROM_lineal<E>::write_all(Address address, const uint8_t* buf0, size_type N)
+{
+    if (!good())
+	return 0;
+
+    if (!clip_to_memory(address, N))
+	return 0;
+
+    const uint8_t* buf = buf0;
+    while (N > 0){
+	if (!wait_while_busy())
+	    break;
+
+	size_type n = std::min(N, page_left(address));
+	write_page(address, buf, n);
+
+	address += n;
+	buf += n;
+	N -= n;
     }
 
     return (buf - buf0);
@@ -361,11 +391,23 @@ EEPROM_lineal<EEPROM>::
     if (!good())
 	return 0;
 
-// TODO: ¿qué pasa si n > buf_size??? overflow!!! Corregir!!!
-    constexpr uint8_t buf_size = std::min(EEPROM::page_size(), SIZE_BUF_MAX);
+    // Escribimos página a página: nunca se escriben más de page_size bytes
+    // de una vez.
+    constexpr uint8_t buf_size = std::min<size_type>(EEPROM::page_size(), SIZE_BUF_MAX);
     uint8_t buf[buf_size];
-    std::fill_n(buf, n, value);
-    return write(address, buf, n);
+    std::fill_n(buf, buf_size, value);
+
+    size_type escritos = 0;
+    while (escritos < n){
+	size_type m = std::min<size_type>(n - escritos, buf_size);
+	size_type w = write_all(address + escritos, buf, m);
+	escritos += w;
+
+	if (w != m)
+	    break;
+    }
+
+    return escritos;
 }
 
 
@@ -62,6 +62,7 @@
  *			      opción más sencilla (con ceros). De momento esto
  *			      lo estoy pensando en usar en un reloj, donde
  *			      necesito los '0' a la izda.
+ *	18/10/2026       flush/flush_some (si el LCD es un LCD_shadow)
  *
  ****************************************************************************/
 #include <stdint.h>
@@ -243,6 +244,18 @@ public:
     constexpr static uint8_t rows() {return num_rows;}
     constexpr static uint8_t cols() {return num_cols;}
 
+// REFRESCO (solo si el LCD tiene buffer, ver LCD_shadow)
+    /// Envía al LCD todo lo que se haya escrito.
+    void flush() 
+	requires requires(Generic_LCD_type& lcd) {lcd.flush();}
+    { lcd_.flush(); }
+
+    /// Envía al LCD como mucho budget operaciones.
+    /// Returns: true si el LCD queda actualizado.
+    bool flush_some(uint8_t budget) 
+	requires requires(Generic_LCD_type& lcd) {lcd.flush_some(uint8_t{0});}
+    { return lcd_.flush_some(budget); }
+
     
 private:
 // Hardware al que está conectado
@@ -0,0 +1,357 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __DEV_LCD_SHADOW_H__
+#define __DEV_LCD_SHADOW_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: LCD con una copia en RAM de lo que muestra.
+ *
+ *	Escribir en el HD44780 es lento: por cada caracter hay que esperar a
+ *	que el LCD esté disponible. Un reloj o un menú que redibuja toda la
+ *	fila en cada tick envía los 16 caracteres aunque solo haya cambiado
+ *	un dígito.
+ *
+ *	LCD_shadow es un Generic_LCD (tiene el mismo interfaz que
+ *	dev::HD44780) que en lugar de escribir en el LCD escribe en una copia
+ *	en RAM (la shadow), marcando las celdas que cambian (dirty). Al llamar
+ *	a `flush()` envía al LCD solo los tramos de celdas que han cambiado.
+ *	Como el HD44780 incrementa automáticamente la dirección de la DDRAM,
+ *	solo se envía `cursor_pos` al principio de cada tramo.
+ *
+ *	`flush_some(budget)` envía como mucho `budget` operaciones (caracteres
+ *	o cursor_pos) permitiendo repartir el refresco entre varias vueltas
+ *	del main loop.
+ *
+ *	Se usa como cualquier otro Generic_LCD:
+ *
+ *	    using LCD    = dev::LCD_shadow<16, 2, dev::HD44780<Micro, Pins>>;
+ *	    using Screen = dev::LCD_screen_1602<LCD>;
+ *	    ...
+ *	    screen.cursor_pos(0, 0);
+ *	    screen.print(hh, nm::Width{2}); ...
+ *	    screen.flush();
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <stdint.h>
+
+namespace dev{
+
+template <uint8_t num_cols, uint8_t num_rows, typename Generic_LCD>
+class LCD_shadow{
+public:
+    using LCD = Generic_LCD;
+
+// Init
+    LCD_shadow() { init_shadow(); }
+
+    /// Clears entire display and set cursor in (0,0)
+    void clear_display();
+
+// Cursor y display: van directamente al LCD
+    /// Enciende el LCD.
+    void display_on() {lcd_.display_on();}
+
+    /// Apaga el LCD.
+    void display_off() {lcd_.display_off();}
+
+    /// Muestra el cursor.
+    /// Returns: El estado anterior del cursor.
+    bool cursor_on();
+
+    /// No muestra el cursor.
+    /// Returns: El estado anterior del cursor.
+    bool cursor_off();
+
+    /// Hace que el cursor parpadee.
+    void cursor_blink()	    {lcd_.cursor_blink();}
+
+    /// Hace que el cursor no parpadee.
+    void cursor_no_blink()  {lcd_.cursor_no_blink();}
+
+// Escritura en la shadow
+    /// Coloca el cursor en la posición (x,y), con  x = col; y = row.
+    /// En caso de pasarle una posición no válida lo coloca en (0,0).
+    void cursor_pos(uint8_t x, uint8_t y);
+
+    /// Imprime el caracter c en el display.
+    // Los caracteres que se salen de la fila se ignoran.
+    void print(char c);
+
+    /// Imprime el caracter extendido c en el display.
+    void print_extended(char c) {print(c);}
+
+    /// Lee el caracter mostrado en el display (leyéndolo de la shadow).
+    uint8_t read();
+
+    /// Crea un nuevo caracter 'c' de 8 filas en la página de memoria extendida.
+    // Se envía directamente al LCD.
+    template <typename Array>
+    void new_extended_char(uint8_t c, const Array& glyph);
+
+// Refresco
+    /// Envía al LCD todas las celdas que han cambiado.
+    void flush() { while (!flush_some(255)) { } }
+
+    /// Envía al LCD como mucho `budget` operaciones (caracteres o
+    /// cursor_pos).
+    /// Returns: true si el LCD queda actualizado (no quedan celdas
+    /// pendientes), false en caso contrario.
+    bool flush_some(uint8_t budget);
+
+    /// ¿Hay celdas pendientes de enviar al LCD?
+    bool is_dirty() const;
+
+    /// ¿La celda (x,y) está pendiente de enviar al LCD?
+    bool is_dirty(uint8_t x, uint8_t y) const
+    { return dirty_[index(x, y) / 8] & (1 << (index(x, y) % 8)); }
+
+    /// Marca todas las celdas para que se vuelvan a enviar al LCD.
+    void mark_all_dirty();
+
+// DATOS DEL LCD
+    constexpr static uint8_t rows() {return num_rows;}
+    constexpr static uint8_t cols() {return num_cols;}
+
+private:
+// Data
+    static constexpr uint16_t size = uint16_t{num_cols} * num_rows;
+    static constexpr uint8_t dirty_size = (size + 7) / 8;
+
+    LCD lcd_;
+
+    char shadow_[size];		// lo que queremos mostrar
+    uint8_t dirty_[dirty_size];	// bit i = 1 si la celda i no está en el LCD
+    
+    uint8_t x_ = 0, y_ = 0;	// cursor de la shadow
+
+    // Posición de la DDRAM del LCD (a donde escribiría el siguiente
+    // caracter). hw_x_ == cols() indica que la desconocemos (o que se ha
+    // salido de la fila).
+    uint8_t hw_x_ = num_cols, hw_y_ = 0;
+
+    bool cursor_on_ = false;
+
+// Helpers
+    static constexpr uint16_t index(uint8_t x, uint8_t y) 
+    { return uint16_t{y} * num_cols + x; }
+
+    void init_shadow();
+
+    void dirty(uint16_t i)    { dirty_[i / 8] |= (1 << (i % 8)); }
+    void clean(uint16_t i)    { dirty_[i / 8] &= ~(1 << (i % 8)); }
+
+    void write(uint16_t i, char c);
+
+    void hw_cursor_pos(uint8_t x, uint8_t y);
+    void hw_cursor_unknown() { hw_x_ = num_cols; }
+
+    // Coloca el cursor del LCD donde está el de la shadow (solo si se ve)
+    void sync_cursor();
+};
+
+
+template <uint8_t C, uint8_t R, typename L>
+void LCD_shadow<C, R, L>::init_shadow()
+{
+    // Después de init el LCD está borrado
+    for (uint16_t i = 0; i < size; ++i)
+	shadow_[i] = ' ';
+
+    for (uint8_t i = 0; i < dirty_size; ++i)
+	dirty_[i] = 0;
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+void LCD_shadow<C, R, L>::clear_display()
+{
+    for (uint16_t i = 0; i < size; ++i)
+	write(i, ' ');
+
+    x_ = 0; y_ = 0;
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+bool LCD_shadow<C, R, L>::cursor_on()
+{
+    cursor_on_ = true;
+    sync_cursor();
+    return lcd_.cursor_on();
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+bool LCD_shadow<C, R, L>::cursor_off()
+{
+    cursor_on_ = false;
+    return lcd_.cursor_off();
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+void LCD_shadow<C, R, L>::cursor_pos(uint8_t x, uint8_t y)
+{
+    if (x >= cols() or y >= rows()){
+	x = 0;
+	y = 0;
+    }
+
+    x_ = x;
+    y_ = y;
+
+    if (cursor_on_)
+	sync_cursor();
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+void LCD_shadow<C, R, L>::write(uint16_t i, char c)
+{
+    if (shadow_[i] != c){
+	shadow_[i] = c;
+	dirty(i);
+    }
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+void LCD_shadow<C, R, L>::print(char c)
+{
+    if (x_ >= cols())
+	return;
+
+    write(index(x_, y_), c);
+    ++x_;
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+uint8_t LCD_shadow<C, R, L>::read()
+{
+    if (x_ >= cols())
+	return ' ';
+
+    uint8_t c = static_cast<uint8_t>(shadow_[index(x_, y_)]);
+    ++x_;
+
+    return c;
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+template <typename Array>
+void LCD_shadow<C, R, L>::new_extended_char(uint8_t c, const Array& glyph)
+{
+    lcd_.new_extended_char(c, glyph);
+    hw_cursor_unknown();
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+bool LCD_shadow<C, R, L>::is_dirty() const
+{
+    for (uint8_t i = 0; i < dirty_size; ++i)
+	if (dirty_[i])
+	    return true;
+
+    return false;
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+void LCD_shadow<C, R, L>::mark_all_dirty()
+{
+    for (uint16_t i = 0; i < size; ++i)
+	dirty(i);
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+inline void LCD_shadow<C, R, L>::hw_cursor_pos(uint8_t x, uint8_t y)
+{
+    lcd_.cursor_pos(x, y);
+    hw_x_ = x;
+    hw_y_ = y;
+}
+
+
+template <uint8_t C, uint8_t R, typename L>
+void LCD_shadow<C, R, L>::sync_cursor()
+{
+    if (x_ < cols() and (hw_x_ != x_ or hw_y_ != y_))
+	hw_cursor_pos(x_, y_);
+}
+
+
+// Recorremos la shadow fila a fila enviando las celdas dirty. Si la
+// posición del LCD coincide con la celda no es necesario enviar cursor_pos
+// (el HD44780 incrementa la dirección después de cada escritura).
+// Un hueco de una sola celda limpia entre dos tramos lo rellenamos
+// reenviando la celda: cuesta lo mismo que un cursor_pos.
+template <uint8_t C, uint8_t R, typename L>
+bool LCD_shadow<C, R, L>::flush_some(uint8_t budget)
+{
+    for (uint8_t y = 0; y < rows(); ++y){
+	for (uint8_t x = 0; x < cols(); ++x){
+	    uint16_t i = index(x, y);
+
+	    bool send = is_dirty(x, y) or
+		    (hw_x_ == x and hw_y_ == y and x + 1 < cols() and
+		     is_dirty(x + 1, y));
+
+	    if (!send)
+		continue;
+
+	    if (hw_x_ != x or hw_y_ != y){
+		if (budget == 0)
+		    return false;
+
+		hw_cursor_pos(x, y);
+		--budget;
+	    }
+
+	    if (budget == 0)
+		return false;
+
+	    lcd_.print(shadow_[i]);
+	    clean(i);
+	    ++hw_x_;
+	    --budget;
+	}
+    }
+
+    if (cursor_on_)
+	sync_cursor();
+
+    return true;
+}
+
+
+}// namespace dev
+
+
+#endif
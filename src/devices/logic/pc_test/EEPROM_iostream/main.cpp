@@ -0,0 +1,172 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../dev_EEPROM_lineal.h"
+#include "../../dev_EEPROM_iostream.h"
+#include "../../test/EEPROM_lineal/simulador/sim_eeprom.h"
+
+#include <alp_test.h>
+#include <alp_string.h>
+
+#include <iostream>
+#include <string>
+
+using namespace test;
+
+// EEPROM simulada: 8 páginas de 16 bytes
+using Sim    = sim::EEPROM<8, 16>;
+using EEPROM = dev::EEPROM_lineal<Sim>;
+
+// Cadena de n caracteres distintos
+std::string make_data(size_t n)
+{
+    std::string res(n, ' ');
+    for (size_t i = 0; i < n; ++i)
+	res[i] = static_cast<char>('A' + i % 53);
+
+    return res;
+}
+
+std::string read(EEPROM& eeprom, EEPROM::Address address, size_t n)
+{
+    std::string res(n, ' ');
+    eeprom.read(address, reinterpret_cast<uint8_t*>(res.data()), n);
+    return res;
+}
+
+
+void test_lineal()
+{
+    test::interfaz("EEPROM_lineal");
+
+    Sim::busy_polls = 3;
+    Sim::reset_stats();
+
+    EEPROM eeprom;
+    std::string data = make_data(20);
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data.data());
+
+// write no espera: escribe solo hasta el final de la página
+    CHECK_TRUE(eeprom.write(5, p, 20) == 11, "write");
+    CHECK_TRUE(Sim::nwrites == 1, "write");
+
+// ... y si la EEPROM está grabando no escribe nada (y no es un error)
+    CHECK_TRUE(eeprom.write(16, p + 11, 9) == 0, "write busy");
+    CHECK_TRUE(eeprom.good(), "write busy");
+    CHECK_TRUE(Sim::nwrites == 1, "write busy");
+
+    CHECK_TRUE(eeprom.wait_while_busy(), "wait_while_busy");
+    CHECK_FALSE(eeprom.is_busy(), "wait_while_busy");
+    CHECK_TRUE(eeprom.write(16, p + 11, 9) == 9, "write");
+
+    CHECK_TRUE(read(eeprom, 5, 20) == data, "read");
+
+// write_all espera entre página y página
+    data = make_data(50);
+    p = reinterpret_cast<const uint8_t*>(data.data());
+    CHECK_TRUE(eeprom.write_all(30, p, 50) == 50, "write_all");
+    CHECK_TRUE(read(eeprom, 30, 50) == data, "write_all");
+
+// Final de la memoria
+    CHECK_TRUE(eeprom.write_all(120, p, 20) == 8, "end_memory");
+    CHECK_TRUE(eeprom.end_memory(), "end_memory");
+    eeprom.clear();
+
+    CHECK_TRUE(Sim::nerrors == 0, "no write while busy or across a page");
+}
+
+
+template <uint8_t N>
+void test_ostream(uint8_t busy_polls)
+{
+    test::interfaz("EEPROM_ostream<" + std::to_string(int{N}) +
+		   ">, busy_polls = " + std::to_string(int{busy_polls}));
+
+    Sim::busy_polls = busy_polls;
+    Sim::reset_stats();
+
+// Bloque (xsputn)
+{
+    std::string data = make_data(100);
+
+    dev::EEPROM_ostream<EEPROM, N> out{3};
+    out.write(data.data(), data.size());
+    CHECK_TRUE(out.good(), "write");
+    out.close();
+
+    CHECK_TRUE(read(out.eeprom(), 3, data.size()) == data, "write");
+    CHECK_TRUE(out.eeprom().good(), "write");
+
+    // [3, 103) ocupa 7 páginas: 7 escrituras como mínimo
+    CHECK_TRUE(Sim::nwrites >= 7, "write");
+    CHECK_TRUE(Sim::nerrors == 0, "no write while busy or across a page");
+}
+
+// Caracter a caracter (overflow)
+    Sim::reset_stats();
+{
+    std::string data = make_data(70);
+
+    dev::EEPROM_ostream<EEPROM, N> out{20};
+    for (char c: data)
+	out << c;
+
+    CHECK_TRUE(out.good(), "operator<<");
+    out.close();
+
+    CHECK_TRUE(read(out.eeprom(), 20, data.size()) == data, "operator<<");
+    CHECK_TRUE(Sim::nerrors == 0, "no write while busy or across a page");
+}
+
+// Mezcla de bloques y caracteres
+    Sim::reset_stats();
+{
+    std::string a = make_data(5);
+    std::string b = make_data(37);
+
+    dev::EEPROM_ostream<EEPROM, N> out{0};
+    out << a << 'x' << b << 'y' << a;
+    out.close();
+
+    std::string res = a + 'x' + b + 'y' + a;
+    CHECK_TRUE(read(out.eeprom(), 0, res.size()) == res, "mixed");
+    CHECK_TRUE(Sim::nerrors == 0, "no write while busy or across a page");
+}
+}
+
+
+int main()
+{
+try{
+    test::header("EEPROM_iostream");
+
+    test_lineal();
+
+    for (uint8_t busy_polls: {0, 1, 3, 50}){
+	test_ostream<4>(busy_polls);
+	test_ostream<8>(busy_polls);
+	test_ostream<16>(busy_polls);
+    }
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
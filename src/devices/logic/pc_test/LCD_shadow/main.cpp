@@ -0,0 +1,159 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../dev_LCD_screen.h"
+#include "../../dev_LCD_shadow.h"
+
+#include <alp_test.h>
+#include <alp_string.h>
+
+#include <iostream>
+#include <string>
+#include <array>
+
+using namespace test;
+
+// LCD simulado (Generic_LCD)
+// --------------------------
+// Cuenta las operaciones que llegan al LCD (caracteres y cursor_pos)
+struct LCD_1602{
+    inline static std::array<std::string, 2> ddram{std::string(16, ' '),
+						    std::string(16, ' ')};
+    inline static uint8_t x = 0, y = 0;
+    inline static uint32_t nchars = 0, ncursor = 0;
+
+    static void reset_stats() {nchars = 0; ncursor = 0;}
+
+    void clear_display() 
+    { ddram[0].assign(16, ' '); ddram[1].assign(16, ' '); x = y = 0;}
+
+    void display_on() {}
+    void display_off() {}
+    bool cursor_on() {return false;}
+    bool cursor_off() {return false;}
+    void cursor_blink() {}
+    void cursor_no_blink() {}
+
+    void cursor_pos(uint8_t x0, uint8_t y0) {x = x0; y = y0; ++ncursor;}
+
+    void print(char c) 
+    { 
+	if (x < 16) 
+	    ddram[y][x] = c; 
+	++x; 
+	++nchars;
+    }
+
+    template <typename Array>
+    void new_extended_char(uint8_t, const Array&) {x = 0; y = 0;}
+};
+
+using Shadow = dev::LCD_shadow<16, 2, LCD_1602>;
+using Screen = dev::LCD_screen_1602<Shadow>;
+
+void test_shadow()
+{
+    test::interface("LCD_shadow");
+
+    Screen scr;
+    LCD_1602::reset_stats();
+
+// Nada se envía hasta flush
+    scr.cursor_pos(0, 0);
+    scr.print("12:34:56");
+    CHECK_TRUE(LCD_1602::nchars == 0 and LCD_1602::ncursor == 0, "print");
+    CHECK_TRUE(scr.read(3, 0) == '3', "read");
+
+    scr.flush();
+    CHECK_TRUE(LCD_1602::ddram[0] == "12:34:56        ", "flush");
+    CHECK_TRUE(LCD_1602::nchars == 8 and LCD_1602::ncursor == 1, "flush");
+
+// Redibujamos la fila entera cambiando un dígito: solo se envía ese dígito
+    LCD_1602::reset_stats();
+    scr.cursor_pos(0, 0);
+    scr.print("12:34:57");
+    scr.flush();
+    CHECK_TRUE(LCD_1602::ddram[0] == "12:34:57        ", "one digit");
+    CHECK_TRUE(LCD_1602::nchars == 1 and LCD_1602::ncursor == 1, "one digit");
+
+// Dos tramos
+    LCD_1602::reset_stats();
+    scr.cursor_pos(0, 0);
+    scr.print("12:35:58");
+    scr.flush();
+    CHECK_TRUE(LCD_1602::ddram[0] == "12:35:58        ", "two runs");
+    CHECK_TRUE(LCD_1602::nchars == 2 and LCD_1602::ncursor == 2, "two runs");
+
+// Tramos separados por una celda: se rellena el hueco (sin cursor_pos)
+    LCD_1602::reset_stats();
+    scr.cursor_pos(0, 0);
+    scr.print("12:45.58");
+    scr.flush();
+    CHECK_TRUE(LCD_1602::ddram[0] == "12:45.58        ", "gap");
+    CHECK_TRUE(LCD_1602::nchars == 3 and LCD_1602::ncursor == 1, "gap");
+
+// Dos filas
+    LCD_1602::reset_stats();
+    scr.cursor_pos(0, 1);
+    scr.print("Hola");
+    scr.cursor_pos(15, 0);
+    scr.print('x');
+    scr.flush();
+    CHECK_TRUE(LCD_1602::ddram[0] == "12:45.58       x", "rows");
+    CHECK_TRUE(LCD_1602::ddram[1] == "Hola            ", "rows");
+    CHECK_TRUE(LCD_1602::nchars == 5 and LCD_1602::ncursor == 2, "rows");
+
+// flush_some
+    LCD_1602::reset_stats();
+    scr.clear();
+    CHECK_TRUE(!scr.flush_some(5), "flush_some");
+    CHECK_TRUE(LCD_1602::nchars + LCD_1602::ncursor == 5, "flush_some");
+    uint8_t n = 1;
+    while (!scr.flush_some(5))
+	++n;
+
+    CHECK_TRUE(LCD_1602::ddram[0] == std::string(16, ' ') and
+	       LCD_1602::ddram[1] == std::string(16, ' '), "flush_some");
+    CHECK_TRUE(n > 1 and LCD_1602::nchars + LCD_1602::ncursor <= 5u * (n + 1),
+								"flush_some");
+    LCD_1602::reset_stats();
+    scr.flush();
+    CHECK_TRUE(LCD_1602::nchars == 0 and LCD_1602::ncursor == 0, "clean");
+
+// El caracter que se sale de la fila se ignora
+    scr.cursor_pos(14, 1);
+    scr.print("abc");
+    scr.flush();
+    CHECK_TRUE(LCD_1602::ddram[1] == "              ab", "end of row");
+}
+
+
+int main()
+{
+try{
+    test::header("LCD_shadow");
+
+    test_shadow();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
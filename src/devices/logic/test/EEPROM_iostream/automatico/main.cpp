@@ -96,7 +96,7 @@ void reset_eeprom(EEPROM_lineal& eeprom, uint16_t address, uint16_t n)
 
     std::fill_n(buffer, n, uint8_t{0});
     
-    eeprom.write(address, buffer, n);
+    eeprom.write_all(address, buffer, n);
     if (!eeprom.good())
 	uart << "EEPROM en mal estado\n"
 	     << ERROR << "al inicializarla a 0\n\n";
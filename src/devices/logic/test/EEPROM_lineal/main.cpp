@@ -132,7 +132,7 @@ void test_eeprom_interactiva()
 	for (uint16_t i = 0; i < n; ++i)
 	    buf[i] = uint8_t{static_cast<uint8_t>(n0 + i)};
 
-	auto escritos = eeprom.write(address, buf, n);
+	auto escritos = eeprom.write_all(address, buf, n);
 	uart << "escritos = " << escritos << "\n";
 
 	if (eeprom.good())
@@ -189,8 +189,8 @@ void test_write(EEPROM& eeprom,
     for (uint8_t i = 0; i < n; ++i)
 	buf_write[i] = uint8_t{static_cast<uint8_t>(n0 + i)};
 
-    uart << "write(" << address << ", " << n << ") ... ";
-    auto escritos = eeprom.write(address, buf_write, n);
+    uart << "write_all(" << address << ", " << n << ") ... ";
+    auto escritos = eeprom.write_all(address, buf_write, n);
     if (escritos != n)
 	uart << " FAIL (escritos != n)\n";
     else{
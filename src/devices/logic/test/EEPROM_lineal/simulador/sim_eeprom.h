@@ -28,6 +28,12 @@
 #include <iostream>
 
 // Simulador de una EEPROM particular
+//
+// Simula también el tiempo de grabación: después de cada write el status
+// register indica write-in-process durante las siguientes `busy_polls`
+// lecturas. Se cuentan las escrituras y se anota como error cualquier
+// escritura mientras está ocupada o que se salga de la página (la EEPROM
+// real las haría mal).
 namespace sim{
 
 template <int num_pages_, int page_size_>
@@ -51,7 +57,7 @@ public:
     /// Como cada página tiene 64 bytes, en caso de que address + n se pase
     /// del fin de la página continua escribiendo en el principio de la
     /// página. Tarda máximo 5 ms.
-    void write(Address address, uint8_t* buf, size_type n);
+    void write(Address address, const uint8_t* buf, size_type n);
 
     /// Set the write enable latch.
     void write_enable() {}
@@ -59,14 +65,23 @@ public:
     /// Reset the write enable latch.
     void write_disable() {}
 
-    uint8_t read_status_register() {return 0;}
+    uint8_t read_status_register() 
+    {
+	if (busy_ > 0){
+	    --busy_;
+	    return WIP;
+	}
+
+	return 0;
+    }
 //  void write_status_register();  <--- TODO: solo se pueden escribir 2 bits.
 
     // Funciones de estado
     // -------------------
     /// Devuelve el valor del bit Write-In-Process del status register.
     /// Indica si el chip está ocupado con una operación de escritura.
-    static bool write_in_process(uint8_t status_reg) { return false;}
+    static bool write_in_process(uint8_t status_reg) 
+    { return (status_reg & WIP) != 0;}
 
     /// Devuelve el valor del bit Write Enable Latch del status register.
     /// Indica el chip está habilitado para escribir o no. Este bit es el 
@@ -75,13 +90,28 @@ public:
     static bool write_enable_latch(uint8_t status_reg) { return true;}
 
     /// Número de bytes que tiene cada página.
-    constexpr size_type page_size() const
+    static constexpr size_type page_size()
     {return page_size_;}
 
     /// Dirección de la última posición de memoria.
-    constexpr size_type max_address() const
+    static constexpr size_type max_address()
     {return num_pages_ * page_size_ - 1;}
 
+    // Simulación del tiempo de grabación
+    // ----------------------------------
+    /// Número de lecturas del status register que dura una grabación.
+    /// Con 0 la EEPROM nunca está ocupada.
+    inline static uint8_t busy_polls = 0;
+
+    /// Número de escrituras recibidas.
+    inline static uint32_t nwrites = 0;
+
+    /// Número de escrituras erróneas: mientras estaba ocupada o
+    /// saliéndose de la página.
+    inline static uint32_t nerrors = 0;
+
+    static void reset_stats() {nwrites = 0; nerrors = 0;}
+
 
     // Funciones de ayuda
     void print(std::ostream& out)
@@ -97,6 +127,12 @@ public:
 private:
     std::array<uint8_t, num_pages_ * page_size_> mem_;
 
+    // Bit write-in-process del status register
+    static constexpr uint8_t WIP = 0x01;
+
+    // Lecturas del status register que faltan para acabar de grabar
+    uint8_t busy_ = 0;
+
     constexpr size_type ie() const
     {return num_pages_ * page_size_;}
 };
@@ -124,8 +160,14 @@ void EEPROM<np, ps>::read(Address i, uint8_t* buf, size_type N)
 // del fin de la página continua escribiendo en el principio de la
 // página. Tarda máximo 5 ms.
 template <int np, int ps>
-void EEPROM<np, ps>::write(Address address, uint8_t* buf, size_type N)
+void EEPROM<np, ps>::write(Address address, const uint8_t* buf, size_type N)
 {
+    ++nwrites;
+    if (busy_ > 0 or (address % page_size()) + N > page_size())
+	++nerrors;
+
+    busy_ = busy_polls;
+
     // (i, j) = (num_page, pos_page)
     size_type i = address/page_size();
     size_type page_addr0 = page_size()*i;   // dirección inicial de la página
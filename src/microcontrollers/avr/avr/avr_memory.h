@@ -58,6 +58,8 @@
  *               mismos nombres sea cual sea el microcontrolador (ese es el
  *               ideal).
  *    23/10/2024 Traido del antiguo avr_
+ *    18/10/2026 ROM_read::copy
+ *    18/10/2026 rom_read de 4 bytes (para las tablas CRC32 en PROGMEM)
  *
  ****************************************************************************/
 #include <ostream>  // std::ostream
@@ -248,6 +250,9 @@ inline constexpr T rom_read(const T& x)
     else if constexpr (sizeof(T) == 2)
 	return T{pgm_read_word(&x)};
 
+    else if constexpr (sizeof(T) == 4)
+	return T{pgm_read_dword(&x)};
+
     else
 	static_assert(atd::always_false_v<T>, "Not implemented");
 }
@@ -256,10 +261,16 @@ struct ROM_read{
     template <typename T>
     T operator()(const T& x) const
     { return rom_read(x); }
+
+    // Copia src[0, n) de la ROM a dst[0, n) en RAM
+    template <typename T>
+    void copy(T* dst, const T* src, size_t n) const
+    { memcpy_P(dst, src, n * sizeof(T)); }
 };
 
 using ROM_uint8_t = atd::ROM<uint8_t, ROM_read>;
 using ROM_uint16_t = atd::ROM<uint16_t, ROM_read>;
+using ROM_uint32_t = atd::ROM<uint32_t, ROM_read>;
 
 
 template <typename T, size_t N, typename Read = ROM_read>
@@ -33,6 +33,7 @@
  *    Manuel Perez
  *    03/12/2022 Escrito
  *    04/11/2024 avr_atmega.h -> mega.h
+ *    18/10/2026 mega_USART_SPI_hal.h, mega_ADC_sampler.h
  *
  ****************************************************************************/
 // Cosas genéricas a todas las familias de avrs
@@ -70,12 +71,14 @@
 // Hardware abstraction layer
 // --------------------------
 #include <mega_SPI_hal.h>
+#include <mega_USART_SPI_hal.h>
 
 #include <mega_timer0_hal.h>
 #include <mega_timer1_hal.h>
 #include <mega_timer2_hal.h>
 
 #include <mega_ADC_hal.h>
+#include <mega_ADC_sampler.h>
 
 #include <mega_UART_hal.h>
 #include <mcu_UART_iostream.h>	// es comodo meterlo aqui
@@ -45,6 +45,7 @@
  * HISTORIA
  *    Manuel Perez
  *    14/06/2024 Primer intento: v-100
+ *    18/10/2026 AREF_selection público (lo usa ADC_sampler)
  *
  ****************************************************************************/
 
@@ -92,6 +93,9 @@ public:
     static constexpr uint8_t AREF_connect_to_external	   = 1;
     static constexpr uint8_t AREF_connect_to_internal_1_1V = 2;
 
+    template <uint8_t AREF_connect_to>
+    static void AREF_selection();
+
 
     /// Indicamos que el ADC funciona en single-mode (solo lee cuando se 
     /// lo pedimos).
@@ -151,9 +155,6 @@ private:
     template <uint16_t adc_frequency>
     static void clock_frequency_in_kHz_12MHz();
 
-    template <uint8_t AREF_connect_to>
-    static void AREF_selection();
-
 };
 
 
@@ -39,6 +39,7 @@
  *	30/03/2020 Reestructurado: saco las funciones de alto nivel.
  *		   Lo dejo como traductor puro.
  *	13/06/2024 Lo dejo como traductor puro (o eso espero)
+ *	18/10/2026 select_channel/channel
  *
  ****************************************************************************/
 
@@ -129,6 +130,15 @@ public:
     template <uint8_t num_pin>
     static void select_pin();
 
+    /// Devuelve el canal ADCn que corresponde al pin num_pin del chip.
+    template <uint8_t num_pin>
+    static constexpr uint8_t channel() {return cfg::ADC_PIN<num_pin>::value;}
+
+    /// Seleccionamos el canal ADCn (versión dinámica de select_pin).
+    /// Está pensada para ir cambiando de canal desde la ISR. 
+    /// precondicion: n = channel<num_pin>()
+    static void select_channel(uint8_t n);
+
     // Analog channel selection temperature sensor
     static void select_temperature_sensor();
 
@@ -274,6 +284,9 @@ template <uint8_t num_pin>
 inline void ADC::select_pin()
 { select_pin_<cfg::ADC_PIN<num_pin>::value>(); }
 
+inline void ADC::select_channel(uint8_t n)
+{ ADMUX = (0xf0 & ADMUX) | n; }
+
 inline void ADC::select_temperature_sensor()
 {// 1000 
     atd::write_bits<MUX3, MUX2, MUX1, MUX0>::to<1,0,0,0>::in(ADMUX); 
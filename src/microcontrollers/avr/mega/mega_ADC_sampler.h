@@ -0,0 +1,305 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __MEGA_ADC_SAMPLER_H__
+#define __MEGA_ADC_SAMPLER_H__
+/****************************************************************************
+ *
+ * DESCRIPCION
+ *	Muestreo del ADC por interrupciones en dos buffers (ping-pong).
+ *
+ * HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include "mega_ADC_hal.h"
+#include "mega_timer1_hwd.h"	// ADC_sampler disparado por el Timer1
+#include "mega_import_avr.h"	// Disable_interrupts
+
+#include <span>
+#include <atd_type_traits.h>	// always_false_v
+
+namespace mega_{
+namespace hal{
+
+/***************************************************************************
+ *				ADC_sampler
+ *
+ *  El ADC convierte continuamente (en free running mode o disparado por el
+ *  Timer1) y la ISR va guardando las muestras en dos buffers (ping-pong):
+ *  mientras la ISR llena uno el programa principal procesa el otro. No se
+ *  hace polling y es el hardware el que marca cuándo se muestrea (sin
+ *  jitter).
+ *
+ *  Si se indican varios pines se leen en round-robin: el bloque contiene las
+ *  muestras intercaladas pin0, pin1, ..., pin0, pin1, ...
+ *
+ *  Frecuencia de muestreo:
+ *	+ free_running: frecuencia del ADC / 13 (125 kHz / 13 = 9.6 kHz).
+ *	  Con varios pines cada pin se muestrea a esa frecuencia / npins.
+ *	+ timer1_*: la marca el Timer1, que tiene que configurar el cliente.
+ *	  La ISR del ADC borra el flag del Timer1 (si no se borra el ADC no
+ *	  vuelve a disparar) así que no hay que definir la ISR del Timer1.
+ *	  Ejemplo: Timer1 en modo CTC con TOP = OCR1A y OCR1B = 0 disparando
+ *	  con timer1_compare_match_B.
+ *
+ *  Configuración:
+ *	struct ADC_sampler_cfg{
+ *	    static constexpr uint8_t AREF_connect_to = 
+ *				    ADC::AREF_connect_to_internal_AVCC;
+ *	    static constexpr uint16_t adc_frequency_in_kHz = 125;
+ *	    static constexpr auto trigger = ADC_trigger::free_running;
+ *	    static constexpr uint8_t block_size = 32; // múltiplo de npins
+ *	};
+ *	using Sampler = ADC_sampler<ADC_sampler_cfg, 23, 24>;
+ *
+ *  Hay que definir la ISR:
+ *	ISR_ADC { Sampler::handle_interrupt(); }
+ *
+ *  Uso:
+ *	Sampler::start();
+ *	...
+ *	auto block = Sampler::block();
+ *	if (!block.empty()){
+ *	    process(block);
+ *	    Sampler::release_block();
+ *	}
+ *
+ ***************************************************************************/
+enum class ADC_trigger : uint8_t{
+    free_running,
+    timer1_compare_match_B,
+    timer1_overflow,
+    timer1_capture_event
+};
+
+template <typename Cfg, uint8_t... npin>
+class ADC_sampler{
+public:
+// Types
+    using AREF_type = ADC::AREF_type;
+    using Block     = std::span<const AREF_type>;
+
+// Cfg
+    static constexpr uint8_t npins	   = sizeof...(npin);
+    static constexpr uint8_t block_size  = Cfg::block_size;
+    static constexpr ADC_trigger trigger = Cfg::trigger;
+
+    static_assert(npins > 0, "At least one pin needed");
+    static_assert(block_size > 0 and block_size % npins == 0,
+		"block_size has to be a multiple of the number of pins");
+
+// Constructor
+    ADC_sampler() = delete; // static interface
+
+// Control
+    // Configura el ADC y empieza a muestrear.
+    // Si trigger es un timer1_*, el Timer1 lo configura el cliente.
+    static void start();
+    static void stop();
+
+// Bloques
+    // Devuelve el último bloque completo o un bloque vacío si no hay
+    // ninguno. La muestra i del bloque es del pin i % npins.
+    // Una vez procesado hay que llamar a release_block() para que la ISR
+    // pueda volver a usar el buffer.
+    static Block block();
+    static void release_block() {ready_ = false;}
+
+    // Número de bloques descartados por no haber llamado a tiempo a
+    // release_block().
+    static uint16_t overruns();
+
+// Interrupts
+    // Llamar desde ISR_ADC
+    static void handle_interrupt();
+
+private:
+// Data
+    static constexpr uint8_t channel_[npins] = {hwd::ADC::channel<npin>()...};
+
+    inline static AREF_type buffer_[2][block_size];
+    inline static volatile uint8_t writing_;	// buffer que llena la ISR
+    inline static volatile bool ready_;		// ¿está lleno el otro?
+    inline static volatile uint16_t overruns_;
+
+    // Estos solo los usa la ISR
+    inline static uint8_t n_;	    // muestras en buffer_[writing_]
+    inline static uint8_t next_;    // canal a seleccionar en la ISR
+    inline static bool discard_;    // ¿descartamos la siguiente muestra?
+
+// Helpers
+    static void select_trigger_source();
+    static void clear_trigger_flag();
+    static void next_channel();
+};
+
+
+template <typename C, uint8_t... p>
+inline void ADC_sampler<C, p...>::select_trigger_source()
+{
+    if constexpr (trigger == ADC_trigger::free_running)
+	hwd::ADC::auto_trigger_source_free_running_mode();
+
+    else if constexpr (trigger == ADC_trigger::timer1_compare_match_B)
+	hwd::ADC::auto_trigger_source_timer1_compare_match_B();
+
+    else if constexpr (trigger == ADC_trigger::timer1_overflow)
+	hwd::ADC::auto_trigger_source_timer1_overflow();
+
+    else if constexpr (trigger == ADC_trigger::timer1_capture_event)
+	hwd::ADC::auto_trigger_source_timer1_capture_event();
+
+    else
+	static_assert(atd::always_false_v<C>, "Unknown ADC_trigger");
+}
+
+
+// Datasheet: el ADC se dispara en el flanco de subida del flag. Si nadie
+// lo borra no se vuelve a disparar.
+template <typename C, uint8_t... p>
+inline void ADC_sampler<C, p...>::clear_trigger_flag()
+{
+    if constexpr (trigger == ADC_trigger::timer1_compare_match_B)
+	hwd::Timer1::clear_output_compare_B_match_flag();
+
+    else if constexpr (trigger == ADC_trigger::timer1_overflow)
+	hwd::Timer1::clear_overflow_interrupt();
+
+    else if constexpr (trigger == ADC_trigger::timer1_capture_event)
+	hwd::Timer1::clear_input_capture_interrupt_flag();
+}
+
+
+// (RRR) ¿Qué canal seleccionar?
+//	 ADMUX se lee al empezar la conversión.
+//	 + Si el trigger es un timer, la siguiente conversión empieza después
+//	   de la ISR: el canal que se selecciona en la ISR k es el de la
+//	   conversión k + 1.
+//	 + En free running, cuando se ejecuta la ISR k la conversión k + 1 ya
+//	   ha empezado con el canal anterior: el canal que se selecciona en la
+//	   ISR k es el de la conversión k + 2. Para que las muestras sigan el
+//	   orden pin0, pin1, ... descartamos la primera conversión (que
+//	   además es la que tarda más, 25 ciclos, al inicializar el ADC).
+//	 En los dos casos basta con seleccionar en cada ISR el siguiente canal
+//	 de la lista.
+template <typename C, uint8_t... p>
+inline void ADC_sampler<C, p...>::next_channel()
+{
+    if constexpr (npins > 1){
+	hwd::ADC::select_channel(channel_[next_]);
+
+	++next_;
+	if (next_ == npins)
+	    next_ = 0;
+    }
+}
+
+
+template <typename C, uint8_t... p>
+void ADC_sampler<C, p...>::start()
+{
+    ADC::clock_frequency_in_kHz<C::adc_frequency_in_kHz>();
+    ADC::AREF_selection<C::AREF_connect_to>();
+    hwd::ADC::right_adjust_result();
+
+    writing_  = 0;
+    ready_    = false;
+    overruns_ = 0;
+    n_        = 0;
+    next_     = (1 < npins? 1: 0);
+    discard_  = (trigger == ADC_trigger::free_running);
+
+    hwd::ADC::select_channel(channel_[0]);
+    select_trigger_source();
+    hwd::ADC::auto_trigger_mode();
+    hwd::ADC::interrupt_enable();
+    hwd::ADC::enable();
+
+    if constexpr (trigger == ADC_trigger::free_running)
+	hwd::ADC::start_conversion();
+}
+
+
+template <typename C, uint8_t... p>
+void ADC_sampler<C, p...>::stop()
+{
+    hwd::ADC::interrupt_disable();
+    hwd::ADC::single_conversion_mode();
+}
+
+
+// (RRR) La ISR solo cambia writing_ cuando ready_ == false, así que si
+//       ready_ == true writing_ no cambia mientras se procesa el bloque.
+template <typename C, uint8_t... p>
+inline ADC_sampler<C, p...>::Block ADC_sampler<C, p...>::block()
+{
+    if (!ready_)
+	return Block{};
+
+    return Block{buffer_[1 - writing_], block_size};
+}
+
+
+template <typename C, uint8_t... p>
+inline uint16_t ADC_sampler<C, p...>::overruns()
+{
+    Disable_interrupts lock; // 2 bytes
+    return overruns_;
+}
+
+
+template <typename C, uint8_t... p>
+inline void ADC_sampler<C, p...>::handle_interrupt()
+{
+    AREF_type x = hwd::ADC::ADC_in_arefs();
+
+    clear_trigger_flag();
+    next_channel();
+
+    if (discard_){
+	discard_ = false;
+	return;
+    }
+
+    uint8_t w = writing_;
+    buffer_[w][n_] = x;
+    ++n_;
+
+    if (n_ == block_size){
+	n_ = 0;
+
+	if (ready_) // el programa principal no ha acabado con el otro
+	    overruns_ = overruns_ + 1;	// sobreescribimos este
+
+	else {
+	    writing_ = 1 - w;
+	    ready_ = true;
+	}
+    }
+}
+
+
+}// namespace 
+}// namespace 
+
+#endif
@@ -43,11 +43,14 @@
  *
  *			3. El cliente es responsable de hacer el select del
  *			   SPI.
+ *	18/10/2026 SPI_master: write/read/transfer/fill de bloques.
  *
  ****************************************************************************/
 #include "mega_SPI_hwd.h"
 #include "mega_clock_frequencies.h"	
 
+#include <span>
+
 namespace mega_{
 namespace hal{
 
@@ -137,10 +140,12 @@ public:
     static void default_transfer_value(uint8_t x)
     { transfer_value_ = x;}
 
-private:
+
+protected:
 // Cfg
     inline static uint8_t transfer_value_ = 0;
 
+private:
 // Functions
     // Enviamos el byte x y esperamos hasta que lo haya enviado.
     // Devuelve el valor recibido.
@@ -155,6 +160,7 @@ private:
 
 };
 
+
 }// private_
 
 namespace private_{
@@ -342,6 +348,37 @@ public:
 
     static void turn_off()
     { disable(); }
+
+// Bytes
+    using Base::write;
+    using Base::read;
+
+// Bloques
+// -------
+// (RRR) ¿por qué no llamar a write(x) en un bucle?
+//       Entre byte y byte el SPI está parado: hay que esperar a SPIF,
+//       leer SPDR, volver, incrementar el contador y el puntero... A 
+//       SCK = F_CPU/2 un byte son 16 ciclos, y el bucle byte a byte pierde
+//       un 30-50% del bus.
+//
+//       El SPI tiene un buffer simple para transmitir y doble para recibir:
+//       en cuanto se activa SPIF se puede escribir el siguiente byte en 
+//       SPDR y luego leer el byte recibido (que sigue en el buffer hasta 
+//       que acabe la siguiente transmisión). Así que el siguiente byte se
+//       prepara antes de esperar y se envía nada más acabar el anterior.
+//
+    /// Envía los bytes de `out` descartando lo recibido.
+    static void write(std::span<const uint8_t> out);
+
+    /// Lee in.size() bytes enviando el default_transfer_value.
+    static void read(std::span<uint8_t> in);
+
+    /// Envía out y recibe in a la vez.
+    /// Precondición: in.size() == out.size() (pueden ser el mismo array)
+    static void transfer(std::span<const uint8_t> out, std::span<uint8_t> in);
+
+    /// Envía n veces el byte x descartando lo recibido.
+    static void fill(uint8_t x, size_t n);
     
 private:
 // Types
@@ -428,6 +465,88 @@ void SPI_master<Cfg>::cfg_pins()
 
 
 
+template <typename C>
+void SPI_master<C>::write(std::span<const uint8_t> out)
+{
+    size_t n = out.size();
+    if (n == 0)
+	return;
+
+    const uint8_t* p = out.data();
+    SPI::data_register(*p);
+
+    while (--n){
+	uint8_t x = *++p;
+	Base::wait_transmission_complete();
+	SPI::data_register(x);
+    }
+
+    Base::wait_transmission_complete();
+    (void) SPI::data_register(); // borramos SPIF (read SPSR + read SPDR)
+}
+
+template <typename C>
+void SPI_master<C>::read(std::span<uint8_t> in)
+{
+    size_t n = in.size();
+    if (n == 0)
+	return;
+
+    uint8_t x = Base::transfer_value_;
+    uint8_t* q = in.data();
+    SPI::data_register(x);
+
+    while (--n){
+	Base::wait_transmission_complete();
+	SPI::data_register(x);
+	*q++ = SPI::data_register(); // buffer de recepción doble
+    }
+
+    Base::wait_transmission_complete();
+    *q = SPI::data_register();
+}
+
+template <typename C>
+void SPI_master<C>::transfer(std::span<const uint8_t> out, 
+			     std::span<uint8_t> in)
+{
+    size_t n = out.size();
+    if (n == 0)
+	return;
+
+    const uint8_t* p = out.data();
+    uint8_t* q = in.data();
+    SPI::data_register(*p);
+
+    while (--n){
+	uint8_t x = *++p;
+	Base::wait_transmission_complete();
+	SPI::data_register(x);
+	*q++ = SPI::data_register(); 
+    }
+
+    Base::wait_transmission_complete();
+    *q = SPI::data_register();
+}
+
+template <typename C>
+void SPI_master<C>::fill(uint8_t x, size_t n)
+{
+    if (n == 0)
+	return;
+
+    SPI::data_register(x);
+
+    while (--n){
+	Base::wait_transmission_complete();
+	SPI::data_register(x);
+    }
+
+    Base::wait_transmission_complete();
+    (void) SPI::data_register();
+}
+
+
 /***************************************************************************
  *				SPI_slave
  ***************************************************************************/
@@ -45,6 +45,7 @@
  *    Manuel Perez
  *    17/09/2023 Reestructurado
  *    02/11/2024 UART_8bits
+ *    18/10/2026 enable/disable_interrupt_ready_to_transmit
  *
  ****************************************************************************/
 
@@ -144,9 +145,14 @@ public:
     static int flush(uint16_t time_out_ms);
 
 // Interrupts
+    // Remember to define ISR_USART_RX
     static void enable_interrupt_unread_data();
     static void disable_interrupt_unread_data();
 
+    // Remember to define ISR_USART_UDRE
+    static void enable_interrupt_ready_to_transmit();
+    static void disable_interrupt_ready_to_transmit();
+
 };
 
 // init
@@ -198,6 +204,12 @@ inline void UART_8bits::enable_interrupt_unread_data()
 inline void UART_8bits::disable_interrupt_unread_data()
 { USART::disable_interrupt_unread_data();}
 
+inline void UART_8bits::enable_interrupt_ready_to_transmit()
+{ USART::enable_interrupt_transmit_buffer_empty();}
+
+inline void UART_8bits::disable_interrupt_ready_to_transmit()
+{ USART::disable_interrupt_transmit_buffer_empty();}
+
 
 }// namespace
 }// namespace
@@ -0,0 +1,365 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __MEGA_USART_SPI_HAL_H__
+#define __MEGA_USART_SPI_HAL_H__
+/****************************************************************************
+ *
+ *  DESCRIPCION
+ *	SPI master usando el USART en modo MSPIM (Master SPI Mode).
+ *
+ *	El SPI del atmega tiene buffer simple para transmitir: entre byte y
+ *	byte el bus se para mientras el micro escribe el siguiente. El USART
+ *	en modo MSPIM tiene buffer doble: mientras se transmite un byte se
+ *	puede escribir el siguiente, consiguiendo enviar bytes seguidos sin
+ *	huecos.
+ *
+ *	Tiene el mismo interfaz que SPI_master, con lo que se puede pasar
+ *	como `SPI` en la Cfg de los dispositivos (SDCard, MAX7219...).
+ *
+ *	Conexiones:
+ *		TXD (pin 3) = MOSI
+ *		RXD (pin 2) = MISO
+ *		XCK (pin 6) = SCK
+ *
+ *	Observar que no podemos usar la UART a la vez.
+ *
+ *  HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include "mega_USART_hwd.h"
+#include "mega_clock_frequencies.h"
+
+#include <span>
+#include <atd_type_traits.h>	// always_false_v
+
+namespace mega_{
+namespace hal{
+
+// Ejemplo de Cfg:
+//
+// struct USART_SPI_cfg{
+//	template <uint8_t n>
+//	using Pin = myu::hwd::Pin<n>;
+//
+//	static constexpr uint32_t frequency_in_hz     = xxxx
+//	or
+//	static constexpr uint32_t period_in_us = xxx
+// };
+template <typename Cfg0>
+class USART_SPI_master{
+public:
+    using Hwd = hwd::UART; // hardware que hay por debajo
+    using Cfg = Cfg0;
+
+    static constexpr uint8_t MOSI_pin = Hwd::TXD_pin;
+    static constexpr uint8_t MISO_pin = Hwd::RXD_pin;
+    static constexpr uint8_t SCK_pin  = Hwd::XCK_pin;
+
+// Constructor
+    USART_SPI_master() = delete;
+
+    // Inicializa el USART como SPI master.
+    // No lo enciende. Hay que llamar a turn_on explicitamente.
+    static void init();
+
+    // Configura polaridad, fase y data order del dispositivo con el que
+    // nos vamos a comunicar (ver SPI_master::cfg)
+    template <typename SPI_dev_cfg>
+    static void cfg();
+
+    static void turn_on();
+    static void turn_off();
+
+// SCK
+    // SCK = F_CPU / (2 * (UBRR0 + 1)). Si la frecuencia no es exacta se
+    // elige la inmediatamente inferior.
+    template<uint32_t frequency, uint32_t clock_frequency_in_hz = hwd::clock_cpu()>
+    static void SCK_frequency_in_hz();
+
+    template<uint16_t period, uint32_t clock_frequency_in_hz = hwd::clock_cpu()>
+    static void SCK_period_in_us()
+    { SCK_frequency_in_hz<1'000'000ul / period, clock_frequency_in_hz>(); }
+
+// Modo (mismos nombres que el SPI)
+    static void mode(uint8_t polarity, uint8_t phase)
+    { Hwd::SPI_mode(polarity, phase); }
+
+    static void data_order_LSB() { Hwd::SPI_data_order_LSB(); }
+    static void data_order_MSB() { Hwd::SPI_data_order_MSB(); }
+
+// Transferencias
+    static void default_transfer_value(uint8_t x) { transfer_value_ = x;}
+
+    /// Envía x. Devuelve el valor recibido.
+    static uint8_t write(uint8_t x);
+
+    /// Lee un byte enviando default_transfer_value.
+    static uint8_t read() {return write(transfer_value_);}
+
+    // Bloques: mantienen lleno el buffer de transmisión. Mientras se
+    // transmite el byte i está esperando en el buffer el i + 1.
+    static void write(std::span<const uint8_t> out);
+    static void read(std::span<uint8_t> in);
+
+    /// Precondición: in.size() == out.size() (pueden ser el mismo array)
+    static void transfer(std::span<const uint8_t> out, std::span<uint8_t> in);
+
+    static void fill(uint8_t x, size_t n);
+
+private:
+// Cfg
+    inline static uint8_t transfer_value_ = 0;
+
+// Helpers
+    static void wait_data_register_empty()
+    { while (!Hwd::is_data_register_empty()) { ; } }
+
+    static void wait_unread_data()
+    { while (!Hwd::are_there_unread_data()) { ; } }
+
+    // Descarta lo que haya en el buffer de recepción.
+    static void flush_receiver()
+    {
+	while (Hwd::are_there_unread_data())
+	    (void) Hwd::data_register();
+    }
+
+    template <template <uint8_t n> typename Pin>
+    static void cfg_pins();
+};
+
+
+template <typename C>
+    template <template <uint8_t n> typename Pin>
+inline void USART_SPI_master<C>::cfg_pins()
+{
+    Pin<SCK_pin>::as_output();
+    Pin<MOSI_pin>::as_output();
+    Pin<MISO_pin>::as_input_without_pullup();
+}
+
+// 20.5 (datasheet): UBRR0 tiene que ser 0 al activar el transmisor y
+// se fija la velocidad después.
+template <typename C>
+void USART_SPI_master<C>::init()
+{
+    cfg_pins<Cfg::template Pin>();
+
+    Hwd::baud_rate_register(0);
+    Hwd::master_SPI_mode();
+    Hwd::SPI_data_order_MSB();
+    Hwd::SPI_mode(0, 0);
+
+    turn_on();
+
+    if constexpr (requires {Cfg::frequency_in_hz;})
+	SCK_frequency_in_hz<Cfg::frequency_in_hz>();
+
+    else if constexpr (requires {Cfg::period_in_us;})
+	SCK_period_in_us<Cfg::period_in_us>();
+
+    else
+	static_assert(atd::always_false_v<C>,
+			"You forgot to define frequency_in_hz or period_in_us!");
+}
+
+template <typename C>
+    template <typename SPI_dev_cfg>
+void USART_SPI_master<C>::cfg()
+{
+    if constexpr (requires {SPI_dev_cfg::data_order_LSB;})
+    {
+	if constexpr (SPI_dev_cfg::data_order_LSB)
+	    data_order_LSB();
+	else
+	    data_order_MSB();
+
+    } else if constexpr (requires {SPI_dev_cfg::data_order_MSB;}){
+	if constexpr (SPI_dev_cfg::data_order_MSB)
+	    data_order_MSB();
+	else
+	    data_order_LSB();
+    }
+
+    mode(SPI_dev_cfg::polarity, SPI_dev_cfg::phase);
+}
+
+template <typename C>
+inline void USART_SPI_master<C>::turn_on()
+{
+    Hwd::enable_receiver();
+    Hwd::enable_transmitter();
+}
+
+template <typename C>
+inline void USART_SPI_master<C>::turn_off()
+{
+    Hwd::disable_receiver();
+    Hwd::disable_transmitter();
+}
+
+template <typename C>
+    template<uint32_t frequency, uint32_t clock_frequency_in_hz>
+inline void USART_SPI_master<C>::SCK_frequency_in_hz()
+{
+    constexpr uint32_t div = 2 * frequency;
+    constexpr uint32_t ubrr = (clock_frequency_in_hz + div - 1) / div - 1;
+
+    static_assert(frequency > 0 and frequency <= clock_frequency_in_hz / 2,
+		    "SCK frequency too high (max = F_CPU / 2)");
+    static_assert(ubrr <= 4095, "SCK frequency too low");
+
+    Hwd::baud_rate_register(static_cast<uint16_t>(ubrr));
+}
+
+
+// Al recibir a la vez que se transmite, cuando llega el byte recibido es
+// que se ha acabado de enviar: no hace falta mirar TXC0.
+template <typename C>
+inline uint8_t USART_SPI_master<C>::write(uint8_t x)
+{
+    flush_receiver();
+
+    wait_data_register_empty();
+    Hwd::data_register(x);
+
+    wait_unread_data();
+    return Hwd::data_register();
+}
+
+
+// (RRR) ¿por qué leer también en write?
+//       Si no leemos lo recibido se produce un overrun (el buffer de
+//       recepción es de 2 bytes) y, sobre todo, no sabríamos cuándo se ha
+//       acabado de enviar el último byte: el cliente puede hacer el
+//       deselect antes de tiempo. Leer no cuesta nada: se hace mientras se
+//       transmite el siguiente byte.
+template <typename C>
+void USART_SPI_master<C>::write(std::span<const uint8_t> out)
+{
+    size_t n = out.size();
+    if (n == 0)
+	return;
+
+    flush_receiver();
+
+    const uint8_t* p = out.data();
+    wait_data_register_empty();
+    Hwd::data_register(*p);
+
+    while (--n){
+	uint8_t x = *++p;
+	wait_data_register_empty();
+	Hwd::data_register(x);	    // en el buffer mientras sale el anterior
+
+	wait_unread_data();
+	(void) Hwd::data_register();
+    }
+
+    wait_unread_data();
+    (void) Hwd::data_register();
+}
+
+template <typename C>
+void USART_SPI_master<C>::read(std::span<uint8_t> in)
+{
+    size_t n = in.size();
+    if (n == 0)
+	return;
+
+    flush_receiver();
+
+    uint8_t x = transfer_value_;
+    uint8_t* q = in.data();
+    wait_data_register_empty();
+    Hwd::data_register(x);
+
+    while (--n){
+	wait_data_register_empty();
+	Hwd::data_register(x);
+
+	wait_unread_data();
+	*q++ = Hwd::data_register();
+    }
+
+    wait_unread_data();
+    *q = Hwd::data_register();
+}
+
+template <typename C>
+void USART_SPI_master<C>::transfer(std::span<const uint8_t> out,
+				   std::span<uint8_t> in)
+{
+    size_t n = out.size();
+    if (n == 0)
+	return;
+
+    flush_receiver();
+
+    const uint8_t* p = out.data();
+    uint8_t* q = in.data();
+    wait_data_register_empty();
+    Hwd::data_register(*p);
+
+    while (--n){
+	uint8_t x = *++p;
+	wait_data_register_empty();
+	Hwd::data_register(x);
+
+	wait_unread_data();
+	*q++ = Hwd::data_register();
+    }
+
+    wait_unread_data();
+    *q = Hwd::data_register();
+}
+
+template <typename C>
+void USART_SPI_master<C>::fill(uint8_t x, size_t n)
+{
+    if (n == 0)
+	return;
+
+    flush_receiver();
+
+    wait_data_register_empty();
+    Hwd::data_register(x);
+
+    while (--n){
+	wait_data_register_empty();
+	Hwd::data_register(x);
+
+	wait_unread_data();
+	(void) Hwd::data_register();
+    }
+
+    wait_unread_data();
+    (void) Hwd::data_register();
+}
+
+
+}// namespace hal
+}// namespace mega_
+
+#endif
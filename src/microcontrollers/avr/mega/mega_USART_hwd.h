@@ -31,6 +31,7 @@
  *	27/08/2019 Modifico el calculo de UBBR.
  *	13/10/2019 Creo uart_iostream dejando UART como traductor puro.
  *	01/12/2022 enable_interrupt_.../disable_interrupt_...
+ *	18/10/2026 Master SPI mode (MSPIM)
  *
  ****************************************************************************/
 #include <avr/io.h>
@@ -38,6 +39,7 @@
 #include <atd_bit.h>
 
 #include "mega_UART_baud_rate.h"
+#include "mega_registers.h"
 
 namespace mega_{
 namespace hwd{
@@ -58,6 +60,11 @@ namespace hwd{
  */
 class UART{
 public:
+    // Pines
+    static constexpr uint8_t RXD_pin = cfg::usart::RXD_pin;
+    static constexpr uint8_t TXD_pin = cfg::usart::TXD_pin;
+    static constexpr uint8_t XCK_pin = cfg::usart::XCK_pin;
+
     // Configuración del UART
     // -----------------------
     // Recordar que antes que hacer nada hay que configurar:
@@ -257,6 +264,36 @@ public:
     static void asynchronous_mode() // modo 00
     {atd::write_bits<UMSEL01, UMSEL00>::to<0, 0>::in(UCSR0C);}
 
+
+    // --------------------------------
+    // Master SPI mode (MSPIM, cap. 20)
+    // --------------------------------
+    // El USART funciona como SPI master: TXD = MOSI, RXD = MISO y 
+    // XCK = SCK (el pin XCK tiene que estar configurado como salida).
+    // Velocidad: SCK = F_CPU / (2 * (UBRR0 + 1))
+    // A diferencia del SPI, el transmisor tiene buffer doble.
+    static void master_SPI_mode() // modo 11
+    {atd::write_bits<UMSEL01, UMSEL00>::to<1, 1>::in(UCSR0C);}
+
+    // En MSPIM los bits UCSZ01 y UCSZ00 son UDORD0 y UCPHA0
+    static void SPI_data_order_LSB()
+    { atd::write_bit<UDORD0>::to<1>::in(UCSR0C);}
+
+    static void SPI_data_order_MSB()
+    { atd::write_bit<UDORD0>::to<0>::in(UCSR0C);}
+
+    static void SPI_mode(uint8_t polarity, uint8_t phase)
+    {
+	if (polarity) atd::write_bit<UCPOL0>::to<1>::in(UCSR0C);
+	else	      atd::write_bit<UCPOL0>::to<0>::in(UCSR0C);
+
+	if (phase) atd::write_bit<UCPHA0>::to<1>::in(UCSR0C);
+	else	   atd::write_bit<UCPHA0>::to<0>::in(UCSR0C);
+    }
+
+    /// Escribe directamente el UBRR0 (en MSPIM no hay tabla de baud rates).
+    static void baud_rate_register(uint16_t ubrr) {UBRR0 = ubrr;}
+
     // TODO: esta función no pertenece al traductor. No usarla aquí. Dejarla
     // en UART_8bits o como helper.
     /// Definimos la velocidad a la que queremos transmitir datos.
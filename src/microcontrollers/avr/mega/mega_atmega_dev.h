@@ -28,6 +28,10 @@
  *   - HISTORIA:
  *    Manuel Perez
  *      08/12/2022 Escrito
+ *      18/10/2026 ADC_sampler
+ *      18/10/2026 Input_capture1
+ *      18/10/2026 USART_SPI_master
+ *      18/10/2026 Pin_group
  *
  ****************************************************************************/
 #include "mega_import_avr.h"    // import avr_;
@@ -82,6 +86,9 @@ namespace hwd{
     template <uint8_t n>
     using Enable_change_level_interrupt = mega_::hwd::Enable_change_level_interrupt<n>;
 
+    template <uint8_t... pins>
+    using Pin_group = mega_::hwd::Pin_group<mega_::hwd::cfg::pins_28, pins...>;
+
     using ADC      = mega_::hwd::ADC;
 
     using Timer0   = mega_::hwd::Timer0;
@@ -105,6 +112,11 @@ namespace hal{
     using ADC_pin_single_mode	  
 	    = mega_::hal::ADC_pin_single_mode<AREF_connect_to, adc_frequency_in_kHz>;
 
+    using ADC_trigger = mega_::hal::ADC_trigger;
+
+    template <typename Cfg, uint8_t... npin>
+    using ADC_sampler = mega_::hal::ADC_sampler<Cfg, npin...>;
+
 // TIMERS
     // TODO: sería más genérico el pasar solamente el número de pin sin
     // indicar el Timer al que pertenece.
@@ -129,6 +141,11 @@ namespace hal{
     // Timer1
     // ------
     using Time_counter1  = mega_::hal::Time_counter1;
+    using Cycle_counter1 = mega_::hal::Cycle_counter1;
+
+    template <uint16_t prescaler_factor, size_t ring_size = 32>
+    using Input_capture1 = mega_::hal::Input_capture1<prescaler_factor, 
+								ring_size>;
 
     template <uint8_t npin>
     using PWM1_pin	 = mega_::hal::PWM1_pin<npin>;
@@ -162,6 +179,10 @@ namespace driver{
 
     using SPI_slave  = mega_::hal::SPI_slave;
 
+    // SPI master usando el USART (MSPIM)
+    template <typename Cfg>
+    using USART_SPI_master = mega_::hal::USART_SPI_master<Cfg>;
+
 
 // ROM (Generic interface of progmem)
     template <typename T>
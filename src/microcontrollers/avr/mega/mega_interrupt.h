@@ -41,6 +41,7 @@
  *		 Enable_interrupt
  *    12/12/2022 Enable_interrupts/Disable_interrupts a dev_interrupt.h
  *    07/09/2023 Vuelvo a meter Enable_interrupts/Disable_interrupts en avr_.
+ *    18/10/2026 ISR_ADC
  *
  ****************************************************************************/
 #include <avr/interrupt.h>
@@ -152,6 +153,9 @@ namespace mega_{
 // TWI
 #define ISR_TWI		ISR(TWI_vect)
 
+// ADC
+#define ISR_ADC		ISR(ADC_vect)
+
 }// namespace
 
 
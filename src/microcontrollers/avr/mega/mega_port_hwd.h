@@ -25,14 +25,21 @@
  *
  *   - DESCRIPCION: Clases para manejar los puertos enteros
  *
+ *	Pin_group: grupo de pines (de uno o varios puertos) que se escriben
+ *	a la vez, como si fueran un puerto.
+ *
  *
  *   - HISTORIA:
  *    Manuel Perez
  *    03/06/2019 Escrito
+ *    18/10/2026 Pin_group
  *
  ****************************************************************************/
 #include <avr/io.h>
 
+#include "mega_registers.h"
+#include <mcu_pin.h>
+
 namespace mega_{
 namespace hwd{
 
@@ -68,6 +75,108 @@ struct Output_portD{
     }
 };
 
+
+/***************************************************************************
+ *				PIN_GROUP
+ ***************************************************************************/
+// Escribe a la vez varios pines: el bit i del valor va al pin pins[i].
+// Ejemplo:
+//	using Leds = Pin_group<cfg::pins_28, 15, 16, 17, 18, 19, 23, 24, 25>;
+//	Leds::as_output();
+//	Leds::write(0b10111101);
+//
+// En lugar de escribir pin a pin (8 read-modify-write de PORTx) hace una
+// única escritura por puerto. Cómo repartir los bits entre los puertos se
+// calcula en tiempo de compilación (ver mcu::Pin_group_layout).
+//
+// (RRR) ¿Por qué escribir en PINx en lugar de en PORTx?
+//       Escribir un 1 en PINx cambia el valor del pin. Si escribimos
+//	 (PORTx ^ bits) & mask solo cambian los pines del grupo que sean
+//	 diferentes. Cuesta lo mismo que (PORTx & ~mask) | bits, pero si una
+//	 interrupción modifica otro pin del puerto entre la lectura y la
+//	 escritura no machacamos su valor.
+//
+// Precondición: todos los pines son válidos y distintos. Como mucho 8.
+template <typename Cfg, uint8_t... pins>
+class Pin_group{
+public:
+// Cfg
+    static constexpr uint8_t size = sizeof...(pins);
+
+// Constructor
+    Pin_group() = delete;
+
+// Configuración
+    static void as_output();
+
+// Escritura
+    static void write(uint8_t x) __attribute__((always_inline));
+
+private:
+    static constexpr uint8_t port_id_[] = {
+		static_cast<uint8_t>(Cfg::template port_name<pins>())...};
+
+    static constexpr uint8_t pin_bit_[] = {
+		static_cast<uint8_t>(Cfg::template pin_bit<pins>())...};
+
+    static constexpr uint8_t pin_number_[] = {pins...};
+
+    static constexpr mcu::Pin_group_layout<size> layout{port_id_, pin_bit_};
+
+    // Número del pin del grupo que pertenece al puerto np (para llegar a
+    // los registros DDRx, PORTx y PINx a través de Cfg)
+    template <uint8_t np>
+    static constexpr uint8_t pin_of_port() 
+    { return pin_number_[layout.port[np].pin]; }
+
+    template <uint8_t np>
+    static void as_output_port();
+
+    template <uint8_t np>
+    static void write_port(uint8_t x) __attribute__((always_inline));
+};
+
+
+template <typename Cfg, uint8_t... pins>
+    template <uint8_t np>
+inline void Pin_group<Cfg, pins...>::as_output_port()
+{
+    if constexpr (np < layout.nports){
+	constexpr uint8_t n = pin_of_port<np>();
+	*Cfg::template ddr<n>() |= layout.port[np].mask;
+
+	as_output_port<np + 1>();
+    }
+}
+
+template <typename Cfg, uint8_t... pins>
+inline void Pin_group<Cfg, pins...>::as_output()
+{ as_output_port<0>(); }
+
+template <typename Cfg, uint8_t... pins>
+inline void Pin_group<Cfg, pins...>::write(uint8_t x)
+{ write_port<0>(x); }
+
+template <typename Cfg, uint8_t... pins>
+    template <uint8_t np>
+inline void Pin_group<Cfg, pins...>::write_port(uint8_t x)
+{
+    if constexpr (np < layout.nports){
+	constexpr uint8_t n    = pin_of_port<np>();
+	constexpr uint8_t mask = layout.port[np].mask;
+
+	uint8_t bits = mcu::pin_group_port_value<layout, np>(x);
+
+	if constexpr (mask == 0xFF)
+	    *Cfg::template port<n>() = bits;
+	else
+	    *Cfg::template pin<n>() = (*Cfg::template port<n>() ^ bits) & mask;
+
+	write_port<np + 1>(x);
+    }
+}
+
+
 }// namespace
 }// namespace
 
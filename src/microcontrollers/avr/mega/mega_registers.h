@@ -30,6 +30,9 @@
  *    Manuel Perez
  *      13/01/2019 v0.0
  *      20/10/2024 cfg::pins_28
+ *      18/10/2026 timer1::ICP_pin
+ *      18/10/2026 usart (pines del USART para el modo MSPIM)
+ *      18/10/2026 pins_28::port_name
  *
  ****************************************************************************/
 #include <cstdint>  // uint8_t
@@ -211,6 +214,23 @@ static constexpr
 auto bitmask()
 { return (1 << pin_bit<n>()); }
 
+// Nombre del puerto al que pertenece el pin. Sirve para saber, en tiempo
+// de compilación, si dos pines están en el mismo puerto (no podemos
+// comparar &PORTB con &PORTC en un constexpr).
+template <uint8_t n>
+static constexpr 
+char port_name()
+{
+    static_assert(is_a_valid_pin<n>(), "Wrong pin number");
+
+    if constexpr (n == 1) return 'C';
+    if constexpr (2 <= n and n <= 6) return 'D';
+    if constexpr (n == 9 or n == 10) return 'B';
+    if constexpr (11 <= n and n <= 13) return 'D';
+    if constexpr (14 <= n and n <= 19) return 'B';
+    if constexpr (23 <= n and n <= 28) return 'C';
+}
+
 template <uint8_t n>
 static constexpr 
 auto pcie()
@@ -363,6 +383,14 @@ inline constexpr int8_t nINT_of_pin()
 	static constexpr uint8_t SS_pin = 16u;
     };
 
+// USART
+// -----
+    struct usart{
+	static constexpr uint8_t RXD_pin = 2u;	// MISO en modo MSPIM
+	static constexpr uint8_t TXD_pin = 3u;	// MOSI en modo MSPIM
+	static constexpr uint8_t XCK_pin = 6u;	// SCK  en modo MSPIM
+    };
+
 // Timer0
 // ------
     struct timer0{
@@ -381,6 +409,7 @@ inline constexpr int8_t nINT_of_pin()
 	static constexpr uint8_t number_of_pins = 2;
         static constexpr uint8_t OCA_pin   = 15u;
         static constexpr uint8_t OCB_pin   = 16u;
+        static constexpr uint8_t ICP_pin   = 14u;
 	// constexpr uint32_t resolution= 65536u;
     };
 
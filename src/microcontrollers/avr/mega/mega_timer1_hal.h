@@ -91,6 +91,8 @@
  *    22/06/2024 SWG1_pin
  *    27/08/2024 PWM1_pin: funciones para poder controlar mejor la señal
  *			   generada
+ *    18/10/2026 Cycle_counter1
+ *    18/10/2026 Input_capture1
  *
  ****************************************************************************/
 #include "mega_timer1_hwd.h"
@@ -102,6 +104,7 @@
 
 #include <atd_math.h>
 #include <atd_names.h>
+#include <atd_array.h>	// Spsc_ring
 
 namespace mega_{
 namespace hal{
@@ -534,6 +537,255 @@ inline void Time_counter1::turn_on_with_overflow_every_1ms()
 }
 
 
+/***************************************************************************
+ *			    Cycle_counter1
+ ***************************************************************************/
+// Cuenta ciclos de reloj: Timer1 en modo normal sin prescaler. Es el Clock
+// de test::Benchmark (atd_benchmark.h).
+//
+// Sin interrupciones solo se detecta 1 overflow (por el flag TOV1), por lo
+// que se pueden medir hasta 2^17 - 1 ciclos. Para medir más hay que llamar
+// a enable_overflow_count() y definir:
+//	ISR_TIMER1_OVF { Micro::Cycle_counter1::handle_overflow_interrupt(); }
+class Cycle_counter1{
+public:
+// Types
+    using Hwd	       = mega_::hwd::Timer1;
+    using Timer        = mega_::hwd::Timer1;
+    using Disable_interrupts = mega_::Disable_interrupts;
+
+// Constructor
+    Cycle_counter1() = delete;
+
+// Clock
+    static void start()
+    {
+	Timer::off();
+	Timer::normal_mode();
+	Timer::unsafe_counter(0);
+	noverflows_ = 0;
+	Timer::clear_overflow_interrupt();
+	Timer::clock_frequency_no_prescaling();
+    }
+
+    // Devuelve el número de ciclos desde start()
+    static uint32_t stop()
+    {
+	Timer::off();
+
+	Disable_interrupts lock;
+	uint16_t n = noverflows_;
+	if (Timer::overflow_interrupt_is_set()) // overflow no contado
+	    ++n;
+
+	return (uint32_t{n} << 16) | Timer::unsafe_counter();
+    }
+
+// Overflow
+    static void enable_overflow_count() {Timer::enable_overflow_interrupt();}
+    static void disable_overflow_count() {Timer::disable_overflow_interrupt();}
+
+    static void handle_overflow_interrupt() {noverflows_ = noverflows_ + 1;}
+
+private:
+    inline static volatile uint16_t noverflows_ = 0;
+};
+
+
+/***************************************************************************
+ *			    Input_capture1
+ ***************************************************************************/
+// Mide la duración de los semiciclos de la señal conectada al pin ICP1 
+// usando el input capture unit del Timer1: el hardware copia TCNT1 en ICR1
+// en el flanco, con lo que la medida no depende de la latencia de la ISR
+// (a diferencia de Train_of_pulses_isr_receiver que lee el miniclock dentro
+// de la ISR).
+//
+// En cada captura se cambia el flanco (rising <-> falling) de tal manera
+// que se miden los dos semiciclos. Los overflows extienden el contador a 32
+// bits. La ISR deja los semiciclos en un atd::Spsc_ring que el cliente va
+// leyendo con pop().
+//
+// Hay que definir:
+//	ISR_TIMER1_CAPT { Micro::Input_capture1<8>::handle_capture_interrupt(); }
+//	ISR_TIMER1_OVF  { Micro::Input_capture1<8>::handle_overflow_interrupt(); }
+//
+// Es el productor de mcu::Train_of_pulses_capture_receiver.
+template <uint16_t prescaler_factor0, size_t ring_size = 32>
+class Input_capture1{
+public:
+// Types
+    using Hwd	       = mega_::hwd::Timer1;
+    using Timer        = mega_::hwd::Timer1;
+    using Pin	       = mega_::hwd::Pin<Timer::ICP_pin()>;
+    using Disable_interrupts = mega_::Disable_interrupts;
+
+    static constexpr uint16_t prescaler_factor = prescaler_factor0;
+
+    // ticks: duración del semiciclo en ticks del timer
+    // level: nivel de la señal durante el semiciclo
+    struct Semicycle{
+	uint32_t ticks;
+	bool level;
+    };
+
+// Constructor
+    Input_capture1() = delete;
+
+// Capture
+    /// Empieza a capturar. El primer flanco no genera semiciclo (no
+    /// sabemos cuándo empezó); marca el inicio (ver is_started()).
+    /// Recordar llamar a enable_interrupts.
+    // Precondicion: el cliente llama a Pin::as_input_without_pullup
+    static void start();
+    static void stop();
+
+    /// ¿Ha llegado el primer flanco?
+    static bool is_started() {return started_;}
+
+    /// Saca el siguiente semiciclo. Devuelve false si no hay ninguno.
+    static bool pop(Semicycle& s) {return semicycle_.pop(s);}
+
+    /// Número de semiciclos perdidos por estar lleno el buffer.
+    static uint8_t overruns() {return overruns_;}
+
+    /// Ticks transcurridos desde el último flanco. Útil para detectar el
+    /// final del tren de pulsos.
+    static uint32_t ticks_since_last_edge();
+
+    /// Nivel actual del pin ICP1
+    static bool pin_level() {return Pin::is_one();}
+
+    /// Activa el noise canceler del hardware (retrasa 4 ciclos la
+    /// captura).
+    static void noise_canceler_on() {Timer::input_capture_noise_canceler_on();}
+    static void noise_canceler_off() {Timer::input_capture_noise_canceler_off();}
+
+// Conversion
+    static constexpr uint32_t ticks_to_us(uint32_t ticks);
+
+// ISRs
+    static void handle_capture_interrupt();
+    static void handle_overflow_interrupt() {noverflows_ = noverflows_ + 1;}
+
+private:
+// Data
+    inline static atd::Spsc_ring<Semicycle, ring_size> semicycle_;
+    inline static volatile uint16_t noverflows_ = 0;
+    inline static volatile uint32_t last_ = 0;   // tiempo del último flanco
+    inline static volatile bool started_ = false;
+    inline static volatile uint8_t overruns_ = 0;
+
+    static constexpr uint32_t clock_in_MHz = hwd::clock_cpu() / 1'000'000ul;
+    static_assert(clock_in_MHz * 1'000'000ul == hwd::clock_cpu(),
+		"Input_capture1: clock_cpu must be a multiple of 1 MHz");
+
+// Helpers
+    // Tiempo en 32 bits de la lectura `counter` del timer. 
+    // Precondicion: interrupciones deshabilitadas.
+    static uint32_t unsafe_extend(uint16_t counter);
+
+    // Elegimos el flanco contrario al nivel actual de la señal.
+    static void wait_for_next_edge(bool level);
+};
+
+
+template <uint16_t P, size_t R>
+void Input_capture1<P, R>::start()
+{
+    Disable_interrupts lock;
+
+    Timer::off();
+    Timer::normal_mode();
+    Timer::unsafe_counter(0);
+
+    semicycle_.reset();
+    noverflows_ = 0;
+    last_	= 0;
+    started_    = false;
+    overruns_   = 0;
+
+    wait_for_next_edge(Pin::is_one());
+    Timer::clear_overflow_interrupt();
+
+    Timer::enable_input_capture_interrupt();
+    Timer::enable_overflow_interrupt();
+
+    Timer::prescaler(prescaler_factor);
+}
+
+template <uint16_t P, size_t R>
+void Input_capture1<P, R>::stop()
+{
+    Timer::off();
+    Timer::disable_input_capture_interrupt();
+    Timer::disable_overflow_interrupt();
+}
+
+// Datasheet: después de cambiar el flanco hay que borrar ICF1.
+template <uint16_t P, size_t R>
+inline void Input_capture1<P, R>::wait_for_next_edge(bool level)
+{
+    if (level)
+	Timer::input_capture_on_falling_edge();
+    else
+	Timer::input_capture_on_rising_edge();
+
+    Timer::clear_input_capture_interrupt_flag();
+}
+
+// Si TOV1 está activo el overflow todavía no se ha contado (estamos dentro
+// de una ISR o con las interrupciones deshabilitadas). Solo pertenece a
+// esta lectura si counter es pequeño: si counter está cerca de 0xFFFF la
+// lectura es anterior al overflow.
+template <uint16_t P, size_t R>
+inline uint32_t Input_capture1<P, R>::unsafe_extend(uint16_t counter)
+{
+    uint16_t n = noverflows_;
+    if (Timer::overflow_interrupt_is_set() and counter < 0x8000)
+	++n;
+
+    return (uint32_t{n} << 16) | counter;
+}
+
+template <uint16_t P, size_t R>
+uint32_t Input_capture1<P, R>::ticks_since_last_edge()
+{
+    Disable_interrupts lock;
+    return unsafe_extend(Timer::unsafe_counter()) - last_;
+}
+
+// El nivel del semiciclo que acaba es el contrario al flanco capturado: si
+// se captura un rising edge la señal estaba en 0.
+template <uint16_t P, size_t R>
+inline void Input_capture1<P, R>::handle_capture_interrupt()
+{
+    uint32_t t = unsafe_extend(Timer::unsafe_input_capture_register());
+    bool level = !Timer::is_input_capture_on_rising_edge();
+
+    wait_for_next_edge(!level);
+
+    if (started_){
+	if (!semicycle_.push(Semicycle{t - last_, level}))
+	    overruns_ = overruns_ + 1;
+    }
+    else
+	started_ = true;
+
+    last_ = t;
+}
+
+
+// (RRR) ticks * prescaler puede desbordar uint32_t (prescaler = 1024).
+//       Separando cociente y resto no desborda.
+template <uint16_t P, size_t R>
+inline constexpr uint32_t Input_capture1<P, R>::ticks_to_us(uint32_t ticks)
+{
+    return (ticks / clock_in_MHz) * prescaler_factor
+	 + ((ticks % clock_in_MHz) * prescaler_factor) / clock_in_MHz;
+}
+
+
 /***************************************************************************
  *			Square_wave_generator1_g
  ***************************************************************************/
@@ -64,6 +64,7 @@
  *
  *     08/07/2024 mode(), prescaler()
  *     28/08/2024 Funciones de acceso a los flags de las interrupciones.
+ *     18/10/2026 Input capture unit: ICP_pin, edge select, noise canceler.
  *
  ****************************************************************************/
 #include <limits>
@@ -130,6 +131,9 @@ public:
     // generador de ondas.
     static constexpr uint8_t OCB_pin() {return cfg::timer1::OCB_pin;}
 
+    // Devuelve el número de pin ICP1 (input capture)
+    static constexpr uint8_t ICP_pin() {return cfg::timer1::ICP_pin;}
+
 
 // CONFIGURACIÓN DEL RELOJ
     // (RRR) ¿por qué definir explícitamente aquí los prescaler_factor?
@@ -219,6 +223,19 @@ public:
     static counter_type unsafe_input_capture_register();	 /// Lectura del ICR.
     static void unsafe_input_capture_register(counter_type x);/// Escritura del ICR.
 
+// INPUT CAPTURE UNIT
+    /// Flanco del pin ICP1 en el que se copia TCNT1 en ICR1 (ICES1).
+    /// Datasheet: después de cambiar el flanco hay que borrar ICF1 
+    /// (clear_input_capture_interrupt_flag).
+    static void input_capture_on_falling_edge();
+    static void input_capture_on_rising_edge();
+    static bool is_input_capture_on_rising_edge();
+
+    /// Input capture noise canceler (ICNC1): filtra el pin ICP1 exigiendo
+    /// 4 muestras iguales. Retrasa la captura 4 ciclos de reloj.
+    static void input_capture_noise_canceler_on();
+    static void input_capture_noise_canceler_off();
+
 // WAVEFORM GENERATION MODES (table 20-6)
     enum class Mode{
 	normal,
@@ -452,6 +469,23 @@ inline void Timer1::unsafe_input_capture_register(Timer1::counter_type x)
 { ICR1 = x; }
 
 
+// INPUT CAPTURE UNIT
+inline void Timer1::input_capture_on_falling_edge()
+{ atd::write_bits<ICES1>::to<0>::in(TCCR1B); }
+
+inline void Timer1::input_capture_on_rising_edge()
+{ atd::write_bits<ICES1>::to<1>::in(TCCR1B); }
+
+inline bool Timer1::is_input_capture_on_rising_edge()
+{return atd::read_bit<ICES1>::of(TCCR1B) != 0;}
+
+inline void Timer1::input_capture_noise_canceler_on()
+{ atd::write_bits<ICNC1>::to<1>::in(TCCR1B); }
+
+inline void Timer1::input_capture_noise_canceler_off()
+{ atd::write_bits<ICNC1>::to<0>::in(TCCR1B); }
+
+
 // INTERRUPTS
 inline void Timer1::enable_overflow_interrupt()
 { atd::write_bits<TOIE1>::to<1>::in(TIMSK1); }
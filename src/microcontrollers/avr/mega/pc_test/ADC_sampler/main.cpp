@@ -0,0 +1,273 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#include <vector>
+
+// Simulación del hardware
+// -----------------------
+// No incluimos los traductores reales (necesitan <avr/io.h>): definimos
+// sus guardas y los sustituimos por estos.
+#define __MEGA_ADC_HAL_H__
+#define __MEGA_TIMER1_HWD_H__
+#define __MEGA_IMPORT_AVR_H__
+
+namespace sim{
+inline uint8_t admux = 0;	    // canal seleccionado
+inline uint16_t result = 0;	    // resultado de la última conversión
+inline int nflags = 0;		    // veces que se ha borrado el flag del Timer1
+inline bool running = false;
+}
+
+namespace mega_{
+
+struct Disable_interrupts{ Disable_interrupts() { } };
+
+namespace hwd{
+struct ADC{
+    using AREF_type = uint16_t;
+
+    // ADC0 = pin 23, ADC1 = pin 24, ...
+    template <uint8_t num_pin>
+    static constexpr uint8_t channel() {return num_pin - 23;}
+
+    static void select_channel(uint8_t n) {sim::admux = n;}
+    static AREF_type ADC_in_arefs() {return sim::result;}
+
+    static void auto_trigger_source_free_running_mode(){}
+    static void auto_trigger_source_timer1_compare_match_B(){}
+    static void auto_trigger_source_timer1_overflow(){}
+    static void auto_trigger_source_timer1_capture_event(){}
+    static void right_adjust_result(){}
+    static void auto_trigger_mode() {}
+    static void single_conversion_mode() {sim::running = false;}
+    static void interrupt_enable() {sim::running = true;}
+    static void interrupt_disable() {}
+    static void enable(){}
+    static void start_conversion(){}
+};
+
+struct Timer1{
+    static void clear_output_compare_B_match_flag() {++sim::nflags;}
+    static void clear_overflow_interrupt() {++sim::nflags;}
+    static void clear_input_capture_interrupt_flag() {++sim::nflags;}
+};
+}// namespace hwd
+
+namespace hal{
+struct ADC{
+    using AREF_type = hwd::ADC::AREF_type;
+    static constexpr uint8_t AREF_connect_to_internal_AVCC = 0;
+
+    template <uint16_t adc_frequency_in_kHz>
+    static void clock_frequency_in_kHz() {}
+
+    template <uint8_t AREF_connect_to>
+    static void AREF_selection() {}
+};
+}// namespace hal
+
+}// namespace mega_
+
+#include "../../mega_ADC_sampler.h"
+
+#include <alp_test.h>
+#include <alp_string.h>
+
+#include <iostream>
+#include <algorithm>
+
+using namespace test;
+using mega_::hal::ADC_trigger;
+
+template <ADC_trigger trigger0, uint8_t block_size0>
+struct Cfg{
+    static constexpr uint8_t AREF_connect_to = 0;
+    static constexpr uint16_t adc_frequency_in_kHz = 125;
+    static constexpr auto trigger = trigger0;
+    static constexpr uint8_t block_size = block_size0;
+};
+
+
+// Simulamos nconv conversiones.
+// La conversión k usa el canal que hay en ADMUX al empezar:
+//  + free running: la conversión k + 1 empieza antes de la ISR k.
+//  + timer: la conversión k + 1 empieza (con el trigger) después de la
+//    ISR k.
+// El resultado de cada conversión es 1000 * canal + k.
+// Cada `late_each` bloques tardamos en liberar el bloque lo que tarda la ISR
+// en llenar otro (simula que el programa principal llega tarde).
+template <typename Sampler, uint8_t... pin>
+void run(int nconv, int late_each,
+	    int& nblocks, bool& order_ok, bool& sequence_ok)
+{
+    constexpr uint8_t channel[] = {(pin - 23)...};
+
+    constexpr bool free_running = (Sampler::trigger == ADC_trigger::free_running);
+    constexpr uint8_t npins = Sampler::npins;
+
+    Sampler::start();
+    uint8_t latched = sim::admux;
+
+    nblocks = 0;
+    order_ok = true;
+    sequence_ok = true;
+    int last = -1;
+    int late = 0;
+
+    for (int k = 0; k < nconv; ++k){
+	sim::result = static_cast<uint16_t>(1000 * latched + k);
+
+	if constexpr (free_running)
+	    latched = sim::admux;
+
+	Sampler::handle_interrupt();
+
+	if constexpr (!free_running)
+	    latched = sim::admux;
+
+	if (late > 0){
+	    --late;
+	    if (late == 0)
+		Sampler::release_block();
+
+	    continue;
+	}
+
+	auto block = Sampler::block();
+	if (!block.empty()){
+	    CHECK_TRUE(block.size() == Sampler::block_size, "block size");
+
+	    for (size_t i = 0; i < block.size(); ++i){
+		if (block[i] / 1000 != channel[i % npins])
+		    order_ok = false;
+
+		// dentro de un bloque las muestras son consecutivas
+		int x = block[i] % 1000;
+		if (i > 0 and x != last + 1)
+		    sequence_ok = false;
+		last = x;
+	    }
+
+	    ++nblocks;
+	    if (late_each != 0 and nblocks % late_each == 0)
+		late = Sampler::block_size + 1;
+	    else
+		Sampler::release_block();
+	}
+    }
+
+    Sampler::stop();
+}
+
+
+template <ADC_trigger trigger>
+void test_sampler(const char* name)
+{
+    test::interfaz(name);
+
+// Un pin
+{
+    using Sampler = mega_::hal::ADC_sampler<Cfg<trigger, 8>, 25>;
+    int nblocks = 0; bool order_ok, sequence_ok;
+    sim::nflags = 0;
+
+    run<Sampler, 25>(80, 0, nblocks, order_ok, sequence_ok);
+    CHECK_TRUE(order_ok and sequence_ok, "one pin");
+
+    // En free running se descarta la primera conversión
+    if constexpr (trigger == ADC_trigger::free_running){
+	CHECK_TRUE(nblocks == 9, "one pin: first conversion discarded");
+	CHECK_TRUE(sim::nflags == 0, "no timer flag");
+    }
+    else {
+	CHECK_TRUE(nblocks == 10, "one pin");
+	CHECK_TRUE(sim::nflags == 80, "timer flag cleared in each ISR");
+    }
+
+    CHECK_TRUE(Sampler::overruns() == 0, "one pin: no overruns");
+    CHECK_FALSE(sim::running, "stop");
+}
+
+// Varios pines: round-robin
+{
+    using Sampler = mega_::hal::ADC_sampler<Cfg<trigger, 6>, 23, 24, 25>;
+    int nblocks = 0; bool order_ok, sequence_ok;
+
+    run<Sampler, 23, 24, 25>(100, 0, nblocks, order_ok, sequence_ok);
+    CHECK_TRUE(order_ok, "round-robin: block[i] from pin i % npins");
+    CHECK_TRUE(sequence_ok, "round-robin: no lost samples inside a block");
+    CHECK_TRUE(nblocks >= 16, "round-robin");
+    CHECK_TRUE(Sampler::overruns() == 0, "round-robin: no overruns");
+}
+
+// El programa principal no libera a tiempo: overruns
+{
+    using Sampler = mega_::hal::ADC_sampler<Cfg<trigger, 6>, 23, 24>;
+    int nblocks = 0; bool order_ok, sequence_ok;
+
+    run<Sampler, 23, 24>(100, 3, nblocks, order_ok, sequence_ok);
+    CHECK_TRUE(order_ok, "overruns: order");
+    CHECK_TRUE(Sampler::overruns() > 0, "overruns");
+}
+
+// El bloque entregado no lo toca la ISR hasta release_block()
+{
+    using Sampler = mega_::hal::ADC_sampler<Cfg<trigger, 4>, 23>;
+    Sampler::start();
+
+    int k = 0;
+    while (Sampler::block().empty()){
+	sim::result = static_cast<uint16_t>(k++);
+	Sampler::handle_interrupt();
+    }
+
+    auto block = Sampler::block();
+    std::vector<uint16_t> before(block.begin(), block.end());
+
+    for (int i = 0; i < 20; ++i){
+	sim::result = 999;
+	Sampler::handle_interrupt();
+    }
+
+    CHECK_TRUE(std::equal(block.begin(), block.end(), before.begin()),
+							"block not touched");
+    CHECK_TRUE(Sampler::overruns() > 0, "block not touched: overruns");
+
+    Sampler::release_block();
+    CHECK_TRUE(Sampler::block().empty(), "release_block");
+}
+}
+
+int main()
+{
+try{
+    test::header("ADC_sampler");
+
+    test_sampler<ADC_trigger::free_running>("free_running");
+    test_sampler<ADC_trigger::timer1_compare_match_B>("timer1_compare_match_B");
+    test_sampler<ADC_trigger::timer1_overflow>("timer1_overflow");
+    test_sampler<ADC_trigger::timer1_capture_event>("timer1_capture_event");
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
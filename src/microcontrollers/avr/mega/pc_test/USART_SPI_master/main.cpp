@@ -0,0 +1,358 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <random>
+
+// Simulación del hardware
+// -----------------------
+// No incluimos el traductor real (necesita <avr/io.h>): definimos sus
+// guardas y lo sustituimos por este.
+#define __MEGA_USART_HWD_H__
+#define __MEGA_CLOCK_FREQUENCIES_H__
+
+namespace sim{
+// USART en modo MSPIM:
+//	UDR0 --> buffer de transmisión (1 byte) --> shift register --> MOSI
+//	MISO --> shift register --> buffer de recepción (2 bytes)
+// Cada acceso de la CPU a un registro hace avanzar el reloj entre 0 y
+// max_step ciclos de SCK (simula lo que tarda la CPU).
+struct USART{
+    inline static int tx = -1;		// buffer de transmisión
+    inline static int shift = -1;	// shift register
+    inline static int nbits = 0;	// bits enviados del shift register
+    inline static std::deque<uint8_t> rx;
+
+    inline static std::vector<uint8_t> mosi;	// bytes enviados
+    inline static uint32_t nerrors = 0;	// overruns, datos perdidos...
+    inline static uint32_t idle = 0;	// ciclos de SCK con el bus parado
+					// entre el primer y el último byte
+    inline static uint32_t stopped = 0; // ciclos parados desde el último byte
+    inline static bool started = false;
+
+    inline static int max_step = 1;
+    inline static std::mt19937 gen{1234};
+
+    // El slave responde a cada byte con x ^ 0x5A
+    static constexpr uint8_t miso(uint8_t x) {return x ^ 0x5A;}
+
+    static void reset()
+    {
+	tx = shift = -1;
+	nbits = 0;
+	rx.clear();
+	mosi.clear();
+	nerrors = idle = stopped = 0;
+	started = false;
+    }
+
+    static void tick()
+    {
+	int n = static_cast<int>(gen() % (max_step + 1));
+	for (int i = 0; i < n; ++i){
+	    if (shift == -1 and tx != -1){
+		shift = tx;
+		tx = -1;
+		nbits = 0;
+		if (started)
+		    idle += stopped;
+		started = true;
+		stopped = 0;
+	    }
+
+	    if (shift == -1){
+		++stopped;
+		continue;
+	    }
+
+	    if (++nbits == 8){
+		uint8_t x = static_cast<uint8_t>(shift);
+		mosi.push_back(x);
+
+		if (rx.size() == 2)
+		    ++nerrors;	    // data overrun: se pierde el byte
+		else
+		    rx.push_back(miso(x));
+
+		shift = -1;
+	    }
+	}
+    }
+
+    // ¿Ha acabado de enviar todo?
+    static bool is_idle() {return tx == -1 and shift == -1;}
+};
+
+// Configuración de la USART
+inline uint16_t ubrr = 0xFFFF;
+inline bool spi_mode = false;
+inline bool lsb = false;
+inline uint8_t polarity = 0xFF, phase = 0xFF;
+inline bool rx_enable = false, tx_enable = false;
+
+inline std::vector<uint8_t> outputs, inputs; // configuración de los pines
+}
+
+namespace mega_{
+namespace hwd{
+
+constexpr uint32_t clock_cpu() {return 1'000'000ul;}
+
+struct UART{
+    static constexpr uint8_t TXD_pin = 3;
+    static constexpr uint8_t RXD_pin = 2;
+    static constexpr uint8_t XCK_pin = 6;
+
+    static void data_register(uint8_t x)
+    {
+	sim::USART::tick();
+	if (sim::USART::tx != -1)
+	    ++sim::USART::nerrors;  // se sobreescribe el buffer
+
+	sim::USART::tx = x;
+	sim::USART::tick();
+    }
+
+    static uint8_t data_register()
+    {
+	sim::USART::tick();
+	if (sim::USART::rx.empty()){
+	    ++sim::USART::nerrors;
+	    return 0;
+	}
+
+	uint8_t x = sim::USART::rx.front();
+	sim::USART::rx.pop_front();
+	return x;
+    }
+
+    static bool is_data_register_empty()
+    {
+	sim::USART::tick();
+	return sim::USART::tx == -1;
+    }
+
+    static bool are_there_unread_data()
+    {
+	sim::USART::tick();
+	return !sim::USART::rx.empty();
+    }
+
+    static void baud_rate_register(uint16_t x) {sim::ubrr = x;}
+    static void master_SPI_mode() {sim::spi_mode = true;}
+    static void SPI_data_order_LSB() {sim::lsb = true;}
+    static void SPI_data_order_MSB() {sim::lsb = false;}
+    static void SPI_mode(uint8_t pol, uint8_t pha)
+    { sim::polarity = pol; sim::phase = pha; }
+
+    static void enable_receiver() {sim::rx_enable = true;}
+    static void disable_receiver() {sim::rx_enable = false;}
+    static void enable_transmitter() {sim::tx_enable = true;}
+    static void disable_transmitter() {sim::tx_enable = false;}
+};
+
+}// namespace hwd
+}// namespace mega_
+
+#include "../../mega_USART_SPI_hal.h"
+
+#include <alp_test.h>
+#include <alp_string.h>
+
+#include <iostream>
+
+using namespace test;
+
+template <uint8_t n>
+struct Pin{
+    static void as_output() {sim::outputs.push_back(n);}
+    static void as_input_without_pullup() {sim::inputs.push_back(n);}
+};
+
+struct Cfg{
+    template <uint8_t n>
+    using Pin = ::Pin<n>;
+
+    static constexpr uint32_t frequency_in_hz = 100'000;
+};
+
+using SPI = mega_::hal::USART_SPI_master<Cfg>;
+
+struct SPI_dev_cfg{
+    static constexpr bool data_order_LSB = true;
+    static constexpr uint8_t polarity    = 1;
+    static constexpr uint8_t phase       = 0;
+};
+
+using USART = sim::USART;
+
+std::vector<uint8_t> make_data(size_t n)
+{
+    std::vector<uint8_t> res(n);
+    for (size_t i = 0; i < n; ++i)
+	res[i] = static_cast<uint8_t>(3 * i + 1);
+
+    return res;
+}
+
+void test_cfg()
+{
+    test::interfaz("init/cfg");
+
+    SPI::init();
+    CHECK_TRUE(sim::spi_mode and sim::rx_enable and sim::tx_enable, "init");
+    CHECK_TRUE(!sim::lsb and sim::polarity == 0 and sim::phase == 0, "init");
+    // SCK = F_CPU / (2 * (UBRR0 + 1)) = 1 MHz / 10 = 100 kHz
+    CHECK_TRUE(sim::ubrr == 4, "init: frequency");
+    CHECK_TRUE((sim::outputs == std::vector<uint8_t>{6, 3}), "init: pins");
+    CHECK_TRUE((sim::inputs == std::vector<uint8_t>{2}), "init: pins");
+
+    // Frecuencias no exactas: la inmediatamente inferior
+    SPI::SCK_frequency_in_hz<300'000>(); // 250 kHz
+    CHECK_TRUE(sim::ubrr == 1, "SCK_frequency_in_hz");
+    SPI::SCK_frequency_in_hz<500'000>();
+    CHECK_TRUE(sim::ubrr == 0, "SCK_frequency_in_hz");
+    SPI::SCK_period_in_us<10>();
+    CHECK_TRUE(sim::ubrr == 4, "SCK_period_in_us");
+
+    SPI::cfg<SPI_dev_cfg>();
+    CHECK_TRUE(sim::lsb and sim::polarity == 1 and sim::phase == 0, "cfg");
+
+    SPI::turn_off();
+    CHECK_TRUE(!sim::rx_enable and !sim::tx_enable, "turn_off");
+    SPI::turn_on();
+}
+
+void test_transfer(int max_step)
+{
+    test::interfaz("transfers, max_step = " + std::to_string(max_step));
+    USART::max_step = max_step;
+
+// bytes
+    USART::reset();
+    CHECK_TRUE(SPI::write(0x12) == USART::miso(0x12), "write(x)");
+    SPI::default_transfer_value(0xFF);
+    CHECK_TRUE(SPI::read() == USART::miso(0xFF), "read()");
+    CHECK_TRUE((USART::mosi == std::vector<uint8_t>{0x12, 0xFF}), "bytes");
+    CHECK_TRUE(USART::nerrors == 0 and USART::rx.empty(), "bytes");
+
+    std::vector<uint8_t> out = make_data(100);
+    std::vector<uint8_t> in(out.size());
+
+// write
+    USART::reset();
+    SPI::write(out);
+    CHECK_TRUE(USART::mosi == out, "write");
+    CHECK_TRUE(USART::is_idle(), "write: returns after the last byte");
+    CHECK_TRUE(USART::nerrors == 0 and USART::rx.empty(), "write");
+
+// read
+    USART::reset();
+    SPI::default_transfer_value(0xA0);
+    SPI::read(in);
+    CHECK_TRUE(USART::mosi == std::vector<uint8_t>(in.size(), 0xA0), "read");
+    bool ok = true;
+    for (uint8_t x: in)
+	if (x != USART::miso(0xA0)) ok = false;
+    CHECK_TRUE(ok, "read");
+    CHECK_TRUE(USART::is_idle(), "read: returns after the last byte");
+    CHECK_TRUE(USART::nerrors == 0 and USART::rx.empty(), "read");
+
+// transfer
+    USART::reset();
+    SPI::transfer(out, in);
+    CHECK_TRUE(USART::mosi == out, "transfer");
+    ok = true;
+    for (size_t i = 0; i < in.size(); ++i)
+	if (in[i] != USART::miso(out[i])) ok = false;
+    CHECK_TRUE(ok, "transfer");
+    CHECK_TRUE(USART::nerrors == 0 and USART::rx.empty(), "transfer");
+
+// transfer in place
+    USART::reset();
+    std::vector<uint8_t> buf = out;
+    SPI::transfer(buf, buf);
+    ok = true;
+    for (size_t i = 0; i < buf.size(); ++i)
+	if (buf[i] != USART::miso(out[i])) ok = false;
+    CHECK_TRUE(ok and USART::mosi == out, "transfer in place");
+
+// fill
+    USART::reset();
+    SPI::fill(0x33, 70);
+    CHECK_TRUE(USART::mosi == std::vector<uint8_t>(70, 0x33), "fill");
+    CHECK_TRUE(USART::is_idle(), "fill: returns after the last byte");
+    CHECK_TRUE(USART::nerrors == 0 and USART::rx.empty(), "fill");
+
+// Bloques vacíos
+    USART::reset();
+    SPI::write(std::span<const uint8_t>{});
+    SPI::fill(0x33, 0);
+    CHECK_TRUE(USART::mosi.empty() and USART::nerrors == 0, "empty");
+
+// Lo que haya quedado en el buffer de recepción no se lee como respuesta
+    USART::reset();
+    USART::rx.push_back(0x77);
+    CHECK_TRUE(SPI::write(0x01) == USART::miso(0x01), "flush_receiver");
+}
+
+// Si la CPU va más rápido que el SPI los bloques salen sin huecos; byte a
+// byte no.
+void test_back_to_back()
+{
+    test::interfaz("back to back");
+    USART::max_step = 1;
+
+    std::vector<uint8_t> out = make_data(64);
+
+    USART::reset();
+    SPI::write(out);
+    CHECK_TRUE(USART::idle == 0, "write(span): no gaps");
+
+    USART::reset();
+    SPI::fill(0, 64);
+    CHECK_TRUE(USART::idle == 0, "fill: no gaps");
+
+    USART::reset();
+    for (uint8_t x: out)
+	SPI::write(x);
+    CHECK_TRUE(USART::idle > 0, "write(x): gaps");
+}
+
+
+int main()
+{
+try{
+    test::header("USART_SPI_master");
+
+    test_cfg();
+
+    for (int max_step: {1, 4, 20})
+	test_transfer(max_step);
+
+    test_back_to_back();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
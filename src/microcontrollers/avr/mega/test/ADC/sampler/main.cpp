@@ -0,0 +1,127 @@
+// Copyright (C) 2026 Manuel Perez 
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#include "../../../mega_registers.h"
+#include "../../../mega_ADC_sampler.h"
+#include "../../../mega_UART_hal.h"
+#include "../../../mega_interrupt.h"
+#include <mcu_UART_iostream.h>
+#include <avr_time.h>
+
+
+// Microcontroller
+// ---------------
+namespace myu = mega_;
+using UART_iostream = mcu::UART_iostream<myu::hal::UART_8bits>;
+		
+// Pin connections
+// ---------------
+constexpr uint8_t ADC_npin0 = 27;
+constexpr uint8_t ADC_npin1 = 28;
+
+// Hwd devices
+// -----------
+using ADC = myu::hal::ADC;
+
+struct ADC_sampler_cfg{
+    static constexpr uint8_t AREF_connect_to = ADC::AREF_connect_to_internal_AVCC;
+    // A 1 MHz la ISR no da abasto con 125 kHz (9.6 kHz de muestreo)
+    static constexpr uint16_t adc_frequency_in_kHz = 62;
+    static constexpr auto trigger = myu::hal::ADC_trigger::free_running;
+    static constexpr uint8_t block_size = 32;
+};
+
+using Sampler = myu::hal::ADC_sampler<ADC_sampler_cfg, ADC_npin0, ADC_npin1>;
+
+
+// FUNCTIONS
+// ---------
+void init_uart()
+{
+    UART_iostream uart;
+    UART_iostream::init();
+    uart.turn_on();
+}
+
+
+void hello()
+{
+    UART_iostream uart;
+    uart << "\n\nADC_sampler test\n"
+	        "----------------\n"
+		"* DON'T FORGET to connect AVCC to power.\n"
+		"* Connect pins " << (uint16_t) ADC_npin0 << " and "
+		<< (uint16_t) ADC_npin1 << " to potenciometers.\n"
+		"Press a key to stop\n\n";
+}
+
+
+// Media de las muestras de cada pin del bloque
+void print(const Sampler::Block& block, uint16_t nblocks)
+{
+    uint32_t sum[Sampler::npins]{};
+    for (uint8_t i = 0; i < block.size(); ++i)
+	sum[i % Sampler::npins] += block[i];
+
+    constexpr uint8_t n = Sampler::block_size / Sampler::npins;
+
+    UART_iostream uart;
+    uart << nblocks << " blocks; overruns = " << Sampler::overruns()
+	 << "; pin " << (uint16_t) ADC_npin0 << " = " << sum[0] / n
+	 << "; pin " << (uint16_t) ADC_npin1 << " = " << sum[1] / n << '\n';
+}
+
+
+void test_sampler()
+{
+    UART_iostream uart;
+
+    Sampler::start();
+
+    uint16_t nblocks = 0;
+    while (!uart.is_there_something_to_read()){
+	auto block = Sampler::block();
+	if (block.empty())
+	    continue;
+
+	++nblocks;
+	if (nblocks % 256 == 0) // 62.5 kHz / 13 / 32 = 150 bloques/s
+	    print(block, nblocks);
+
+	Sampler::release_block();
+    }
+
+    Sampler::stop();
+
+    char c{};
+    uart >> c;
+}
+
+
+ISR_ADC { Sampler::handle_interrupt(); }
+
+int main() 
+{
+    init_uart();
+    myu::enable_interrupts();
+
+    while (1) {
+	hello();
+	test_sampler();
+    }
+}
@@ -0,0 +1,147 @@
+// Copyright (C) 2026 Manuel Perez 
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Compara el bucle byte a byte con las funciones de bloque del SPI
+// enviando un bloque de 512 bytes (el de la SD card).
+// No hace falta conectar nada: el master genera SCK aunque no haya slave.
+#include "../../../mega_registers.h"
+#include "../../../mega_SPI_hal.h"
+#include "../../../mega_pin_hwd.h"
+#include "../../../mega_timer1_hal.h"
+#include "../../../mega_UART_hal.h"
+#include <mcu_UART_iostream.h>
+#include <atd_benchmark.h>
+
+
+// Microcontroller
+// ---------------
+namespace myu = mega_;
+namespace hwd = mega_::hwd;
+using UART_iostream = mcu::UART_iostream<myu::hal::UART_8bits>;
+using Cycle_counter = myu::hal::Cycle_counter1;
+
+// SPI protocol
+// ------------
+// SCK = F_CPU / 2: es donde más se nota el tiempo perdido entre bytes
+struct SPI_master_cfg{
+    template <uint8_t n>
+    using Pin = myu::hwd::Pin<n>;
+};
+
+using SPI = myu::hal::SPI_master<SPI_master_cfg>;
+
+struct SPI_dev_cfg{
+    static constexpr bool data_order_MSB = true;
+    static constexpr uint8_t polarity    = 0;
+    static constexpr uint8_t phase       = 0;
+};
+
+using no_CS = hwd::Pin<SPI::SS_pin>;
+
+constexpr uint16_t block_size = 512;
+uint8_t block[block_size];
+
+
+// Functions
+// ---------
+void init_uart()
+{
+    UART_iostream uart;
+    UART_iostream::init();
+    uart.turn_on();
+}
+
+void init_SPI()
+{
+    SPI::init();
+    SPI::clock_frequency_divide_by_2();
+    SPI::cfg<SPI_dev_cfg>();
+    SPI::turn_on();
+    no_CS::as_output();
+    no_CS::write_one();
+}
+
+void hello()
+{
+    UART_iostream uart;
+    uart << "\n\nSPI block benchmark\n"
+		"-------------------\n"
+		"Block of " << block_size << " bytes; SCK = F_CPU/2\n"
+		"bench <name> <min> <median> <max> (cycles)\n\n";
+}
+
+void print_bytes_per_second(const char* name, const test::Benchmark_result& res)
+{
+    UART_iostream uart;
+    uart << "\t" << name << ": " 
+	 << (uint32_t{block_size} * (F_CPU / 100)) / res.median * 100
+	 << " bytes/s\n";
+}
+
+void benchmark()
+{
+    UART_iostream uart;
+    test::Benchmark<Cycle_counter, 5> bench{uart};
+
+    for (uint16_t i = 0; i < block_size; ++i)
+	block[i] = static_cast<uint8_t>(i);
+
+    auto r0 = bench.run("write_byte_by_byte", []{
+	for (uint16_t i = 0; i < block_size; ++i)
+	    SPI::write(block[i]);
+    });
+    print_bytes_per_second("byte by byte", r0);
+
+    auto r1 = bench.run("write(span)", []{ SPI::write(block); });
+    print_bytes_per_second("write(span)", r1);
+
+    auto r2 = bench.run("read_byte_by_byte", []{
+	for (uint16_t i = 0; i < block_size; ++i)
+	    block[i] = SPI::read();
+    });
+    print_bytes_per_second("byte by byte", r2);
+
+    auto r3 = bench.run("read(span)", []{ SPI::read(block); });
+    print_bytes_per_second("read(span)", r3);
+
+    auto r4 = bench.run("fill", []{ SPI::fill(0xFF, block_size); });
+    print_bytes_per_second("fill", r4);
+}
+
+
+// Main
+// ----
+int main() 
+{
+    init_uart();
+    init_SPI();
+
+    hello();
+
+    UART_iostream uart;
+    while (1) {
+	no_CS::write_zero();
+	benchmark();
+	no_CS::write_one();
+
+	uart << "\nPress a key to repeat\n";
+	char c{};
+	uart >> c;
+    }
+}
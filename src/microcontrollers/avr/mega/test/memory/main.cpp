@@ -22,6 +22,7 @@
 #include "../../mega_UART_hal.h"
 #include <mcu_UART_iostream.h>
 #include <avr_memory.h>
+#include <atd_crc.h>
 
 
 namespace myu = mega_;
@@ -139,11 +140,16 @@ void test_basic()
 
 constexpr uint8_t nu8 = 12;
 constexpr uint16_t nu16 = 47;
+constexpr uint32_t nu32 = 0x12345678;
 constexpr myu::ROM_uint8_t pu8 PROGMEM = nu8;
 constexpr myu::ROM_uint16_t pu16 PROGMEM = nu16;
+constexpr myu::ROM_uint32_t pu32 PROGMEM = nu32;
 
 // Este no tiene que compilar:
-// constexpr Progmem<uint32_t> pu32 PROGMEM = 200;
+// constexpr Progmem<uint64_t> pu64 PROGMEM = 200;
+
+// Tabla CRC32 en PROGMEM: cada entrada es un uint32_t
+constexpr atd::CRC32_table<256, myu::ROM_read> crc32_table PROGMEM{};
 constexpr atd::ROM<my::My_struct, my::ROM_read_my_struct> pstruct PROGMEM 
 			    = my::My_struct{111, 222, my::Enum::b};
 
@@ -197,6 +203,16 @@ void test_progmem()
     uint16_t x16 = pu16;
     uart << "u16:\t[" << x16 << "] =? [" << nu16 << "]\n";
 
+    uint32_t x32 = pu32;
+    uart << "u32:\t[" << x32 << "] =? [" << nu32 << "]\n";
+
+    {// CRC32 con la tabla en PROGMEM
+	constexpr uint8_t msg[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+	uint32_t crc = atd::CRC32(crc32_table, msg);
+	uart << "CRC32(\"123456789\") = [" << crc << "] =? [" 
+	     << atd::CRC32(msg) << "] =? [3421780262]\n";
+    }
+
     my::My_struct str1 = pstruct;
     uart << "My_struct = {" << (int) str1.u8 << ", " << str1.u16 
 	 << ", " << (int) str1.en << "}\n";
@@ -0,0 +1,105 @@
+// Copyright (C) 2026 Manuel Perez 
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../../mega_registers.h"
+#include "../../../mega_UART_hal.h"
+#include "../../../mega_timer1_hal.h"
+#include "../../../mega_interrupt.h"
+#include "../../../mega_micro.h"
+#include <mcu_UART_iostream.h>
+#include <mcu_train_of_pulses.h>
+
+
+// Microcontroller
+// ---------------
+namespace myu = mega_;
+using Micro   = myu::Micro<myu::hwd::cfg::pins_28>;
+using UART_iostream = mcu::UART_iostream<myu::hal::UART_8bits>;
+
+// Hwd devices
+// -----------
+// A 1 MHz con prescaler 1 cada tick es 1 us
+using Capture = myu::hal::Input_capture1<1>;
+using Pin     = Micro::Pin<Capture::Timer::ICP_pin()>;
+
+// Devices
+// -------
+constexpr int16_t num_max_pulses = 40;
+
+using Receiver_cfg = mcu::Train_of_pulses_capture_receiver_cfg<
+					Micro, Capture, num_max_pulses>;
+using Receiver = mcu::Train_of_pulses_capture_receiver<Receiver_cfg>;
+
+
+// FUNCTIONS
+// ---------
+void init_uart()
+{
+    UART_iostream uart;
+    UART_iostream::init();
+    uart.turn_on();
+}
+
+
+void hello()
+{
+    UART_iostream uart;
+    uart << "\n\nInput_capture1 test\n"
+	        "-------------------\n"
+		"Connect an IR receiver (or any signal) to pin "
+		<< (uint16_t) Pin::number << "\n"
+		"Press a key to receive a train of pulses\n\n";
+}
+
+
+void test_receive()
+{
+    UART_iostream uart;
+    char c{};
+    uart >> c;
+
+    uart << "Waiting for pulses ... ";
+
+    mcu::Train_of_pulses<num_max_pulses> pulse;
+    volatile bool abort = false;
+    size_t n = Receiver::receive(pulse, abort);
+
+    uart << "received " << n << " pulses (polarity = "
+	 << (uint16_t) pulse.polarity() << "; overruns = "
+	 << (uint16_t) Capture::overruns() << ")\n";
+
+    for (size_t i = 0; i < pulse.size(); ++i)
+	uart << '\t' << i << ": low = " << pulse[i].time_low 
+	     << " us; high = " << pulse[i].time_high << " us\n";
+}
+
+
+ISR_TIMER1_CAPT { Capture::handle_capture_interrupt(); }
+ISR_TIMER1_OVF  { Capture::handle_overflow_interrupt(); }
+
+int main() 
+{
+    init_uart();
+    Pin::as_input_without_pullup();
+
+    hello();
+
+    while (1) 
+	test_receive();
+}
@@ -29,6 +29,9 @@
  * HISTORIA
  *    Manuel Perez
  *    19/10/2024 Empezando...
+ *    18/10/2026 Pin_group
+ *    18/10/2026 TCA, TCB
+ *    18/10/2026 EVSYS
  *
  ****************************************************************************/
 #include "mega0_import_avr.h"
@@ -43,6 +46,13 @@
 #include "mega0_spi_hal.h"
 #include "mega0_spi_hwd.h"
 
+#include "mega0_evsys_hwd.h"
+
+#include "mega0_timerA_hwd.h"
+#include "mega0_timerA_hal.h"
+#include "mega0_timerB_hwd.h"
+#include "mega0_timerB_hal.h"
+
 #include "mega0_registers.h"
 
 #include <mcu_UART_iostream.h>  // Este lo incluyo por comodidad aquí
@@ -69,6 +79,9 @@ namespace hwd{
     template <uint8_t n>
     using Pin = mega0_::hwd::Pin<n, cfg::pins>;
 
+    template <uint8_t... pins>
+    using Pin_group = mega0_::hwd::Pin_group<cfg::pins, pins...>;
+
     using Clock_controller = mega0_::hwd::Clock_controller;
 
 // USART
@@ -79,6 +92,17 @@ namespace hwd{
 // SPI
     using SPI = mega0_::hwd::SPI<cfg::SPI0>;
 
+// Event system
+    using EVSYS = mega0_::hwd::EVSYS<cfg::EVSYS>;
+
+// Timers
+    using TCA0 = mega0_::hwd::TCA<cfg::TCA0>;
+
+    using TCB0 = mega0_::hwd::TCB<cfg::TCB0>;
+    using TCB1 = mega0_::hwd::TCB<cfg::TCB1>;
+    using TCB2 = mega0_::hwd::TCB<cfg::TCB2>;
+    using TCB3 = mega0_::hwd::TCB<cfg::TCB3>;
+
 } // hwd
 
 // Drivers
@@ -95,6 +119,30 @@ namespace hwd{
     using SPI_master = mega0_::hal::SPI_master<cfg::SPI0, Cfg>;
 
     using SPI_master_cfg = mega0_::hal::SPI_master_cfg;
+
+// TCA
+    using Time_counterA0 = mega0_::hal::Time_counterA<cfg::TCA0>;
+    using SWG_TCA0	 = mega0_::hal::SWG_TCA<cfg::TCA0, cfg::pins>;
+    using PWM_TCA0_split = mega0_::hal::PWM_TCA_split<cfg::TCA0, cfg::pins>;
+
+// TCB
+    using Time_counterB0 = mega0_::hal::Time_counterB<cfg::TCB0>;
+    using Time_counterB1 = mega0_::hal::Time_counterB<cfg::TCB1>;
+    using Time_counterB2 = mega0_::hal::Time_counterB<cfg::TCB2>;
+    using Time_counterB3 = mega0_::hal::Time_counterB<cfg::TCB3>;
+
+    using PWM8_TCB0 = mega0_::hal::PWM8_TCB<cfg::TCB0, cfg::pins>;
+    using PWM8_TCB1 = mega0_::hal::PWM8_TCB<cfg::TCB1, cfg::pins>;
+    using PWM8_TCB2 = mega0_::hal::PWM8_TCB<cfg::TCB2, cfg::pins>;
+
+    template <uint16_t clock_divisor = 1>
+    using Capture_TCB0 = mega0_::hal::Capture_TCB<cfg::TCB0, clock_divisor>;
+    template <uint16_t clock_divisor = 1>
+    using Capture_TCB1 = mega0_::hal::Capture_TCB<cfg::TCB1, clock_divisor>;
+    template <uint16_t clock_divisor = 1>
+    using Capture_TCB2 = mega0_::hal::Capture_TCB<cfg::TCB2, clock_divisor>;
+    template <uint16_t clock_divisor = 1>
+    using Capture_TCB3 = mega0_::hal::Capture_TCB<cfg::TCB3, clock_divisor>;
 }
 
 // La única diferencia entre estos dos namespace son los pines y la función
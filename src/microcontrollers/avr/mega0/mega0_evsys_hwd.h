@@ -0,0 +1,259 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __MEGA0_EVSYS_HWD_H__
+#define __MEGA0_EVSYS_HWD_H__
+/****************************************************************************
+ *
+ * DESCRIPCION
+ *	Traductor del Event System (EVSYS)
+ *
+ *	El EVSYS conecta periféricos sin pasar por la CPU: un generador (un
+ *	pin, el overflow de un timer, el ADC...) se conecta a un canal y el
+ *	canal a uno o varios usuarios (TCB, ADC, TCA, pin EVOUT...).
+ *
+ *	    generador ---> CHANNELn ---> USERxxx (1 o más)
+ *
+ *	Todo se elige en tiempo de compilación: si el generador no se puede
+ *	conectar a ese canal, error de compilación.
+ *
+ *	Ejemplo: medir con el TCB0 la señal que llega al pin 9 (PD0):
+ *	    EVSYS::channel_from_pin<2, 9>();	// PD0 solo en canales 2 y 3
+ *	    EVSYS::connect<2, cfg::evsys_user::TCB0>();
+ *
+ * HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <cstdint>
+
+namespace mega0_{
+namespace hwd{
+
+template <typename Registers>
+class EVSYS{
+public:
+// syntactic sugar
+    using Reg = Registers;
+
+    static auto reg() { return Reg::reg(); }
+    using value = Reg::value;
+    using pins	= Reg::pins;
+
+    static constexpr uint8_t nchannels = Reg::nchannels;
+
+// Constructor
+    EVSYS() = delete;
+
+// CHANNELn: generadores
+    template <uint8_t channel>
+    static void channel_off()
+    { channel_generator<channel>(value::GENERATOR_OFF); }
+
+    /// El pin genera un evento (nivel del pin) en channel.
+    /// Solo los canales 0 a 5 y solo ciertos pines en cada canal.
+    template <uint8_t channel, uint8_t pin>
+    static void channel_from_pin()
+    { channel_generator<channel>(pin_generator<channel, pin>()); }
+
+    /// Overflow del TCA0 (underflow del contador low en split mode)
+    template <uint8_t channel>
+    static void channel_from_TCA0_overflow()
+    { channel_generator<channel>(value::GENERATOR_TCA0_OVF_LUNF); }
+
+    template <uint8_t channel, uint8_t n>
+    static void channel_from_TCA0_compare();
+
+    template <uint8_t channel, uint8_t n>
+    static void channel_from_TCB_capture();
+
+    template <uint8_t channel>
+    static void channel_from_ADC0_result_ready()
+    { channel_generator<channel>(value::GENERATOR_ADC0_RESRDY); }
+
+    template <uint8_t channel>
+    static void channel_from_AC0()
+    { channel_generator<channel>(value::GENERATOR_AC0_OUT); }
+
+    template <uint8_t channel>
+    static void channel_from_RTC_overflow()
+    { channel_generator<channel>(value::GENERATOR_RTC_OVF); }
+
+    /// Cualquier generador (GENERATOR_xxx)
+    template <uint8_t channel>
+    static void channel_generator(uint8_t generator);
+
+    template <uint8_t channel>
+    static uint8_t channel_generator();
+
+// USERxxx: usuarios
+    // User = cfg::evsys_user::xxx
+    /// El usuario recibe los eventos del canal channel.
+    template <uint8_t channel, typename User>
+    static void connect();
+
+    template <typename User>
+    static void disconnect() {*User::reg() = value::CHANNEL_OFF;}
+
+    template <typename User>
+    static bool is_connected() {return *User::reg() != value::CHANNEL_OFF;}
+
+    template <uint8_t channel, typename User>
+    static bool is_connected()
+    {return *User::reg() == channel_value<channel>();}
+
+// STROBE
+    /// Genera un evento por software en channel.
+    template <uint8_t channel>
+    static void software_event();
+
+// Info
+    /// Generador correspondiente al pin en ese canal.
+    template <uint8_t channel, uint8_t pin>
+    static constexpr uint8_t pin_generator();
+
+private:
+    template <uint8_t channel>
+    static constexpr void check_channel()
+    { static_assert(channel < nchannels, "Wrong EVSYS channel"); }
+
+    template <uint8_t channel>
+    static constexpr uint8_t channel_value()
+    {
+	check_channel<channel>();
+	return value::CHANNEL0 + channel;
+    }
+
+    template <uint8_t channel>
+    static volatile uint8_t* channel_register();
+
+    static constexpr uint8_t bit_of(uint8_t bitmask)
+    {
+	uint8_t i = 0;
+	while (bitmask >>= 1)
+	    ++i;
+
+	return i;
+    }
+};
+
+
+template <typename R>
+    template <uint8_t channel>
+inline volatile uint8_t* EVSYS<R>::channel_register()
+{
+    check_channel<channel>();
+
+    if constexpr (channel == 0) return &reg()->CHANNEL0;
+    else if constexpr (channel == 1) return &reg()->CHANNEL1;
+    else if constexpr (channel == 2) return &reg()->CHANNEL2;
+    else if constexpr (channel == 3) return &reg()->CHANNEL3;
+    else if constexpr (channel == 4) return &reg()->CHANNEL4;
+    else if constexpr (channel == 5) return &reg()->CHANNEL5;
+    else if constexpr (channel == 6) return &reg()->CHANNEL6;
+    else return &reg()->CHANNEL7;
+}
+
+template <typename R>
+    template <uint8_t channel>
+inline void EVSYS<R>::channel_generator(uint8_t generator)
+{ *channel_register<channel>() = generator; }
+
+template <typename R>
+    template <uint8_t channel>
+inline uint8_t EVSYS<R>::channel_generator()
+{ return *channel_register<channel>(); }
+
+
+template <typename R>
+    template <uint8_t channel, uint8_t pin>
+inline constexpr uint8_t EVSYS<R>::pin_generator()
+{
+    check_channel<channel>();
+
+    constexpr int8_t port =
+		Reg::port_of_channel(channel, pins::template port_name<pin>());
+
+    static_assert(port != -1,
+		"This pin can't be connected to that EVSYS channel. "
+		"Try: PORTA, PORTB = channel 0 or 1; PORTC, PORTD = 2 or 3; "
+		"PORTE, PORTF = 4 or 5");
+
+    constexpr uint8_t port0 = (port == 0? value::GENERATOR_PORT0_PIN0
+					 : value::GENERATOR_PORT1_PIN0);
+
+    return port0 + bit_of(pins::template bitmask<pin>());
+}
+
+
+template <typename R>
+    template <uint8_t channel, uint8_t n>
+inline void EVSYS<R>::channel_from_TCA0_compare()
+{
+    static_assert(n < 3, "Wrong compare channel (0, 1 or 2)");
+
+    if constexpr (n == 0)
+	channel_generator<channel>(value::GENERATOR_TCA0_CMP0);
+    else if constexpr (n == 1)
+	channel_generator<channel>(value::GENERATOR_TCA0_CMP1);
+    else
+	channel_generator<channel>(value::GENERATOR_TCA0_CMP2);
+}
+
+template <typename R>
+    template <uint8_t channel, uint8_t n>
+inline void EVSYS<R>::channel_from_TCB_capture()
+{
+    static_assert(n < 4, "Wrong TCB (0 to 3)");
+
+    if constexpr (n == 0)
+	channel_generator<channel>(value::GENERATOR_TCB0_CAPT);
+    else if constexpr (n == 1)
+	channel_generator<channel>(value::GENERATOR_TCB1_CAPT);
+    else if constexpr (n == 2)
+	channel_generator<channel>(value::GENERATOR_TCB2_CAPT);
+    else
+	channel_generator<channel>(value::GENERATOR_TCB3_CAPT);
+}
+
+
+template <typename R>
+    template <uint8_t channel, typename User>
+inline void EVSYS<R>::connect()
+{ *User::reg() = channel_value<channel>(); }
+
+
+// (RRR) Escribir un 0 en el resto de bits no tiene efecto: no es necesario
+//       hacer read-modify-write.
+template <typename R>
+    template <uint8_t channel>
+inline void EVSYS<R>::software_event()
+{
+    check_channel<channel>();
+    reg()->STROBE = (1 << channel);
+}
+
+
+}// namespace hwd
+}// namespace mega0_
+
+#endif
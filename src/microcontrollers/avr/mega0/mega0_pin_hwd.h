@@ -30,6 +30,7 @@
  * HISTORIA
  *    Manuel Perez
  *    19/10/2024 Escrito
+ *    18/10/2026 Pin_group
  *
  ****************************************************************************/
 #include <mcu_pin.h>
@@ -206,6 +207,122 @@ inline void Pin<n, C>::write(uint8_t x)
 template <uint8_t n, typename Cfg>
 using Pin = mcu::Pin<private_::Pin<n, Cfg>>::type;
 
+
+/***************************************************************************
+ *				PIN_GROUP
+ ***************************************************************************/
+// Escribe a la vez varios pines: el bit i del valor va al pin pins[i].
+// Ejemplo:
+//	using Leds = Pin_group<Cfg, 33, 34, 35, 36, 9, 10, 11, 12>;
+//	Leds::as_output();
+//	Leds::write(0b10111101);
+//
+// Hace una única escritura por puerto: todos los pines del grupo de un
+// mismo puerto cambian a la vez. Cómo repartir los bits entre los puertos
+// se calcula en tiempo de compilación (ver mcu::Pin_group_layout).
+//
+// (RRR) ¿Por qué OUTTGL = (OUT ^ bits) & mask?
+//       Con OUTSET seguido de OUTCLR los pines que pasan a 1 lo hacen
+//       antes que los que pasan a 0, y durante un ciclo el puerto tiene un
+//       valor que no es ni el anterior ni el nuevo (un glitch en un bus
+//       paralelo). Con OUTTGL cambian todos en la misma escritura y solo
+//       los pines de mask: el resto del puerto no se toca aunque una
+//       interrupción lo modifique entre la lectura de OUT y la escritura.
+//
+// Precondición: todos los pines son válidos y distintos. Como mucho 8.
+template <typename Cfg, uint8_t... pins>
+class Pin_group{
+public:
+// Cfg
+    static constexpr uint8_t size = sizeof...(pins);
+
+// Constructor
+    Pin_group() = delete;
+
+// Configuración
+    static void as_output();
+
+// Escritura
+    static void write(uint8_t x) __attribute__((always_inline));
+
+private:
+    // Posición del único bit a 1 de mask
+    static constexpr uint8_t bit_of(uint8_t mask)
+    {
+	uint8_t i = 0;
+	while (mask >>= 1)
+	    ++i;
+
+	return i;
+    }
+
+    static constexpr uint8_t port_id_[] = {
+		static_cast<uint8_t>(Cfg::template port_name<pins>())...};
+
+    static constexpr uint8_t pin_bit_[] = {
+		bit_of(Cfg::template bitmask<pins>())...};
+
+    static constexpr uint8_t pin_number_[] = {pins...};
+
+    static constexpr mcu::Pin_group_layout<size> layout{port_id_, pin_bit_};
+
+    // Número del pin del grupo que pertenece al puerto np (para llegar a
+    // PORTx a través de Cfg)
+    template <uint8_t np>
+    static constexpr uint8_t pin_of_port() 
+    { return pin_number_[layout.port[np].pin]; }
+
+    template <uint8_t np>
+    static void as_output_port();
+
+    template <uint8_t np>
+    static void write_port(uint8_t x) __attribute__((always_inline));
+};
+
+
+template <typename Cfg, uint8_t... pins>
+    template <uint8_t np>
+inline void Pin_group<Cfg, pins...>::as_output_port()
+{
+    if constexpr (np < layout.nports){
+	constexpr uint8_t n = pin_of_port<np>();
+	Cfg::template PORT<n>()->DIRSET = layout.port[np].mask;
+
+	as_output_port<np + 1>();
+    }
+}
+
+template <typename Cfg, uint8_t... pins>
+inline void Pin_group<Cfg, pins...>::as_output()
+{ as_output_port<0>(); }
+
+
+template <typename Cfg, uint8_t... pins>
+inline void Pin_group<Cfg, pins...>::write(uint8_t x)
+{ write_port<0>(x); }
+
+template <typename Cfg, uint8_t... pins>
+    template <uint8_t np>
+inline void Pin_group<Cfg, pins...>::write_port(uint8_t x)
+{
+    if constexpr (np < layout.nports){
+	constexpr uint8_t n    = pin_of_port<np>();
+	constexpr uint8_t mask = layout.port[np].mask;
+
+	uint8_t bits = mcu::pin_group_port_value<layout, np>(x);
+
+	if constexpr (mask == 0xFF)
+	    Cfg::template PORT<n>()->OUT = bits;
+
+	else {
+	    auto port = Cfg::template PORT<n>();
+	    port->OUTTGL = static_cast<uint8_t>((port->OUT ^ bits) & mask);
+	}
+
+	write_port<np + 1>(x);
+    }
+}
+
 } // namespace
 }// namespace mega0_
 
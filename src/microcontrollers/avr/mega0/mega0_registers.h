@@ -42,6 +42,9 @@
  *               ¡Este fichero contiene informacion sobre los registros de la
  *               familia mega0!!! En lugar de llamarlo "mega0_cfg.h" mejor
  *               "mega0_registers.h" 
+ *    18/10/2026 pins::port_name
+ *    18/10/2026 TCA0, TCB0-TCB3
+ *    18/10/2026 EVSYS
  *
  ****************************************************************************/
 
@@ -179,6 +182,151 @@ struct SPI_values{
     static constexpr uint8_t MODE_3 = SPI_MODE_3_gc;
 };
 
+// TCA
+// ---
+// Posición de los bits en los registros (normal mode = SINGLE)
+struct TCA_bits{
+// CTRLA
+    static constexpr uint8_t ENABLE = TCA_SINGLE_ENABLE_bp;
+
+// CTRLB
+    static constexpr uint8_t CMP0EN = TCA_SINGLE_CMP0EN_bp;
+    static constexpr uint8_t CMP1EN = TCA_SINGLE_CMP1EN_bp;
+    static constexpr uint8_t CMP2EN = TCA_SINGLE_CMP2EN_bp;
+
+// CTRLD
+    static constexpr uint8_t SPLITM = TCA_SINGLE_SPLITM_bp;
+
+// EVCTRL
+    static constexpr uint8_t CNTEI = TCA_SINGLE_CNTEI_bp;
+
+// INTCTRL/INTFLAGS
+    static constexpr uint8_t OVF  = TCA_SINGLE_OVF_bp;
+    static constexpr uint8_t CMP0 = TCA_SINGLE_CMP0_bp;
+    static constexpr uint8_t CMP1 = TCA_SINGLE_CMP1_bp;
+    static constexpr uint8_t CMP2 = TCA_SINGLE_CMP2_bp;
+
+// Split mode
+// CTRLB
+    static constexpr uint8_t LCMP0EN = TCA_SPLIT_LCMP0EN_bp;
+    static constexpr uint8_t LCMP1EN = TCA_SPLIT_LCMP1EN_bp;
+    static constexpr uint8_t LCMP2EN = TCA_SPLIT_LCMP2EN_bp;
+    static constexpr uint8_t HCMP0EN = TCA_SPLIT_HCMP0EN_bp;
+    static constexpr uint8_t HCMP1EN = TCA_SPLIT_HCMP1EN_bp;
+    static constexpr uint8_t HCMP2EN = TCA_SPLIT_HCMP2EN_bp;
+
+// INTCTRL/INTFLAGS
+    static constexpr uint8_t LUNF = TCA_SPLIT_LUNF_bp;
+    static constexpr uint8_t HUNF = TCA_SPLIT_HUNF_bp;
+};
+
+struct TCA_values{
+    // Clock select (iguales en SINGLE y SPLIT)
+    static constexpr uint8_t CLKSEL_mask    = TCA_SINGLE_CLKSEL_gm;
+    static constexpr uint8_t CLKSEL_DIV1    = TCA_SINGLE_CLKSEL_DIV1_gc;
+    static constexpr uint8_t CLKSEL_DIV2    = TCA_SINGLE_CLKSEL_DIV2_gc;
+    static constexpr uint8_t CLKSEL_DIV4    = TCA_SINGLE_CLKSEL_DIV4_gc;
+    static constexpr uint8_t CLKSEL_DIV8    = TCA_SINGLE_CLKSEL_DIV8_gc;
+    static constexpr uint8_t CLKSEL_DIV16   = TCA_SINGLE_CLKSEL_DIV16_gc;
+    static constexpr uint8_t CLKSEL_DIV64   = TCA_SINGLE_CLKSEL_DIV64_gc;
+    static constexpr uint8_t CLKSEL_DIV256  = TCA_SINGLE_CLKSEL_DIV256_gc;
+    static constexpr uint8_t CLKSEL_DIV1024 = TCA_SINGLE_CLKSEL_DIV1024_gc;
+
+    // Waveform generation mode
+    static constexpr uint8_t WGMODE_mask	= TCA_SINGLE_WGMODE_gm;
+    static constexpr uint8_t WGMODE_NORMAL	= TCA_SINGLE_WGMODE_NORMAL_gc;
+    static constexpr uint8_t WGMODE_FRQ		= TCA_SINGLE_WGMODE_FRQ_gc;
+    static constexpr uint8_t WGMODE_SINGLESLOPE = TCA_SINGLE_WGMODE_SINGLESLOPE_gc;
+    static constexpr uint8_t WGMODE_DSTOP	= TCA_SINGLE_WGMODE_DSTOP_gc;
+    static constexpr uint8_t WGMODE_DSBOTH	= TCA_SINGLE_WGMODE_DSBOTH_gc;
+    static constexpr uint8_t WGMODE_DSBOTTOM	= TCA_SINGLE_WGMODE_DSBOTTOM_gc;
+
+    // Commands
+    static constexpr uint8_t CMD_RESET = TCA_SINGLE_CMD_RESET_gc;
+
+    // Event action
+    static constexpr uint8_t EVACT_mask	    = TCA_SINGLE_EVACT_gm;
+    static constexpr uint8_t EVACT_POSEDGE  = TCA_SINGLE_EVACT_POSEDGE_gc;
+    static constexpr uint8_t EVACT_ANYEDGE  = TCA_SINGLE_EVACT_ANYEDGE_gc;
+    static constexpr uint8_t EVACT_HIGHLVL  = TCA_SINGLE_EVACT_HIGHLVL_gc;
+    static constexpr uint8_t EVACT_UPDOWN   = TCA_SINGLE_EVACT_UPDOWN_gc;
+};
+
+
+// TCB
+// ---
+struct TCB_bits{
+// CTRLA
+    static constexpr uint8_t ENABLE  = TCB_ENABLE_bp;
+    static constexpr uint8_t SYNCUPD = TCB_SYNCUPD_bp;
+    static constexpr uint8_t RUNSTDBY= TCB_RUNSTDBY_bp;
+
+// CTRLB
+    static constexpr uint8_t CCMPEN  = TCB_CCMPEN_bp;
+    static constexpr uint8_t CCMPINIT= TCB_CCMPINIT_bp;
+    static constexpr uint8_t ASYNC   = TCB_ASYNC_bp;
+
+// EVCTRL
+    static constexpr uint8_t CAPTEI = TCB_CAPTEI_bp;
+    static constexpr uint8_t EDGE   = TCB_EDGE_bp;
+    static constexpr uint8_t FILTER = TCB_FILTER_bp;
+
+// INTCTRL/INTFLAGS
+    static constexpr uint8_t CAPT = TCB_CAPT_bp;
+
+// STATUS
+    static constexpr uint8_t RUN = TCB_RUN_bp;
+};
+
+struct TCB_values{
+    // Clock select
+    static constexpr uint8_t CLKSEL_mask    = TCB_CLKSEL_gm;
+    static constexpr uint8_t CLKSEL_CLKDIV1 = TCB_CLKSEL_CLKDIV1_gc;
+    static constexpr uint8_t CLKSEL_CLKDIV2 = TCB_CLKSEL_CLKDIV2_gc;
+    static constexpr uint8_t CLKSEL_CLKTCA  = TCB_CLKSEL_CLKTCA_gc;
+
+    // Count mode
+    static constexpr uint8_t CNTMODE_mask   = TCB_CNTMODE_gm;
+    static constexpr uint8_t CNTMODE_INT    = TCB_CNTMODE_INT_gc;
+    static constexpr uint8_t CNTMODE_TIMEOUT= TCB_CNTMODE_TIMEOUT_gc;
+    static constexpr uint8_t CNTMODE_CAPT   = TCB_CNTMODE_CAPT_gc;
+    static constexpr uint8_t CNTMODE_FRQ    = TCB_CNTMODE_FRQ_gc;
+    static constexpr uint8_t CNTMODE_PW     = TCB_CNTMODE_PW_gc;
+    static constexpr uint8_t CNTMODE_FRQPW  = TCB_CNTMODE_FRQPW_gc;
+    static constexpr uint8_t CNTMODE_SINGLE = TCB_CNTMODE_SINGLE_gc;
+    static constexpr uint8_t CNTMODE_PWM8   = TCB_CNTMODE_PWM8_gc;
+};
+
+// EVSYS
+// -----
+struct EVSYS_values{
+// Generadores (CHANNELn)
+    static constexpr uint8_t GENERATOR_OFF	= EVSYS_GENERATOR_OFF_gc;
+    static constexpr uint8_t GENERATOR_RTC_OVF	= EVSYS_GENERATOR_RTC_OVF_gc;
+    static constexpr uint8_t GENERATOR_RTC_CMP	= EVSYS_GENERATOR_RTC_CMP_gc;
+    static constexpr uint8_t GENERATOR_AC0_OUT	= EVSYS_GENERATOR_AC0_OUT_gc;
+    static constexpr uint8_t GENERATOR_ADC0_RESRDY = EVSYS_GENERATOR_ADC0_RESRDY_gc;
+
+    // PORT0 y PORT1 dependen del canal (ver EVSYS::pin_generator)
+    static constexpr uint8_t GENERATOR_PORT0_PIN0 = EVSYS_GENERATOR_PORT0_PIN0_gc;
+    static constexpr uint8_t GENERATOR_PORT1_PIN0 = EVSYS_GENERATOR_PORT1_PIN0_gc;
+
+    static constexpr uint8_t GENERATOR_TCA0_OVF_LUNF= EVSYS_GENERATOR_TCA0_OVF_LUNF_gc;
+    static constexpr uint8_t GENERATOR_TCA0_HUNF    = EVSYS_GENERATOR_TCA0_HUNF_gc;
+    static constexpr uint8_t GENERATOR_TCA0_CMP0    = EVSYS_GENERATOR_TCA0_CMP0_gc;
+    static constexpr uint8_t GENERATOR_TCA0_CMP1    = EVSYS_GENERATOR_TCA0_CMP1_gc;
+    static constexpr uint8_t GENERATOR_TCA0_CMP2    = EVSYS_GENERATOR_TCA0_CMP2_gc;
+
+    static constexpr uint8_t GENERATOR_TCB0_CAPT = EVSYS_GENERATOR_TCB0_CAPT_gc;
+    static constexpr uint8_t GENERATOR_TCB1_CAPT = EVSYS_GENERATOR_TCB1_CAPT_gc;
+    static constexpr uint8_t GENERATOR_TCB2_CAPT = EVSYS_GENERATOR_TCB2_CAPT_gc;
+    static constexpr uint8_t GENERATOR_TCB3_CAPT = EVSYS_GENERATOR_TCB3_CAPT_gc;
+
+// Usuarios (USERxxx)
+    static constexpr uint8_t CHANNEL_OFF = EVSYS_CHANNEL_OFF_gc;
+    static constexpr uint8_t CHANNEL0	 = EVSYS_CHANNEL_CHANNEL0_gc;// CHANNELn = CHANNEL0 + n
+};
+
 }// private_
 } // namespace cfg
   
@@ -337,6 +485,21 @@ auto bitmask()
     if constexpr (n == 40) return PIN7_bm;
 }
 
+// Nombre del puerto al que pertenece el pin. Sirve para saber, en tiempo
+// de compilación, si dos pines están en el mismo puerto.
+template <uint8_t n>
+static constexpr 
+char port_name()
+{
+    static_assert(is_a_valid_pin<n>(), "Wrong pin number");
+
+    if constexpr (n <= 8) return 'C';
+    if constexpr (9 <= n and n <= 16) return 'D';
+    if constexpr (19 <= n and n <= 22) return 'E';
+    if constexpr (23 <= n and n <= 29) return 'F';
+    if constexpr (33 <= n) return 'A';
+}
+
 template <uint8_t n>
 static constexpr 
 auto pin_ctrl()
@@ -506,6 +669,172 @@ struct SPI0 {
 
 
 
+/***************************************************************************
+ *				EVSYS
+ ***************************************************************************/
+inline auto evsys_registers() { return &EVSYS; }
+#undef EVSYS
+
+struct EVSYS {
+    // reg = registers
+    static auto reg() {return evsys_registers();}
+
+    // valores
+    using value = cfg::private_::EVSYS_values;
+
+    // pines que pueden ser generadores
+    using pins = cfg_40_pins::pins;
+
+    static constexpr uint8_t nchannels = 8;
+
+    // (RRR) Cada canal solo puede usar como generadores los pines de dos
+    //       puertos (PORT0 y PORT1 en la datasheet):
+    //		    CHANNEL0, 1 : PORTA, PORTB
+    //		    CHANNEL2, 3 : PORTC, PORTD
+    //		    CHANNEL4, 5 : PORTE, PORTF
+    //	     Los canales 6 y 7 no los usamos con pines.
+    //	     Devuelve la posición del puerto: 0 = PORT0, 1 = PORT1, o -1 si
+    //	     el canal no puede usar ese puerto.
+    static constexpr int8_t port_of_channel(uint8_t channel, char port)
+    {
+	if (channel >= 6)
+	    return -1;
+
+	uint8_t i = static_cast<uint8_t>(port - 'A');
+	if (i / 2 != channel / 2)
+	    return -1;
+
+	return static_cast<int8_t>(i % 2);
+    }
+};
+
+// Usuarios del EVSYS: cada usuario es un registro USERxxx en el que se
+// escribe el canal del que lee los eventos.
+namespace evsys_user{
+struct ADC0 { static auto reg() {return &evsys_registers()->USERADC0;} };
+
+struct TCA0 { static auto reg() {return &evsys_registers()->USERTCA0;} };
+
+struct TCB0 { static auto reg() {return &evsys_registers()->USERTCB0;} };
+struct TCB1 { static auto reg() {return &evsys_registers()->USERTCB1;} };
+struct TCB2 { static auto reg() {return &evsys_registers()->USERTCB2;} };
+struct TCB3 { static auto reg() {return &evsys_registers()->USERTCB3;} };
+
+struct USART0 { static auto reg() {return &evsys_registers()->USERUSART0;} };
+struct USART1 { static auto reg() {return &evsys_registers()->USERUSART1;} };
+struct USART2 { static auto reg() {return &evsys_registers()->USERUSART2;} };
+
+// Sacan el evento por el pin 2 del puerto: EVOUTA = PA2, EVOUTC = PC2...
+struct EVOUTA { static auto reg() {return &evsys_registers()->USEREVOUTA;} };
+struct EVOUTC { static auto reg() {return &evsys_registers()->USEREVOUTC;} };
+struct EVOUTD { static auto reg() {return &evsys_registers()->USEREVOUTD;} };
+struct EVOUTE { static auto reg() {return &evsys_registers()->USEREVOUTE;} };
+struct EVOUTF { static auto reg() {return &evsys_registers()->USEREVOUTF;} };
+}// evsys_user
+
+
+
+/***************************************************************************
+ *				TCA
+ ***************************************************************************/
+// TCA0
+// ----
+inline auto tca0_registers() { return &TCA0; }
+#undef TCA0
+
+// TODO: PORTMUX.TCAROUTEA permite sacar WO0-WO5 por los puertos B, C, D, E
+// o F. De momento solo el puerto por defecto (PORTA).
+struct TCA0 {
+    // reg = registers
+    static auto reg() {return tca0_registers();}
+   
+    // posiciones de los bits dentro de los registros
+    using bit_pos = cfg::private_::TCA_bits;
+
+    // valores
+    using value = cfg::private_::TCA_values;
+
+    // event system
+    using evsys	     = EVSYS;
+    
+    // pines de salida (WO0-WO2 en normal mode; WO0-WO5 en split mode)
+    static constexpr uint8_t WO0_pin = 33;
+    static constexpr uint8_t WO1_pin = 34;
+    static constexpr uint8_t WO2_pin = 35;
+    static constexpr uint8_t WO3_pin = 36;
+    static constexpr uint8_t WO4_pin = 37;
+    static constexpr uint8_t WO5_pin = 38;
+};
+
+
+/***************************************************************************
+ *				TCB
+ ***************************************************************************/
+// TCB0
+// ----
+inline auto tcb0_registers() { return &TCB0; }
+#undef TCB0
+
+struct TCB0 {
+    static auto reg() {return tcb0_registers();}
+    using bit_pos = cfg::private_::TCB_bits;
+    using value = cfg::private_::TCB_values;
+
+    using evsys	     = EVSYS;
+    using evsys_user = cfg_40_pins::evsys_user::TCB0;
+
+    static constexpr uint8_t WO_pin = 35; // PA2
+};
+
+// TCB1
+// ----
+inline auto tcb1_registers() { return &TCB1; }
+#undef TCB1
+
+struct TCB1 {
+    static auto reg() {return tcb1_registers();}
+    using bit_pos = cfg::private_::TCB_bits;
+    using value = cfg::private_::TCB_values;
+
+    using evsys	     = EVSYS;
+    using evsys_user = cfg_40_pins::evsys_user::TCB1;
+
+    static constexpr uint8_t WO_pin = 36; // PA3
+};
+
+// TCB2
+// ----
+inline auto tcb2_registers() { return &TCB2; }
+#undef TCB2
+
+struct TCB2 {
+    static auto reg() {return tcb2_registers();}
+    using bit_pos = cfg::private_::TCB_bits;
+    using value = cfg::private_::TCB_values;
+
+    using evsys	     = EVSYS;
+    using evsys_user = cfg_40_pins::evsys_user::TCB2;
+
+    static constexpr uint8_t WO_pin = 1; // PC0
+};
+
+// TCB3
+// ----
+// Su pin de salida por defecto (PB5) no existe en el de 40 pins. Se puede
+// usar como contador o para capturar (no necesita pin).
+inline auto tcb3_registers() { return &TCB3; }
+#undef TCB3
+
+struct TCB3 {
+    static auto reg() {return tcb3_registers();}
+    using bit_pos = cfg::private_::TCB_bits;
+    using value = cfg::private_::TCB_values;
+
+    using evsys	     = EVSYS;
+    using evsys_user = cfg_40_pins::evsys_user::TCB3;
+};
+
+
 /***************************************************************************
  *				INTERRUPTS
  ***************************************************************************/
@@ -571,6 +900,19 @@ struct SPI0 {
 #define ISR_data_register_empty(usart) ISR(usart ## _DRE_vect)
 #define ISR_receiver_start_frame(usart) ISR(usart ## _TXC_vect)
 
+// TCA: en split mode OVF es LUNF y CMPn es LCMPn
+#define ISR_TCA0_OVF	ISR(TCA0_OVF_vect)
+#define ISR_TCA0_HUNF	ISR(TCA0_HUNF_vect)
+#define ISR_TCA0_CMP0	ISR(TCA0_CMP0_vect)
+#define ISR_TCA0_CMP1	ISR(TCA0_CMP1_vect)
+#define ISR_TCA0_CMP2	ISR(TCA0_CMP2_vect)
+
+// TCB
+#define ISR_TCB0_INT	ISR(TCB0_INT_vect)
+#define ISR_TCB1_INT	ISR(TCB1_INT_vect)
+#define ISR_TCB2_INT	ISR(TCB2_INT_vect)
+#define ISR_TCB3_INT	ISR(TCB3_INT_vect)
+
 }// namespace cfg_40_pins
  
 }// namespace mega0_
@@ -32,6 +32,8 @@
  * HISTORIA
  *    Manuel Perez
  *    10/11/2024 Implementación mínima
+ *    18/10/2026 write/read/transfer/fill de bloques (mismo interfaz que
+ *		 mega)
  *
  ****************************************************************************/
 #include "mega0_spi_hwd.h"
@@ -39,6 +41,7 @@
 #include "mega0_pin_hwd.h"
 
 #include <atd_type_traits.h>	// always_false_v
+#include <span>
 
 namespace mega0_{
 
@@ -216,6 +219,14 @@ public:
     // Bloquea el micro: no devuelve el control hasta transmitir el byte.
     static uint8_t read(uint8_t x = transfer_value_);
 
+    // Bloques (mismo interfaz que mega::SPI_master)
+    // En buffer_mode se escribe el siguiente byte sin esperar a que acabe
+    // el anterior: el SPI envía los bytes seguidos, sin huecos.
+    static void write(std::span<const uint8_t> out);
+    static void read(std::span<uint8_t> in);
+    static void transfer(std::span<const uint8_t> out, std::span<uint8_t> in);
+    static void fill(uint8_t x, size_t n);
+
     static void wait_untill_transfer_is_complete();
 
 private:
@@ -232,6 +243,10 @@ private:
     static void wait_untill_write_is_complete();
     static void wait_untill_read_is_complete();
 
+    // Envía n bytes: los de out o, si out == nullptr, n veces x.
+    // Si in != nullptr guarda en él los bytes recibidos.
+    static void transfer_n(const uint8_t* out, uint8_t x, 
+						    uint8_t* in, size_t n);
 };
 
 // Será el usuario el que defina el selector de SPI, no usando SS. Por eso
@@ -346,6 +361,67 @@ template <typename R, typename C>
 inline uint8_t SPI_master<R, C>::read(uint8_t x)
 { return write(x); }
 
+template <typename R, typename C>
+inline void SPI_master<R, C>::write(std::span<const uint8_t> out)
+{ transfer_n(out.data(), 0, nullptr, out.size()); }
+
+template <typename R, typename C>
+inline void SPI_master<R, C>::read(std::span<uint8_t> in)
+{ transfer_n(nullptr, transfer_value_, in.data(), in.size()); }
+
+template <typename R, typename C>
+inline void SPI_master<R, C>::transfer(std::span<const uint8_t> out, 
+				std::span<uint8_t> in)
+{ transfer_n(out.data(), 0, in.data(), out.size()); }
+
+template <typename R, typename C>
+inline void SPI_master<R, C>::fill(uint8_t x, size_t n)
+{ transfer_n(nullptr, x, nullptr, n); }
+
+
+// (RRR) En buffer mode el SPI tiene un buffer de transmisión de 1 byte y
+//       uno de recepción de 2: mientras se envía un byte (shift register)
+//       se puede ir escribiendo el siguiente (DREIF). Como mucho dejamos 2
+//       bytes enviados sin leer (el del shift register y el del buffer de
+//       transmisión) para que nunca se llene el buffer de recepción
+//       (perderíamos bytes) aunque nos interrumpa una ISR.
+template <typename R, typename C>
+void SPI_master<R, C>::transfer_n(const uint8_t* out, uint8_t x, 
+						    uint8_t* in, size_t n)
+{
+    if constexpr (Cfg::mode == SPI_master_cfg::normal_mode){
+	for (size_t i = 0; i < n; ++i){
+	    uint8_t y = write(out? out[i]: x);
+	    if (in)
+		in[i] = y;
+	}
+    }
+
+    else if constexpr (Cfg::mode == SPI_master_cfg::buffer_mode){
+	size_t sent = 0;
+	size_t received = 0;
+
+	while (received < n){
+	    if (sent < n and sent - received < 2 and
+		SPI::is_data_register_empty_flag_set()){
+		SPI::data(out? out[sent]: x);
+		++sent;
+	    }
+
+	    if (SPI::is_receive_complete_flag_set()){
+		uint8_t y = SPI::data();
+		if (in)
+		    in[received] = y;
+		++received;
+	    }
+	}
+    }
+
+    else
+	static_assert(atd::always_false_v<R>, 
+			"Why did you call this function without init SPI?");
+}
+
 
 // TODO: añadirle un counter. Si supera más de x que devuelva el control, asi
 // evitamos que se quede colgado.
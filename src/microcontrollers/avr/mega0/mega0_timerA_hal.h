@@ -0,0 +1,563 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __MEGA0_TIMERA_HAL_H__
+#define __MEGA0_TIMERA_HAL_H__
+/****************************************************************************
+ *
+ * DESCRIPCION
+ *	Diferentes formas de usar el hwd::TCA (mismos usos que el Timer1 del
+ *	atmega328p, ver mega_timer1_hal.h):
+ *
+ *	(1) Time_counterA: medidor de tiempo. Es el Time_counter de
+ *	                   mcu::Clock_ms y, solo con algunos clk_per, de
+ *	                   mcu::Miniclock_us/ms (ver
+ *	                   turn_on_with_clock_period_of).
+ *	(2) SWG_TCA      : generador de onda cuadrada en WO0 (frequency
+ *	                   mode = CTC del atmega328p).
+ *	(3) PWM_TCA_split: 6 PWM de 8 bits (split mode).
+ *
+ *	Todas ellas calculan el prescaler en tiempo de compilación a partir de
+ *	clk_per(), con lo que funcionan a cualquier frecuencia (1, 3.33, 16,
+ *	20 MHz...) siempre que la señal pedida se pueda generar. Si no se
+ *	puede, error de compilación.
+ *
+ * HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *    18/10/2026 Time_counterA::overflow_event_to
+ *
+ ****************************************************************************/
+#include "mega0_timerA_hwd.h"
+#include "mega0_evsys_hwd.h"
+#include "mega0_pin_hwd.h"
+#include "mega0_clock_frequencies.h"
+#include "mega0_import_avr.h"	// Disable_interrupts
+
+#include <atd_type_traits.h>	// always_false_v
+
+namespace mega0_{
+namespace hal{
+
+namespace timerA_{
+
+// Posibles divisores del prescaler
+inline constexpr uint16_t prescalers[] = {1, 2, 4, 8, 16, 64, 256, 1024};
+
+// Devuelve el prescaler que hace que el periodo del reloj del timer sea
+// period_in_us. Si no existe devuelve 0.
+inline constexpr
+uint16_t prescaler_for_period_in_us(uint32_t period_in_us, uint32_t clk)
+{
+    uint64_t d = uint64_t{clk} * period_in_us;
+    if (d % 1'000'000 != 0)
+	return 0;
+
+    d /= 1'000'000;
+    for (uint16_t p : prescalers)
+	if (p == d)
+	    return p;
+
+    return 0;
+}
+
+// Devuelve el menor prescaler (= más resolución) con el que el timer
+// puede dar freq_in_hz desbordándose en top <= max_top.
+// Si exact == true la frecuencia tiene que ser exacta.
+// Si no existe devuelve 0.
+inline constexpr
+uint16_t prescaler_for_frequency(uint32_t freq_in_hz, uint32_t clk,
+				 uint32_t max_top, bool exact)
+{
+    for (uint16_t p : prescalers){
+	uint32_t den = uint32_t{p} * freq_in_hz;
+	uint32_t ticks = (clk + den / 2) / den; // = top + 1
+	if (ticks == 0)
+	    return 0;
+
+	if (ticks - 1 <= max_top and (!exact or clk % den == 0))
+	    return p;
+    }
+
+    return 0;
+}
+
+// top correspondiente al prescaler anterior
+inline constexpr
+uint32_t top_for_frequency(uint32_t freq_in_hz, uint32_t clk, uint16_t p)
+{
+    uint32_t den = uint32_t{p} * freq_in_hz;
+    return (clk + den / 2) / den - 1;
+}
+
+template <typename TCA, uint16_t prescaler>
+inline void clock_divide_by()
+{
+    if constexpr (prescaler == 1) TCA::clock_peripheral_divide_by_1();
+    else if constexpr (prescaler == 2) TCA::clock_peripheral_divide_by_2();
+    else if constexpr (prescaler == 4) TCA::clock_peripheral_divide_by_4();
+    else if constexpr (prescaler == 8) TCA::clock_peripheral_divide_by_8();
+    else if constexpr (prescaler == 16) TCA::clock_peripheral_divide_by_16();
+    else if constexpr (prescaler == 64) TCA::clock_peripheral_divide_by_64();
+    else if constexpr (prescaler == 256) TCA::clock_peripheral_divide_by_256();
+    else if constexpr (prescaler == 1024) TCA::clock_peripheral_divide_by_1024();
+    else
+	static_assert(atd::always_false_v<TCA>,
+			"Wrong TCA prescaler. "
+			"Valid ones: 1, 2, 4, 8, 16, 64, 256 or 1024.");
+}
+
+}// namespace timerA_
+
+
+/***************************************************************************
+ *			    Time_counterA
+ ***************************************************************************/
+// Mismo interfaz que Time_counter1 del atmega328p: se puede pasar a
+// mcu::Clock_ms. A mcu::Miniclock_us/ms solo si clk_per permite su
+// periodo exacto (ver turn_on_with_clock_period_of).
+//
+// Interrupción: ISR_TCA0_OVF. A diferencia del atmega328p, el flag NO se
+// borra automáticamente al ejecutar la ISR. El cliente tiene que llamar a
+// clear_top_interrupt_flag():
+//
+//	ISR_TCA0_OVF {
+//	    Time_counter::clear_top_interrupt_flag();
+//	    Clock_ms::tick();
+//	}
+template <typename Registers>
+class Time_counterA{
+public:
+// Tipo de tipo
+    static constexpr bool is_unsafe = true;
+
+// Types
+// -----
+    using Hwd	       = hwd::TCA<Registers>; // hardware que hay por debajo
+    using Timer        = Hwd;
+    using counter_type = typename Timer::counter_type;
+    using Disable_interrupts = mega0_::Disable_interrupts;
+
+// Initialization
+// --------------
+    Time_counterA() = delete;
+
+    /// Modo de funcionamiento: contador normal y corriente (0..top).
+    /// No lo enciende.
+    static void unsafe_init(counter_type top0 = max_top())
+    {
+	Timer::disable();
+	Timer::split_mode_disable();
+	Timer::normal_mode();
+	unsafe_reset();
+	unsafe_top(top0);
+    }
+
+    static void safe_init(counter_type top0 = max_top())
+    {
+	Disable_interrupts l;
+	unsafe_init(top0);
+    }
+
+    static void init(counter_type top0 = max_top()) { safe_init(top0); }
+
+// Interrupts
+// ----------
+    /// Se captura con ISR_TCA0_OVF
+    static void enable_top_interrupt() { Timer::enable_overflow_interrupt(); }
+    static void disable_top_interrupt() { Timer::disable_overflow_interrupt(); }
+
+    /// Llamarla dentro de ISR_TCA0_OVF.
+    static void clear_top_interrupt_flag() { Timer::clear_overflow_flag(); }
+
+// Events
+// ------
+    using EVSYS = hwd::EVSYS<typename Registers::evsys>;
+
+    /// Cada vez que el contador llega a top genera un evento en el canal
+    /// channel del EVSYS y lo conecta a los usuarios Users
+    /// (cfg::evsys_user::xxx). No necesita interrupción.
+    /// Ejemplo: muestrear el ADC periódicamente
+    ///	    overflow_event_to<0, cfg::evsys_user::ADC0>();
+    template <uint8_t channel, typename... Users>
+    static void overflow_event_to()
+    {
+	EVSYS::template channel_from_TCA0_overflow<channel>();
+	(EVSYS::template connect<channel, Users>(), ...);
+    }
+
+// Timer on/off
+// ------------
+    /// Enciende el contador con un tick cada period_in_us.
+    /// Solo se pueden elegir los periodos exactos que da el prescaler:
+    ///	    period_in_us = prescaler / clk_per (en MHz)
+    /// con prescaler = 1, 2, 4, 8, 16, 64, 256 ó 1024. Si no, no compila.
+    ///
+    /// Limitación: mcu::Miniclock_us (1 us) necesita clk_per = 1, 2, 4,
+    /// 8 ó 16 MHz (no compila a 3.33 ni a 20 MHz) y mcu::Miniclock_ms
+    /// (1024 us) solo funciona con clk_per = 1 MHz.
+    template<uint16_t period_in_us
+	    , uint32_t clock_frequency_in_hz = clk_per()>
+    struct turn_on_with_clock_period_of{
+	static void us()
+	{
+	    constexpr uint16_t prescaler =
+		timerA_::prescaler_for_period_in_us(period_in_us,
+						    clock_frequency_in_hz);
+
+	    static_assert(prescaler != 0,
+		    "TCA can't generate that period with this clk_per");
+
+	    timerA_::clock_divide_by<Timer, prescaler>();
+	    Timer::enable();
+	}
+    };
+
+    /// Enciende el contador generando una interrupción cada 1 ms.
+    /// Es la que usa mcu::Clock_ms.
+    /// Recordar que el cliente es responsable de llamar a
+    /// `enable_interrupts()` para que funcione.
+    template <uint32_t clock_frequency_in_hz = clk_per()>
+    static void turn_on_with_overflow_every_1ms();
+
+    /// Apagamos el contador
+    static void turn_off() { Timer::disable(); }
+
+
+// Value
+// -----
+    static counter_type unsafe_value() { return Timer::unsafe_counter(); }
+
+    static counter_type safe_value()
+    {
+	Disable_interrupts l;
+	return unsafe_value();
+    }
+
+    static counter_type value() {return safe_value();}
+
+    static void unsafe_reset() { Timer::unsafe_counter(0); }
+    static void safe_reset()
+    {
+	Disable_interrupts l;
+	unsafe_reset();
+    }
+    static void reset() {safe_reset();}
+
+// Top
+// ---
+    static void unsafe_top(counter_type top) { Timer::unsafe_period(top); }
+
+    static void safe_top(counter_type top)
+    {
+	Disable_interrupts l;
+	unsafe_top(top);
+    }
+
+    static void top(counter_type top0) {safe_top(top0);}
+
+    static counter_type unsafe_top() { return Timer::unsafe_period(); }
+
+    static counter_type safe_top()
+    {
+	Disable_interrupts l;
+	return unsafe_top();
+    }
+
+    static counter_type top() {return safe_top();}
+
+// Max top
+// -------
+    static constexpr counter_type max_top() { return 0xFFFF; }
+};
+
+
+// (RRR) ¿Por qué exigir que sea exacto?
+//       Clock_ms cuenta ms: un error del 0.1% son casi 1.5 minutos al día.
+template <typename R>
+    template <uint32_t clk>
+inline void Time_counterA<R>::turn_on_with_overflow_every_1ms()
+{
+    constexpr uint16_t prescaler =
+		timerA_::prescaler_for_frequency(1000, clk, max_top(), true);
+
+    static_assert(prescaler != 0,
+		    "TCA can't generate an exact 1 ms with this clk_per");
+
+    constexpr counter_type top0 =
+		    timerA_::top_for_frequency(1000, clk, prescaler);
+
+    init(top0);
+    timerA_::clock_divide_by<Timer, prescaler>();
+    enable_top_interrupt();
+    Timer::enable();
+}
+
+
+
+/***************************************************************************
+ *				SWG_TCA
+ ***************************************************************************/
+// Genera una onda cuadrada en WO0 usando el frequency mode del TCA:
+//	freq = clk_per / (2 * prescaler * (CMP0 + 1))
+//
+// Cfg_pins = configuración de los pines del micro (cfg_40_pins::pins)
+template <typename Registers, typename Cfg_pins>
+class SWG_TCA{
+public:
+    using Hwd	       = hwd::TCA<Registers>;
+    using Timer        = Hwd;
+    using counter_type = typename Timer::counter_type;
+    using Disable_interrupts = mega0_::Disable_interrupts;
+    using Pin	       = hwd::Pin<Timer::WO0_pin, Cfg_pins>;
+
+    static constexpr uint8_t number = Timer::WO0_pin;
+
+    SWG_TCA() = delete;
+
+    /// Genera una onda cuadrada de frecuencia (aproximada)
+    /// frequency_in_hz. Enciende el timer.
+    template <uint32_t frequency_in_hz, uint32_t clk = clk_per()>
+    static void generate();
+
+    /// Frecuencia que realmente se genera con generate<frequency_in_hz>
+    template <uint32_t frequency_in_hz, uint32_t clk = clk_per()>
+    static constexpr uint32_t frequency();
+
+    /// Para el timer y desconecta el pin (lo deja a 0).
+    static void stop();
+
+private:
+    template <uint32_t frequency_in_hz, uint32_t clk>
+    static constexpr uint16_t prescaler()
+    {
+	constexpr uint16_t p = timerA_::prescaler_for_frequency(
+			    2 * frequency_in_hz, clk, 0xFFFF, false);
+
+	static_assert(p != 0, "Frequency out of range");
+	return p;
+    }
+};
+
+template <typename R, typename C>
+    template <uint32_t freq, uint32_t clk>
+inline constexpr uint32_t SWG_TCA<R, C>::frequency()
+{
+    constexpr uint16_t p = prescaler<freq, clk>();
+    constexpr uint32_t top = timerA_::top_for_frequency(2 * freq, clk, p);
+
+    return clk / (2 * p * (top + 1));
+}
+
+template <typename R, typename C>
+    template <uint32_t freq, uint32_t clk>
+void SWG_TCA<R, C>::generate()
+{
+    constexpr uint16_t p = prescaler<freq, clk>();
+    constexpr counter_type top = timerA_::top_for_frequency(2 * freq, clk, p);
+
+    Timer::disable();
+    Timer::split_mode_disable();
+    Timer::frequency_mode();
+
+    {
+	Disable_interrupts l;
+	Timer::unsafe_counter(0);
+	Timer::template unsafe_compare_register<0>(top);
+    }
+
+    Pin::as_output();
+    Timer::template compare_output_enable<0>();
+
+    timerA_::clock_divide_by<Timer, p>();
+    Timer::enable();
+}
+
+template <typename R, typename C>
+void SWG_TCA<R, C>::stop()
+{
+    Timer::disable();
+    Timer::template compare_output_disable<0>();
+    Pin::write_zero();
+}
+
+
+
+/***************************************************************************
+ *			    PWM_TCA_split
+ ***************************************************************************/
+// 6 señales PWM de 8 bits, todas de la misma frecuencia, en los pines
+// WO0-WO5. En split mode el TCA son dos timers de 8 bits (L = WO0-2,
+// H = WO3-5) que cuentan hacia abajo; los configuramos con el mismo
+// periodo.
+//
+//	freq = clk_per / (prescaler * (top + 1))
+//	duty = compare / (top + 1)
+//
+// Ejemplo:
+//	using PWM = PWM_TCA_split<cfg::TCA0, cfg::pins>;
+//	PWM::init();
+//	PWM::turn_on<1000>();	    // 1 kHz
+//	PWM::connect<2>();	    // WO2
+//	PWM::duty_cycle<2>(25);	    // 25%
+template <typename Registers, typename Cfg_pins>
+class PWM_TCA_split{
+public:
+    using Hwd	       = hwd::TCA<Registers>;
+    using Timer        = Hwd;
+
+    static constexpr uint8_t nchannels = 6;
+
+    PWM_TCA_split() = delete;
+
+    /// Configura el TCA en split mode. No lo enciende.
+    static void init();
+
+    /// Enciende el timer generando PWM de frecuencia (aproximada)
+    /// frequency_in_hz.
+    template <uint32_t frequency_in_hz, uint32_t clk = clk_per()>
+    static void turn_on();
+
+    /// Frecuencia que realmente se genera con turn_on<frequency_in_hz>
+    template <uint32_t frequency_in_hz, uint32_t clk = clk_per()>
+    static constexpr uint32_t frequency();
+
+    static void turn_off() { Timer::disable(); }
+
+    /// Conecta el canal ch (0..5) al pin WOch.
+    template <uint8_t ch>
+    static void connect();
+
+    /// Desconecta el canal dejando el pin a 0.
+    template <uint8_t ch>
+    static void disconnect();
+
+    /// Duty cycle en tanto por cien [0, 100]
+    template <uint8_t ch>
+    static void duty_cycle(uint8_t percentage);
+
+    /// Valor del comparador: duty = compare / (top + 1)
+    template <uint8_t ch>
+    static void compare(uint8_t x)
+    { Timer::template split_compare_register<ch>(x); }
+
+    static uint8_t top() { return Timer::split_low_period(); }
+
+private:
+    template <uint8_t ch>
+    static constexpr uint8_t pin_number()
+    {
+	static_assert(ch < nchannels, "Wrong PWM channel (0 to 5)");
+
+	if constexpr (ch == 0) return Timer::WO0_pin;
+	else if constexpr (ch == 1) return Timer::WO1_pin;
+	else if constexpr (ch == 2) return Timer::WO2_pin;
+	else if constexpr (ch == 3) return Timer::WO3_pin;
+	else if constexpr (ch == 4) return Timer::WO4_pin;
+	else return Timer::WO5_pin;
+    }
+
+    template <uint8_t ch>
+    using Pin = hwd::Pin<pin_number<ch>(), Cfg_pins>;
+
+    template <uint32_t frequency_in_hz, uint32_t clk>
+    static constexpr uint16_t prescaler()
+    {
+	constexpr uint16_t p = timerA_::prescaler_for_frequency(
+				    frequency_in_hz, clk, 0xFF, false);
+
+	static_assert(p != 0, "PWM frequency out of range");
+	return p;
+    }
+};
+
+
+// (RRR) Datasheet 20.3.3.6: para pasar a split mode hay que tener el TCA
+//       deshabilitado y conviene hacer un RESET antes.
+template <typename R, typename C>
+void PWM_TCA_split<R, C>::init()
+{
+    Timer::disable();
+    Timer::reset();
+    Timer::split_mode_enable();
+}
+
+template <typename R, typename C>
+    template <uint32_t freq, uint32_t clk>
+inline constexpr uint32_t PWM_TCA_split<R, C>::frequency()
+{
+    constexpr uint16_t p = prescaler<freq, clk>();
+    constexpr uint32_t top = timerA_::top_for_frequency(freq, clk, p);
+
+    return clk / (p * (top + 1));
+}
+
+template <typename R, typename C>
+    template <uint32_t freq, uint32_t clk>
+void PWM_TCA_split<R, C>::turn_on()
+{
+    constexpr uint16_t p = prescaler<freq, clk>();
+    constexpr uint8_t top =
+		static_cast<uint8_t>(timerA_::top_for_frequency(freq, clk, p));
+
+    Timer::split_low_period(top);
+    Timer::split_high_period(top);
+    Timer::split_counters(0);
+
+    timerA_::clock_divide_by<Timer, p>();
+    Timer::enable();
+}
+
+template <typename R, typename C>
+    template <uint8_t ch>
+inline void PWM_TCA_split<R, C>::connect()
+{
+    Pin<ch>::as_output();
+    Timer::template split_compare_output_enable<ch>();
+}
+
+template <typename R, typename C>
+    template <uint8_t ch>
+inline void PWM_TCA_split<R, C>::disconnect()
+{
+    Timer::template split_compare_output_disable<ch>();
+    Pin<ch>::write_zero();
+}
+
+template <typename R, typename C>
+    template <uint8_t ch>
+void PWM_TCA_split<R, C>::duty_cycle(uint8_t percentage)
+{
+    if (percentage > 100)
+	percentage = 100;
+
+    uint16_t x = (uint16_t{top()} + 1) * percentage / 100;
+    if (x > 0xFF)
+	x = 0xFF;
+
+    compare<ch>(static_cast<uint8_t>(x));
+}
+
+
+}// namespace hal
+}// namespace mega0_
+
+#endif
@@ -0,0 +1,482 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __MEGA0_TIMERA_HWD_H__
+#define __MEGA0_TIMERA_HWD_H__
+/****************************************************************************
+ *
+ * DESCRIPCION
+ *	Traductor del TCA (Timer/Counter type A)
+ *
+ *	El TCA tiene dos modos de funcionamiento:
+ *	    1) normal (SINGLE): contador de 16 bits con 3 comparadores.
+ *	    2) split  (SPLIT) : dos contadores de 8 bits (L y H) con 3
+ *	                        comparadores cada uno = 6 PWM de 8 bits.
+ *
+ *	Las funciones de split mode empiezan por `split_`.
+ *
+ *	Registros de 16 bits: el hardware usa el registro TEMP para leerlos y
+ *	escribirlos de forma atómica. TEMP es común a todos los registros de
+ *	16 bits del TCA, así que si se acceden desde una ISR hay que
+ *	bloquear las interrupciones (funciones unsafe_).
+ *
+ * HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <atd_bit.h>
+
+namespace mega0_{
+namespace hwd{
+
+template <typename Registers>
+class TCA{
+public:
+// syntactic sugar
+    using Reg = Registers;
+
+    static auto reg() { return Reg::reg(); }
+    using pos   = Reg::bit_pos; // posiciones de los bits dentro de los registros
+    using value = Reg::value;
+
+    using counter_type = uint16_t;
+
+// pines de salida
+    static constexpr uint8_t WO0_pin = Reg::WO0_pin;
+    static constexpr uint8_t WO1_pin = Reg::WO1_pin;
+    static constexpr uint8_t WO2_pin = Reg::WO2_pin;
+    static constexpr uint8_t WO3_pin = Reg::WO3_pin;
+    static constexpr uint8_t WO4_pin = Reg::WO4_pin;
+    static constexpr uint8_t WO5_pin = Reg::WO5_pin;
+
+// Constructor
+    TCA() = delete;
+
+// CTRLA
+// CTRLA::CLKSEL
+    static void clock_peripheral_divide_by_1();
+    static void clock_peripheral_divide_by_2();
+    static void clock_peripheral_divide_by_4();
+    static void clock_peripheral_divide_by_8();
+    static void clock_peripheral_divide_by_16();
+    static void clock_peripheral_divide_by_64();
+    static void clock_peripheral_divide_by_256();
+    static void clock_peripheral_divide_by_1024();
+
+// CTRLA::ENABLE
+    static void enable();
+    static void disable();
+    static bool is_enable();
+
+// CTRLB (normal mode)
+// CTRLB::WGMODE
+    static void normal_mode();
+    static void frequency_mode();	// FRQ: top = CMP0
+    static void single_slope_PWM_mode();
+    static void dual_slope_PWM_mode_top();
+    static void dual_slope_PWM_mode_both();
+    static void dual_slope_PWM_mode_bottom();
+
+// CTRLB::CMPnEN
+    template <uint8_t n>
+    static void compare_output_enable();
+
+    template <uint8_t n>
+    static void compare_output_disable();
+
+// CTRLD::SPLITM
+    // Precondición: el TCA tiene que estar deshabilitado.
+    static void split_mode_enable();
+    static void split_mode_disable();
+
+// CTRLESET::CMD
+    // Reinicia todos los registros del TCA.
+    // Precondición: el TCA tiene que estar deshabilitado.
+    static void reset();
+
+// EVCTRL
+// TODO: EVCTRL::CNTEI, EVCTRL::EVACT
+
+// INTCTRL/INTFLAGS (normal mode)
+// OVF
+    static void enable_overflow_interrupt();
+    static void disable_overflow_interrupt();
+    static bool is_overflow_flag_set();
+    static void clear_overflow_flag();
+
+// CMPn
+    template <uint8_t n>
+    static void enable_compare_interrupt();
+
+    template <uint8_t n>
+    static void disable_compare_interrupt();
+
+    template <uint8_t n>
+    static bool is_compare_flag_set();
+
+    template <uint8_t n>
+    static void clear_compare_flag();
+
+// CNT
+    static counter_type unsafe_counter() {return reg()->SINGLE.CNT;}
+    static void unsafe_counter(counter_type x) {reg()->SINGLE.CNT = x;}
+
+// PER
+    static counter_type unsafe_period() {return reg()->SINGLE.PER;}
+    static void unsafe_period(counter_type x) {reg()->SINGLE.PER = x;}
+
+// CMPn
+    template <uint8_t n>
+    static counter_type unsafe_compare_register();
+
+    template <uint8_t n>
+    static void unsafe_compare_register(counter_type x);
+
+// Split mode
+// ----------
+// CTRLB::xCMPnEN (n = 0..5; 0-2 = L, 3-5 = H)
+    template <uint8_t n>
+    static void split_compare_output_enable();
+
+    template <uint8_t n>
+    static void split_compare_output_disable();
+
+// INTCTRL::LUNF/HUNF
+    static void split_enable_low_underflow_interrupt();
+    static void split_disable_low_underflow_interrupt();
+    static void split_enable_high_underflow_interrupt();
+    static void split_disable_high_underflow_interrupt();
+
+// LPER/HPER
+    static void split_low_period(uint8_t x) {reg()->SPLIT.LPER = x;}
+    static uint8_t split_low_period() {return reg()->SPLIT.LPER;}
+    static void split_high_period(uint8_t x) {reg()->SPLIT.HPER = x;}
+    static uint8_t split_high_period() {return reg()->SPLIT.HPER;}
+
+// LCMPn/HCMPn (n = 0..5)
+    template <uint8_t n>
+    static void split_compare_register(uint8_t x);
+
+    template <uint8_t n>
+    static uint8_t split_compare_register();
+
+// LCNT/HCNT
+    static void split_counters(uint8_t x);
+
+private:
+    static void clock_select(uint8_t clksel);
+
+    template <uint8_t n>
+    static constexpr uint8_t cmpen_bit();
+
+    template <uint8_t n>
+    static constexpr uint8_t cmp_bit();
+
+    template <uint8_t n>
+    static constexpr uint8_t split_cmpen_bit();
+
+    template <uint8_t n>
+    static constexpr void check_compare_number()
+    { static_assert(n < 3, "Wrong compare channel (0, 1 or 2)"); }
+};
+
+
+// CTRLA::CLKSEL
+template <typename C>
+inline void TCA<C>::clock_select(uint8_t clksel)
+{ reg()->SINGLE.CTRLA = (reg()->SINGLE.CTRLA & ~value::CLKSEL_mask) | clksel; }
+
+template <typename C>
+inline void TCA<C>::clock_peripheral_divide_by_1()
+{ clock_select(value::CLKSEL_DIV1); }
+
+template <typename C>
+inline void TCA<C>::clock_peripheral_divide_by_2()
+{ clock_select(value::CLKSEL_DIV2); }
+
+template <typename C>
+inline void TCA<C>::clock_peripheral_divide_by_4()
+{ clock_select(value::CLKSEL_DIV4); }
+
+template <typename C>
+inline void TCA<C>::clock_peripheral_divide_by_8()
+{ clock_select(value::CLKSEL_DIV8); }
+
+template <typename C>
+inline void TCA<C>::clock_peripheral_divide_by_16()
+{ clock_select(value::CLKSEL_DIV16); }
+
+template <typename C>
+inline void TCA<C>::clock_peripheral_divide_by_64()
+{ clock_select(value::CLKSEL_DIV64); }
+
+template <typename C>
+inline void TCA<C>::clock_peripheral_divide_by_256()
+{ clock_select(value::CLKSEL_DIV256); }
+
+template <typename C>
+inline void TCA<C>::clock_peripheral_divide_by_1024()
+{ clock_select(value::CLKSEL_DIV1024); }
+
+
+// CTRLA::ENABLE
+template <typename C>
+inline void TCA<C>::enable()
+{ atd::write_bit<pos::ENABLE>::template to<1>::in(reg()->SINGLE.CTRLA); }
+
+template <typename C>
+inline void TCA<C>::disable()
+{ atd::write_bit<pos::ENABLE>::template to<0>::in(reg()->SINGLE.CTRLA); }
+
+template <typename C>
+inline bool TCA<C>::is_enable()
+{ return atd::is_one_bit<pos::ENABLE>::of(reg()->SINGLE.CTRLA); }
+
+
+// CTRLB::WGMODE
+template <typename C>
+inline void TCA<C>::normal_mode()
+{ reg()->SINGLE.CTRLB = (reg()->SINGLE.CTRLB & ~value::WGMODE_mask)
+						    | value::WGMODE_NORMAL; }
+
+template <typename C>
+inline void TCA<C>::frequency_mode()
+{ reg()->SINGLE.CTRLB = (reg()->SINGLE.CTRLB & ~value::WGMODE_mask)
+						    | value::WGMODE_FRQ; }
+
+template <typename C>
+inline void TCA<C>::single_slope_PWM_mode()
+{ reg()->SINGLE.CTRLB = (reg()->SINGLE.CTRLB & ~value::WGMODE_mask)
+						    | value::WGMODE_SINGLESLOPE; }
+
+template <typename C>
+inline void TCA<C>::dual_slope_PWM_mode_top()
+{ reg()->SINGLE.CTRLB = (reg()->SINGLE.CTRLB & ~value::WGMODE_mask)
+						    | value::WGMODE_DSTOP; }
+
+template <typename C>
+inline void TCA<C>::dual_slope_PWM_mode_both()
+{ reg()->SINGLE.CTRLB = (reg()->SINGLE.CTRLB & ~value::WGMODE_mask)
+						    | value::WGMODE_DSBOTH; }
+
+template <typename C>
+inline void TCA<C>::dual_slope_PWM_mode_bottom()
+{ reg()->SINGLE.CTRLB = (reg()->SINGLE.CTRLB & ~value::WGMODE_mask)
+						    | value::WGMODE_DSBOTTOM; }
+
+
+// CTRLB::CMPnEN
+template <typename C>
+    template <uint8_t n>
+inline constexpr uint8_t TCA<C>::cmpen_bit()
+{
+    check_compare_number<n>();
+
+    if constexpr (n == 0) return pos::CMP0EN;
+    else if constexpr (n == 1) return pos::CMP1EN;
+    else return pos::CMP2EN;
+}
+
+template <typename C>
+    template <uint8_t n>
+inline void TCA<C>::compare_output_enable()
+{ atd::write_bit<cmpen_bit<n>()>::template to<1>::in(reg()->SINGLE.CTRLB); }
+
+template <typename C>
+    template <uint8_t n>
+inline void TCA<C>::compare_output_disable()
+{ atd::write_bit<cmpen_bit<n>()>::template to<0>::in(reg()->SINGLE.CTRLB); }
+
+
+// CTRLD::SPLITM
+template <typename C>
+inline void TCA<C>::split_mode_enable()
+{ atd::write_bit<pos::SPLITM>::template to<1>::in(reg()->SINGLE.CTRLD); }
+
+template <typename C>
+inline void TCA<C>::split_mode_disable()
+{ atd::write_bit<pos::SPLITM>::template to<0>::in(reg()->SINGLE.CTRLD); }
+
+
+// CTRLESET::CMD
+template <typename C>
+inline void TCA<C>::reset()
+{ reg()->SINGLE.CTRLESET = value::CMD_RESET; }
+
+
+// INTCTRL/INTFLAGS
+// (RRR) Los flags se borran escribiendo un 1. No usar write_bit
+//       (read-modify-write) ya que borraría el resto de flags activos.
+template <typename C>
+inline void TCA<C>::enable_overflow_interrupt()
+{ atd::write_bit<pos::OVF>::template to<1>::in(reg()->SINGLE.INTCTRL); }
+
+template <typename C>
+inline void TCA<C>::disable_overflow_interrupt()
+{ atd::write_bit<pos::OVF>::template to<0>::in(reg()->SINGLE.INTCTRL); }
+
+template <typename C>
+inline bool TCA<C>::is_overflow_flag_set()
+{ return atd::is_one_bit<pos::OVF>::of(reg()->SINGLE.INTFLAGS); }
+
+template <typename C>
+inline void TCA<C>::clear_overflow_flag()
+{ reg()->SINGLE.INTFLAGS = (1 << pos::OVF); }
+
+template <typename C>
+    template <uint8_t n>
+inline constexpr uint8_t TCA<C>::cmp_bit()
+{
+    check_compare_number<n>();
+
+    if constexpr (n == 0) return pos::CMP0;
+    else if constexpr (n == 1) return pos::CMP1;
+    else return pos::CMP2;
+}
+
+template <typename C>
+    template <uint8_t n>
+inline void TCA<C>::enable_compare_interrupt()
+{ atd::write_bit<cmp_bit<n>()>::template to<1>::in(reg()->SINGLE.INTCTRL); }
+
+template <typename C>
+    template <uint8_t n>
+inline void TCA<C>::disable_compare_interrupt()
+{ atd::write_bit<cmp_bit<n>()>::template to<0>::in(reg()->SINGLE.INTCTRL); }
+
+template <typename C>
+    template <uint8_t n>
+inline bool TCA<C>::is_compare_flag_set()
+{ return atd::is_one_bit<cmp_bit<n>()>::of(reg()->SINGLE.INTFLAGS); }
+
+template <typename C>
+    template <uint8_t n>
+inline void TCA<C>::clear_compare_flag()
+{ reg()->SINGLE.INTFLAGS = (1 << cmp_bit<n>()); }
+
+
+// CMPn
+template <typename C>
+    template <uint8_t n>
+inline TCA<C>::counter_type TCA<C>::unsafe_compare_register()
+{
+    check_compare_number<n>();
+
+    if constexpr (n == 0) return reg()->SINGLE.CMP0;
+    else if constexpr (n == 1) return reg()->SINGLE.CMP1;
+    else return reg()->SINGLE.CMP2;
+}
+
+template <typename C>
+    template <uint8_t n>
+inline void TCA<C>::unsafe_compare_register(counter_type x)
+{
+    check_compare_number<n>();
+
+    if constexpr (n == 0) reg()->SINGLE.CMP0 = x;
+    else if constexpr (n == 1) reg()->SINGLE.CMP1 = x;
+    else reg()->SINGLE.CMP2 = x;
+}
+
+
+// Split mode
+// ----------
+template <typename C>
+    template <uint8_t n>
+inline constexpr uint8_t TCA<C>::split_cmpen_bit()
+{
+    static_assert(n < 6, "Wrong split channel (0 to 5)");
+
+    if constexpr (n == 0) return pos::LCMP0EN;
+    else if constexpr (n == 1) return pos::LCMP1EN;
+    else if constexpr (n == 2) return pos::LCMP2EN;
+    else if constexpr (n == 3) return pos::HCMP0EN;
+    else if constexpr (n == 4) return pos::HCMP1EN;
+    else return pos::HCMP2EN;
+}
+
+template <typename C>
+    template <uint8_t n>
+inline void TCA<C>::split_compare_output_enable()
+{ atd::write_bit<split_cmpen_bit<n>()>::template to<1>::in(reg()->SPLIT.CTRLB); }
+
+template <typename C>
+    template <uint8_t n>
+inline void TCA<C>::split_compare_output_disable()
+{ atd::write_bit<split_cmpen_bit<n>()>::template to<0>::in(reg()->SPLIT.CTRLB); }
+
+template <typename C>
+inline void TCA<C>::split_enable_low_underflow_interrupt()
+{ atd::write_bit<pos::LUNF>::template to<1>::in(reg()->SPLIT.INTCTRL); }
+
+template <typename C>
+inline void TCA<C>::split_disable_low_underflow_interrupt()
+{ atd::write_bit<pos::LUNF>::template to<0>::in(reg()->SPLIT.INTCTRL); }
+
+template <typename C>
+inline void TCA<C>::split_enable_high_underflow_interrupt()
+{ atd::write_bit<pos::HUNF>::template to<1>::in(reg()->SPLIT.INTCTRL); }
+
+template <typename C>
+inline void TCA<C>::split_disable_high_underflow_interrupt()
+{ atd::write_bit<pos::HUNF>::template to<0>::in(reg()->SPLIT.INTCTRL); }
+
+template <typename C>
+    template <uint8_t n>
+inline void TCA<C>::split_compare_register(uint8_t x)
+{
+    static_assert(n < 6, "Wrong split channel (0 to 5)");
+
+    if constexpr (n == 0) reg()->SPLIT.LCMP0 = x;
+    else if constexpr (n == 1) reg()->SPLIT.LCMP1 = x;
+    else if constexpr (n == 2) reg()->SPLIT.LCMP2 = x;
+    else if constexpr (n == 3) reg()->SPLIT.HCMP0 = x;
+    else if constexpr (n == 4) reg()->SPLIT.HCMP1 = x;
+    else reg()->SPLIT.HCMP2 = x;
+}
+
+template <typename C>
+    template <uint8_t n>
+inline uint8_t TCA<C>::split_compare_register()
+{
+    static_assert(n < 6, "Wrong split channel (0 to 5)");
+
+    if constexpr (n == 0) return reg()->SPLIT.LCMP0;
+    else if constexpr (n == 1) return reg()->SPLIT.LCMP1;
+    else if constexpr (n == 2) return reg()->SPLIT.LCMP2;
+    else if constexpr (n == 3) return reg()->SPLIT.HCMP0;
+    else if constexpr (n == 4) return reg()->SPLIT.HCMP1;
+    else return reg()->SPLIT.HCMP2;
+}
+
+template <typename C>
+inline void TCA<C>::split_counters(uint8_t x)
+{
+    reg()->SPLIT.LCNT = x;
+    reg()->SPLIT.HCNT = x;
+}
+
+
+}// namespace hwd
+}// namespace mega0_
+
+#endif
@@ -0,0 +1,470 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __MEGA0_TIMERB_HAL_H__
+#define __MEGA0_TIMERB_HAL_H__
+/****************************************************************************
+ *
+ * DESCRIPCION
+ *	Diferentes formas de usar el hwd::TCB:
+ *
+ *	(1) Time_counterB: contador con interrupción periódica.
+ *	(2) PWM8_TCB     : una señal PWM de 8 bits en el pin WO del TCB.
+ *	(3) Capture_TCB  : mide frecuencia y/o ancho de pulso de una señal.
+ *
+ *	El TCB solo tiene prescaler 1 y 2 (o usar el clock del TCA). Es un
+ *	timer pensado para medir (capture) o para generar una interrupción
+ *	periódica de alta resolución.
+ *
+ * HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *    18/10/2026 Capture_TCB::input_from_pin
+ *
+ ****************************************************************************/
+#include "mega0_timerB_hwd.h"
+#include "mega0_evsys_hwd.h"
+#include "mega0_pin_hwd.h"
+#include "mega0_clock_frequencies.h"
+#include "mega0_import_avr.h"	// Disable_interrupts
+
+#include <atd_type_traits.h>	// always_false_v
+
+namespace mega0_{
+namespace hal{
+
+namespace timerB_{
+
+template <typename TCB, uint16_t prescaler>
+inline void clock_divide_by()
+{
+    if constexpr (prescaler == 1) TCB::clock_peripheral_divide_by_1();
+    else if constexpr (prescaler == 2) TCB::clock_peripheral_divide_by_2();
+    else
+	static_assert(atd::always_false_v<TCB>,
+			"Wrong TCB prescaler. Valid ones: 1 or 2.");
+}
+
+// Menor prescaler (1 ó 2) con el que se puede obtener freq_in_hz con
+// top <= max_top. 0 si no existe.
+inline constexpr
+uint16_t prescaler_for_frequency(uint32_t freq_in_hz, uint32_t clk,
+				 uint32_t max_top)
+{
+    for (uint16_t p = 1; p <= 2; ++p){
+	uint32_t den = uint32_t{p} * freq_in_hz;
+	uint32_t ticks = (clk + den / 2) / den;
+	if (ticks == 0)
+	    return 0;
+
+	if (ticks - 1 <= max_top)
+	    return p;
+    }
+
+    return 0;
+}
+
+inline constexpr
+uint32_t top_for_frequency(uint32_t freq_in_hz, uint32_t clk, uint16_t p)
+{
+    uint32_t den = uint32_t{p} * freq_in_hz;
+    return (clk + den / 2) / den - 1;
+}
+
+}// namespace timerB_
+
+
+/***************************************************************************
+ *			    Time_counterB
+ ***************************************************************************/
+// Contador de 16 bits que genera una interrupción (ISR_TCBn_INT) cada vez
+// que llega a top. Como en el TCA, el cliente tiene que borrar el flag
+// dentro de la ISR:
+//
+//	ISR_TCB0_INT {
+//	    Counter::clear_top_interrupt_flag();
+//	    ...
+//	}
+template <typename Registers>
+class Time_counterB{
+public:
+    static constexpr bool is_unsafe = true;
+
+// Types
+    using Hwd	       = hwd::TCB<Registers>;
+    using Timer        = Hwd;
+    using counter_type = typename Timer::counter_type;
+    using Disable_interrupts = mega0_::Disable_interrupts;
+
+// Initialization
+    Time_counterB() = delete;
+
+    static void init(counter_type top0 = max_top());
+
+// Interrupts
+    static void enable_top_interrupt() { Timer::enable_capture_interrupt(); }
+    static void disable_top_interrupt() { Timer::disable_capture_interrupt(); }
+    static void clear_top_interrupt_flag() { Timer::clear_capture_flag(); }
+
+// on/off
+    /// Enciende el contador con un tick cada period_in_us.
+    /// Con prescaler 1 ó 2 solo es posible si clk_per es 1 ó 2 MHz
+    /// (o múltiplos en ns, que no soportamos).
+    template<uint16_t period_in_us
+	    , uint32_t clock_frequency_in_hz = clk_per()>
+    struct turn_on_with_clock_period_of{
+	static void us();
+    };
+
+    /// Enciende el contador generando una interrupción cada 1 ms.
+    template <uint32_t clock_frequency_in_hz = clk_per()>
+    static void turn_on_with_overflow_every_1ms();
+
+    static void turn_off() { Timer::disable(); }
+
+// Value
+    static counter_type unsafe_value() { return Timer::unsafe_counter(); }
+
+    static counter_type safe_value()
+    {
+	Disable_interrupts l;
+	return unsafe_value();
+    }
+
+    static counter_type value() {return safe_value();}
+
+    static void unsafe_reset() { Timer::unsafe_counter(0); }
+    static void safe_reset()
+    {
+	Disable_interrupts l;
+	unsafe_reset();
+    }
+    static void reset() {safe_reset();}
+
+// Top
+    static void unsafe_top(counter_type top)
+    { Timer::unsafe_compare_register(top); }
+
+    static void top(counter_type top0)
+    {
+	Disable_interrupts l;
+	unsafe_top(top0);
+    }
+
+    static counter_type top()
+    {
+	Disable_interrupts l;
+	return Timer::unsafe_compare_register();
+    }
+
+    static constexpr counter_type max_top() { return 0xFFFF; }
+};
+
+
+template <typename R>
+void Time_counterB<R>::init(counter_type top0)
+{
+    Disable_interrupts l;
+    Timer::disable();
+    Timer::periodic_interrupt_mode();
+    unsafe_reset();
+    unsafe_top(top0);
+}
+
+template <typename R>
+    template<uint16_t period_in_us, uint32_t clk>
+void Time_counterB<R>::turn_on_with_clock_period_of<period_in_us, clk>::us()
+{
+    constexpr uint64_t d = uint64_t{clk} * period_in_us;
+    static_assert(d % 1'000'000 == 0 and
+		  (d / 1'000'000 == 1 or d / 1'000'000 == 2),
+		  "TCB can't generate that period with this clk_per");
+
+    timerB_::clock_divide_by<Timer, d / 1'000'000>();
+    Timer::enable();
+}
+
+template <typename R>
+    template <uint32_t clk>
+void Time_counterB<R>::turn_on_with_overflow_every_1ms()
+{
+    constexpr uint16_t p = timerB_::prescaler_for_frequency(1000, clk, 0xFFFF);
+    static_assert(p != 0 and clk % (p * 1000) == 0,
+		  "TCB can't generate an exact 1 ms with this clk_per");
+
+    init(timerB_::top_for_frequency(1000, clk, p));
+    timerB_::clock_divide_by<Timer, p>();
+    enable_top_interrupt();
+    Timer::enable();
+}
+
+
+/***************************************************************************
+ *				PWM8_TCB
+ ***************************************************************************/
+// Una señal PWM de 8 bits en el pin WO del TCB:
+//	freq = clk_per / (prescaler * (CCMPL + 1))
+//	duty = CCMPH / (CCMPL + 1)
+//
+// Ejemplo:
+//	using PWM = PWM8_TCB<cfg::TCB0, cfg::pins>;
+//	PWM::turn_on<20'000>();
+//	PWM::duty_cycle(30);
+template <typename Registers, typename Cfg_pins>
+class PWM8_TCB{
+public:
+    using Hwd	       = hwd::TCB<Registers>;
+    using Timer        = Hwd;
+    using Pin	       = hwd::Pin<Registers::WO_pin, Cfg_pins>;
+
+    static constexpr uint8_t number = Registers::WO_pin;
+
+    PWM8_TCB() = delete;
+
+    /// Configura el TCB en PWM 8 bits, conecta el pin y lo enciende con
+    /// frecuencia (aproximada) frequency_in_hz y duty cycle 0.
+    template <uint32_t frequency_in_hz, uint32_t clk = clk_per()>
+    static void turn_on();
+
+    /// Frecuencia que realmente se genera con turn_on<frequency_in_hz>
+    template <uint32_t frequency_in_hz, uint32_t clk = clk_per()>
+    static constexpr uint32_t frequency();
+
+    /// Apaga el timer dejando el pin a 0.
+    static void turn_off();
+
+    /// Duty cycle en tanto por cien [0, 100]
+    static void duty_cycle(uint8_t percentage);
+
+    /// Valor del comparador: duty = compare / (top + 1)
+    static void compare(uint8_t x) { Timer::PWM_8bit(top_, x); }
+
+    static uint8_t top() { return top_; }
+
+private:
+    // (RRR) CCMPL y CCMPH se escriben a la vez a través de TEMP: para
+    //       cambiar el duty hay que volver a escribir el periodo. Lo
+    //       guardamos aquí para no tener que leer CCMP.
+    inline static uint8_t top_ = 0xFF;
+
+    template <uint32_t frequency_in_hz, uint32_t clk>
+    static constexpr uint16_t prescaler()
+    {
+	constexpr uint16_t p = timerB_::prescaler_for_frequency(
+					    frequency_in_hz, clk, 0xFF);
+
+	static_assert(p != 0, "PWM frequency out of range");
+	return p;
+    }
+};
+
+template <typename R, typename C>
+    template <uint32_t freq, uint32_t clk>
+inline constexpr uint32_t PWM8_TCB<R, C>::frequency()
+{
+    constexpr uint16_t p = prescaler<freq, clk>();
+    constexpr uint32_t top = timerB_::top_for_frequency(freq, clk, p);
+
+    return clk / (p * (top + 1));
+}
+
+template <typename R, typename C>
+    template <uint32_t freq, uint32_t clk>
+void PWM8_TCB<R, C>::turn_on()
+{
+    constexpr uint16_t p = prescaler<freq, clk>();
+    top_ = static_cast<uint8_t>(timerB_::top_for_frequency(freq, clk, p));
+
+    Timer::disable();
+    Timer::PWM_8bit_mode();
+    Timer::unsafe_counter(0);
+    Timer::PWM_8bit(top_, 0);
+
+    Pin::as_output();
+    Timer::compare_output_enable();
+
+    timerB_::clock_divide_by<Timer, p>();
+    Timer::enable();
+}
+
+template <typename R, typename C>
+void PWM8_TCB<R, C>::turn_off()
+{
+    Timer::disable();
+    Timer::compare_output_disable();
+    Pin::write_zero();
+}
+
+template <typename R, typename C>
+void PWM8_TCB<R, C>::duty_cycle(uint8_t percentage)
+{
+    if (percentage > 100)
+	percentage = 100;
+
+    uint16_t x = (uint16_t{top_} + 1) * percentage / 100;
+    if (x > 0xFF)
+	x = 0xFF;
+
+    compare(static_cast<uint8_t>(x));
+}
+
+
+/***************************************************************************
+ *				Capture_TCB
+ ***************************************************************************/
+// Mide la señal que llega al TCB como evento. El TCB no tiene pin de
+// entrada: hay que conectar el pin (o lo que se quiera medir) a la entrada
+// de eventos del TCB usando el event system (EVSYS). input_from_pin lo
+// hace. Una vez conectado el hardware captura cada flanco sin que
+// intervenga la CPU: solo hay que leer capture().
+//
+// Modos:
+//  + frequency      : capture() = periodo de la señal (en ticks).
+//  + pulse_width    : capture() = ancho del pulso (en ticks).
+//  + frequency_and_pulse_width: capture() = ancho del pulso,
+//		       period() = periodo. Al capturar el TCB se para hasta
+//		       el siguiente flanco: leer capture() lo rearma.
+//
+// tick = clock_divisor / clk_per
+//
+// La interrupción es ISR_TCBn_INT. Leer capture() borra el flag.
+template <typename Registers, uint16_t clock_divisor = 1>
+class Capture_TCB{
+public:
+    static constexpr bool is_unsafe = true;
+
+    using Hwd	       = hwd::TCB<Registers>;
+    using Timer        = Hwd;
+    using counter_type = typename Timer::counter_type;
+    using Disable_interrupts = mega0_::Disable_interrupts;
+    using EVSYS        = hwd::EVSYS<typename Registers::evsys>;
+
+    Capture_TCB() = delete;
+
+// Input
+    /// Mide la señal del pin: lo conecta al TCB a través del canal
+    /// channel del EVSYS. No toca la configuración del pin: el evento es
+    /// el nivel del pin tanto si es de entrada como de salida, con lo
+    /// que se puede medir una señal generada por el propio micro. Si es
+    /// una señal externa el cliente tiene que configurarlo como entrada.
+    /// Cada canal solo admite los pines de ciertos puertos (ver
+    /// mega0_evsys_hwd.h): si no es posible no compila.
+    template <uint8_t channel, uint8_t pin>
+    static void input_from_pin();
+
+    /// Desconecta el TCB del EVSYS (el canal sigue configurado).
+    static void input_disconnect()
+    { EVSYS::template disconnect<typename Registers::evsys_user>(); }
+
+// Modes (no encienden el timer)
+    static void frequency_mode()
+    { init(); Timer::input_capture_frequency_mode(); }
+
+    static void pulse_width_mode()
+    { init(); Timer::input_capture_pulse_width_mode(); }
+
+    static void frequency_and_pulse_width_mode()
+    { init(); Timer::input_capture_frequency_and_pulse_width_mode(); }
+
+// Cfg
+    static void capture_on_rising_edge() { Timer::event_edge_rising(); }
+    static void capture_on_falling_edge() { Timer::event_edge_falling(); }
+
+    static void noise_canceler_on() { Timer::noise_canceler_on(); }
+    static void noise_canceler_off() { Timer::noise_canceler_off(); }
+
+// on/off
+    static void turn_on()
+    {
+	timerB_::clock_divide_by<Timer, clock_divisor>();
+	Timer::enable();
+    }
+
+    static void turn_off() { Timer::disable(); }
+
+// Interrupts
+    static void enable_interrupt() { Timer::enable_capture_interrupt(); }
+    static void disable_interrupt() { Timer::disable_capture_interrupt(); }
+    static bool is_capture_ready() { return Timer::is_capture_flag_set(); }
+
+// Values
+    static counter_type unsafe_capture()
+    { return Timer::unsafe_compare_register(); }
+
+    static counter_type capture()
+    {
+	Disable_interrupts l;
+	return unsafe_capture();
+    }
+
+    // En frequency_and_pulse_width_mode: periodo de la señal.
+    // Leerlo antes que capture().
+    static counter_type unsafe_period() { return Timer::unsafe_counter(); }
+
+    static counter_type period()
+    {
+	Disable_interrupts l;
+	return unsafe_period();
+    }
+
+// Conversion
+    /// Convierte un periodo en ticks a frecuencia en hercios.
+    template <uint32_t clk = clk_per()>
+    static constexpr uint32_t frequency_in_hz(counter_type ticks)
+    {
+	if (ticks == 0)
+	    return 0;
+
+	return clk / (uint32_t{clock_divisor} * ticks);
+    }
+
+    /// Convierte ticks a microsegundos
+    template <uint32_t clk = clk_per()>
+    static constexpr uint32_t ticks_to_us(counter_type ticks)
+    {
+	return static_cast<uint32_t>(
+		(uint64_t{ticks} * clock_divisor * 1'000'000) / clk);
+    }
+
+private:
+    static void init()
+    {
+	Timer::disable();
+	Timer::compare_output_disable();
+	Timer::enable_capture_event_input();
+	Timer::unsafe_counter(0);
+	Timer::clear_capture_flag();
+    }
+};
+
+template <typename R, uint16_t d>
+    template <uint8_t channel, uint8_t pin>
+void Capture_TCB<R, d>::input_from_pin()
+{
+    EVSYS::template channel_from_pin<channel, pin>();
+    EVSYS::template connect<channel, typename R::evsys_user>();
+}
+
+
+}// namespace hal
+}// namespace mega0_
+
+#endif
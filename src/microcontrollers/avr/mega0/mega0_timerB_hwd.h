@@ -0,0 +1,291 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __MEGA0_TIMERB_HWD_H__
+#define __MEGA0_TIMERB_HWD_H__
+/****************************************************************************
+ *
+ * DESCRIPCION
+ *	Traductor del TCB (Timer/Counter type B)
+ *
+ *	Contador de 16 bits con un único registro CCMP que, según el modo,
+ *	es el top (periodic interrupt), el valor capturado (input capture,
+ *	frequency, pulse-width) o, en PWM 8 bits, periodo (CCMPL) y duty
+ *	cycle (CCMPH).
+ *
+ *	La entrada de captura NO es un pin: es un evento (EVSYS). Para medir
+ *	una señal en un pin hay que conectar el pin al TCB a través del event
+ *	system.
+ *
+ *	Registros de 16 bits: igual que en el TCA, se leen/escriben a través
+ *	de TEMP (funciones unsafe_).
+ *
+ * HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <atd_bit.h>
+
+namespace mega0_{
+namespace hwd{
+
+template <typename Registers>
+class TCB{
+public:
+// syntactic sugar
+    using Reg = Registers;
+
+    static auto reg() { return Reg::reg(); }
+    using pos   = Reg::bit_pos; // posiciones de los bits dentro de los registros
+    using value = Reg::value;
+
+    using counter_type = uint16_t;
+
+// Constructor
+    TCB() = delete;
+
+// CTRLA
+// CTRLA::CLKSEL
+    static void clock_peripheral_divide_by_1();
+    static void clock_peripheral_divide_by_2();
+    static void clock_from_TCA();   // usa el clock (con prescaler) del TCA
+
+// CTRLA::ENABLE
+    static void enable();
+    static void disable();
+    static bool is_enable();
+
+// CTRLB
+// CTRLB::CNTMODE
+    static void periodic_interrupt_mode();
+    static void timeout_check_mode();
+    static void input_capture_on_event_mode();
+    static void input_capture_frequency_mode();
+    static void input_capture_pulse_width_mode();
+    static void input_capture_frequency_and_pulse_width_mode();
+    static void single_shot_mode();
+    static void PWM_8bit_mode();
+
+// CTRLB::CCMPEN
+    static void compare_output_enable();
+    static void compare_output_disable();
+
+// CTRLB::CCMPINIT
+    static void compare_output_initial_value_one();
+    static void compare_output_initial_value_zero();
+
+// EVCTRL
+// EVCTRL::CAPTEI
+    static void enable_capture_event_input();
+    static void disable_capture_event_input();
+
+// EVCTRL::EDGE
+    // El significado depende del modo (ver tabla 21-2 de la datasheet). En
+    // los modos frequency/pulse-width: rising = mide desde el flanco de
+    // subida.
+    static void event_edge_rising();
+    static void event_edge_falling();
+
+// EVCTRL::FILTER
+    static void noise_canceler_on();
+    static void noise_canceler_off();
+
+// INTCTRL/INTFLAGS::CAPT
+    static void enable_capture_interrupt();
+    static void disable_capture_interrupt();
+    static bool is_capture_flag_set();
+    static void clear_capture_flag();
+
+// STATUS::RUN
+    static bool is_running();
+
+// CNT
+    static counter_type unsafe_counter() {return reg()->CNT;}
+    static void unsafe_counter(counter_type x) {reg()->CNT = x;}
+
+// CCMP
+    // (RRR) En input capture leer CCMP borra el flag CAPT.
+    static counter_type unsafe_compare_register() {return reg()->CCMP;}
+    static void unsafe_compare_register(counter_type x) {reg()->CCMP = x;}
+
+    // PWM 8 bits: CCMPL = periodo, CCMPH = duty cycle
+    // Hay que escribir siempre los dos bytes: primero L y luego H.
+    static void PWM_8bit(uint8_t period, uint8_t duty);
+
+private:
+    static void clock_select(uint8_t clksel);
+    static void count_mode(uint8_t mode);
+};
+
+
+// CTRLA::CLKSEL
+template <typename C>
+inline void TCB<C>::clock_select(uint8_t clksel)
+{ reg()->CTRLA = (reg()->CTRLA & ~value::CLKSEL_mask) | clksel; }
+
+template <typename C>
+inline void TCB<C>::clock_peripheral_divide_by_1()
+{ clock_select(value::CLKSEL_CLKDIV1); }
+
+template <typename C>
+inline void TCB<C>::clock_peripheral_divide_by_2()
+{ clock_select(value::CLKSEL_CLKDIV2); }
+
+template <typename C>
+inline void TCB<C>::clock_from_TCA()
+{ clock_select(value::CLKSEL_CLKTCA); }
+
+
+// CTRLA::ENABLE
+template <typename C>
+inline void TCB<C>::enable()
+{ atd::write_bit<pos::ENABLE>::template to<1>::in(reg()->CTRLA); }
+
+template <typename C>
+inline void TCB<C>::disable()
+{ atd::write_bit<pos::ENABLE>::template to<0>::in(reg()->CTRLA); }
+
+template <typename C>
+inline bool TCB<C>::is_enable()
+{ return atd::is_one_bit<pos::ENABLE>::of(reg()->CTRLA); }
+
+
+// CTRLB::CNTMODE
+template <typename C>
+inline void TCB<C>::count_mode(uint8_t mode)
+{ reg()->CTRLB = (reg()->CTRLB & ~value::CNTMODE_mask) | mode; }
+
+template <typename C>
+inline void TCB<C>::periodic_interrupt_mode()
+{ count_mode(value::CNTMODE_INT); }
+
+template <typename C>
+inline void TCB<C>::timeout_check_mode()
+{ count_mode(value::CNTMODE_TIMEOUT); }
+
+template <typename C>
+inline void TCB<C>::input_capture_on_event_mode()
+{ count_mode(value::CNTMODE_CAPT); }
+
+template <typename C>
+inline void TCB<C>::input_capture_frequency_mode()
+{ count_mode(value::CNTMODE_FRQ); }
+
+template <typename C>
+inline void TCB<C>::input_capture_pulse_width_mode()
+{ count_mode(value::CNTMODE_PW); }
+
+template <typename C>
+inline void TCB<C>::input_capture_frequency_and_pulse_width_mode()
+{ count_mode(value::CNTMODE_FRQPW); }
+
+template <typename C>
+inline void TCB<C>::single_shot_mode()
+{ count_mode(value::CNTMODE_SINGLE); }
+
+template <typename C>
+inline void TCB<C>::PWM_8bit_mode()
+{ count_mode(value::CNTMODE_PWM8); }
+
+
+// CTRLB::CCMPEN
+template <typename C>
+inline void TCB<C>::compare_output_enable()
+{ atd::write_bit<pos::CCMPEN>::template to<1>::in(reg()->CTRLB); }
+
+template <typename C>
+inline void TCB<C>::compare_output_disable()
+{ atd::write_bit<pos::CCMPEN>::template to<0>::in(reg()->CTRLB); }
+
+// CTRLB::CCMPINIT
+template <typename C>
+inline void TCB<C>::compare_output_initial_value_one()
+{ atd::write_bit<pos::CCMPINIT>::template to<1>::in(reg()->CTRLB); }
+
+template <typename C>
+inline void TCB<C>::compare_output_initial_value_zero()
+{ atd::write_bit<pos::CCMPINIT>::template to<0>::in(reg()->CTRLB); }
+
+
+// EVCTRL
+template <typename C>
+inline void TCB<C>::enable_capture_event_input()
+{ atd::write_bit<pos::CAPTEI>::template to<1>::in(reg()->EVCTRL); }
+
+template <typename C>
+inline void TCB<C>::disable_capture_event_input()
+{ atd::write_bit<pos::CAPTEI>::template to<0>::in(reg()->EVCTRL); }
+
+template <typename C>
+inline void TCB<C>::event_edge_rising()
+{ atd::write_bit<pos::EDGE>::template to<0>::in(reg()->EVCTRL); }
+
+template <typename C>
+inline void TCB<C>::event_edge_falling()
+{ atd::write_bit<pos::EDGE>::template to<1>::in(reg()->EVCTRL); }
+
+template <typename C>
+inline void TCB<C>::noise_canceler_on()
+{ atd::write_bit<pos::FILTER>::template to<1>::in(reg()->EVCTRL); }
+
+template <typename C>
+inline void TCB<C>::noise_canceler_off()
+{ atd::write_bit<pos::FILTER>::template to<0>::in(reg()->EVCTRL); }
+
+
+// INTCTRL/INTFLAGS
+template <typename C>
+inline void TCB<C>::enable_capture_interrupt()
+{ atd::write_bit<pos::CAPT>::template to<1>::in(reg()->INTCTRL); }
+
+template <typename C>
+inline void TCB<C>::disable_capture_interrupt()
+{ atd::write_bit<pos::CAPT>::template to<0>::in(reg()->INTCTRL); }
+
+template <typename C>
+inline bool TCB<C>::is_capture_flag_set()
+{ return atd::is_one_bit<pos::CAPT>::of(reg()->INTFLAGS); }
+
+template <typename C>
+inline void TCB<C>::clear_capture_flag()
+{ reg()->INTFLAGS = (1 << pos::CAPT); }
+
+
+// STATUS
+template <typename C>
+inline bool TCB<C>::is_running()
+{ return atd::is_one_bit<pos::RUN>::of(reg()->STATUS); }
+
+
+// CCMP
+template <typename C>
+inline void TCB<C>::PWM_8bit(uint8_t period, uint8_t duty)
+{
+    reg()->CCMPL = period;
+    reg()->CCMPH = duty;
+}
+
+
+}// namespace hwd
+}// namespace mega0_
+
+#endif
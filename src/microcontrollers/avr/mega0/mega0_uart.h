@@ -29,6 +29,7 @@
  * HISTORIA
  *    Manuel Perez
  *    02/11/2024 UART_8bits, calculo del baud rate
+ *    18/10/2026 enable/disable_interrupt_ready_to_transmit
  *
  ****************************************************************************/
 
@@ -213,6 +214,12 @@ public:
     // definir la ISR para RXC o DRE o TXC. El nombre que defino aquí tiene
     // que coincidir con el nombre de la función "enable_interrupt_xxx"
 #define ISR_UART_8bits_unread_data(usart) ISR_receive_complete(usart)
+
+    // ¿se puede escribir en el data register?
+    static void enable_interrupt_ready_to_transmit();
+    static void disable_interrupt_ready_to_transmit();
+#define ISR_UART_8bits_ready_to_transmit(usart) ISR_data_register_empty(usart)
+
     // TODO: por consistencia debería de poderse habilitar la interrupcion que
     // informa de que se ha transmitido todo y no hay nada pendiente de
     // transmitir.
@@ -310,6 +317,14 @@ template <typename C>
 inline void UART_8bits<C>::disable_interrupt_unread_data()
 { USART::disable_receive_complete_interrupt();}
 
+template <typename C>
+inline void UART_8bits<C>::enable_interrupt_ready_to_transmit()
+{ USART::enable_data_register_empty_interrupt();}
+
+template <typename C>
+inline void UART_8bits<C>::disable_interrupt_ready_to_transmit()
+{ USART::disable_data_register_empty_interrupt();}
+
 }// mega0_
 
 #endif
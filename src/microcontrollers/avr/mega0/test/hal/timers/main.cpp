@@ -0,0 +1,221 @@
+// Copyright (C) 2026 Manuel Perez 
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../../mega0.h"
+
+#include <mcu_miniclock.h>
+#include <mcu_clock.h>
+#include <mcu_UART_iostream.h>
+
+// HELP: conectar el osciloscopio a los pines WO0-WO5 del TCA (33-38) y
+// al pin WO del TCB1 (36). La UART es la USART1 (pines 1, 2): no usar el
+// TCB2, su pin WO (1) es el TxD de la USART1.
+// El test de captura mide la señal PWM del TCB1 (pin 36) con el TCB0, 
+// conectados a través del EVSYS: no hay que cablear nada.
+// El pin 36 es también el WO3 del TCA: el PWM del TCB1 lo desconecta del
+// PWM split.
+
+// Microcontroller
+// ---------------
+namespace myu = atmega4809_40;
+using Micro   = myu::Micro;
+
+// Devices
+// -------
+using UART_8bits    = myu::UART1_8bits;
+using UART_iostream = mcu::UART_iostream<UART_8bits>;
+
+using Clock_controller = myu::hwd::Clock_controller;
+
+using Time_counter = myu::Time_counterA0;
+using Miniclock_us = mcu::Miniclock_us<Micro, Time_counter>;
+using Clock	   = mcu::Clock_ms<Micro, Time_counter>;
+
+using PWM_split	   = myu::PWM_TCA0_split;
+using PWM8	   = myu::PWM8_TCB1;
+using Capture	   = myu::Capture_TCB0<>;
+
+
+ISR_TCA0_OVF
+{
+    Time_counter::clear_top_interrupt_flag();
+    Clock::tick();
+}
+
+
+void init()
+{
+    myu::init();
+
+    // clk_per = 16 MHz / 16 = 1 MHz = F_CPU (ver makefile)
+    Clock_controller::clk_main_divided_by_16();
+
+    UART_iostream uart;
+    UART_iostream::init();
+    uart.turn_on();
+}
+
+void print_menu()
+{
+    UART_iostream uart;
+    uart << "\n\nTimers test\n"
+	        "-----------\n"
+		"1. Miniclock_us (TCA0)\n"
+		"2. Clock_ms (TCA0)\n"
+		"3. PWM split (TCA0)\n"
+		"4. PWM 8 bits (TCB1)\n"
+		"5. Capture PWM 8 bits (TCB1 --> EVSYS --> TCB0)\n";
+}
+
+void test_miniclock_us()
+{
+    UART_iostream uart;
+    uart << "\nMiniclock_us\n"
+	      "Waiting 1000, 2000 and 10000 us:\n";
+
+    Miniclock_us::init();
+
+    // wait_us necesita una constante en tiempo de compilación
+    Miniclock_us::start();
+    Micro::wait_us(1000);
+    Miniclock_us::stop();
+    uart << "\twait_us(1000) = " << Miniclock_us::time() << " us\n";
+
+    Miniclock_us::start();
+    Micro::wait_us(2000);
+    Miniclock_us::stop();
+    uart << "\twait_us(2000) = " << Miniclock_us::time() << " us\n";
+
+    Miniclock_us::start();
+    Micro::wait_us(10000);
+    Miniclock_us::stop();
+    uart << "\twait_us(10000) = " << Miniclock_us::time() << " us\n";
+}
+
+void test_clock_ms()
+{
+    UART_iostream uart;
+    uart << "\nClock_ms\n"
+	      "Printing time for 3 seconds:\n";
+
+    Micro::enable_interrupts();
+    Clock::turn_on();
+
+    for (uint8_t i = 0; i < 6; ++i){
+	auto t = Clock::now_as_time();
+	uart << '\t' << (int) t.seconds << ':' << (int) t.milliseconds << '\n';
+	Micro::wait_ms(500);
+    }
+
+    Clock::turn_off();
+}
+
+void test_pwm_split()
+{
+    UART_iostream uart;
+    uart << "\nPWM split: 1 kHz, duty cycles 0, 20, 40, 60, 80, 100\n"
+	      "Real frequency = " << PWM_split::frequency<1000>() << " Hz\n";
+
+    Time_counter::turn_off(); // el TCA deja de ser Clock_ms
+
+    PWM_split::init();
+    PWM_split::turn_on<1000>();
+
+    PWM_split::connect<0>();
+    PWM_split::connect<1>();
+    PWM_split::connect<2>();
+    PWM_split::connect<3>();
+    PWM_split::connect<4>();
+    PWM_split::connect<5>();
+
+    PWM_split::duty_cycle<0>(0);
+    PWM_split::duty_cycle<1>(20);
+    PWM_split::duty_cycle<2>(40);
+    PWM_split::duty_cycle<3>(60);
+    PWM_split::duty_cycle<4>(80);
+    PWM_split::duty_cycle<5>(100);
+}
+
+void test_pwm8()
+{
+    UART_iostream uart;
+    uart << "\nPWM 8 bits: 10 kHz, duty = 25%\n"
+	      "Real frequency = " << PWM8::frequency<10'000>() << " Hz\n";
+
+    PWM_split::disconnect<3>();	// pin 36 = WO3 del TCA
+
+    PWM8::turn_on<10'000>();
+    PWM8::duty_cycle(25);
+}
+
+void test_capture()
+{
+    UART_iostream uart;
+    uart << "\nCapture: PWM 8 bits (pin 36) --> EVSYS channel 0 --> TCB0\n";
+
+    test_pwm8();
+
+    // PA3 (pin 36) solo puede ir al canal 0 ó 1.
+    // El pin sigue siendo la salida del PWM: medimos lo que genera.
+    Capture::input_from_pin<0, PWM8::number>();
+    Capture::frequency_and_pulse_width_mode();
+    Capture::capture_on_rising_edge();
+    Capture::turn_on();
+
+    for (uint8_t i = 0; i < 5; ++i){
+	while (!Capture::is_capture_ready()) { ; }
+
+	auto period = Capture::period();    // antes que capture()
+	auto width  = Capture::capture();
+
+	uart << "\tperiod = " << Capture::ticks_to_us(period) << " us ("
+	     << Capture::frequency_in_hz(period) << " Hz); width = "
+	     << Capture::ticks_to_us(width) << " us\n";
+
+	Micro::wait_ms(200);
+    }
+
+    Capture::turn_off();
+    Capture::input_disconnect();
+}
+
+
+int main()
+{
+    init();
+
+    UART_iostream uart;
+
+    while (1) {
+	print_menu();
+
+	char opt{};
+	uart >> opt;
+
+	switch (opt){
+	    break; case '1': test_miniclock_us();
+	    break; case '2': test_clock_ms();
+	    break; case '3': test_pwm_split();
+	    break; case '4': test_pwm8();
+	    break; case '5': test_capture();
+	    break; default : uart << "Unknown option\n";
+	}
+    }
+}
+
@@ -0,0 +1,506 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#pragma once
+
+#ifndef __MCU_TWI_MASTER_QUEUE_H__
+#define __MCU_TWI_MASTER_QUEUE_H__
+
+/****************************************************************************
+ *
+ *  DESCRIPCION
+ *	Master de TWI con una cola de transacciones.
+ *
+ *  COMENTARIOS
+ *	`TWI_master` solo puede tener una transacción en marcha: el driver
+ *  tiene que esperar (`wait_while_busy`) a que acabe antes de poder lanzar
+ *  la siguiente. Si tenemos varios dispositivos en el mismo bus (un BME280,
+ *  un DS1307 y un SDD1306, por ejemplo) toda esa espera se hace en el main
+ *  loop.
+ *
+ *	Con `TWI_master_queue` el cliente describe la transacción (write,
+ *  read o write seguido de read con repeated start) y la mete en la cola.
+ *  La ISR las va ejecutando una detrás de otra sin devolver el control al
+ *  cliente. Cuando acaba una transacción se lo notifica al cliente
+ *  escribiendo su estado en la transacción y, opcionalmente, llamando a un
+ *  callback.
+ *
+ *  RESPONSABILIDADES
+ *	+ Gestionar una cola de transacciones de capacidad fija (reservada
+ *	  en tiempo de compilación).
+ *	+ Ejecutar el protocolo de TWI de cada transacción desde la ISR.
+ *
+ *  DISEÑO
+ *	+ La cola no copia los datos: guarda punteros a las transacciones. Es
+ *	  el cliente el que reserva la memoria de la transacción y de sus
+ *	  buffers (normalmente como variables static del driver).
+ *	  Precondición: la transacción y sus buffers tienen que existir hasta
+ *	  que `is_done()`.
+ *
+ *	+ Entre dos transacciones de la cola enviamos STOP seguido de START
+ *	  (`master_transmit_stop_followed_by_start`). No usamos un repeated
+ *	  start ya que hay dispositivos que necesitan ver el STOP para
+ *	  procesar el comando recibido.
+ *
+ *	+ Un error en una transacción no afecta a las siguientes: se marca la
+ *	  transacción con el error y se pasa a la siguiente.
+ *
+ *	+ El callback se llama desde la ISR: tiene que ser corto. Desde él se
+ *	  puede volver a llamar a `push` (para encadenar lecturas periódicas,
+ *	  por ejemplo).
+ *
+ *  HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <cstdint>  // uint8_t
+#include <limits>
+
+namespace mcu{
+
+namespace impl_of{
+enum class TWI_transaction_state : uint8_t {
+    empty	    = 0, // no se ha metido en la cola
+    queued	    = 1,
+    running	    = 2,
+
+// done (>= ok)
+    ok		    = 3,
+
+// errors (> ok)
+    no_response	    = 4, // el slave no responde a SLA+W/R
+    data_nack	    = 5, // el slave contestó NACK a un byte enviado
+    bus_error	    = 6,
+    unknown_error   = 7
+};
+
+}// namespace impl_of
+
+
+// Configuración de TWI_master_queue
+// ---------------------------------
+template <typename Micro0, typename TWI0, uint8_t queue_size0>
+struct TWI_master_queue_cfg{
+    using Micro = Micro0;
+    using TWI   = TWI0;
+    static constexpr uint8_t queue_size = queue_size0;
+};
+
+
+template <typename Cfg>
+class TWI_master_queue{
+public:
+// Types
+    using Micro	     = Cfg::Micro;
+    using TWI	     = Cfg::TWI;
+    using streamsize = TWI::streamsize;
+    using Address    = TWI::Address;
+    using State	     = impl_of::TWI_transaction_state;
+
+// cfg data
+    static constexpr uint8_t queue_size = Cfg::queue_size;
+    static constexpr uint16_t max_time_out_us
+					= std::numeric_limits<uint16_t>::max();
+
+    // Descriptor de una transacción
+    class Transaction{
+    public:
+	using Callback = void (*)(Transaction&);
+
+	Transaction() = default;
+
+	// Envía buf[0, n) al slave
+	void write(Address slave, const uint8_t* buf, streamsize n)
+	{ write_read(slave, buf, n, nullptr, 0); }
+
+	// Lee n bytes del slave en buf[0, n)
+	void read(Address slave, uint8_t* buf, streamsize n)
+	{ write_read(slave, nullptr, 0, buf, n); }
+
+	// Envía wbuf[0, nw), envía un repeated start y lee rbuf[0, nr).
+	// Es la forma típica de leer un registro de un dispositivo.
+	void write_read(Address slave, const uint8_t* wbuf, streamsize nw,
+					     uint8_t* rbuf, streamsize nr)
+	{
+	    slave_ = slave;
+	    wbuf_ = wbuf;
+	    nwrite_ = nw;
+	    rbuf_ = rbuf;
+	    nread_ = nr;
+	}
+
+	// Función a la que llama la ISR cuando acaba la transacción
+	// (tanto si acaba bien como si no).
+	void on_done(Callback f) {callback_ = f;}
+
+	// Estado
+	State state() const {return state_;}
+	bool is_done() const {return state_ >= State::ok;}
+	bool is_pending() const
+	    {return state_ == State::queued or state_ == State::running;}
+
+	bool ok() const {return state_ == State::ok;}
+	bool error() const {return state_ > State::ok;}
+	bool no_response() const {return state_ == State::no_response;}
+	bool data_nack() const {return state_ == State::data_nack;}
+	bool bus_error() const {return state_ == State::bus_error;}
+
+	// Número de bytes enviados/recibidos.
+	// (útil para saber dónde falló la transacción)
+	streamsize nwritten() const {return iw_;}
+	streamsize nread() const {return ir_;}
+
+	Address slave() const {return slave_;}
+
+    private:
+	Address slave_{};
+
+	const uint8_t* wbuf_ = nullptr;
+	uint8_t* rbuf_ = nullptr;
+	streamsize nwrite_ = 0;
+	streamsize nread_  = 0;
+
+	// Los modifica la ISR
+	volatile streamsize iw_ = 0;
+	volatile streamsize ir_ = 0;
+	volatile State state_ = State::empty;
+
+	Callback callback_ = nullptr;
+
+	friend class TWI_master_queue;
+    };
+
+
+// turn_on
+    /// Enables TWI interface definiendo la frecuencia del SCL
+    /// a la que vamos a operar (ver TWI_master::turn_on).
+    template <uint16_t f_scl, uint32_t f_clock = Micro::clock_frequency_in_hz>
+    static void turn_on()
+    {
+	TWI::template SCL_frequency_in_kHz<f_scl, f_clock>();
+	Micro::enable_interrupts();
+
+	init();
+    }
+
+    /// Aborta todas las transacciones pendientes (las marca como
+    /// unknown_error, sin llamar a los callbacks) y reinicia el TWI.
+    static void reset();
+
+    /// Mete la transacción `t` en la cola. Si el bus está libre comienza a
+    /// ejecutarla.
+    /// Devuelve false si la cola está llena o si `t` ya está en la cola,
+    /// en cuyo caso no la mete.
+    static bool push(Transaction& t);
+
+    /// Número de transacciones pendientes (incluyendo la que se está
+    /// ejecutando).
+    static uint8_t size() {return n_;}
+
+    static bool is_full() {return n_ == queue_size;}
+
+    /// ¿Hay alguna transacción pendiente?
+    static bool is_busy() {return n_ != 0;}
+    static bool is_idle() {return n_ == 0;}
+
+    // Devuelve el número de microsegundos que quedaban para que venciera el
+    // timeout. Cuando vence el timeout devuelve 0.
+    static uint16_t wait_while_busy(uint16_t time_out_us = max_time_out_us);
+
+    // Función que va dentro de la ISR
+    static void handle_interrupt();
+
+private:
+// Data
+    // Cola circular de transacciones: [head_, head_ + n_)
+    static inline Transaction* queue_[queue_size];
+    static inline volatile uint8_t head_ = 0;
+    static inline volatile uint8_t n_    = 0;
+
+    // ¿Estamos en la fase de lectura de la transacción en curso?
+    static inline volatile bool reading_ = false;
+
+// Helper functions
+    static void init()
+    {
+	TWI::enable();
+	TWI::interrupt_disable();
+    }
+
+    static Transaction& current() {return *queue_[head_];}
+
+    static uint8_t next(uint8_t i)
+    { return (i + 1 == queue_size)? 0: i + 1; }
+
+    // Lanza la transacción que esté en la cabeza de la cola
+    static void start_current();
+
+    // Da por acabada la transacción en curso y pasa a la siguiente
+    static void end_current(State st);
+
+// Respuesta a las interrupciones
+    static void mm_start();
+    static void mtm_send_next_byte();
+    static void mrm_receive_next_byte();
+    static void mrm_data();
+};
+
+
+template <typename Cfg>
+bool TWI_master_queue<Cfg>::push(Transaction& t)
+{
+    typename Micro::Disable_interrupts lock;
+
+    if (n_ == queue_size or t.is_pending())
+	return false;
+
+    t.iw_ = 0;
+    t.ir_ = 0;
+    t.state_ = State::queued;
+
+    uint8_t tail = head_ + n_;
+    if (tail >= queue_size)
+	tail -= queue_size;
+
+    queue_[tail] = &t;
+    n_ = n_ + 1;
+
+    if (n_ == 1){ // el bus estaba libre
+	start_current();
+	TWI::master_transmit_start();
+	TWI::interrupt_enable();
+    }
+
+    return true;
+}
+
+
+template <typename Cfg>
+void TWI_master_queue<Cfg>::reset()
+{
+    typename Micro::Disable_interrupts lock;
+
+    for (uint8_t i = 0; i < n_; ++i){
+	queue_[head_]->state_ = State::unknown_error;
+	head_ = next(head_);
+    }
+
+    head_ = 0;
+    n_ = 0;
+    TWI::master_reset();
+    init();
+}
+
+
+template <typename Cfg>
+inline void TWI_master_queue<Cfg>::start_current()
+{
+    Transaction& t = current();
+    t.state_ = State::running;
+
+    // Una transacción solo de lectura empieza directamente con SLA+R
+    reading_ = (t.nwrite_ == 0 and t.nread_ != 0);
+}
+
+
+template <typename Cfg>
+void TWI_master_queue<Cfg>::end_current(State st)
+{
+    Transaction& t = current();
+
+    head_ = next(head_);
+    n_ = n_ - 1;
+
+    t.state_ = st;
+
+    if (n_ != 0){
+	start_current();
+
+	if (st == State::bus_error){
+	    TWI::recover_from_bus_error();
+	    TWI::master_transmit_start();
+	}
+	else
+	    TWI::master_transmit_stop_followed_by_start();
+    }
+
+    else {
+	if (st == State::bus_error)
+	    TWI::recover_from_bus_error();
+	else
+	    TWI::master_transmit_stop();
+
+	TWI::interrupt_disable();
+    }
+
+    // Llamamos al callback al final, una vez que el TWI ya está trabajando
+    // en la siguiente transacción. Así el callback puede hacer push.
+    if (t.callback_ != nullptr)
+	t.callback_(t);
+}
+
+
+template <typename Cfg>
+inline void TWI_master_queue<Cfg>::mm_start()
+{
+    Transaction& t = current();
+
+    if (reading_)
+	TWI::master_transmit_sla_r(t.slave_);
+    else
+	TWI::master_transmit_sla_w(t.slave_);
+}
+
+
+template <typename Cfg>
+void TWI_master_queue<Cfg>::mtm_send_next_byte()
+{
+    Transaction& t = current();
+
+    if (t.iw_ < t.nwrite_){
+	TWI::master_transmit_byte(t.wbuf_[t.iw_]);
+	t.iw_ = t.iw_ + 1;
+    }
+
+    else if (t.nread_ != 0){
+	reading_ = true;
+	TWI::master_transmit_repeated_start();
+    }
+
+    else
+	end_current(State::ok);
+}
+
+
+template <typename Cfg>
+inline void TWI_master_queue<Cfg>::mrm_receive_next_byte()
+{
+    Transaction& t = current();
+
+    if (t.ir_ + 1 == t.nread_)
+	TWI::master_receive_data_with_NACK();
+
+    else
+	TWI::master_receive_data_with_ACK();
+}
+
+
+template <typename Cfg>
+inline void TWI_master_queue<Cfg>::mrm_data()
+{
+    Transaction& t = current();
+
+    t.rbuf_[t.ir_] = TWI::data();
+    t.ir_ = t.ir_ + 1;
+}
+
+
+template <typename Cfg>
+void TWI_master_queue<Cfg>::handle_interrupt()
+{
+    using MM  = TWI::State::master_mode;
+    using MRM = TWI::State::master_receiver_mode;
+    using MTM = TWI::State::master_transmitter_mode;
+
+    if (n_ == 0){ // no debería de ocurrir
+	TWI::interrupt_disable();
+	return;
+    }
+
+    switch (TWI::status()){
+    // modos comunes a transmitter/receiver mode
+    // -----------------------------------------
+	case MM::start:
+	case MM::repeated_start:
+	    mm_start();
+	    break;
+
+	case MM::arbitration_lost:
+	    // Hemos perdido el bus: lo volvemos a intentar cuando quede libre
+	    current().iw_ = 0;
+	    current().ir_ = 0;
+	    start_current();
+	    TWI::master_transmit_start();
+	    break;
+
+
+    // master transmitter mode
+    // ----------------------
+	case MTM::sla_w_ack:
+	case MTM::data_ack:
+	    mtm_send_next_byte();
+	    break;
+
+	case MTM::sla_w_nack:
+	    end_current(State::no_response);
+	    break;
+
+	case MTM::data_nack:
+	    end_current(State::data_nack);
+	    break;
+
+
+    // master receiver mode
+    // -------------------
+	case MRM::sla_r_ack:
+	    mrm_receive_next_byte();
+	    break;
+
+	case MRM::sla_r_nack:
+	    end_current(State::no_response);
+	    break;
+
+	case MRM::data_ack:
+	    mrm_data();
+	    mrm_receive_next_byte();
+	    break;
+
+	case MRM::data_nack: // último byte
+	    mrm_data();
+	    end_current(State::ok);
+	    break;
+
+
+    // miscellaneous states
+    // --------------------
+	case TWI::State::bus_error:
+	    end_current(State::bus_error);
+            break;
+
+        default: // ¿Qué ha sucedido? ¡¡¡status desconocido!!!
+	    end_current(State::unknown_error);
+	    break;
+    }
+}
+
+
+template <typename Cfg>
+uint16_t TWI_master_queue<Cfg>::wait_while_busy(uint16_t time_out_us)
+{
+    uint16_t i = 0;
+    for (; i < time_out_us and is_busy(); ++i)
+	Micro::wait_us(1);
+
+    return (time_out_us - i);
+}
+
+
+}// namespace
+
+#endif
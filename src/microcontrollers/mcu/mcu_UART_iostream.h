@@ -52,12 +52,18 @@
  *	01/11/2024 Generalizado: lo parametrizo por el traductor de USART para 
  *		   poderlo usar con cualquier dispositivo UART.
  *
+ *	18/10/2026 UART_streambuf_buffered/UART_buffered_iostream
+ *	18/10/2026 UART_streambuf_buffered::xsputn copia bloques en el buffer
+ *	18/10/2026 Los buffers son atd::Spsc_ring
+ *
  *
  ****************************************************************************/
 #include <iostream>
 #include <streambuf>
 #include <atd_ascii.h>
+#include <atd_array.h>	// Spsc_ring
 #include <mcu_default_cfg.h>	// default_cfg
+#include <stdint.h>
 
 namespace mcu{
 
@@ -251,7 +257,7 @@ std::streamsize UART_streambuf_unbuffered<U>::xsgetn(char_type* s, std::streamsi
     for (; i < N; ++i){
 	int_type d = receive_byte();
 
-	if (!is_eof(d))
+	if (!traits_type::eq_int_type(d, traits_type::eof()))
 	    s[i] = traits_type::to_char_type(d);
 
 	else
@@ -350,6 +356,352 @@ std::streambuf::int_type UART_streambuf_unbuffered<U>::receive_byte()
 }
 
 
+/***************************************************************************
+ *			UART_streambuf_buffered
+ *
+ *  Flujo con buffers de transmisión y recepción gestionados por
+ *  interrupciones: escribir en el flujo no bloquea el programa mientras
+ *  quede sitio en el buffer de transmisión (la ISR UDRE va enviando los
+ *  bytes) y la ISR RXC va guardando los bytes recibidos en el buffer de
+ *  recepción.
+ *
+ *  Los buffers son atd::Spsc_ring (un único productor y un único
+ *  consumidor, uno de ellos es la ISR) por lo que no hace falta deshabilitar
+ *  las interrupciones para acceder a ellos (salvo en la política
+ *  overwrite).
+ *
+ *  Configuración:
+ *	struct UART_buffered_cfg{
+ *	    using Micro = myu::Micro;
+ *	    static constexpr uint8_t tx_buffer_size = 32; // potencia de 2
+ *	    static constexpr uint8_t rx_buffer_size = 16; // <= 128
+ *	    static constexpr auto tx_overflow = mcu::UART_overflow::block;
+ *	    static constexpr auto rx_overflow = mcu::UART_overflow::drop;
+ *	};
+ *
+ *  Hay que definir las ISRs:
+ *	ISR_USART_RX   { UART_iostream::handle_interrupt_unread_data(); }
+ *	ISR_USART_UDRE { UART_iostream::handle_interrupt_ready_to_transmit(); }
+ *
+ ***************************************************************************/
+// ¿Qué hacer cuando el buffer está lleno?
+enum class UART_overflow : uint8_t{
+    block,	// esperamos a que haya sitio. La ISR RXC no puede esperar: 
+		// en recepción es equivalente a drop.
+    drop,	// se descarta el nuevo byte
+    overwrite	// se descarta el byte más antiguo del buffer
+};
+
+
+
+
+template <typename UART_8bits, typename Cfg>
+class UART_streambuf_buffered : public std::streambuf {
+public:
+// Types
+    using UART  = UART_8bits;
+    using Micro = typename Cfg::Micro;
+
+    static constexpr uint8_t tx_buffer_size = Cfg::tx_buffer_size;
+    static constexpr uint8_t rx_buffer_size = Cfg::rx_buffer_size;
+    static constexpr UART_overflow tx_overflow = Cfg::tx_overflow;
+    static constexpr UART_overflow rx_overflow = Cfg::rx_overflow;
+
+// Constructor
+    // (RRR) igual que UART_streambuf_unbuffered no llama a init.
+    UART_streambuf_buffered() { setg(&buf_, &buf_ + 1, &buf_ + 1); }
+
+    // Enciende el UART y la interrupción de recepción.
+    // Recordar haberlo configurado y habilitado las interrupciones.
+    static void turn_on();
+    static void turn_off();
+
+// Interrupts
+    // Llamar desde ISR_USART_RX
+    static void handle_interrupt_unread_data();
+
+    // Llamar desde ISR_USART_UDRE
+    static void handle_interrupt_ready_to_transmit();
+
+// Info
+    // Número de bytes recibidos pendientes de leer
+    static uint8_t rx_size() {return rx_.size();}
+
+    // ¿Quedan bytes pendientes de enviar?
+    static bool tx_empty() {return tx_.empty();}
+
+    // Número de bytes descartados al estar lleno el buffer
+    static uint16_t tx_dropped();
+    static uint16_t rx_dropped();
+    static void reset_dropped();
+
+private:
+// Data
+    inline static atd::Spsc_ring<uint8_t, tx_buffer_size> tx_;
+    inline static atd::Spsc_ring<uint8_t, rx_buffer_size> rx_;
+
+    inline static volatile uint16_t tx_dropped_ = 0;
+    inline static volatile uint16_t rx_dropped_ = 0; // lo escribe la ISR
+
+    // get area de 1 byte
+    char_type buf_;
+
+// Buffer management
+    // Espera a que se envíe todo el buffer de transmisión.
+    virtual int sync() override;
+
+// Get area
+    virtual std::streamsize showmanyc() override {return rx_.size();}
+
+    // Espera a recibir un byte
+    virtual int_type underflow() override;
+
+    virtual std::streamsize xsgetn(char_type* s, std::streamsize N) override;
+
+    virtual int_type pbackfail(int_type c = traits_type::eof()) override
+    {return traits_type::eof();}
+
+// Put area
+    virtual int_type overflow(int_type c = traits_type::eof()) override
+    {
+	if (traits_type::eq_int_type(c, traits_type::eof()))
+	    return traits_type::not_eof(c);
+
+	put_(traits_type::to_char_type(c));
+	return c;
+    }
+
+    virtual std::streamsize xsputn(const char_type* s, std::streamsize n) override;
+
+// Helpers
+    static void put_(char_type c);
+
+    // Si las interrupciones están deshabilitadas (por ejemplo, si escribimos
+    // desde una ISR) las ISRs no pueden vaciar/llenar los buffers y
+    // esperar bloquearía el micro. Para evitarlo mientras esperamos
+    // hacemos nosotros el trabajo de las ISRs.
+    static void poll_transmit();
+    static void poll_receive();
+};
+
+
+template <typename U, typename C>
+inline void UART_streambuf_buffered<U, C>::turn_on()	
+{                                
+    if (!UART::is_receiver_enable())
+	UART::enable_receiver();
+
+    if (!UART::is_transmitter_enable())
+	UART::enable_transmitter();
+
+    UART::enable_interrupt_unread_data();
+}
+
+template <typename U, typename C>
+inline void UART_streambuf_buffered<U, C>::turn_off()	
+{                                
+    UART::disable_interrupt_unread_data();
+    UART::disable_interrupt_ready_to_transmit();
+
+    if (UART::is_receiver_enable())
+	UART::disable_receiver();
+
+    if (UART::is_transmitter_enable())
+	UART::disable_transmitter();
+}
+
+
+template <typename U, typename C>
+inline void UART_streambuf_buffered<U, C>::handle_interrupt_unread_data()
+{
+    uint8_t x = UART::receive_data_register();
+
+    if constexpr (rx_overflow == UART_overflow::overwrite){
+	if (!rx_.push_overwrite(x))
+	    rx_dropped_ = rx_dropped_ + 1;
+    }
+    else {
+	if (!rx_.push(x))
+	    rx_dropped_ = rx_dropped_ + 1;
+    }
+}
+
+
+template <typename U, typename C>
+inline void UART_streambuf_buffered<U, C>::handle_interrupt_ready_to_transmit()
+{
+    uint8_t x;
+    if (tx_.pop(x))
+	UART::transmit_data_register(x);
+    
+    else // no queda nada que enviar
+	UART::disable_interrupt_ready_to_transmit();
+}
+
+
+template <typename U, typename C>
+inline void UART_streambuf_buffered<U, C>::put_(char_type c)
+{
+    uint8_t x = static_cast<uint8_t>(c);
+
+    if constexpr (tx_overflow == UART_overflow::block){
+	while (!tx_.push(x))
+	    poll_transmit();
+    }
+
+    else if constexpr (tx_overflow == UART_overflow::drop){
+	if (!tx_.push(x))
+	    tx_dropped_ = tx_dropped_ + 1;
+    }
+
+    else { // overwrite
+	typename Micro::Disable_interrupts lock; // modificamos tail_
+	if (!tx_.push_overwrite(x))
+	    tx_dropped_ = tx_dropped_ + 1;
+    }
+
+    UART::enable_interrupt_ready_to_transmit();
+}
+
+
+// Copiamos en el buffer de transmisión todo lo que quepa de una vez
+// (excepto en overwrite, que tiene que descartar byte a byte).
+template <typename U, typename C>
+std::streamsize 
+    UART_streambuf_buffered<U, C>::xsputn(const char_type* s, std::streamsize n)
+{
+    if constexpr (tx_overflow == UART_overflow::overwrite){
+	for (std::streamsize i = 0; i < n; ++i)
+	    put_(s[i]);
+
+	return n;
+    }
+
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(s);
+    std::streamsize i = 0;
+    while (i < n){
+	std::streamsize k = n - i;
+	if (k > tx_buffer_size)
+	    k = tx_buffer_size;
+
+	i += tx_.push_n(p + i, static_cast<uint8_t>(k));
+
+	UART::enable_interrupt_ready_to_transmit();
+
+	if (i < n){
+	    if constexpr (tx_overflow == UART_overflow::block)
+		poll_transmit();
+
+	    else { // drop
+		tx_dropped_ = tx_dropped_ + static_cast<uint16_t>(n - i);
+		return n;
+	    }
+	}
+    }
+
+    return n;
+}
+
+
+template <typename U, typename C>
+inline void UART_streambuf_buffered<U, C>::poll_transmit()
+{
+    typename Micro::Disable_interrupts lock;
+    if (!tx_.empty() and UART::is_ready_to_transmit())
+	handle_interrupt_ready_to_transmit();
+}
+
+
+template <typename U, typename C>
+inline void UART_streambuf_buffered<U, C>::poll_receive()
+{
+    typename Micro::Disable_interrupts lock;
+    if (UART::are_there_unread_data())
+	handle_interrupt_unread_data();
+}
+
+
+template <typename U, typename C>
+inline int UART_streambuf_buffered<U, C>::sync()
+{
+    while (!tx_.empty())
+	poll_transmit();
+
+    return UART::flush(10); 
+}
+
+
+template <typename U, typename C>
+inline 
+std::streambuf::int_type UART_streambuf_buffered<U, C>::underflow() 
+{
+    uint8_t x;
+
+    if constexpr (rx_overflow == UART_overflow::overwrite){
+	// la ISR puede modificar tail_
+	while (true){
+	    {
+	    typename Micro::Disable_interrupts lock;
+	    if (rx_.pop(x))
+		break;
+	    }
+
+	    poll_receive();
+	}
+    }
+    else {
+	while (!rx_.pop(x))
+	    poll_receive();
+    }
+
+    if (static_cast<char_type>(x) == atd::ASCII::EOT)
+	return traits_type::eof();
+
+    buf_ = static_cast<char_type>(x);
+    setg(&buf_, &buf_, &buf_ + 1);
+
+    return traits_type::to_int_type(buf_);
+}
+
+
+template <typename U, typename C>
+inline std::streamsize 
+	UART_streambuf_buffered<U, C>::xsgetn(char_type* s, std::streamsize N) 
+{
+    std::streamsize i = 0;
+    for (; i < N; ++i){
+	int_type c = sbumpc();
+
+	if (traits_type::eq_int_type(c, traits_type::eof()))
+	    return i;
+
+	s[i] = traits_type::to_char_type(c);
+    }
+
+    return i;
+}
+
+
+template <typename U, typename C>
+uint16_t UART_streambuf_buffered<U, C>::tx_dropped()
+{ return tx_dropped_; } // solo lo modifica el programa principal
+
+template <typename U, typename C>
+uint16_t UART_streambuf_buffered<U, C>::rx_dropped()
+{
+    typename Micro::Disable_interrupts lock; // 16 bits modificados por la ISR
+    return rx_dropped_;
+}
+
+template <typename U, typename C>
+void UART_streambuf_buffered<U, C>::reset_dropped()
+{
+    typename Micro::Disable_interrupts lock;
+    tx_dropped_ = 0;
+    rx_dropped_ = 0;
+}
+
+
 /***************************************************************************
  *			    UART_iostream
  ***************************************************************************/
@@ -357,7 +709,7 @@ std::streambuf::int_type UART_streambuf_unbuffered<U>::receive_byte()
 template <typename UART_8bits>
 class UART_iostream : public std::iostream {
 public:
-    UART_iostream():iostream{&sb_} { }
+    UART_iostream():std::iostream{&sb_} { }
 
     template <typename Cfg = default_cfg::UART_8bits_9600_bauds>
     static bool init() {return UART_8bits::template init<Cfg>(); }
@@ -392,6 +744,47 @@ private:
 };
 
 
+/***************************************************************************
+ *			    UART_buffered_iostream
+ ***************************************************************************/
+// Igual que UART_iostream pero con UART_streambuf_buffered. 
+template <typename UART_8bits, typename Cfg>
+class UART_buffered_iostream : public std::iostream {
+public:
+    using streambuf = UART_streambuf_buffered<UART_8bits, Cfg>;
+
+    UART_buffered_iostream():std::iostream{&sb_} { }
+
+    template <typename Cfg_uart = default_cfg::UART_8bits_9600_bauds>
+    static bool init() {return UART_8bits::template init<Cfg_uart>(); }
+
+    /// Enciende el UART en caso de que estuviera apagado.
+    /// Recordar haber configurado el UART antes de llamar a esta función.
+    void turn_on() { sb_.turn_on(); }
+
+    void turn_off() { sb_.turn_off(); }
+
+    // Mira, SIN BLOQUEAR, si hay caracteres a leer.
+    bool is_there_something_to_read() { return streambuf::rx_size() != 0; }
+
+// Interrupts
+    static void handle_interrupt_unread_data()
+    { streambuf::handle_interrupt_unread_data(); }
+
+    static void handle_interrupt_ready_to_transmit()
+    { streambuf::handle_interrupt_ready_to_transmit(); }
+
+// Overflow
+    static uint16_t tx_dropped() {return streambuf::tx_dropped();}
+    static uint16_t rx_dropped() {return streambuf::rx_dropped();}
+    static void reset_dropped() {streambuf::reset_dropped();}
+
+private:
+    streambuf sb_;
+
+};
+
+
 
 }// namespace
 
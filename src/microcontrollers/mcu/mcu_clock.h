@@ -50,6 +50,7 @@
  *    26/02/2021 Basado en Generic_timer
  *    11/04/2022 Reestructurado. Chronometer_ms
  *    06/01/2023 Clock_s/Clock_ms
+ *    18/10/2026 as_date_time convertía now() en lugar de t
  *
  ****************************************************************************/
 
@@ -286,7 +287,7 @@ template <typename M, typename TC>
 Clock_s<M, TC>::Date_time Clock_s<M, TC>::as_date_time(const time_point& t)
 {
     Date_time dt;
-    dt.from_time_t(static_cast<std::time_t>(nseconds_));
+    dt.from_time_t(static_cast<std::time_t>(t.time_since_epoch().count()));
 
     return dt;
 }
@@ -29,6 +29,7 @@
  * HISTORIA
  *    Manuel Perez
  *    24/06/2024 connected_to_VCC, connected_to_GND, floating
+ *    18/10/2026 Pin_group_layout
  *
  ****************************************************************************/
 
@@ -106,7 +107,125 @@ template <typename Pin_t>
 struct Pin <Pin_t, false, false>
 { static_assert(false, "Wrong pin number"); };
 
- 
+
+/***************************************************************************
+ *			    PIN_GROUP_LAYOUT
+ ***************************************************************************/
+// Parte genérica de Pin_group: a partir del puerto y del bit de cada pin
+// calcula, en tiempo de compilación, cómo escribir un valor en el grupo
+// con el mínimo número de operaciones.
+//
+// El bit i del valor se escribe en el pin i del grupo. Para cada puerto
+// agrupamos los pines que hay que desplazar la misma cantidad:
+//
+//	    bits_del_puerto = (x & mask0) << shift0 | (x & mask1) >> shift1 ...
+//
+// Si los pines están conectados en orden (lo normal al soldar) cada puerto
+// se resuelve con un único desplazamiento.
+//
+// (RRR) ¿Por qué desplazamientos y no una tabla de 256 bytes en PROGMEM?
+//       Un grupo tiene como mucho 8 pines, así que hay como mucho 8
+//       términos (en la práctica 1 ó 2 por puerto). Son unas pocas
+//       instrucciones, menos que leer de la flash, y no gastamos memoria.
+//
+// Precondición: todos los pines son distintos y son como mucho 8.
+template <uint8_t N>
+struct Pin_group_layout{
+    static_assert(N > 0 and N <= 8, "Pin_group: from 1 to 8 pins");
+
+    struct Port{
+	uint8_t id;	// identificador del puerto (lo elige el micro)
+	uint8_t pin;	// índice (en el grupo) de un pin de este puerto
+	uint8_t mask;	// bits del puerto que pertenecen al grupo
+    };
+
+    struct Term{
+	uint8_t port;	// índice en port[]
+	int8_t shift;	// bit del puerto - bit del valor
+	uint8_t mask;	// bits del valor que se desplazan shift
+    };
+
+    Port port[N]{};
+    uint8_t nports = 0;
+
+    Term term[N]{};
+    uint8_t nterms = 0;
+
+    // id[i] = puerto del pin i; bit[i] = posición del pin i en el puerto
+    constexpr Pin_group_layout(const uint8_t (&id)[N], const uint8_t (&bit)[N]);
+
+    // Devuelve la posición de id en port[] (nports si no está)
+    constexpr uint8_t find_port(uint8_t id) const;
+};
+
+
+template <uint8_t N>
+constexpr uint8_t Pin_group_layout<N>::find_port(uint8_t id) const
+{
+    for (uint8_t p = 0; p < nports; ++p)
+	if (port[p].id == id)
+	    return p;
+
+    return nports;
+}
+
+template <uint8_t N>
+constexpr Pin_group_layout<N>::
+	Pin_group_layout(const uint8_t (&id)[N], const uint8_t (&bit)[N])
+{
+    for (uint8_t i = 0; i < N; ++i){
+	uint8_t p = find_port(id[i]);
+	if (p == nports){
+	    port[p] = Port{id[i], i, 0};
+	    ++nports;
+	}
+
+	port[p].mask |= static_cast<uint8_t>(1u << bit[i]);
+
+	int8_t shift = static_cast<int8_t>(bit[i] - i);
+
+	uint8_t t = 0;
+	while (t < nterms and !(term[t].port == p and term[t].shift == shift))
+	    ++t;
+
+	if (t == nterms){
+	    term[t] = Term{p, shift, 0};
+	    ++nterms;
+	}
+
+	term[t].mask |= static_cast<uint8_t>(1u << i);
+    }
+}
+
+
+// Devuelve los bits del puerto np correspondientes al valor x
+// (el resto de bits del puerto a 0).
+// Es recursiva para que el compilador vea todos los términos como
+// constantes y genere solo los desplazamientos necesarios.
+template <const auto& layout, uint8_t np, uint8_t k = 0>
+inline uint8_t pin_group_port_value(uint8_t x) __attribute__((always_inline));
+
+template <const auto& layout, uint8_t np, uint8_t k>
+inline uint8_t pin_group_port_value(uint8_t x)
+{
+    if constexpr (k == layout.nterms)
+	return 0;
+
+    else {
+	constexpr auto term = layout.term[k];
+	uint8_t res = pin_group_port_value<layout, np, k + 1>(x);
+
+	if constexpr (term.port == np){
+	    if constexpr (term.shift >= 0)
+		res |= static_cast<uint8_t>((x & term.mask) << term.shift);
+	    else
+		res |= static_cast<uint8_t>((x & term.mask) >> -term.shift);
+	}
+
+	return res;
+    }
+}
+
 
 }// namespace
 
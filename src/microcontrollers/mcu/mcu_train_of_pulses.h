@@ -28,10 +28,13 @@
  * HISTORIA
  *    Manuel Perez
  *    10/10/2023 Traído de IR remote control y generalizado.
+ *    18/10/2026 Train_of_pulses_isr_receiver usa un atd::Spsc_ring
+ *    18/10/2026 Train_of_pulses_capture_receiver
  *
  ****************************************************************************/
 #include "mcu_cycle.h"
 #include <atd_array.h>
+#include <atd_math.h>   // ceil_power_of_two
 
 namespace mcu{
 
@@ -83,6 +86,66 @@ inline Train_of_pulses<N>::Train_of_pulses()
 {}
 
 
+namespace impl_of{
+// Convierte los semiciclos en ciclos a medida que se van recibiendo.
+// Lo comparten todos los receivers que reciben semiciclos de una ISR.
+template <int16_t nmax_semicycles>
+struct Train_of_pulses_builder{
+    uint8_t polarity;
+    size_t npulses     = 0;	// pulsos copiados
+    int16_t nsemicycles = 0;	// semiciclos leídos
+    Semicycle first;	// primer semiciclo del pulso actual
+    bool ok = true;	// ¿se han recibido bien todos los pulsos?
+
+    bool is_done(size_t N) const
+    { return !ok or npulses == N or nsemicycles >= nmax_semicycles; }
+
+    template <size_t N>
+    void add(Train_of_pulses<N>& pulse, const Semicycle& s);
+
+    // Anota en pulse el número de pulsos recibidos y la polaridad.
+    template <size_t N>
+    void end(Train_of_pulses<N>& pulse) const
+    {
+	pulse.size(npulses);
+	pulse.polarity(polarity);
+    }
+};
+
+// Un pulso son dos semiciclos: el primero de nivel !polarity y el segundo
+// de nivel polarity. Si los niveles no son esos es que se han perdido
+// semiciclos.
+// Observar que en caso de que se haya recibido mal el último pulso, no lo
+// anotamos.
+template <int16_t M>
+template <size_t N>
+void Train_of_pulses_builder<M>::
+		    add(Train_of_pulses<N>& pulse, const Semicycle& s)
+{
+    ++nsemicycles;
+
+    if (nsemicycles % 2){ // primer semiciclo del pulso
+	first = s;
+	return;
+    }
+
+    if (first.level != polarity and s.level == polarity){
+	if (polarity){
+	    pulse[npulses].time_low  = first.time;
+	    pulse[npulses].time_high = s.time;
+	} else {
+	    pulse[npulses].time_high = first.time;
+	    pulse[npulses].time_low  = s.time;
+	}
+    }
+    else
+	ok = false;
+
+    ++npulses;
+}
+
+}// impl_of
+
 
 /***************************************************************************
  *			Train_of_pulses_isr_receiver
@@ -118,6 +181,11 @@ struct Train_of_pulses_isr_receiver_cfg{
 };
 
 // Por culpa de la callback tengo que definirlo todo como static.
+//
+// La ISR (productor) va dejando los semiciclos en un atd::Spsc_ring y
+// receive (consumidor) los va convirtiendo en ciclos mientras se reciben.
+// De esta forma no hace falta guardar todos los semiciclos: basta con un
+// buffer pequeño.
 template <typename Cfg>
 class Train_of_pulses_isr_receiver{
 public:
@@ -135,10 +203,19 @@ public:
     static void interrupt_callback();
 
 private:
+// Cfg
+    static constexpr auto time_overflow = Cfg::time_overflow;
+    static constexpr int16_t nmax_semicycles = Cfg::nmax_semicycles;
+
+    // (RRR) El consumidor solo tiene que ir un poco por detrás de la ISR.
+    //       Si se llena el buffer se pierden semiciclos y se detecta
+    //       gracias al level (ver interrupt_callback).
+    static constexpr size_t ring_size = atd::ceil_power_of_two(
+		    static_cast<size_t>(std::min<int16_t>(nmax_semicycles, 32)));
+
 // Data
-    inline static constexpr int16_t nmax_semicycles = Cfg::nmax_semicycles;
-    inline static volatile Semicycle semicycle[nmax_semicycles];
-    inline static volatile int16_t nsemipulse_;
+    inline static atd::Spsc_ring<Semicycle, ring_size> semicycle_;
+    inline static volatile bool started_; // ¿ha llegado el primer flanco?
 
 // Devices
     using Micro        = Cfg::Micro;
@@ -146,29 +223,16 @@ private:
     using Miniclock_us = Cfg::Miniclock_us;
     using Enable_interrupts = typename Micro::Enable_interrupts;
 
-// Cfg
-    static constexpr auto time_overflow = Cfg::time_overflow;
-
-
 // Functions
-    template <size_t N>
-    static uint16_t copy_polarity1( volatile Semicycle* semicycle
-				  , int16_t n
-				  , Train_of_pulses<N>& pulse);
+    using Copy_state = impl_of::Train_of_pulses_builder<nmax_semicycles>;
 
+    // Convierte en ciclos los semiciclos que haya en semicycle_
     template <size_t N>
-    static uint16_t copy_polarity0( volatile Semicycle* semicycle
-				  , int16_t n
-				  , Train_of_pulses<N>& pulse);
+    static void copy_pending(Train_of_pulses<N>& pulse, Copy_state& st);
 
-    // Devuelve el número de ciclos copiados
     template <size_t N>
-    static uint16_t copy( uint8_t polarity
-			, volatile Semicycle* semicycle
-			, int16_t n
-			, Train_of_pulses<N>& pulse);
-
-    static void receive_semicycles(volatile bool& abort);
+    static void receive_semicycles(Train_of_pulses<N>& pulse, Copy_state& st,
+							volatile bool& abort);
     
 };
 
@@ -180,88 +244,25 @@ template <size_t N>
 size_t Train_of_pulses_isr_receiver<Cfg>::
     receive(Train_of_pulses<N>& pulse, volatile bool& abort)
 {
-    uint8_t polarity = Pin::is_one();
-
-    receive_semicycles(abort);
-
-    size_t n = copy(polarity, semicycle, nsemipulse_, pulse);
-
-    pulse.size(n);
-    pulse.polarity(polarity);
-
-    return n;
-}
-
-
-// precondition: n > 0
-// Observar que en caso de que se haya recibido mal el último pulso, no lo
-// anotamos.
-template <typename C>
-template <size_t N>
-uint16_t Train_of_pulses_isr_receiver<C>::
-	copy_polarity1(
-		volatile Semicycle* semicycle
-		, int16_t n
-		, Train_of_pulses<N>& pulse)
-{
-    uint16_t size = std::min(static_cast<size_t>(n) / 2u, N);
-
-    for (uint16_t i = 0; i < size; ++i){
-	if (semicycle[2*i].level == 0 and semicycle[2*i + 1].level == 1){
-	    pulse[i].time_low  = semicycle[2*i].time;
-	    pulse[i].time_high = semicycle[2*i + 1].time;
-	}
-
-	else
-	    return i + 1;
-    }
-
-    return size;
-}
-
-
-// precondition: n > 0
-// Observar que en caso de que se haya recibido mal el último pulso, no lo
-// anotamos.
-template <typename C>
-template <size_t N>
-uint16_t Train_of_pulses_isr_receiver<C>::
-	copy_polarity0(
-		volatile Semicycle* semicycle
-		, int16_t n
-		, Train_of_pulses<N>& pulse)
-{
-    uint16_t size = std::min(static_cast<size_t>(n) / 2u, N);
+    Copy_state st;
+    st.polarity = Pin::is_one();
 
-    for (uint16_t i = 0; i < size; ++i){
-	if (semicycle[2*i].level == 1 and semicycle[2*i + 1].level == 0){
-	    pulse[i].time_high = semicycle[2*i].time;
-	    pulse[i].time_low  = semicycle[2*i + 1].time;
-	}
+    receive_semicycles(pulse, st, abort);
 
-	else
-	    return i + 1;
-    }
+    st.end(pulse);
 
-    return size;
+    return st.npulses;
 }
 
 
 template <typename C>
 template <size_t N>
-uint16_t Train_of_pulses_isr_receiver<C>::copy( uint8_t polarity
-		, volatile Semicycle* semicycle
-		, int16_t n
-		, Train_of_pulses<N>& pulse)
+inline void Train_of_pulses_isr_receiver<C>::
+	copy_pending(Train_of_pulses<N>& pulse, Copy_state& st)
 {
-    if (n <= 0)
-	return 0;
-
-    if (polarity)
-	return copy_polarity1(semicycle, n, pulse);
-
-    else
-	return copy_polarity0(semicycle, n, pulse);
+    Semicycle s;
+    while (!st.is_done(N) and semicycle_.pop(s))
+	st.add(pulse, s);
 }
 
 
@@ -269,9 +270,13 @@ uint16_t Train_of_pulses_isr_receiver<C>::copy( uint8_t polarity
  *			    IMPLEMENTACIÓN
  ***************************************************************************/
 template <typename C>
-void Train_of_pulses_isr_receiver<C>::receive_semicycles(volatile bool& abort)
+template <size_t N>
+void Train_of_pulses_isr_receiver<C>::
+    receive_semicycles(Train_of_pulses<N>& pulse, Copy_state& st,
+						    volatile bool& abort)
 {
-    nsemipulse_ = -1;
+    semicycle_.reset();
+    started_ = false;
 
     Pin::enable_change_level_interrupt();
 
@@ -280,12 +285,11 @@ void Train_of_pulses_isr_receiver<C>::receive_semicycles(volatile bool& abort)
     {// TODO: meter esto en una función? nombre?
 	Enable_interrupts lock; 
 
-	while (nsemipulse_ < 0 and !abort) { ; } // esperamos a recibir algo
+	while (!started_ and !abort) { ; } // esperamos a recibir algo
 
 	if (!abort){
-	    while (Miniclock_us::time() < time_overflow
-			and nsemipulse_ < nmax_semicycles)
-	    { ; }
+	    while (Miniclock_us::time() < time_overflow and !st.is_done(N))
+		copy_pending(pulse, st);
 	}
 
     }// ~Enable_interrupt
@@ -294,11 +298,11 @@ void Train_of_pulses_isr_receiver<C>::receive_semicycles(volatile bool& abort)
 
     Pin::disable_change_level_interrupt();
 
-// anotamos el último semiperiodo
-    semicycle[nsemipulse_].time = time_overflow;
-    semicycle[nsemipulse_].level = Pin::is_one();
+    copy_pending(pulse, st); // lo que haya quedado en el buffer
 
-    nsemipulse_ = nsemipulse_ + 1;
+// anotamos el último semiperiodo
+    if (!st.is_done(N))
+	st.add(pulse, Semicycle{time_overflow, Pin::is_one()});
 
 }
 
@@ -307,7 +311,7 @@ void Train_of_pulses_isr_receiver<C>::receive_semicycles(volatile bool& abort)
 //       Resulta que si se están enviando pulsos demasiado rápidos este método
 //       no lo va a detectar. El level sirve para detectar si se han omitido
 //       algunas interrupciones (por estar dentro de la ISR que llama 
-//       a esta función interrupt_callback).
+//       a esta función interrupt_callback, o por estar lleno el buffer).
 //
 // Mirando el código .asm esta interrupción lleva unas 50 instrucciones.
 // A 1MHz es posible que no pueda leer pulsos de menor longitud de 50 us.
@@ -319,15 +323,135 @@ template <typename C>
 inline  // inline ya que quiero que sea lo más eficiente posible la ISR.
 void Train_of_pulses_isr_receiver<C>::interrupt_callback()
 {
-    if (nsemipulse_ >= 0){
-	semicycle[nsemipulse_].time = Miniclock_us::unsafe_time();
-	semicycle[nsemipulse_].level= !Pin::is_one();
-    }
+    if (started_)
+	semicycle_.push(Semicycle{Miniclock_us::unsafe_time(), !Pin::is_one()});
+
+    else
+	started_ = true;
 
     Miniclock_us::unsafe_reset();
-    nsemipulse_ = nsemipulse_ + 1;
 }
 
+/***************************************************************************
+ *			Train_of_pulses_capture_receiver
+ *
+ *  Recibimos el tren de pulsos usando el input capture de un timer
+ *  (por ejemplo, Micro::Input_capture1). 
+ *
+ *  Ventajas
+ *	El hardware congela el valor del contador en el flanco, con lo que la
+ *	medida no depende de la latencia de la ISR ni de que el micro esté
+ *	atendiendo otra interrupción. Es la forma más precisa de medir los
+ *	pulsos (y la que mejor funciona a 1 MHz).
+ *
+ *  Desventajas
+ *	Solo funciona en el pin de input capture del timer (ICP1 en el
+ *	atmega328p).
+ *
+ *  Capture tiene que suministrar:
+ *	start(), stop(), is_started(), pin_level(),
+ *	pop(Capture::Semicycle&) con campos {ticks, level},
+ *	ticks_since_last_edge(), ticks_to_us(ticks).
+ *
+ *  El cliente es responsable de definir las ISRs del Capture.
+ ***************************************************************************/
+template <typename Micro0,
+	  typename Capture0, 
+	  int16_t num_max_pulses,
+	  uint16_t time_overflow0 = 60000>
+struct Train_of_pulses_capture_receiver_cfg{
+    using Micro   = Micro0;
+    using Capture = Capture0;
+
+    static constexpr int16_t nmax_semicycles = 2 * num_max_pulses;
+    static constexpr uint16_t time_overflow   = time_overflow0; // en us
+};
+
+
+template <typename Cfg>
+class Train_of_pulses_capture_receiver{
+public:
+    Train_of_pulses_capture_receiver() = delete;
+
+    // Devuelve el número de pulsos recibidos.
+    // Los tiempos de los pulsos están en microsegundos.
+    // Precondicion: el cliente llama a Pin::as_input_without_pullup
+    template <size_t N>
+    static size_t receive(Train_of_pulses<N>& pulse, volatile bool& abort);
+
+private:
+// Cfg
+    static constexpr uint16_t time_overflow  = Cfg::time_overflow;
+    static constexpr int16_t nmax_semicycles = Cfg::nmax_semicycles;
+
+// Devices
+    using Micro   = Cfg::Micro;
+    using Capture = Cfg::Capture;
+    using Enable_interrupts = typename Micro::Enable_interrupts;
+
+// Functions
+    using Copy_state = impl_of::Train_of_pulses_builder<nmax_semicycles>;
+
+    // Ticks del Capture a us, saturando en time_overflow.
+    static uint16_t to_us(uint32_t ticks)
+    {
+	uint32_t t = Capture::ticks_to_us(ticks);
+	return (t < time_overflow)? static_cast<uint16_t>(t): time_overflow;
+    }
+
+    template <size_t N>
+    static void copy_pending(Train_of_pulses<N>& pulse, Copy_state& st);
+};
+
+
+template <typename C>
+template <size_t N>
+inline void Train_of_pulses_capture_receiver<C>::
+	copy_pending(Train_of_pulses<N>& pulse, Copy_state& st)
+{
+    typename Capture::Semicycle s;
+    while (!st.is_done(N) and Capture::pop(s))
+	st.add(pulse, Semicycle{to_us(s.ticks), s.level});
+}
+
+
+template <typename C>
+template <size_t N>
+size_t Train_of_pulses_capture_receiver<C>::
+    receive(Train_of_pulses<N>& pulse, volatile bool& abort)
+{
+    Copy_state st;
+    st.polarity = Capture::pin_level();
+
+    Capture::start();
+
+    {
+	Enable_interrupts lock; 
+
+	while (!Capture::is_started() and !abort) { ; }
+
+	if (!abort){
+	    while (!st.is_done(N) and 
+		    to_us(Capture::ticks_since_last_edge()) < time_overflow)
+		copy_pending(pulse, st);
+	}
+
+    }// ~Enable_interrupt
+
+    Capture::stop();
+
+    copy_pending(pulse, st); // lo que haya quedado en el buffer
+
+// anotamos el último semiperiodo
+    if (!st.is_done(N))
+	st.add(pulse, Semicycle{time_overflow, Capture::pin_level()});
+
+    st.end(pulse);
+
+    return st.npulses;
+}
+
+
 /***************************************************************************
  *			Train_of_pulses_poll_receiver
  *
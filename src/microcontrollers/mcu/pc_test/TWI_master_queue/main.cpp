@@ -0,0 +1,456 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#include "../../mcu_TWI_master_queue.h"
+
+#include <alp_test.h>
+#include <alp_string.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <array>
+
+using namespace test;
+
+// Simulación del hardware
+// -----------------------
+namespace pru{
+
+struct Micro{
+    struct Disable_interrupts{ Disable_interrupts() { } };
+
+    static void enable_interrupts() { }
+    static void wait_us(uint16_t) { }
+
+    static constexpr uint32_t clock_frequency_in_hz = 1'000'000;
+};
+
+
+// Slave con un banco de registros: el primer byte escrito es el número de
+// registro; el resto de bytes escritos/leídos van a los registros
+// consecutivos.
+struct Slave{
+    std::array<uint8_t, 256> reg{};
+    uint8_t ptr = 0;
+    bool first = true;
+
+    // Número de bytes a partir del cual contesta NACK al escribir
+    // (0 = nunca)
+    int nack_after = 0;
+    int nwritten = 0;
+
+    Slave()
+    {
+	for (int i = 0; i < 256; ++i)
+	    reg[i] = static_cast<uint8_t>(i ^ 0x5A);
+    }
+
+    void start() { first = true; nwritten = 0; }
+
+    bool write(uint8_t x)
+    {
+	++nwritten;
+	if (first){
+	    ptr = x;
+	    first = false;
+	}
+	else
+	    reg[ptr++] = x;
+
+	return !(nack_after != 0 and nwritten >= nack_after);
+    }
+
+    uint8_t read() { return reg[ptr++]; }
+};
+
+
+// TWI que ejecuta instantáneamente cada orden: el status resultante queda
+// pendiente hasta que el test llama a la ISR (`tick`).
+struct TWI{
+    using streamsize = uint8_t;
+    using Address    = uint8_t;
+
+    struct State{
+	struct master_mode{
+	    static constexpr uint8_t start	      = 0x08;
+	    static constexpr uint8_t repeated_start   = 0x10;
+	    static constexpr uint8_t arbitration_lost = 0x38;
+	};
+
+	struct master_transmitter_mode{
+	    static constexpr uint8_t sla_w_ack  = 0x18;
+	    static constexpr uint8_t sla_w_nack = 0x20;
+	    static constexpr uint8_t data_ack   = 0x28;
+	    static constexpr uint8_t data_nack  = 0x30;
+	};
+
+	struct master_receiver_mode{
+	    static constexpr uint8_t sla_r_ack  = 0x40;
+	    static constexpr uint8_t sla_r_nack = 0x48;
+	    static constexpr uint8_t data_ack   = 0x50;
+	    static constexpr uint8_t data_nack  = 0x58;
+	};
+
+	static constexpr uint8_t bus_error = 0x00;
+	static constexpr uint8_t running   = 0xF8;
+    };
+
+    inline static std::map<uint8_t, Slave> slaves;
+    inline static std::string trace;	// qué ha pasado en el bus
+
+    inline static uint8_t status_ = State::running;
+    inline static bool pending_ = false; // ¿hay interrupción pendiente?
+    inline static bool interrupt_ = false;
+    inline static bool owner_ = false;   // ¿el master tiene el bus?
+    inline static Slave* slave_ = nullptr;
+    inline static uint8_t data_ = 0;
+
+    // Si != 0 el siguiente START da bus error
+    inline static int inject_bus_error = 0;
+
+    static void reset()
+    {
+	slaves.clear();
+	trace.clear();
+	status_ = State::running;
+	pending_ = interrupt_ = owner_ = false;
+	slave_ = nullptr;
+	inject_bus_error = 0;
+    }
+
+    template <uint16_t f_scl, uint32_t f_clock>
+    static void SCL_frequency_in_kHz() { }
+
+    static void enable() { }
+    static void master_reset() { pending_ = false; owner_ = false; }
+    static void interrupt_enable() {interrupt_ = true;}
+    static void interrupt_disable() {interrupt_ = false;}
+
+    static uint8_t status() {return status_;}
+    static uint8_t data() {return data_;}
+
+    static void master_transmit_start()
+    {
+	if (inject_bus_error){
+	    --inject_bus_error;
+	    trace += "E ";
+	    set(State::bus_error);
+	    return;
+	}
+
+	trace += owner_? "Sr ": "S ";
+	set(owner_? State::master_mode::repeated_start:
+		    State::master_mode::start);
+	owner_ = true;
+    }
+
+    static void master_transmit_repeated_start() {master_transmit_start();}
+
+    static void master_transmit_stop()
+    {
+	trace += "P ";
+	owner_ = false;
+	pending_ = false;   // STOP no genera interrupción
+    }
+
+    static void master_transmit_stop_followed_by_start()
+    {
+	master_transmit_stop();
+	master_transmit_start();
+    }
+
+    static void recover_from_bus_error()
+    {
+	owner_ = false;
+	pending_ = false;
+    }
+
+    static void master_transmit_sla_w(Address a) { sla(a, 'W'); }
+    static void master_transmit_sla_r(Address a) { sla(a, 'R'); }
+
+    static void master_transmit_byte(uint8_t x)
+    {
+	trace += "w" + std::to_string(x) + ' ';
+	if (slave_->write(x))
+	    set(State::master_transmitter_mode::data_ack);
+	else
+	    set(State::master_transmitter_mode::data_nack);
+    }
+
+    static void master_receive_data_with_ACK()
+    {
+	data_ = slave_->read();
+	trace += "r ";
+	set(State::master_receiver_mode::data_ack);
+    }
+
+    static void master_receive_data_with_NACK()
+    {
+	data_ = slave_->read();
+	trace += "rn ";
+	set(State::master_receiver_mode::data_nack);
+    }
+
+// Simulación de la interrupción
+    // Ejecuta la ISR si hay una interrupción pendiente.
+    template <typename ISR>
+    static bool tick()
+    {
+	if (!interrupt_ or !pending_)
+	    return false;
+
+	pending_ = false;
+	ISR::handle_interrupt();
+	return true;
+    }
+
+private:
+    static void set(uint8_t st)
+    {
+	status_ = st;
+	pending_ = true;
+    }
+
+    static void sla(Address a, char rw)
+    {
+	trace += std::to_string(a) + rw + ' ';
+
+	auto p = slaves.find(a);
+	bool ack = (p != slaves.end());
+
+	if (ack){
+	    slave_ = &p->second;
+	    if (rw == 'W')
+		slave_->start();
+	}
+
+	if (rw == 'W')
+	    set(ack? State::master_transmitter_mode::sla_w_ack:
+		     State::master_transmitter_mode::sla_w_nack);
+	else
+	    set(ack? State::master_receiver_mode::sla_r_ack:
+		     State::master_receiver_mode::sla_r_nack);
+    }
+};
+
+}// namespace pru
+
+
+using Cfg = mcu::TWI_master_queue_cfg<pru::Micro, pru::TWI, 4>;
+using TWI = mcu::TWI_master_queue<Cfg>;
+using Transaction = TWI::Transaction;
+
+constexpr uint8_t BME280 = 0x76;
+constexpr uint8_t DS1307 = 0x68;
+constexpr uint8_t SDD1306 = 0x3C;
+
+
+// Ejecuta las ISRs hasta vaciar la cola
+void run()
+{
+    for (int i = 0; i < 10000 and TWI::is_busy(); ++i)
+	pru::TWI::tick<TWI>();
+
+    CHECK_TRUE(TWI::is_idle(), "run: queue empty");
+    CHECK_TRUE(!pru::TWI::interrupt_, "run: interrupt disabled");
+}
+
+std::string order; // orden en que se llaman los callbacks
+
+void callback(Transaction& t) { order += std::to_string(t.slave()) + ' '; }
+
+void init()
+{
+    pru::TWI::reset();
+    pru::TWI::slaves[BME280];
+    pru::TWI::slaves[DS1307];
+    pru::TWI::slaves[SDD1306];
+    TWI::turn_on<100, 1'000'000>();
+    order.clear();
+}
+
+void test_back_to_back()
+{
+    test::interface("back to back");
+
+    init();
+
+    const uint8_t bme_reg[] = {0xF7};
+    uint8_t bme_data[3]{};
+
+    const uint8_t ds_reg[] = {0x00};
+    uint8_t ds_data[2]{};
+
+    const uint8_t sdd_cmd[] = {0x00, 0xAF, 0x20};
+
+    Transaction t0, t1, t2, t3;
+    t0.write_read(BME280, bme_reg, 1, bme_data, 3);
+    t1.write_read(DS1307, ds_reg, 1, ds_data, 2);
+    t2.write(SDD1306, sdd_cmd, 3);
+    t3.read(DS1307, ds_data, 1);	// continúa donde lo dejó t1
+
+    for (Transaction* t : {&t0, &t1, &t2, &t3})
+	t->on_done(callback);
+
+    CHECK_TRUE(TWI::push(t0), "push");
+    CHECK_TRUE(t0.is_pending() and !t0.is_done(), "is_pending");
+    CHECK_TRUE(TWI::push(t1), "push");
+    CHECK_TRUE(TWI::push(t2), "push");
+    CHECK_TRUE(TWI::push(t3), "push");
+    CHECK_TRUE(TWI::is_full(), "is_full");
+    CHECK_TRUE(TWI::size() == 4, "size");
+
+    // mientras la cola está llena no admite más
+    Transaction t4;
+    t4.write(SDD1306, sdd_cmd, 1);
+    CHECK_TRUE(!TWI::push(t4), "push (full)");
+    CHECK_TRUE(!TWI::push(t0), "push (already queued)");
+
+    run();
+
+    CHECK_TRUE(t0.ok() and t1.ok() and t2.ok() and t3.ok(), "ok");
+    CHECK_TRUE(order == "118 104 60 104 ", "callback order");
+
+    CHECK_TRUE(bme_data[0] == (0xF7 ^ 0x5A) and
+	       bme_data[1] == (0xF8 ^ 0x5A) and
+	       bme_data[2] == (0xF9 ^ 0x5A), "write_read data");
+    CHECK_TRUE(ds_data[0] == (0x02 ^ 0x5A), "read data");
+    CHECK_TRUE(t0.nwritten() == 1 and t0.nread() == 3, "nwritten/nread");
+
+    auto& sdd = pru::TWI::slaves[SDD1306];
+    CHECK_TRUE(sdd.reg[0] == 0xAF and sdd.reg[1] == 0x20, "write data");
+
+    CHECK_TRUE(pru::TWI::trace ==
+	    "S 118W w247 Sr 118R r r rn P "
+	    "S 104W w0 Sr 104R r rn P "
+	    "S 60W w0 w175 w32 P "
+	    "S 104R rn P ", "trace");
+}
+
+
+void test_errors()
+{
+    test::interface("errors");
+
+    init();
+    pru::TWI::slaves[SDD1306].nack_after = 2;
+
+    const uint8_t reg[] = {0x10, 0x11, 0x12};
+    uint8_t data[2]{};
+
+    Transaction t0, t1, t2, t3;
+    t0.write_read(0x50, reg, 1, data, 2); // no existe
+    t1.write(SDD1306, reg, 3);		  // NACK en el segundo byte
+    t2.read(0x51, data, 2);		  // no existe
+    t3.write_read(BME280, reg, 1, data, 2);
+
+    for (Transaction* t : {&t0, &t1, &t2, &t3}){
+	t->on_done(callback);
+	CHECK_TRUE(TWI::push(*t), "push");
+    }
+
+    run();
+
+    CHECK_TRUE(t0.no_response(), "no_response (SLA+W)");
+    CHECK_TRUE(t1.data_nack() and t1.nwritten() == 2, "data_nack");
+    CHECK_TRUE(t2.no_response(), "no_response (SLA+R)");
+    CHECK_TRUE(t3.ok(), "errors don't propagate");
+    CHECK_TRUE(data[0] == (0x10 ^ 0x5A) and data[1] == (0x11 ^ 0x5A),
+							    "data after errors");
+    CHECK_TRUE(order == "80 60 81 118 ", "callback order");
+    CHECK_TRUE(pru::TWI::trace ==
+	    "S 80W P "
+	    "S 60W w16 w17 P "
+	    "S 81R P "
+	    "S 118W w16 Sr 118R r rn P ", "trace");
+
+
+    // bus error
+    init();
+    pru::TWI::inject_bus_error = 1;
+
+    t0.write(BME280, reg, 1);
+    t1.write(DS1307, reg, 2);
+    CHECK_TRUE(TWI::push(t0), "push");
+    CHECK_TRUE(TWI::push(t1), "push");
+
+    run();
+
+    CHECK_TRUE(t0.bus_error(), "bus_error");
+    CHECK_TRUE(t1.ok(), "after bus_error");
+    CHECK_TRUE(pru::TWI::trace == "E S 104W w16 w17 P ", "trace");
+}
+
+
+// Un callback puede volver a meter transacciones en la cola
+Transaction periodic;
+const uint8_t periodic_reg[] = {0x00};
+uint8_t periodic_data[1];
+int nperiodic = 0;
+
+void periodic_callback(Transaction& t)
+{
+    if (++nperiodic < 3)
+	TWI::push(t);
+}
+
+void test_push_from_callback()
+{
+    test::interface("push from callback");
+
+    init();
+
+    periodic.write_read(DS1307, periodic_reg, 1, periodic_data, 1);
+    periodic.on_done(periodic_callback);
+    CHECK_TRUE(TWI::push(periodic), "push");
+
+    run();
+    CHECK_TRUE(nperiodic == 3 and periodic.ok(), "push from callback");
+    CHECK_TRUE(pru::TWI::trace ==
+	    "S 104W w0 Sr 104R rn P "
+	    "S 104W w0 Sr 104R rn P "
+	    "S 104W w0 Sr 104R rn P ", "trace");
+
+    // reset aborta lo pendiente
+    Transaction t;
+    t.write(0x50, periodic_reg, 1);
+    CHECK_TRUE(TWI::push(t), "push");
+    TWI::reset();
+    CHECK_TRUE(TWI::is_idle() and t.error(), "reset");
+}
+
+
+int main()
+{
+try{
+    test::header("TWI_master_queue");
+
+    test_back_to_back();
+    test_errors();
+    test_push_from_callback();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
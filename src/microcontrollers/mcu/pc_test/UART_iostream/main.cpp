@@ -0,0 +1,322 @@
+// Copyright (C) 2026 Manuel Perez 
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#include "../../mcu_UART_iostream.h"
+
+#include <alp_test.h>
+#include <alp_string.h>
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <random>
+
+using namespace test;
+
+// Simulación del hardware
+// -----------------------
+namespace pru{
+
+struct Micro{
+    struct Disable_interrupts{ Disable_interrupts() { } };
+};
+
+// UART que transmite instantáneamente cuando está preparado.
+// Simulamos el tiempo que tarda en enviar/recibir con `ready_`.
+struct UART_8bits{
+    inline static std::vector<uint8_t> wire_out;    // bytes enviados
+    inline static std::deque<uint8_t> wire_in;	    // bytes que llegan
+
+    inline static bool rx_enable = false;
+    inline static bool tx_enable = false;
+    inline static bool rxc_interrupt  = false;
+    inline static bool udre_interrupt = false;
+
+    inline static std::mt19937 gen{1234};
+
+    static void reset()
+    {
+	wire_out.clear();
+	wire_in.clear();
+	rxc_interrupt = udre_interrupt = false;
+    }
+
+    static void enable_receiver() {rx_enable = true;}
+    static void disable_receiver() {rx_enable = false;}
+    static bool is_receiver_enable() {return rx_enable;}
+
+    static void enable_transmitter() {tx_enable = true;}
+    static void disable_transmitter() {tx_enable = false;}
+    static bool is_transmitter_enable() {return tx_enable;}
+
+    static uint8_t receive_data_register() 
+    { 
+	uint8_t x = wire_in.front();
+	wire_in.pop_front();
+	return x;
+    }
+
+    static bool are_there_unread_data() {return !wire_in.empty();}
+
+    static void transmit_data_register(uint8_t c) {wire_out.push_back(c);}
+
+    // La mitad de las veces el data register está ocupado
+    static bool is_ready_to_transmit() {return gen() % 2;}
+
+    static int flush(uint16_t) {return 0;}
+
+    static void enable_interrupt_unread_data() {rxc_interrupt = true;}
+    static void disable_interrupt_unread_data() {rxc_interrupt = false;}
+
+    static void enable_interrupt_ready_to_transmit() {udre_interrupt = true;}
+    static void disable_interrupt_ready_to_transmit() {udre_interrupt = false;}
+};
+
+template <mcu::UART_overflow tx, mcu::UART_overflow rx>
+struct Cfg{
+    using Micro = pru::Micro;
+    static constexpr uint8_t tx_buffer_size = 16;
+    static constexpr uint8_t rx_buffer_size = 8;
+    static constexpr mcu::UART_overflow tx_overflow = tx;
+    static constexpr mcu::UART_overflow rx_overflow = rx;
+};
+
+// Simulamos que el hardware genera las interrupciones
+template <typename Stream>
+void isr_tick()
+{
+    if (UART_8bits::udre_interrupt and UART_8bits::is_ready_to_transmit())
+	Stream::handle_interrupt_ready_to_transmit();
+
+    if (UART_8bits::rxc_interrupt and UART_8bits::are_there_unread_data())
+	Stream::handle_interrupt_unread_data();
+}
+
+}// pru
+
+using UART = pru::UART_8bits;
+using mcu::UART_overflow;
+
+template <UART_overflow tx, UART_overflow rx>
+using UART_iostream = mcu::UART_buffered_iostream<UART, pru::Cfg<tx, rx>>;
+
+
+// Escribimos bytes intercalando aleatoriamente las interrupciones
+template <typename Stream>
+std::vector<uint8_t> write_random(Stream& uart, size_t n)
+{
+    std::vector<uint8_t> msg;
+    for (size_t i = 0; i < n; ++i){
+	uint8_t x = static_cast<uint8_t>(UART::gen());
+	msg.push_back(x);
+	uart.put(x);
+
+	for (auto k = UART::gen() % 3; k > 0; --k)
+	    pru::isr_tick<Stream>();
+    }
+
+    return msg;
+}
+
+// ¿Es a subsecuencia de b?
+bool is_subsequence(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b)
+{
+    size_t j = 0;
+    for (size_t i = 0; i < b.size() and j < a.size(); ++i)
+	if (a[j] == b[i]) ++j;
+
+    return j == a.size();
+}
+
+
+void test_tx_block()
+{
+    test::interface("tx block");
+
+    using Uart = UART_iostream<UART_overflow::block, UART_overflow::drop>;
+    UART::reset();
+    Uart uart;
+    uart.turn_on();
+
+    auto msg = write_random(uart, 10000);
+    uart.flush();
+
+    CHECK_TRUE(UART::wire_out == msg, "block: no se pierde nada");
+    CHECK_TRUE(Uart::tx_dropped() == 0, "tx_dropped");
+
+    // Escribimos sin que haya interrupciones (como si escribiéramos desde
+    // una ISR): no se tiene que bloquear.
+    UART::reset();
+    uart << "Esto no cabe en el buffer de 16 bytes";
+    uart.flush();
+    std::string res{UART::wire_out.begin(), UART::wire_out.end()};
+    CHECK_TRUE(res == "Esto no cabe en el buffer de 16 bytes", 
+						    "block sin interrupciones");
+}
+
+void test_tx_drop()
+{
+    test::interface("tx drop");
+
+    using Uart = UART_iostream<UART_overflow::drop, UART_overflow::drop>;
+    UART::reset();
+    Uart uart;
+    uart.turn_on();
+    Uart::reset_dropped();
+
+    auto msg = write_random(uart, 10000);
+    while (UART::udre_interrupt)
+	pru::isr_tick<Uart>();
+
+    CHECK_TRUE(UART::wire_out.size() + Uart::tx_dropped() == msg.size(),
+						"drop: enviados + dropped");
+    CHECK_TRUE(Uart::tx_dropped() > 0, "drop: dropped");
+    CHECK_TRUE(is_subsequence(UART::wire_out, msg), "drop: en orden");
+
+    // Escribimos de golpe (xsputn) sin interrupciones: se copia lo que
+    // cabe en el buffer y se descarta el resto
+    UART::reset();
+    Uart::reset_dropped();
+    uart << "0123456789abcdefghijklmnopqrstuvwxyz";
+    while (UART::udre_interrupt)
+	pru::isr_tick<Uart>();
+
+    std::string res{UART::wire_out.begin(), UART::wire_out.end()};
+    CHECK_TRUE(res == "0123456789abcdef", "drop: xsputn");
+    CHECK_TRUE(Uart::tx_dropped() == 36 - 16, "drop: xsputn dropped");
+}
+
+void test_tx_overwrite()
+{
+    test::interface("tx overwrite");
+
+    using Uart = UART_iostream<UART_overflow::overwrite, UART_overflow::drop>;
+    UART::reset();
+    Uart uart;
+    uart.turn_on();
+    Uart::reset_dropped();
+
+    auto msg = write_random(uart, 10000);
+    while (UART::udre_interrupt)
+	pru::isr_tick<Uart>();
+
+    CHECK_TRUE(UART::wire_out.size() + Uart::tx_dropped() == msg.size(),
+					    "overwrite: enviados + dropped");
+    CHECK_TRUE(is_subsequence(UART::wire_out, msg), "overwrite: en orden");
+
+    // Los últimos bytes escritos siempre se envían
+    CHECK_TRUE(std::equal(msg.end() - 16, msg.end(), UART::wire_out.end() - 16),
+					    "overwrite: últimos bytes");
+}
+
+
+template <UART_overflow rx>
+void test_rx(const char* name)
+{
+    test::interface(name);
+
+    using Uart = UART_iostream<UART_overflow::block, rx>;
+    UART::reset();
+    Uart uart;
+    uart.turn_on();
+    Uart::reset_dropped();
+
+    std::vector<uint8_t> msg;
+    std::vector<uint8_t> received;
+    for (int i = 0; i < 10000; ++i){
+	// Llegan entre 0 y 3 bytes ...
+	for (auto k = UART::gen() % 4; k > 0; --k){
+	    uint8_t x = static_cast<uint8_t>(UART::gen());
+	    if (x == atd::ASCII::EOT) x = 0;
+	    msg.push_back(x);
+	    UART::wire_in.push_back(x);
+	    pru::isr_tick<Uart>();
+	}
+
+	// ... y leemos los que haya (a veces no leemos ninguno)
+	if (UART::gen() % 2){
+	    while (uart.is_there_something_to_read()){
+		char c;
+		uart.get(c);
+		received.push_back(static_cast<uint8_t>(c));
+	    }
+	}
+    }
+
+    while (UART::are_there_unread_data())
+	pru::isr_tick<Uart>();
+
+    while (uart.is_there_something_to_read()){
+	char c;
+	uart.get(c);
+	received.push_back(static_cast<uint8_t>(c));
+    }
+
+    CHECK_TRUE(received.size() + Uart::rx_dropped() == msg.size(),
+						    "rx: recibidos + dropped");
+    CHECK_TRUE(Uart::rx_dropped() > 0, "rx: dropped");
+    CHECK_TRUE(is_subsequence(received, msg), "rx: en orden");
+
+    if constexpr (rx == UART_overflow::overwrite)
+	CHECK_TRUE(std::equal(msg.end() - 8, msg.end(), received.end() - 8),
+					    "rx overwrite: últimos bytes");
+}
+
+void test_rx_blocking_read()
+{
+    test::interface("rx lectura bloqueante");
+
+    using Uart = UART_iostream<UART_overflow::block, UART_overflow::drop>;
+    UART::reset();
+    Uart uart;
+    uart.turn_on();
+
+    // Sin interrupciones: la lectura tiene que leer directamente del UART
+    for (char c : std::string{"123 abc\n"})
+	UART::wire_in.push_back(c);
+
+    int x = 0;
+    std::string s;
+    uart >> x >> s;
+    CHECK_TRUE(x == 123, "operator>>(int)");
+    CHECK_TRUE(s == "abc", "operator>>(string)");
+}
+
+
+int main()
+{
+try{
+    test::header("UART_buffered_iostream");
+
+    test_tx_block();
+    test_tx_drop();
+    test_tx_overwrite();
+    test_rx<UART_overflow::drop>("rx drop");
+    test_rx<UART_overflow::overwrite>("rx overwrite");
+    test_rx_blocking_read();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
+
+
@@ -0,0 +1,129 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../mcu_pin.h"
+
+#include <alp_test.h>
+
+#include <iostream>
+
+using namespace test;
+
+// Simulamos un micro con los puertos A, B, C: escribimos el valor en los
+// puertos tal como lo haría Pin_group y comprobamos que cada bit llega a
+// su pin.
+template <const auto& layout, uint8_t np = 0>
+void write(uint8_t x, uint8_t (&port)[3])
+{
+    if constexpr (np < layout.nports){
+	uint8_t id   = layout.port[np].id - 'A';
+	uint8_t mask = layout.port[np].mask;
+	port[id] = (port[id] & ~mask) | mcu::pin_group_port_value<layout, np>(x);
+
+	write<layout, np + 1>(x, port);
+    }
+}
+
+template <const auto& layout, uint8_t N>
+bool check_all_values(const uint8_t (&id)[N], const uint8_t (&bit)[N])
+{
+    for (unsigned x = 0; x < 256; ++x){
+	uint8_t port[3] = {0x5A, 0xA5, 0x3C};
+	uint8_t expected[3] = {0x5A, 0xA5, 0x3C};
+
+	for (uint8_t i = 0; i < N; ++i){
+	    uint8_t& p = expected[id[i] - 'A'];
+	    if ((x >> i) & 1)
+		p |= (1 << bit[i]);
+	    else
+		p &= ~(1 << bit[i]);
+	}
+
+	write<layout>(static_cast<uint8_t>(x), port);
+
+	for (uint8_t p = 0; p < 3; ++p)
+	    if (port[p] != expected[p])
+		return false;
+    }
+
+    return true;
+}
+
+
+// Dos puertos, pines en orden: un desplazamiento por puerto
+constexpr uint8_t id0[]  = {'B', 'B', 'B', 'B', 'B', 'C', 'C', 'C'};
+constexpr uint8_t bit0[] = { 1,   2,   3,   4,   5,   0,   1,   2};
+constexpr mcu::Pin_group_layout<8> layout0{id0, bit0};
+
+// Puerto entero en orden inverso: 8 desplazamientos diferentes
+constexpr uint8_t id1[]  = {'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A'};
+constexpr uint8_t bit1[] = { 7,   6,   5,   4,   3,   2,   1,   0};
+constexpr mcu::Pin_group_layout<8> layout1{id1, bit1};
+
+// Tres puertos desordenados
+constexpr uint8_t id2[]  = {'C', 'A', 'C', 'B', 'A'};
+constexpr uint8_t bit2[] = { 5,   0,   7,   3,   1};
+constexpr mcu::Pin_group_layout<5> layout2{id2, bit2};
+
+// Un solo pin
+constexpr uint8_t id3[]  = {'B'};
+constexpr uint8_t bit3[] = { 7 };
+constexpr mcu::Pin_group_layout<1> layout3{id3, bit3};
+
+void test_layout()
+{
+    test::interface("Pin_group_layout");
+
+    static_assert(layout0.nports == 2);
+    static_assert(layout0.nterms == 2);
+    static_assert(layout0.port[0].id == 'B' and layout0.port[0].mask == 0x3E);
+    static_assert(layout0.port[1].id == 'C' and layout0.port[1].mask == 0x07);
+    static_assert(layout0.port[1].pin == 5);
+    static_assert(layout0.term[0].shift == 1 and layout0.term[0].mask == 0x1F);
+    static_assert(layout0.term[1].shift == -5 and layout0.term[1].mask == 0xE0);
+
+    static_assert(layout1.nports == 1 and layout1.port[0].mask == 0xFF);
+    static_assert(layout1.nterms == 8);
+
+    static_assert(layout2.nports == 3);
+    static_assert(layout2.nterms == 4);	// C5 y C7 tienen el mismo shift
+
+    CHECK_TRUE((check_all_values<layout0>(id0, bit0)), "2 puertos en orden");
+    CHECK_TRUE((check_all_values<layout1>(id1, bit1)), "orden inverso");
+    CHECK_TRUE((check_all_values<layout2>(id2, bit2)), "3 puertos");
+    CHECK_TRUE((check_all_values<layout3>(id3, bit3)), "1 pin");
+}
+
+
+
+int main()
+{
+try{
+    test::header("mcu_pin");
+
+    test_layout();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
+
+
@@ -17,59 +17,38 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
-// Es más eficiente y más sencillo de implementar usando los puertos
-// (ver ejemplo de port/POV_toy). Sin embargo, es más fácil soldar con estas
-// conexiones.
+// Los leds están conectados a dos puertos (PB1-PB5 y PC0-PC2) porque es más
+// fácil de soldar. Pin_group escribe los 8 leds con una escritura por
+// puerto en lugar de pin a pin.
 #include <mega.h>
 
 // prj_dev.h
 namespace my_mcu = atmega;
 using Micro = my_mcu::Micro;
 
+using Leds = my_mcu::hwd::Pin_group<15, 16, 17, 18, 19, 23, 24, 25>;
+
 class Main_app{
 public:
+    Main_app() { Leds::as_output(); }
+
     void run();
 
 private:
-    atmega::hwd::Output_pin<15> p1_;
-    atmega::hwd::Output_pin<16> p2_;
-    atmega::hwd::Output_pin<17> p3_;
-    atmega::hwd::Output_pin<18> p4_;
-    atmega::hwd::Output_pin<19> p5_;
-    atmega::hwd::Output_pin<23> p6_;
-    atmega::hwd::Output_pin<24> p7_;
-    atmega::hwd::Output_pin<25> p8_;
-
     void POVDisplay(uint8_t fila_glyph);
     void clear();
 };
 
 void Main_app::POVDisplay(uint8_t fila_glyph)
 {
-    p1_.write(fila_glyph & 0b00000001);
-    p2_.write(fila_glyph & 0b00000010);
-    p3_.write(fila_glyph & 0b00000100);
-    p4_.write(fila_glyph & 0b00001000);
-    p5_.write(fila_glyph & 0b00010000);
-    p6_.write(fila_glyph & 0b00100000);
-    p7_.write(fila_glyph & 0b01000000);
-    p8_.write(fila_glyph & 0b10000000);
+    Leds::write(fila_glyph);
 
     Micro::wait_ms(2);
 }
 
 
 void Main_app::clear()
-{
-    p1_.write_zero();
-    p2_.write_zero();
-    p3_.write_zero();
-    p4_.write_zero();
-    p5_.write_zero();
-    p6_.write_zero();
-    p7_.write_zero();
-    p8_.write_zero();
-}
+{ Leds::write(0); }
 
 
 
@@ -0,0 +1,57 @@
+// Copyright (C) 2026 Manuel Perez 
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Decodifica un volcado binario (de la EEPROM o de la SD) grabado por
+// dlog::Writer, imprimiendo una muestra por línea:
+//	t  value[0]  value[1] ...
+//
+// Uso: log_decoder fichero.bin
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "../prj_log.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2){
+	std::cerr << "Usage: " << argv[0] << " file.bin\n";
+	return 1;
+    }
+
+    std::ifstream in{argv[1], std::ios::binary};
+    if (!in){
+	std::cerr << "Can't open [" << argv[1] << "]\n";
+	return 1;
+    }
+
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>{in},
+			      std::istreambuf_iterator<char>{}};
+
+    auto stats = dlog::decode(data, [](uint32_t t, std::span<const int16_t> v){
+			std::cout << t;
+			for (int16_t x: v)
+			    std::cout << '\t' << x;
+			std::cout << '\n';
+		    });
+
+    std::cerr << stats.nsamples << " samples; " << stats.nblocks 
+	      << " blocks; " << stats.nskipped << " bytes skipped\n";
+}
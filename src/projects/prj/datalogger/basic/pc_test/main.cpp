@@ -25,9 +25,13 @@
 #include <string_view>
 #include <cstring>  // strlen
 #include <cctype>   // isdigit
+#include <algorithm> // search
 
 #include <cstddef>
+#include <sstream>
+#include <vector>
 #include "../prj_locale.h"
+#include "../prj_log.h"
 
 using namespace test;
 
@@ -166,6 +170,113 @@ void test_convert()
     test_convert("43s", 0, 0, 43, true);
 }
 
+// Log
+// ---
+struct Sample{
+    uint32_t t;
+    int16_t T;
+    int16_t H;
+
+    bool operator==(const Sample&) const = default;
+};
+
+std::vector<Sample> generate_samples(size_t n)
+{
+    std::vector<Sample> res;
+    uint32_t t = 1'700'000'000;
+    int16_t T = 215, H = 450;
+    for (size_t i = 0; i < n; ++i){
+	res.push_back(Sample{t, T, H});
+	t += 60 + (i % 3);
+	T = static_cast<int16_t>(T + (i % 5) - 2);
+	H = static_cast<int16_t>(H - (i % 7) + 3);
+    }
+
+    // valores extremos y reloj hacia atrás
+    res.push_back(Sample{t, -32768, 32767});
+    res.push_back(Sample{t + 1, 32767, -32768});
+    res.push_back(Sample{t - 3600, 0, 0});
+
+    return res;
+}
+
+std::vector<uint8_t> write_log(const std::vector<Sample>& sample)
+{
+    std::ostringstream out;
+    dlog::Writer<2> log{out};
+    for (auto& s: sample){
+	int16_t v[2] = {s.T, s.H};
+	CHECK_TRUE(log.write(s.t, v), "write");
+    }
+    CHECK_TRUE(log.flush(), "flush");
+
+    std::string str = out.str();
+    return std::vector<uint8_t>(str.begin(), str.end());
+}
+
+std::vector<Sample> read_log(std::span<const uint8_t> data, 
+						    dlog::Read_stats& stats)
+{
+    std::vector<Sample> res;
+    stats = dlog::decode(data, [&](uint32_t t, std::span<const int16_t> v){
+		CHECK_TRUE(v.size() == 2, "nchannels");
+		res.push_back(Sample{t, v[0], v[1]});
+	    });
+
+    return res;
+}
+
+void test_log()
+{
+    test::interface("dlog");
+
+    CHECK_TRUE(dlog::unzigzag(dlog::zigzag(-1)) == -1, "zigzag");
+    CHECK_TRUE(dlog::zigzag(-1) == 1 and dlog::zigzag(1) == 2, "zigzag");
+
+    auto sample = generate_samples(500);
+    auto data   = write_log(sample);
+
+    dlog::Read_stats stats;
+    auto res = read_log(data, stats);
+    CHECK_TRUE(res == sample, "round trip");
+    CHECK_TRUE(stats.nskipped == 0, "nskipped");
+
+    // Todos los bloques ocupan block_size bytes: alineados a página
+    constexpr size_t block_size = dlog::Writer<2>::block_size;
+    CHECK_TRUE(data.size() % block_size == 0, "padding");
+    bool aligned = true;
+    for (size_t i = 0; i < data.size(); i += block_size){
+	if (data[i] != dlog::sync0 or data[i + 1] != dlog::sync1)
+	    aligned = false;
+    }
+    CHECK_TRUE(aligned, "padding: one block per page");
+    CHECK_TRUE(stats.nblocks == data.size() / block_size, "padding");
+
+    // Cada muestra en texto ocupa unos 20 bytes
+    std::cout << sample.size() << " samples in " << data.size() << " bytes ("
+	      << stats.nblocks << " blocks)\n";
+    CHECK_TRUE(data.size() < 5 * sample.size(), "size");
+
+{// basura al principio, bloque corrupto y final cortado (power loss)
+    std::vector<uint8_t> bad = {0xFF, dlog::sync0, dlog::sync1, 0x00};
+    size_t b0 = bad.size();
+    bad.insert(bad.end(), data.begin(), data.end());
+    bad[b0 + 20] ^= 0x01;	// primer bloque corrupto
+    // último bloque incompleto
+    bad.resize(bad.size() - block_size + dlog::header_size + 1);
+
+    auto res2 = read_log(bad, stats);
+    CHECK_TRUE(stats.nblocks >= 2 and stats.nskipped > 0, "recovery");
+
+    // Las muestras leídas son las correctas de los bloques intermedios
+    auto p = std::search(sample.begin(), sample.end(),
+						res2.begin(), res2.end());
+    CHECK_TRUE(!res2.empty() and p != sample.end(), "recovery");
+    CHECK_TRUE(res2.size() < sample.size(), "recovery");
+}
+}
+
+
 int main()
 {
 try{
@@ -177,6 +288,9 @@ try{
 
     test_convert();
 
+    test::header("log");
+    test_log();
+
 }catch(std::exception& e)
 {
     std::cerr << e.what() << '\n';
@@ -0,0 +1,413 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#pragma once
+
+#ifndef __PRJ_LOG_H__
+#define __PRJ_LOG_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Formato binario para guardar las medidas del datalogger.
+ *
+ *    Imprimiendo las medidas en texto cada muestra ocupa unas 5 veces más
+ *    que en binario. Como las medidas cambian poco de una muestra a la
+ *    siguiente guardamos solo las diferencias:
+ *
+ *    + Las muestras se agrupan en bloques. Cada bloque es independiente de
+ *      los demás (se puede decodificar sin conocer los anteriores):
+ *
+ *	    [0]    0xA5     sync marker
+ *	    [1]    0x5A
+ *	    [2]    nchannels
+ *	    [3]    n = número de bytes de las muestras
+ *	    [4..7] t0 (uint32_t, little-endian): tiempo de la primera muestra
+ *	    [8..8+n)       muestras
+ *	    [8+n..8+n+2)   CRC16_CCITT de [2, 8+n) (little-endian)
+ *	    [8+n+2..block_size)  relleno (0xFF)
+ *
+ *      Todos los bloques ocupan block_size bytes. El decodificador ignora
+ *      los 0xFF entre bloques (es también el valor de la EEPROM borrada).
+ *
+ *    + Cada muestra es:
+ *	    varint(t - t_anterior)
+ *	    zigzag_varint(value[i] - value_anterior[i]) para cada canal
+ *
+ *      En la primera muestra del bloque t_anterior = t0 y
+ *      value_anterior[i] = 0.
+ *
+ *    + varint = LEB128: 7 bits por byte, el bit 7 indica que sigue otro
+ *      byte. zigzag: 0, -1, 1, -2, 2... --> 0, 1, 2, 3, 4...
+ *
+ *    Si se va la corriente se pierde, como mucho, el bloque que se estaba
+ *    llenando. Al leer buscamos el sync marker y comprobamos el CRC: si no
+ *    coincide avanzamos un byte y seguimos buscando.
+ *
+ *    Con 2 canales (T y H) que cambian poco cada muestra ocupa 3-4 bytes
+ *    (frente a unos 20 bytes en texto).
+ *
+ *    Los valores son int16_t: el cliente decide las unidades (por ejemplo,
+ *    décimas de grado).
+ *
+ *    Este fichero no depende del hardware: lo usan tanto el datalogger como
+ *    el decodificador del PC (pc_log_decoder).
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <cstdint>
+#include <span>
+#include <ostream>
+
+#include <atd_crc.h>
+
+namespace dlog{
+
+inline constexpr uint8_t sync0 = 0xA5;
+inline constexpr uint8_t sync1 = 0x5A;
+
+inline constexpr uint8_t header_size = 8;
+inline constexpr uint8_t crc_size    = 2;
+
+// Relleno de los bloques hasta block_size
+inline constexpr uint8_t padding = 0xFF;
+
+// Máximo número de canales que sabe leer el decodificador
+inline constexpr uint8_t max_nchannels = 16;
+
+// Máximo número de bytes de un varint de 32 bits
+inline constexpr uint8_t varint_max_size = 5;
+
+
+/***************************************************************************
+ *				VARINT
+ ***************************************************************************/
+// Escribe x en p. Devuelve el número de bytes escritos.
+// Precondición: en p caben varint_max_size bytes.
+inline uint8_t write_varint(uint8_t* p, uint32_t x)
+{
+    uint8_t n = 0;
+    while (x >= 0x80){
+	p[n++] = static_cast<uint8_t>(x | 0x80);
+	x >>= 7;
+    }
+    p[n++] = static_cast<uint8_t>(x);
+
+    return n;
+}
+
+// Lee un varint de [p, pe). Devuelve el número de bytes leídos (0 si está
+// mal formado).
+inline uint8_t read_varint(const uint8_t* p, const uint8_t* pe, uint32_t& x)
+{
+    x = 0;
+    for (uint8_t i = 0; i < varint_max_size and p != pe; ++i, ++p){
+	x |= uint32_t{static_cast<uint8_t>(*p & 0x7F)} << (7 * i);
+	if ((*p & 0x80) == 0)
+	    return i + 1;
+    }
+
+    return 0;
+}
+
+inline constexpr uint32_t zigzag(int32_t x)
+{ return (static_cast<uint32_t>(x) << 1) ^ static_cast<uint32_t>(x >> 31); }
+
+inline constexpr int32_t unzigzag(uint32_t x)
+{ return static_cast<int32_t>(x >> 1) ^ -static_cast<int32_t>(x & 1); }
+
+
+// (RRR) Little-endian independientemente del micro para que el fichero
+//       sea portable.
+inline void write_uint16(uint8_t* p, uint16_t x)
+{
+    p[0] = static_cast<uint8_t>(x);
+    p[1] = static_cast<uint8_t>(x >> 8);
+}
+
+inline void write_uint32(uint8_t* p, uint32_t x)
+{
+    write_uint16(p, static_cast<uint16_t>(x));
+    write_uint16(p + 2, static_cast<uint16_t>(x >> 16));
+}
+
+inline uint16_t read_uint16(const uint8_t* p)
+{ return static_cast<uint16_t>(p[0] | (uint16_t{p[1]} << 8)); }
+
+inline uint32_t read_uint32(const uint8_t* p)
+{ return read_uint16(p) | (uint32_t{read_uint16(p + 2)} << 16); }
+
+
+/***************************************************************************
+ *				WRITER
+ ***************************************************************************/
+// Va acumulando las muestras en un bloque de block_size bytes y lo escribe
+// en `out` cuando se llena. flush() rellena el bloque hasta block_size, así
+// que todos los bloques ocupan block_size bytes.
+// out puede ser cualquier std::ostream: dev::EEPROM_ostream, la UART...
+//
+// (RRR) ¿por qué block_size = 64?
+//       Es el tamaño de página de la 25LC256. Como todos los bloques
+//       ocupan 64 bytes, si se abre el EEPROM_ostream en una dirección
+//       múltiplo de 64 cada bloque ocupa exactamente una página y nunca se
+//       parte entre dos. Para que además se grabe con una sola escritura de
+//       página el buffer del flujo tiene que ser de 64 bytes
+//       (dev::EEPROM_ostream<EEPROM, 64>): con un buffer menor el flujo
+//       graba el bloque en varios trozos (todos en la misma página).
+template <uint8_t nchannels0, uint8_t block_size0 = 64>
+class Writer{
+public:
+// Cfg
+    static constexpr uint8_t nchannels  = nchannels0;
+    static constexpr uint8_t block_size = block_size0;
+
+    static_assert(nchannels > 0 and nchannels <= max_nchannels);
+
+    // Máximo número de bytes de una muestra
+    static constexpr uint8_t sample_max_size =
+			    varint_max_size + nchannels * varint_max_size;
+
+    static_assert(header_size + sample_max_size + crc_size <= block_size,
+		    "block_size too small");
+
+// Constructor
+    explicit Writer(std::ostream& out) : out_{&out} { }
+
+    // Añade una muestra. Devuelve false si falla la escritura del bloque.
+    bool write(uint32_t t, std::span<const int16_t, nchannels> value);
+
+    // Graba el bloque actual aunque no esté lleno (rellenándolo hasta
+    // block_size). Devuelve false si falla la escritura.
+    bool flush();
+
+    // ¿Hay muestras pendientes de grabar?
+    bool empty() const {return n_ == 0;}
+
+private:
+// Data
+    std::ostream* out_;
+
+    uint8_t block_[block_size];
+    uint8_t n_ = 0; // bytes de muestras en block_
+
+    uint32_t t_;		// tiempo de la última muestra
+    int16_t value_[nchannels];	// valores de la última muestra
+
+    static constexpr uint8_t max_payload = block_size - header_size - crc_size;
+
+// Helpers
+    void begin_block(uint32_t t0);
+
+    // Codifica la muestra en p. Devuelve el número de bytes.
+    uint8_t encode(uint8_t* p, uint32_t t,
+			    std::span<const int16_t, nchannels> value) const;
+};
+
+
+template <uint8_t C, uint8_t B>
+void Writer<C, B>::begin_block(uint32_t t0)
+{
+    n_ = 0;
+    t_ = t0;
+    for (uint8_t i = 0; i < nchannels; ++i)
+	value_[i] = 0;
+
+    block_[0] = sync0;
+    block_[1] = sync1;
+    block_[2] = nchannels;
+    write_uint32(&block_[4], t0);
+}
+
+template <uint8_t C, uint8_t B>
+uint8_t Writer<C, B>::encode(uint8_t* p, uint32_t t,
+			    std::span<const int16_t, nchannels> value) const
+{
+    uint8_t n = write_varint(p, t - t_);
+
+    for (uint8_t i = 0; i < nchannels; ++i)
+	n += write_varint(p + n, zigzag(int32_t{value[i]} - value_[i]));
+
+    return n;
+}
+
+template <uint8_t C, uint8_t B>
+bool Writer<C, B>::write(uint32_t t, std::span<const int16_t, nchannels> value)
+{
+    // Si el reloj va hacia atrás (lo ha cambiado el usuario) empezamos un
+    // bloque nuevo: dt siempre es positivo.
+    if (!empty() and t < t_ and !flush())
+	return false;
+
+    if (empty())
+	begin_block(t);
+
+    uint8_t sample[sample_max_size];
+    uint8_t n = encode(sample, t, value);
+
+    if (n_ + n > max_payload){
+	if (!flush())
+	    return false;
+
+	begin_block(t);
+	n = encode(sample, t, value);
+    }
+
+    for (uint8_t i = 0; i < n; ++i)
+	block_[header_size + n_ + i] = sample[i];
+
+    n_ += n;
+    t_ = t;
+    for (uint8_t i = 0; i < nchannels; ++i)
+	value_[i] = value[i];
+
+    return true;
+}
+
+template <uint8_t C, uint8_t B>
+bool Writer<C, B>::flush()
+{
+    if (empty())
+	return true;
+
+    block_[3] = n_;
+    uint8_t size = header_size + n_;
+
+    write_uint16(&block_[size],
+		    atd::CRC16_CCITT({&block_[2], static_cast<size_t>(size - 2)}));
+    size += crc_size;
+
+    for (uint8_t i = size; i < block_size; ++i)
+	block_[i] = padding;
+
+    out_->write(reinterpret_cast<const char*>(block_), block_size);
+    out_->flush();
+
+    n_ = 0;
+
+    return out_->good();
+}
+
+
+/***************************************************************************
+ *				READER
+ ***************************************************************************/
+struct Read_stats{
+    uint32_t nblocks  = 0;  // bloques correctos
+    uint32_t nsamples = 0;  // muestras leídas
+    uint32_t nskipped = 0;  // bytes descartados (basura, bloques corruptos)
+			    // Los bytes de relleno no se cuentan.
+};
+
+
+namespace impl_of{
+// Decodifica las muestras del bloque.
+// Devuelve false si están mal formadas.
+template <typename F>
+bool decode_samples(const uint8_t* p, const uint8_t* pe,
+		    uint8_t nchannels, uint32_t t,
+		    Read_stats& stats, F& f)
+{
+    int16_t value[max_nchannels]{};
+
+    while (p != pe){
+	uint32_t x;
+	uint8_t n = read_varint(p, pe, x);
+	if (n == 0)
+	    return false;
+
+	p += n;
+	t += x;
+
+	for (uint8_t i = 0; i < nchannels; ++i){
+	    n = read_varint(p, pe, x);
+	    if (n == 0)
+		return false;
+
+	    p += n;
+	    value[i] = static_cast<int16_t>(value[i] + unzigzag(x));
+	}
+
+	f(t, std::span<const int16_t>{value, nchannels});
+	++stats.nsamples;
+    }
+
+    return true;
+}
+
+}// impl_of
+
+// Decodifica todos los bloques de data llamando a f(t, values) por cada
+// muestra (values es un std::span<const int16_t>).
+// Los bloques corruptos se descartan buscando el siguiente sync marker.
+// El relleno entre bloques (padding) se salta.
+template <typename F>
+Read_stats decode(std::span<const uint8_t> data, F f)
+{
+    Read_stats stats;
+
+    const uint8_t* p  = data.data();
+    const uint8_t* pe = p + data.size();
+
+    while (pe - p >= header_size + crc_size){
+	if (p[0] == padding){
+	    ++p;
+	    continue;
+	}
+
+	if (p[0] != sync0 or p[1] != sync1 or
+	    p[2] == 0 or p[2] > max_nchannels){
+	    ++p;
+	    ++stats.nskipped;
+	    continue;
+	}
+
+	uint8_t nchannels = p[2];
+	size_t size = header_size + p[3];
+
+	if (static_cast<size_t>(pe - p) < size + crc_size or
+	    atd::CRC16_CCITT({p + 2, size - 2}) != read_uint16(p + size)){
+	    ++p;
+	    ++stats.nskipped;
+	    continue;
+	}
+
+	// Un bloque con CRC correcto siempre debería estar bien formado. Si
+	// no lo está, lo que hayamos pasado a f ya no se puede deshacer.
+	if (!impl_of::decode_samples(p + header_size, p + size, nchannels,
+					    read_uint32(p + 4), stats, f)){
+	    ++p;
+	    ++stats.nskipped;
+	    continue;
+	}
+
+	++stats.nblocks;
+	p += size + crc_size;
+    }
+
+    for (; p != pe; ++p){
+	if (*p != padding)
+	    ++stats.nskipped;
+    }
+
+    return stats;
+}
+
+}// namespace dlog
+
+#endif
@@ -404,6 +404,14 @@ public:
     FAT_area(Volume* vol) : volume_{vol} {}
     void init(const Boot_sector& bs);
 
+    // Lee del FS_info (sector global `fs_info_sector`) las sugerencias
+    // nxt_free/free_count. Si el FS_info no es válido las ignora.
+    void init_FS_info(const uint32_t& fs_info_sector);
+
+    // Escribe en el FS_info los valores actuales de nxt_free/free_count.
+    // Devuelve true si todo va bien.
+    bool flush_FS_info();
+
 // Creación/modificación de listas
     // Crea una nueva lista de 1 cluster, devolviendo el primer cluster.
     // Devuelve 0 en caso de no poder crear la nueva lista.
@@ -491,6 +499,14 @@ public:
 
     uint8_t number_of_active_FATs() const {return nFATs_;}
 
+    // Número de clusters libres. Es una sugerencia (FS_info::free_count):
+    // si vale unknown_free_count no se conoce.
+    uint32_t free_count() const {return free_count_;}
+    static constexpr uint32_t unknown_free_count = 0xFFFFFFFF;
+
+    // Cluster a partir del cual empezamos a buscar clusters libres
+    // (FS_info::nxt_free)
+    uint32_t next_free_hint() const {return nxt_free_;}
 
 private:
     Volume* volume_;
@@ -506,6 +522,52 @@ private:
     // veces!!!
     uint32_t sector_size_; // número de bytes por sector
 
+// Búsqueda de clusters libres
+// (RRR) Buscar linealmente desde el cluster 2 cada vez que añadimos un
+//       cluster es muy lento en una tarjeta casi llena. Usamos:
+//	 1. Las sugerencias del FS_info: nxt_free y free_count. Al añadir
+//	    clusters a un fichero los clusters libres suelen estar
+//	    consecutivos, con lo que empezando a buscar en nxt_free
+//	    normalmente lo encontramos a la primera.
+//	 2. Un resumen de la FAT area: la dividimos en 32 regiones y
+//	    marcamos las que sabemos que están llenas para no volver a
+//	    leerlas. Son solo 4 bytes de RAM.
+    uint32_t fs_info_sector_ = 0;// 0 == no hay FS_info válido
+    uint32_t nxt_free_	     = 2;
+    uint32_t free_count_     = unknown_free_count;
+    bool fs_info_modified_   = false;
+
+    static constexpr uint8_t nregions = 32;
+    uint32_t full_regions_ = 0;	      // bit i == 1: la región i está llena
+    uint32_t sectors_per_region_ = 1; 
+
+    uint8_t region(uint32_t nsector) const 
+    { return static_cast<uint8_t>(nsector / sectors_per_region_); }
+
+    bool is_full_region(uint8_t r) const 
+    { return (full_regions_ >> r) & uint32_t{1}; }
+
+    // ¿Empezar a buscar en la entrada pos del sector nsector es recorrer
+    // la región desde el principio? Las entradas 0 y 1 están reservadas:
+    // buscar desde el cluster 2 es buscar desde el principio de la región 0.
+    bool is_region_begin(uint32_t nsector, uint32_t pos) const
+    { return nsector % sectors_per_region_ == 0 and 
+		(pos == 0 or (nsector == 0 and pos <= 2)); }
+
+    void full_region(uint8_t r) {full_regions_ |= (uint32_t{1} << r);}
+    void not_full_region(uint8_t r) {full_regions_ &= ~(uint32_t{1} << r);}
+
+    // Actualizan las sugerencias al reservar/liberar un cluster
+    void cluster_allocated(const uint32_t& cluster);
+    void cluster_freed(const uint32_t& cluster);
+
+    // Último cluster + 1 de la FAT area (los clusters válidos son 
+    // [2, end_cluster())
+    uint32_t end_cluster() const {return number_of_clusters_ + 2;}
+
+    uint32_t entries_per_sector() const 
+    { return sector_size_ / sizeof(uint32_t);}
+
 // Cfg de FAT_area
 
 
@@ -532,10 +594,14 @@ private:
 			    cluster2sector_pos(const uint32_t& cluster) const;
     uint32_t sector0_area(uint8_t i) const;
 
-    // Devuelve el primer cluster libre después de cluster0,
+    // Devuelve un cluster libre ó 0 en caso de no encontrar ninguno.
+    // Empieza a buscar en nxt_free_ y si no encuentra ninguno busca desde
+    // el principio.
+    uint32_t find_first_free_cluster();
+
+    // Devuelve el primer cluster libre en [cluster0, cluster1)
     // ó 0 en caso de no encontrar ninguno.
-    // El valor por defecto es 2 ya que el primer cluster es 2, no 0.
-    uint32_t find_first_free_cluster(uint32_t cluster0 = 2) const;
+    uint32_t find_first_free_cluster(uint32_t cluster0, uint32_t cluster1);
 
     uint32_t add_cluster(const uint32_t& cluster, bool only_at_the_end);
     uint32_t add_cluster_and_fill_with( const uint32_t& cluster
@@ -568,6 +634,7 @@ private:
     }
 
     bool read_error() const {return volume_->read_error(); }
+    bool last_operation_fail() const {return volume_->last_operation_fail();}
 
     // Escribe value en el cluster indicado
     // (TODO) Gestionar los errores. ¿Qué devolver o hacer si write_in_area
@@ -578,11 +645,11 @@ private:
     // tienen que leer de FAT0 y luego escribir en FAT0, FAT1, leer en FAT0,
     // escribir en FAT0, FAT1, ... Si se activan las trazas a nivel 100 se ve
     // muy bien los accesos a SDCard::read/write. ¡Accede demasiado! Pero ese
-    // es el precio a pagar por solo mantener un sector en memoria. Se podía
-    // hacer más eficiente si Sector_driver mantuviese 2 sectores en memoria,
-    // de esa forma se ahorrarían muchos SDCard::read. Pero eso necesita más
-    // memoria de RAM. Lo bueno del planteamiento es que es el cliente, a
-    // través de la clase Sector_driver, el que decide esto.
+    // es el precio a pagar por solo mantener un sector en memoria. 
+    // Si Sector_driver mantiene 2 o más sectores en memoria (nslots > 1) se
+    // ahorran muchos SDCard::read/write. Pero eso necesita más memoria de
+    // RAM. Lo bueno del planteamiento es que es el cliente, a través de la
+    // clase Sector_driver, el que decide esto.
     // Con todo ¿se podrá implementar de otra forma más eficiente para
     // Sector_driver que solo mantentan 1 sector en memoria?
     bool write(const uint32_t& cluster, const uint32_t& value) const
@@ -629,7 +696,7 @@ template <typename S>
 inline 
 std::pair<uint32_t, uint32_t> 
 	FAT_area<S>::cluster2sector_pos(const uint32_t& cluster) const
-{ return atd::div(cluster, sector_size_ / sizeof(uint32_t)); }
+{ return atd::div(cluster, entries_per_sector()); }
 
 
 
@@ -646,6 +713,96 @@ void FAT_area<S>::init(const Boot_sector& bs)
     number_of_sectors_ = bs.FAT_number_of_sectors();
     number_of_clusters_ = bs.data_area_number_of_clusters();
     sector_size_ = bs.bytes_per_sector();
+
+    sectors_per_region_ = (number_of_sectors_ + nregions - 1) / nregions;
+    if (sectors_per_region_ == 0)
+	sectors_per_region_ = 1;
+
+    full_regions_ = 0;
+}
+
+// Section 5, FAT specification
+//  free_count: 0xFFFFFFFF = desconocido. Es una sugerencia (puede no ser
+//		correcto).
+//  nxt_free  : 0xFFFFFFFF = desconocido, empezar a buscar en el cluster 2.
+template <typename S>
+void FAT_area<S>::init_FS_info(const uint32_t& sector)
+{
+    fs_info_sector_ = 0;
+    nxt_free_	    = 2;
+    free_count_	    = unknown_free_count;
+    fs_info_modified_ = false;
+
+    // Posiciones (en uint32_t) de los campos de FS_info. 
+    // Section 5: offsets 0, 484, 488, 492 y 508 (en bytes)
+    constexpr uint16_t lead_sig   = 0;
+    constexpr uint16_t struct_sig = 121;
+    constexpr uint16_t free_count = 122;
+    constexpr uint16_t nxt_free   = 123;
+    constexpr uint16_t trail_sig  = 127;
+
+    if (volume_->template sd_read<uint32_t>(sector, lead_sig) != 0x41615252 or
+	volume_->template sd_read<uint32_t>(sector, struct_sig)!= 0x61417272 or
+	volume_->template sd_read<uint32_t>(sector, trail_sig) != 0xAA550000){
+	atd::ctrace<3>() << "FS_info not valid\n";
+	return;
+    }
+
+    fs_info_sector_ = sector;
+
+    uint32_t n = volume_->template sd_read<uint32_t>(sector, free_count);
+    if (n <= number_of_clusters_)
+	free_count_ = n;
+
+    n = volume_->template sd_read<uint32_t>(sector, nxt_free);
+    if (2 <= n and n < end_cluster())
+	nxt_free_ = n;
+}
+
+template <typename S>
+bool FAT_area<S>::flush_FS_info()
+{
+    if (!fs_info_modified_ or fs_info_sector_ == 0)
+	return true;
+
+    constexpr uint16_t free_count = 122; // ver init_FS_info
+    constexpr uint16_t nxt_free   = 123;
+
+    if (!volume_->template sd_write<uint32_t>(fs_info_sector_, free_count
+							  , free_count_) or
+	!volume_->template sd_write<uint32_t>(fs_info_sector_, nxt_free
+							  , nxt_free_))
+	return false;
+
+    fs_info_modified_ = false;
+
+    return true;
+}
+
+template <typename S>
+void FAT_area<S>::cluster_allocated(const uint32_t& cluster)
+{
+    nxt_free_ = cluster + 1;
+    if (nxt_free_ >= end_cluster())
+	nxt_free_ = 2;
+
+    if (free_count_ != unknown_free_count and free_count_ > 0)
+	--free_count_;
+
+    fs_info_modified_ = true;
+}
+
+// No modificamos nxt_free_: para añadir clusters a un fichero es más rápido
+// seguir buscando a partir del último cluster añadido. 
+template <typename S>
+void FAT_area<S>::cluster_freed(const uint32_t& cluster)
+{
+    not_full_region(region(cluster2sector_pos(cluster).first));
+
+    if (free_count_ != unknown_free_count)
+	++free_count_;
+
+    fs_info_modified_ = true;
 }
 
 template <typename S>
@@ -690,28 +847,77 @@ FAT_area<S>::Cluster_state FAT_area<S>::cluster_state(uint32_t cluster) const
     return Cluster_state::reserved;
 }
 
-// (DUDA) Se puede optimizar esta función iterando en lugar por el número de
-// clusters por (sector, pos) con 
-//	sector = [sector0_ ... sector0_ + number_of_sectors_)
-//	pos = [0 .. 512)
-// Y llamar directamente a volume->sd_read. De esa forma evitamos el estar
-// llamando continuamente a la función cluster2sector_pos dentro de read.
-// Pero como estoy aprendiendo FAT32 opto por una implementación sencilla que
-// entienda y no tenga errores, que una más eficiente que pueda tener errores.
 template <typename S>
-uint32_t FAT_area<S>::find_first_free_cluster(uint32_t cluster) const
+uint32_t FAT_area<S>::find_first_free_cluster()
 {
-    for (; cluster < number_of_clusters_; ++cluster){
-	auto v = read(cluster);
-	
-	if (read_error())
+    uint32_t cluster = find_first_free_cluster(nxt_free_, end_cluster());
+
+    if (cluster == 0 and nxt_free_ > 2 and !last_operation_fail())
+	cluster = find_first_free_cluster(2, nxt_free_);
+
+    if (cluster == 0)
+	atd::ctrace<2>() << "FAT area full\n";
+
+    return cluster;
+}
+
+
+// Recorremos la FAT area sector a sector, buscando en el array de 128
+// entradas de cada sector (Sector_driver::find), en lugar de leer cada
+// entrada llamando a read(cluster).
+// Las regiones que estén llenas no las leemos.
+template <typename S>
+uint32_t FAT_area<S>::find_first_free_cluster(uint32_t cluster0
+					     , uint32_t cluster1)
+{
+    if (cluster0 < 2)
+	cluster0 = 2;
+
+    if (cluster1 > end_cluster())
+	cluster1 = end_cluster();
+
+    if (cluster0 >= cluster1)
+	return 0;
+
+    uint32_t N = entries_per_sector();
+    auto [nsector, pos] = cluster2sector_pos(cluster0);
+    uint32_t nsector1   = cluster2sector_pos(cluster1 - 1).first;
+
+    // Si recorremos una región completa sin encontrar un cluster libre la
+    // marcamos como llena.
+    bool from_region_begin = is_region_begin(nsector, pos);
+
+    for (; nsector <= nsector1; ++nsector, pos = 0){
+	uint8_t r = region(nsector);
+
+	if (nsector % sectors_per_region_ == 0)
+	    from_region_begin = is_region_begin(nsector, pos);
+
+	if (is_full_region(r)){ // saltamos a la siguiente región
+	    nsector = (r + 1) * sectors_per_region_ - 1;
+	    continue;
+	}
+
+	auto i = volume_->template 
+			sd_find<uint32_t>(sector0_ + nsector, pos, free_entry);
+
+	if (last_operation_fail())
+	    return 0;
+
+	if (i < N){
+	    uint32_t cluster = nsector * N + i;
+	    if (cluster < cluster1)
+		return cluster;
+
 	    return 0;
+	}
 
-	if (v == free_entry)
-	    return cluster;
+	// ¿Último sector de la región? 
+	if (from_region_begin and 
+	    (nsector + 1) % sectors_per_region_ == 0)
+	    full_region(r);
     }
 
-    atd::ctrace<2>() << "FAT area full\n";
     return 0;
 }
 
@@ -728,6 +934,8 @@ uint32_t FAT_area<S>::new_list()
     if (write(cluster, end_of_file_entry) == 0)
 	return 0;
 
+    cluster_allocated(cluster);
+
     return cluster;
 }
 
@@ -758,6 +966,9 @@ bool FAT_area<S>::remove_list_in_area(uint8_t i, uint32_t cluster0)
 	if (write_in_area(i, cluster0, free_entry) == 0)
 	    return false;
 
+	if (i == 0)
+	    cluster_freed(cluster0);
+
 	cluster0 = cluster1;
     }
 
@@ -797,6 +1008,8 @@ uint32_t FAT_area<S>::add_cluster(const uint32_t& cluster0
 	return 0;
     }
 
+    cluster_allocated(d);
+
     if (write(cluster0, d) == 0)
 	return 0;
 
@@ -868,6 +1081,8 @@ uint32_t FAT_area<S>::remove_next_cluster(const uint32_t& cluster0)
     if (write(cluster1, free_entry) == 0)
 	return 0;
 
+    cluster_freed(cluster1);
+
     if (write(cluster0, cluster2) == 0)
 	return 0;
 
@@ -945,6 +1160,8 @@ public:
     // defecto en Volume
     Volume(const uint32_t& sector0, Boot_sector_min& bs);
 
+    ~Volume() { flush(); }
+
 // Reserved area
     // Primer sector del volumen
     uint32_t first_sector() const {return sector0_;}
@@ -974,6 +1191,12 @@ public:
 		  , std::span<uint8_t> buf)
     {return driver_.read(nsector, pos, buf); }
 
+    // Busca en el sector nsector, a partir de la posición pos, el primer
+    // Int == value (ver Sector_driver::find)
+    template <Type::Integer Int>
+    uint16_t sd_find(const uint32_t& nsector, uint16_t pos, const Int& value)
+    { return driver_.template find<Int>(nsector, pos, value); }
+
     // Devuelve true si todo va bien, false si no consigue escribir.
     // Si falla mirar el state correspondiente para ver error (write_error())
     template <Type::Integer Int>
@@ -986,7 +1209,12 @@ public:
     { return driver_.write(nsector, pos, buf); }
 
     // Devuelve true si hace el flush correctamente, false en caso de error
-    bool flush() { return driver_.flush();}
+    // Actualiza también el FS_info.
+    bool flush() 
+    { 
+	bool ok = fat_area.flush_FS_info();
+	return driver_.flush() and ok;
+    }
 
 // Algorithms
     // Rellena todo el cluster con el valor indicado.
@@ -1021,6 +1249,9 @@ private:
 template <typename SD>
 uint16_t Volume<SD>::init()
 {
+    uint16_t fs_info{};
+
+    { // bloqueamos el boot sector solo dentro de este bloque
     auto bs = driver_.template lock_sector_and_view_as<Boot_sector>(sector0_);
 
     if (bs.is_null()){
@@ -1036,8 +1267,12 @@ uint16_t Volume<SD>::init()
     fat_area.init(*bs);
     data_area.init(*bs);
 
+    fs_info = bs->fs_info;
+    }
+
+    fat_area.init_FS_info(sector0_ + fs_info);
 
-    return bs->fs_info;
+    return fs_info;
 }
 
 
@@ -1408,6 +1643,7 @@ public:
     using FAT_area_list = atd::FAT32::FAT_area_list<Sector_driver0>;
     using Volume = typename FAT_area_list::Volume;
     using State  = impl_of::File_state;
+    using size_type = uint16_t;
 
 // Constructors
     File(Volume& volume, const uint32_t& cluster0);
@@ -1423,7 +1659,7 @@ public:
 
     // Intenta leer buf.size() caracteres, almacenándolos en buf.
     // Devuelve el número de caracteres leídos.
-    uint8_t read(std::span<uint8_t> buf);
+    size_type read(std::span<uint8_t> buf);
 
 
 // State
@@ -1467,9 +1703,10 @@ private:
 // de verdad? Mejor como un wrapper sobre esta clase.
 //    static uint16_t next_byte(FAT_area_list& sector, uint16_t i);
 
-    uint8_t read_byte(uint32_t i) const
-    { return sector_.volume.template sd_read<uint8_t>
-				    (sector_.sd_sector_number(), i); }
+    // Lee del sector actual, a partir de la posición i, buf.size() bytes
+    // como mucho. Devuelve el número de bytes leídos.
+    size_type read_from_sector(std::span<uint8_t> buf)
+    { return sector_.volume.sd_read(sector_.sd_sector_number(), i, buf); }
 };
 
 
@@ -1477,7 +1714,9 @@ template <typename SD>
 inline File<SD>::File(Volume& volume, const uint32_t& cluster0)
     : cluster0_{cluster0}, sector_(volume, cluster0)
     , i{0}
-{ }
+{ 
+    state_ = State::ok;
+}
 
 template <typename SD> 
 inline File<SD>::File(Volume& volume
@@ -1509,40 +1748,49 @@ inline void File<SD>::reset(uint32_t cluster0)
 }
 
 
-// (RRR) ¿por qué leo de 1 byte en 1 byte?
-//       Porque los bytes de un fichero están dispersos por diferentes
-//       sectores. En principio el Sector_driver carga en memoria un sector,
-//       con lo que no debería de ser ineficiente leer 1 byte detrás de otro.
-//       (TODO) Crear en sector_driver::read(span) y que el valor devuelto
-//       sea el número de bytes escritos. Sería un poco más eficiente que esta
-//       función.
+// (RRR) ¿Cómo leo?
+//       Los bytes de un fichero están dispersos por diferentes sectores,
+//       pero dentro de un sector son consecutivos. Copiamos de golpe 
+//       (Sector_driver::read(span)) todos los bytes que podamos del sector
+//       actual y pasamos al siguiente sector usando FAT_area_list, que
+//       recuerda el cluster en el que estamos (solo lee la FAT area al 
+//       cambiar de cluster).
+//       Leer 512 bytes cuesta cargar 1 sector y 1 copia, en lugar de 512
+//       llamadas a Sector_driver::read<uint8_t>.
 template <typename SD> 
-uint8_t File<SD>::read(std::span<uint8_t> buf)
+File<SD>::size_type File<SD>::read(std::span<uint8_t> buf)
 {
-    using Size = std::span<uint8_t>::size_type;
-
     if (sector_.end_of_sectors() or sector_.last_operation_fail()
 	or remainder_bytes_.value() == 0)
 	return 0;
 
-    Size n = 0; 
-    for (; n < buf.size(); ++n){
+    size_type n = 0; 
+    while (n < buf.size()){
+	// Si es un directorio remainder_bytes_ no está inicializado y vale
+	// max(), con lo que no limita el número de bytes a leer.
+	uint32_t m = std::min<uint32_t>(buf.size() - n, 
+			       sector_.volume.bytes_per_sector() - i);
+	m = std::min(m, remainder_bytes_.value());
 
-	buf[n] = read_byte(i); 
+	size_type r = read_from_sector(buf.subspan(n, m));
+	n += r;
 
-	--remainder_bytes_; 
+	if (r != m) // read error
+	    return n;
+
+	remainder_bytes_ -= r; 
 	if (remainder_bytes_.value() == 0){
 	    state_ = State::end_of_file;
-	    return n + 1u;
+	    return n;
 	}
 
-	++i;
+	i += r;
 
 	if (i >= sector_.volume.bytes_per_sector()){
 	    sector_.next_sector(); 
 
 	    if (sector_.end_of_sectors() or sector_.last_operation_fail())
-		return n + 1u;
+		return n;
 
 	    i = 0;
 	}
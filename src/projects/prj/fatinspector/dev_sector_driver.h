@@ -31,9 +31,13 @@
  * HISTORIA
  *    Manuel Perez
  *    26/02/2025 Experimentando con Sector_driver
+ *    18/10/2026 fill_n usando SDCard::Multiple_write
+ *		 find
+ *		 Caché de nslots sectores (LRU) con pin/unpin
  *
  ****************************************************************************/
 #include <algorithm>	// fill
+#include <cstring>	// memcpy
 #include <bit>	// endianness
 #include <atd_basic_types.h> // atd::Uninitialized
 #include <atd_trace.h>
@@ -87,62 +91,166 @@ enum class Sector_driver_errno : uint8_t {
 };
 
 
+// Estado de cada uno de los slots (sectores en memoria) de Sector_driver
+struct Sector_driver_slot{
+    bool modified : 1; // indica que el sector ha sido modificado en RAM
+			// con lo que hay que hacerle un flush antes de
+			// reutilizar el slot
+    bool pinned   : 1; // el cliente está accediendo directamente al sector:
+			// no se puede reutilizar el slot
+    uint8_t age   : 6; // 0 = el último slot usado; nslots - 1 = el que hace
+			// más tiempo que no se usa (LRU)
+};
+
+static_assert(sizeof(Sector_driver_slot) == 1);
+
+
+// Estado de los nslots de Sector_driver + errno
+// Las edades de los slots son siempre una permutación de [0, nslots)
+template <uint8_t nslots>
 struct Sector_driver_struct{
     using Errno = Sector_driver_errno;
 
-    Errno errno   : 6;
-    bool modified : 1; // indica que el sector ha sido modificado en RAM
-			// con lo que hay que hacerle un flush antes de leer
-			// un nuevo sector
-    uint8_t locked : 1;
+    static_assert(nslots > 0 and nslots <= 64, "age is 6 bits long");
+
+    Errno errno;
+    Sector_driver_slot slot[nslots];
 
     Sector_driver_struct() : errno{Errno::ok}
-			    , modified{false}
-			    , locked{0}{}
+    {
+	for (uint8_t i = 0; i < nslots; ++i)
+	    slot[i] = Sector_driver_slot{false, false, i};
+    }
     
     void operator=(Errno e) {errno = e; }
     bool operator==(Errno e) const {return errno == e;}
 
-    void lock() {locked = 1;}
-    void unlock() {locked = 0;}
+    bool ok() const {return errno == Errno::ok;}
+    bool fail() const {return !ok(); }
+    bool read_error() const {return errno == Errno::read_error;}
+    bool write_error() const {return errno == Errno::write_error;}
+
+// Slots
+    bool is_modified(uint8_t i) const {return slot[i].modified;}
+    void modified(uint8_t i, bool m) {slot[i].modified = m;}
+
+    bool is_pinned(uint8_t i) const {return slot[i].pinned;}
+    void pin(uint8_t i) {slot[i].pinned = true;}
+    void unpin(uint8_t i) {slot[i].pinned = false;}
+
+    // Marca el slot i como el último usado
+    void touch(uint8_t i)
+    {
+	uint8_t a = slot[i].age;
+	for (uint8_t j = 0; j < nslots; ++j)
+	    if (slot[j].age < a) ++slot[j].age;
+
+	slot[i].age = 0;
+    }
 
+    // Marca el slot i como el primero a reutilizar (su contenido ya no es
+    // válido)
+    void forget(uint8_t i)
+    {
+	uint8_t a = slot[i].age;
+	for (uint8_t j = 0; j < nslots; ++j)
+	    if (slot[j].age > a) --slot[j].age;
+
+	slot[i].age = nslots - 1;
+    }
+
+    // Slot a reutilizar: el que hace más tiempo que no se usa de los que no
+    // están pinned. Devuelve nslots si todos están pinned.
+    uint8_t victim() const
+    {
+	uint8_t res = nslots;
+	for (uint8_t i = 0; i < nslots; ++i){
+	    if (!slot[i].pinned and 
+		    (res == nslots or slot[i].age > slot[res].age))
+		res = i;
+	}
+
+	return res;
+    }
+
+};
+
+
+// Con un solo slot no necesitamos LRU: todo cabe en 1 byte (como en el
+// atmega328 no sobra la RAM, no queremos gastar más de lo necesario).
+template <>
+struct Sector_driver_struct<1>{
+    using Errno = Sector_driver_errno;
+
+    Errno errno   : 6;
+    bool modified_ : 1; 
+    bool pinned_   : 1;
+
+    Sector_driver_struct() : errno{Errno::ok}
+			    , modified_{false}
+			    , pinned_{false}{}
+    
+    void operator=(Errno e) {errno = e; }
+    bool operator==(Errno e) const {return errno == e;}
 
     bool ok() const {return errno == Errno::ok;}
     bool fail() const {return !ok(); }
     bool read_error() const {return errno == Errno::read_error;}
     bool write_error() const {return errno == Errno::write_error;}
 
-    bool is_locked() const {return locked == 1;}
-    bool is_unlocked() const {return locked == 0;}
+// Slots
+    bool is_modified(uint8_t) const {return modified_;}
+    void modified(uint8_t, bool m) {modified_ = m;}
+
+    bool is_pinned(uint8_t) const {return pinned_;}
+    void pin(uint8_t) {pinned_ = true;}
+    void unpin(uint8_t) {pinned_ = false;}
 
-    bool is_modified() const {return modified;}
+    void touch(uint8_t) { }
+    void forget(uint8_t) { }
 
+    uint8_t victim() const {return pinned_? 1: 0;}
 };
 
 // Garanticemos que el compilador no usa más memoria de la necesaria:
-static_assert(sizeof(Sector_driver_struct) == 1);
+static_assert(sizeof(Sector_driver_struct<1>) == 1);
 
 
-template <typename SDCard, typename T>
+template <typename Driver, typename T>
 struct Sector_driver_lock;
 
 }
 
-// Se puede bloquear la lectura de un sector para que el cliente pueda leer
+// Sector_driver mantiene en memoria `nslots` sectores (una caché
+// write-back): los sectores modificados solo se escriben en la SD card
+// cuando hay que reutilizar su slot o al hacer flush. El slot que se
+// reutiliza es el que hace más tiempo que no se usa (LRU).
+//
+// (RRR) ¿Por qué más de un slot?
+//       Al actualizar un directorio se va alternando entre el sector de la
+//       FAT y el sector de datos. Con un único slot cada acceso obliga a
+//       escribir el sector anterior en la SD card. 
+//       El atmega328 no tiene RAM para más de 1 slot, pero el atmega4809 sí
+//       puede mantener el sector de la FAT y el de datos a la vez.
+//
+// Se puede fijar (pin) un sector para que el cliente pueda leer
 // directamente el array cargado en memoria, evitando que otras llamadas a
-// read/write modificaran su contenido o lo invalidaran.
+// read/write reutilicen su slot invalidando el contenido.
 //
 //
-// ¿Qué significa bloquear el driver?
+// ¿Qué significa fijar un sector?
 // Que queremos acceder al array de bytes del sector directamente y no quiero
-// que se modifique su contenido. Solo afecta a la función `read` no a write.
-// Podré escribir el sector en memoria si quiero o no.
-template <typename SDCard0> // Dispositivo físico de almacenamiento
+// que se modifique su contenido. Solo afecta a la reutilización del slot: se
+// puede seguir leyendo y escribiendo en el sector fijado.
+// Si todos los slots están fijados no se pueden leer otros sectores.
+template <typename SDCard0, // Dispositivo físico de almacenamiento
+	  uint8_t nslots0 = 1>  // Número de sectores en memoria
 class Sector_driver{
 public:
 // Types
     using SDCard = SDCard0;
-    using Errno = impl_of::Sector_driver_struct::Errno;
+    using Errno = impl_of::Sector_driver_errno;
+    static constexpr uint8_t nslots = nslots0;
     
     // Este es el tamaño del sector de la SD card que supongo (?) es igual al
     // tamaño del sector usado por FAT32. Pero Sector_driver es genérico y no
@@ -156,7 +264,7 @@ public:
     using Address = typename SDCard::Address;
 
     template <typename T>
-    using Lock = impl_of::Sector_driver_lock<SDCard0, T>;
+    using Lock = impl_of::Sector_driver_lock<Sector_driver, T>;
 
     static_assert(sector_size == SDCard::block_size);
 
@@ -185,10 +293,10 @@ public:
 		  , std::span<uint8_t> buf);
 
     // Devuelve un puntero con el array de bytes que forman el sector
-    // y bloquea el sector impidiendo que Sector_driver pueda modificar el
-    // sector_ mientras esté bloqueado.
-    uint8_t* lock_sector(const Address& nsector);
-    void unlock() { errno_state_.unlock();}
+    // y fija el sector impidiendo que Sector_driver pueda reutilizar su slot
+    // mientras esté fijado.
+    uint8_t* pin_sector(const Address& nsector);
+    void unpin(const Address& nsector);
 
     template <typename T>
     Lock<T> lock_sector_and_view_as(const Address& nsector);
@@ -206,6 +314,7 @@ public:
 		  , std::span<uint8_t> buf);
 
 
+    // Escribe en la SD card todos los sectores modificados
     bool flush();
 
 
@@ -218,6 +327,15 @@ public:
     // (si todo va bien debería devolver `n`).
     Address fill_n(const Address& sector0, const Address& n, uint8_t value);
 
+    // Concibe el sector nsector como un array de Ints y busca, a partir de
+    // la posición pos, el primer Int igual a value. 
+    // Devuelve su posición o sector_size / sizeof(Int) si no lo encuentra
+    // (o si hay un error de lectura: mirar read_error()).
+    // Sirve para recorrer tablas (la FAT area, por ejemplo) sin tener que
+    // llamar a read<Int> para cada elemento.
+    template <Type::Integer Int>
+    size_type find(const Address& nsector, size_type pos, const Int& value);
+
 // Errno
     bool last_operation_ok() const {return errno() == Errno::ok; }
     bool last_operation_fail() const {return errno() != Errno::ok; }
@@ -225,28 +343,38 @@ public:
     bool read_error() const {return errno() == Errno::read_error; }
     bool write_error() const {return errno() == Errno::write_error; }
 
-    bool is_locked() const {return errno_state_.is_locked();}
-    bool is_unlocked() const {return errno_state_.is_unlocked();}
+// Slots
+    bool is_in_memory(const Address& nsector) const 
+    { return slot_of(nsector) != nslots; }
+
+    bool is_pinned(const Address& nsector) const;
 	
 
 private:
 // Data
-    atd::Uninitialized<Address> nsector_; // num. de sector en memoria
-    Sector sector_;	// sector en memoria
-    impl_of::Sector_driver_struct errno_state_;
+    atd::Uninitialized<Address> nsector_[nslots]; // num. de sector en memoria
+    Sector sector_[nslots];	// sectores en memoria
+    impl_of::Sector_driver_struct<nslots> state_;
     
 // State/errno
-    void state_modified(bool m) {errno_state_.modified = m;}
-    void state_lock() {errno_state_.locked = true;}
-    bool state_is_modified() const {return errno_state_.modified;}
-
-    bool ok() {errno_state_.errno = Errno::ok; return true; }
-    bool errno(Errno e) {errno_state_.errno = e; return false;}
-    Errno errno() const {return errno_state_.errno;}
+    bool ok() {state_.errno = Errno::ok; return true; }
+    bool errno(Errno e) {state_.errno = e; return false;}
+    Errno errno() const {return state_.errno;}
 
 // Helpers
-    // Lee el sector nsector de la SD card cargándolo en memoria
-    bool read_sector(const Address& nsector);
+    // Devuelve el slot donde está el sector nsector o nslots si no está en
+    // memoria.
+    uint8_t slot_of(const Address& nsector) const;
+
+    // Carga el sector nsector de la SD card en memoria (si no lo estaba ya)
+    // Devuelve el slot donde lo ha cargado o nslots en caso de error.
+    uint8_t read_sector(const Address& nsector);
+
+    // Escribe el slot i en la SD card si ha sido modificado
+    bool flush(uint8_t i);
+
+    // El slot i deja de contener un sector
+    void forget(uint8_t i);
 
 // Static interface
     static bool read(const Address& add, Sector_span sector)
@@ -270,81 +398,123 @@ private:
 //        En caso de que el micro fuese big-endian hay que cambiar estas dos
 //        funciones.
     template <Type::Integer Int>
-    Int sector_read(size_type pos)
-    { return *(reinterpret_cast<Int*>(&sector_[pos * sizeof(Int)]));}
+    Int sector_read(uint8_t i, size_type pos)
+    { return *(reinterpret_cast<Int*>(&sector_[i][pos * sizeof(Int)]));}
 
     template <Type::Integer Int>
-    void sector_write(size_type pos, const Int& value)
+    void sector_write(uint8_t i, size_type pos, const Int& value)
     { 
-	*(reinterpret_cast<Int*>(&sector_[pos * sizeof(Int)])) = value;
-	state_modified(true);
+	*(reinterpret_cast<Int*>(&sector_[i][pos * sizeof(Int)])) = value;
+	state_.modified(i, true);
     }
 };
 
 
-template <typename SD>
-bool Sector_driver<SD>::read_sector(const Address& nsector)
+template <typename SD, uint8_t N>
+uint8_t Sector_driver<SD, N>::slot_of(const Address& nsector) const
 {
-    if (is_locked()){
-	atd::ctrace<3>() << "ERROR: Trying to access a locked sector\n";
-	return errno(Errno::lock_sector);
-    }
+    for (uint8_t i = 0; i < nslots; ++i)
+	if (nsector_[i] == nsector)
+	    return i;
+
+    return nslots;
+}
+
+
+template <typename SD, uint8_t N>
+bool Sector_driver<SD, N>::is_pinned(const Address& nsector) const
+{
+    uint8_t i = slot_of(nsector);
+    return i != nslots and state_.is_pinned(i);
+}
+
+
+template <typename SD, uint8_t N>
+void Sector_driver<SD, N>::forget(uint8_t i)
+{
+    nsector_[i] = atd::Uninitialized<Address>::uninitialized;
+    state_.modified(i, false);
+    state_.forget(i);
+}
+
+
+template <typename SD, uint8_t N>
+uint8_t Sector_driver<SD, N>::read_sector(const Address& nsector)
+{
+    uint8_t i = slot_of(nsector);
+
+    if (i == nslots){
+	i = state_.victim();
 
-    if (nsector_ != nsector){
-	if (!flush())
-	    return false;
+	if (i == nslots){
+	    atd::ctrace<3>() << "ERROR: Trying to access a pinned sector\n";
+	    errno(Errno::lock_sector);
+	    return nslots;
+	}
 
-	if (!read(nsector, sector_))
-	    return errno(Errno::read_error);
+	if (!flush(i))
+	    return nslots;
 
-	state_modified(false);
+	if (!read(nsector, sector_[i])){
+	    forget(i);
+	    errno(Errno::read_error);
+	    return nslots;
+	}
 
-	nsector_ = nsector;
+	nsector_[i] = nsector;
     }
 
-    return ok();
+    state_.touch(i);
+    ok();
+
+    return i;
 }
 
 
 
-template <typename SD>
+template <typename SD, uint8_t N>
     template <Type::Integer Int>
-Int Sector_driver<SD>::read(const Address& nsector, const size_type& pos)
+Int Sector_driver<SD, N>::read(const Address& nsector, const size_type& pos)
 {
-    if (!read_sector(nsector))
+    uint8_t i = read_sector(nsector);
+    if (i == nslots)
 	return 0;
 
-    return sector_read<Int>(pos);
+    return sector_read<Int>(i, pos);
 }
 
 
-template <typename SD>
-Sector_driver<SD>::size_type 
-    Sector_driver<SD>::read( const Address& nsector, const size_type& pos
+template <typename SD, uint8_t N>
+Sector_driver<SD, N>::size_type 
+    Sector_driver<SD, N>::read( const Address& nsector, const size_type& pos
 		  , std::span<uint8_t> buf)
 {
-    if (!read_sector(nsector))
+    uint8_t i = read_sector(nsector);
+    if (i == nslots)
 	return 0;
 
-    auto n = std::min(buf.size(), sector_size - pos);
-    std::copy_n(sector_.begin() + pos, n, buf.begin());
+    // (RRR) memcpy y no copy_n: nuestro std::copy_n copia byte a byte y
+    //       esta función la usa File::read para copiar sectores enteros.
+    size_type n = std::min<size_type>(buf.size(), sector_size - pos);
+    std::memcpy(buf.data(), sector_[i].data() + pos, n);
 
     return n;
 }
 
 
-template <typename SD>
-Sector_driver<SD>::size_type 
-    Sector_driver<SD>::write( const Address& nsector, const size_type& pos
+template <typename SD, uint8_t N>
+Sector_driver<SD, N>::size_type 
+    Sector_driver<SD, N>::write( const Address& nsector, const size_type& pos
 		  , std::span<uint8_t> buf)
 {
-    if (!read_sector(nsector))
+    uint8_t i = read_sector(nsector);
+    if (i == nslots)
 	return 0;
 
-    auto n = std::min(buf.size(), sector_size - pos);
-    std::copy_n(buf.begin(), n, sector_.data() + pos);
+    size_type n = std::min<size_type>(buf.size(), sector_size - pos);
+    std::memcpy(sector_[i].data() + pos, buf.data(), n);
 
-    state_modified(true);
+    state_.modified(i, true);
 
     return n;
 
@@ -353,92 +523,182 @@ Sector_driver<SD>::size_type
 
 
 
-template <typename SD>
-uint8_t* Sector_driver<SD>::lock_sector(const Address& nsector)
+template <typename SD, uint8_t N>
+uint8_t* Sector_driver<SD, N>::pin_sector(const Address& nsector)
 { 
-    atd::precondition<9>(is_unlocked(), "ERROR? Locking a locked sector");
+    atd::precondition<9>(!is_pinned(nsector), "ERROR? Pinning a pinned sector");
 
-    if (!read_sector(nsector))
+    uint8_t i = read_sector(nsector);
+    if (i == nslots)
 	return nullptr;
 
-    state_lock();
+    state_.pin(i);
 
-    return sector_.data();
+    return sector_[i].data();
 }
 
 
+template <typename SD, uint8_t N>
+void Sector_driver<SD, N>::unpin(const Address& nsector)
+{ 
+    uint8_t i = slot_of(nsector);
+    if (i != nslots)
+	state_.unpin(i);
+}
+
 
-template <typename SD>
+template <typename SD, uint8_t N>
     template <Type::Integer Int>
-uint8_t Sector_driver<SD>::
+uint8_t Sector_driver<SD, N>::
 	    write(const Address& nsector, const size_type& pos
 		 , const Int& value)
 {
-    if (!read_sector(nsector))
+    uint8_t i = read_sector(nsector);
+    if (i == nslots)
 	return 0;
 
-    sector_write(pos, value);
-
-    state_modified(true);
-    errno(Errno::ok);
+    sector_write(i, pos, value);
 
     return 1;
 }
 
 
-template <typename SD>
-bool Sector_driver<SD>::flush()
+template <typename SD, uint8_t N>
+bool Sector_driver<SD, N>::flush(uint8_t i)
 {
-    atd::ctrace<100>() << "SDCard::flush(" << nsector_ << ")?\n";
-    if (!state_is_modified())
+    atd::ctrace<100>() << "SDCard::flush(" << nsector_[i] << ")?\n";
+    if (!state_.is_modified(i))
 	return true;
 
-    if (!write(nsector_, sector_))
+    if (!write(nsector_[i], sector_[i]))
 	return errno(Errno::write_error);
 
-    state_modified(false);
+    state_.modified(i, false);
 
     return true;
 }
 
 
-template <typename SD>
-Sector_driver<SD>::Address 
-Sector_driver<SD>::fill_n(const Address& sector0
+template <typename SD, uint8_t N>
+bool Sector_driver<SD, N>::flush()
+{
+    bool res = true;
+    for (uint8_t i = 0; i < nslots; ++i){
+	if (!flush(i))
+	    res = false;
+    }
+
+    return res;
+}
+
+
+template <typename SD, uint8_t N>
+Sector_driver<SD, N>::Address 
+Sector_driver<SD, N>::fill_n(const Address& sector0
 			, const Address& n, uint8_t value)
 {
     if (n == 0) return 0;
 
-    if (!flush())
+    // Los sectores [sector0, sector0 + n) que estén en memoria dejan de ser
+    // válidos (si estuvieran modificados su contenido se pierde).
+    for (uint8_t i = 0; i < nslots; ++i){
+	if (nsector_[i].is_initialized() and
+	    sector0 <= nsector_[i] and nsector_[i] - sector0 < n){
+
+	    if (state_.is_pinned(i)){
+		atd::ctrace<3>() << "ERROR: Trying to fill a pinned sector\n";
+		errno(Errno::lock_sector);
+		return 0;
+	    }
+
+	    forget(i);
+	}
+    }
+
+    uint8_t i = state_.victim();
+    if (i == nslots){
+	errno(Errno::lock_sector);
 	return 0;
+    }
 
-    std::fill(sector_.begin(), sector_.end(), value);
-    state_modified(true);
+    if (!flush(i))
+	return 0;
 
-    for (Address i = 0; i < n; ++i){
-	if (!write(sector0 + i, sector_))
-	    return i;
+    // Usamos el slot i como buffer: el sector que había en memoria deja de
+    // ser válido.
+    forget(i);
+    std::fill(sector_[i].begin(), sector_[i].end(), value);
+
+    atd::ctrace<100>() << "SDCard::Multiple_write(" << sector0 
+		       << ", " << n << ")\n";
+
+    // Escribimos todos los sectores en una única sesión (CMD25), 
+    // indicando a la SD card cuántos vamos a escribir (ACMD23).
+    typename SDCard::Multiple_write sd{sector0, n};
+    if (!sd.ok()){
+	errno(Errno::write_error);
+	return 0;
+    }
+
+    for (Address k = 0; k < n; ++k){
+	if (!sd.write(sector_[i]).ok()){
+	    sd.stop();
+	    errno(Errno::write_error);
+	    return k;
+	}
+    }
+
+    if (!sd.stop().ok()){
+	errno(Errno::write_error);
+	return 0;
     }
 
+    // Todos los sectores son iguales: el último escrito queda en memoria
+    nsector_[i] = sector0 + (n - 1);
+    state_.touch(i);
+
+    ok();
     return n;
 }
 
 
 
+template <typename SD, uint8_t N>
+    template <Type::Integer Int>
+Sector_driver<SD, N>::size_type 
+	Sector_driver<SD, N>::find(const Address& nsector, size_type pos
+				, const Int& value)
+{
+    constexpr size_type M = sector_size / sizeof(Int);
+
+    uint8_t i = read_sector(nsector);
+    if (i == nslots)
+	return M;
+
+    const Int* p = reinterpret_cast<const Int*>(sector_[i].data());
+    for (; pos < M; ++pos){
+	if (p[pos] == value)
+	    return pos;
+    }
+
+    return M;
+}
+
+
 /***************************************************************************
  *			    SECTOR_DRIVER_LOCK
  *
- * Smart pointer para bloquear un sector de Sector_driver. Gestiona
- * desbloquear el sector en el destructor (básicamente es lo que hace).
+ * Smart pointer para fijar un sector de Sector_driver. Gestiona
+ * liberar el sector en el destructor (básicamente es lo que hace).
  *
  ***************************************************************************/
 namespace impl_of{
 
-template < typename SDCard
+template < typename Driver
 	 , typename T>
 struct Sector_driver_lock{
 // Types
-    using SD = Sector_driver<SDCard>;
+    using SD = Driver;
     using Address   = typename SD::Address;
     using pointer   = T*;
     using const_pointer = const T*;
@@ -447,13 +707,19 @@ struct Sector_driver_lock{
 
 // Data
     SD& sd; 
+    Address nsector;
     pointer ptr;
 
 // Constructors
-    Sector_driver_lock(SD& sd0, const Address& nsector) : sd{sd0} 
-    { ptr = reinterpret_cast<pointer>(sd.template lock_sector(nsector)); }
+    Sector_driver_lock(SD& sd0, const Address& nsector0) 
+	: sd{sd0}, nsector{nsector0}
+    { ptr = reinterpret_cast<pointer>(sd.pin_sector(nsector)); }
 
-    ~Sector_driver_lock() { sd.unlock();}
+    ~Sector_driver_lock() 
+    { 
+	if (ptr != nullptr) 
+	    sd.unpin(nsector);
+    }
 
 // Pointer access
     reference operator*() { return *ptr; }
@@ -469,10 +735,10 @@ struct Sector_driver_lock{
 } // impl_of
 
 
-template <typename SD>
+template <typename SD, uint8_t N>
     template <typename T>
-auto Sector_driver<SD>::lock_sector_and_view_as(const Address& nsector)
--> typename Sector_driver<SD>::Lock<T>
+auto Sector_driver<SD, N>::lock_sector_and_view_as(const Address& nsector)
+-> typename Sector_driver<SD, N>::Lock<T>
 { return Lock<T>{*this, nsector}; }
 
 }// namespace dev
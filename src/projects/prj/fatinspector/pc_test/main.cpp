@@ -0,0 +1,246 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <alp_test.h>
+#include <alp_string.h>
+
+#include <iostream>
+#include <array>
+#include <span>
+#include <map>
+#include <cstring>
+
+// Sector_driver y FAT32 tienen un miembro `errno`, que en el PC es una
+// macro. Por eso compilamos atd_fat.cpp aquí, después del #undef, en
+// lugar de añadirlo a SOURCES.
+#include <cerrno>
+#undef errno
+
+#include "../dev_sector_driver.h"
+
+// Boot_sector es la imagen del sector en disco: en el AVR no hay padding,
+// en el PC sí.
+#pragma pack(push, 1)
+#include "../atd_fat.h"
+#include "../atd_fat.cpp"
+#pragma pack(pop)
+
+using namespace test;
+
+// SD card simulada
+// ----------------
+// Los sectores que no se han escrito nunca valen 0. Contamos las lecturas
+// de cada sector para saber qué regiones de la FAT se han leído.
+struct SDCard{
+    using Address = uint32_t;
+    static constexpr uint16_t block_size = 512;
+    using Block = std::span<uint8_t, block_size>;
+    using Sector = std::array<uint8_t, block_size>;
+
+    struct Response{
+	bool ok() const {return true;}
+    };
+
+    inline static std::map<Address, Sector> disk;
+    inline static std::map<Address, int> nreads;
+
+    static Response read(const Address& add, Block block)
+    {
+	++nreads[add];
+
+	auto p = disk.find(add);
+	if (p == disk.end())
+	    std::fill(block.begin(), block.end(), 0);
+	else
+	    std::copy(p->second.begin(), p->second.end(), block.begin());
+
+	return Response{};
+    }
+
+    static Response write(const Address& add, Block block)
+    {
+	std::copy(block.begin(), block.end(), disk[add].begin());
+	return Response{};
+    }
+
+    class Multiple_write{
+    public:
+	Multiple_write(const Address& add, uint32_t) : add_{add} { }
+	bool ok() const {return true;}
+	Response write(Block block) {return SDCard::write(add_++, block);}
+	Response stop() {return Response{};}
+
+    private:
+	Address add_;
+    };
+};
+
+using Sector_driver = dev::Sector_driver<SDCard, 2>;
+using Volume	    = atd::FAT32::Volume<Sector_driver>;
+
+
+// Volumen FAT32
+// -------------
+//  sector 0	    : boot sector
+//  sector 1	    : FS_info
+//  sectores 32..95 : FAT[0]
+//  sectores 96..159: FAT[1] (mirror)
+//  sectores 160..  : data area, 1 sector por cluster
+//
+// 64 sectores por FAT = 32 regiones de 2 sectores (256 clusters).
+constexpr uint32_t rsvd_sectors	    = 32;
+constexpr uint32_t FAT_sectors	    = 64;
+constexpr uint32_t FAT0		    = rsvd_sectors;
+constexpr uint32_t FAT1		    = rsvd_sectors + FAT_sectors;
+constexpr uint32_t nclusters	    = 8000;
+constexpr uint32_t end_cluster	    = nclusters + 2;
+constexpr uint32_t clusters_per_region = 2 * 128;
+
+constexpr uint32_t EOC = 0x0FFFFFFF;
+
+template <typename Int>
+void poke(uint32_t nsector, uint32_t offset, Int x)
+{ std::memcpy(SDCard::disk[nsector].data() + offset, &x, sizeof(Int)); }
+
+template <typename Int>
+Int peek(uint32_t nsector, uint32_t offset)
+{
+    Int x{};
+    std::memcpy(&x, SDCard::disk[nsector].data() + offset, sizeof(Int));
+    return x;
+}
+
+void FAT_write(uint32_t cluster, uint32_t x)
+{
+    uint32_t nsector = cluster / 128;
+    uint32_t offset  = (cluster % 128) * 4;
+    poke<uint32_t>(FAT0 + nsector, offset, x);
+    poke<uint32_t>(FAT1 + nsector, offset, x);
+}
+
+uint32_t FAT_read(uint8_t i, uint32_t cluster)
+{ return peek<uint32_t>((i == 0? FAT0: FAT1) + cluster / 128, (cluster % 128) * 4); }
+
+// Tarjeta llena: todos los clusters ocupados
+void format_full_card()
+{
+    SDCard::disk.clear();
+
+// Boot sector (offsets: 3.1 FAT specification)
+    poke<uint16_t>(0, 11, 512);		    // byte_per_sec
+    poke<uint8_t> (0, 13, 1);		    // sec_per_clus
+    poke<uint16_t>(0, 14, rsvd_sectors);    // rsvd_sec_cnt
+    poke<uint8_t> (0, 16, 2);		    // num_fats
+    poke<uint32_t>(0, 32, rsvd_sectors + 2 * FAT_sectors + nclusters);
+    poke<uint32_t>(0, 36, FAT_sectors);	    // fat_sz32
+    poke<uint16_t>(0, 40, 0);		    // ext_flags: mirror
+    poke<uint32_t>(0, 44, 2);		    // root_clus
+    poke<uint16_t>(0, 48, 1);		    // fs_info
+    poke<uint16_t>(0, 50, 6);		    // bk_boot_sec
+    poke<uint16_t>(0, 510, 0xAA55);
+
+// FS_info: free_count desconocido, nxt_free = 2
+    poke<uint32_t>(1, 0, 0x41615252);
+    poke<uint32_t>(1, 484, 0x61417272);
+    poke<uint32_t>(1, 488, 0xFFFFFFFF);
+    poke<uint32_t>(1, 492, 2);
+    poke<uint32_t>(1, 508, 0xAA550000);
+
+// FAT
+    FAT_write(0, 0x0FFFFFF8);
+    FAT_write(1, EOC);
+    for (uint32_t c = 2; c < end_cluster; ++c)
+	FAT_write(c, EOC);
+}
+
+// Número de lecturas de los sectores de FAT[0] de las regiones [r0, r1)
+int reads_of_regions(uint32_t r0, uint32_t r1)
+{
+    int res = 0;
+    for (uint32_t s = 2 * r0; s < 2 * r1; ++s)
+	res += SDCard::nreads[FAT0 + s];
+
+    return res;
+}
+
+void test_full_card()
+{
+    test::interfaz("FAT_area::new_list (full card)");
+
+    format_full_card();
+    Volume vol{0};
+    auto& fat = vol.fat_area;
+    CHECK_TRUE(fat.number_of_clusters() == nclusters, "init");
+
+// La tarjeta está llena
+    CHECK_TRUE(fat.new_list() == 0, "full card");
+
+// La primera búsqueda ha marcado todas las regiones llenas: no se vuelven
+// a leer (incluida la región 0, que empieza en el cluster 2)
+    SDCard::nreads.clear();
+    CHECK_TRUE(fat.new_list() == 0, "full card");
+    CHECK_TRUE(reads_of_regions(0, 31) == 0, "full regions are not read again");
+
+// Liberamos un cluster de la región 5: vuelve a leerse
+    constexpr uint32_t c5 = 5 * clusters_per_region + 10;
+    CHECK_TRUE(fat.remove_list(c5), "remove_list");
+    vol.flush();    // Sector_driver es write-back
+    CHECK_TRUE(FAT_read(0, c5) == 0 and FAT_read(1, c5) == 0, "remove_list");
+
+    SDCard::nreads.clear();
+    CHECK_TRUE(fat.new_list() == c5, "cluster_freed: region 5 not full");
+    CHECK_TRUE(reads_of_regions(0, 5) == 0, "full regions skipped");
+    CHECK_TRUE(fat.next_free_hint() == c5 + 1, "nxt_free");
+    vol.flush();
+    CHECK_TRUE(FAT_read(0, c5) == EOC and FAT_read(1, c5) == EOC, "new_list");
+
+    CHECK_TRUE(fat.new_list() == 0, "full card again");
+
+// nxt_free da la vuelta al llegar al último cluster
+    constexpr uint32_t last = end_cluster - 1;
+    CHECK_TRUE(fat.remove_list(last), "remove_list");
+    CHECK_TRUE(fat.new_list() == last, "last cluster");
+    CHECK_TRUE(fat.next_free_hint() == 2, "nxt_free wraps to 2");
+
+// ... y la siguiente búsqueda empieza en el cluster 2 (región 0)
+    CHECK_TRUE(fat.remove_list(100), "remove_list");
+    CHECK_TRUE(fat.remove_list(c5 + 1), "remove_list");
+    CHECK_TRUE(fat.new_list() == 100, "search from cluster 2");
+    CHECK_TRUE(fat.new_list() == c5 + 1, "search from nxt_free");
+    CHECK_TRUE(fat.new_list() == 0, "full card again");
+
+// FS_info
+    CHECK_TRUE(vol.flush(), "flush");
+    CHECK_TRUE(peek<uint32_t>(1, 492) == fat.next_free_hint(), "FS_info");
+}
+
+
+int main()
+{
+try{
+    test::header("FAT_area");
+
+    test_full_card();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
@@ -135,7 +135,13 @@ struct SDCard_cfg{
 
 // Tipos usados
 using SDCard = dev::hwd::SDCard<SDCard_cfg>;
-using Sector_driver = dev::Sector_driver<SDCard>;
+// El atmega4809 tiene 6kB de RAM: podemos mantener en memoria el sector de
+// la FAT y el sector de datos a la vez.
+using Sector_driver = dev::Sector_driver<SDCard, 2>;
+
+// Para leer un sector suelto (MBR, boot sector...) basta con 1 slot: no
+// reservar otros 1KB en la pila de la función.
+using Sector_reader = dev::Sector_driver<SDCard, 1>;
 
 using Volume = atd::FAT32::Volume<Sector_driver>;
 using Directory = atd::FAT32::Directory<Sector_driver>;
@@ -33,7 +33,7 @@ uint32_t Main::fat_volume_first_sector(const atd::MBR_partition& p, uint8_t n)
 
 uint32_t Main::fat_volume_first_sector(uint8_t npartition)
 {
-    Sector_driver driver;
+    Sector_reader driver;
     auto mbr = driver.template lock_sector_and_view_as<atd::MBR>(0);
 
     if (mbr.is_null() or !mbr->is_valid()){
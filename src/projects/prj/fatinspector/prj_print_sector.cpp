@@ -64,7 +64,7 @@ void Main::print_MBR_boot_sector()
     using MBR = atd::MBR;
     using MBR_type = atd::MBR::Partition_type;
     
-    Sector_driver driver;
+    Sector_reader driver;
     auto mbr = driver.template lock_sector_and_view_as<MBR>(0);
 
 
@@ -91,9 +91,9 @@ void Main::reserved_area_print_FS_info()
     }
 
 // TODO: esto es un poco ineficiente. Por una parte Volume tiene un
-// Sector_driver dentro, que son 512 bytes y luego el Sector_driver que creo
-// localmente aquí tiene otros 512 bytes, reservando 1KB de memoria en esta
-// función!!! (Pero como estoy probando tampoco preocupa)
+// Sector_driver dentro, que son 2 sectores (1KB), y luego el Sector_reader
+// que creo localmente aquí tiene otros 512 bytes, reservando 1.5KB de
+// memoria en esta función!!! (Pero como estoy probando tampoco preocupa)
     Boot_sector_min bs_min{};
     Volume vol{nsector, bs_min};
 
@@ -102,7 +102,7 @@ void Main::reserved_area_print_FS_info()
 	return;
     }
 
-    Sector_driver driver;
+    Sector_reader driver;
     auto info = driver.template lock_sector_and_view_as<FS_info>(
 	    vol.first_sector() + bs_min.FS_info_sector());
 
@@ -137,7 +137,7 @@ void Main::reserved_area_print_FAT32_boot_sector()
 
     using Boot_sector = atd::FAT32::Boot_sector;
 
-    Sector_driver driver;
+    Sector_reader driver;
 
     auto bs = driver.template lock_sector_and_view_as<Boot_sector>(nsector);
     if (bs.is_null()){
@@ -0,0 +1,192 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../std_charconv.h"
+
+#include <alp_test.h>
+#include <iostream>
+#include <string>
+#include <limits>
+#include <cstdint>
+
+using namespace test;
+
+namespace prv = mtd::atd_::private_;
+
+// Resultado de to_chars como string
+template <typename Int>
+std::string mtd_to_chars(Int x)
+{
+    char buffer[30];
+    auto [p, ec] = mtd::to_chars(buffer, buffer + 30, x);
+    if (ec != mtd::errc{})
+	return "ERROR";
+
+    return std::string(buffer, p);
+}
+
+// Resultado de int_to_cstring como string
+template <typename Int>
+std::string mtd_int_to_cstring(Int x)
+{
+    char buffer[30];
+    char* p = mtd::atd_::int_to_cstring(buffer, buffer + 30, x);
+    return std::string(p, buffer + 30);
+}
+
+template <typename Int>
+bool check(Int x)
+{
+    std::string res = std::to_string(x);
+    return mtd_to_chars(x) == res and mtd_int_to_cstring(x) == res;
+}
+
+
+void test_div()
+{
+    test::interface("div100");
+
+    bool ok = true;
+    for (uint16_t x = 0; x < 256; ++x){
+	uint8_t y = static_cast<uint8_t>(x);
+	if (prv::div100(y) != y / 100)
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "uint8_t");
+
+    ok = true;
+    for (uint32_t x = 0; x <= 0xFFFF; ++x){
+	uint16_t y = static_cast<uint16_t>(x);
+	if (prv::div100(y) != y / 100)
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "uint16_t");
+}
+
+
+void test_exhaustive()
+{
+    test::interface("to_chars (exhaustivo 8 y 16 bits)");
+
+    bool ok = true;
+    for (int x = 0; x < 256; ++x){
+	if (!check(static_cast<uint8_t>(x)) or !check(static_cast<int8_t>(x)))
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "8 bits");
+
+    ok = true;
+    for (uint32_t x = 0; x <= 0xFFFF; ++x){
+	if (!check(static_cast<uint16_t>(x)) or !check(static_cast<int16_t>(x)))
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "16 bits");
+}
+
+
+template <typename Int>
+void test_limits(const char* name)
+{
+    using L = std::numeric_limits<Int>;
+    CHECK_TRUE(check(L::min()) and check(L::max()) and check(Int{0}), name);
+}
+
+void test_32_64()
+{
+    test::interface("to_chars (32 y 64 bits)");
+
+    // Todas las potencias de 10 y sus vecinos
+    bool ok = true;
+    for (uint64_t p = 1; p <= 1'000'000'000ull; p *= 10){
+	for (int64_t d = -1; d <= 1; ++d){
+	    uint32_t x = static_cast<uint32_t>(p + d);
+	    if (!check(x) or !check(static_cast<int32_t>(x))
+		          or !check(-static_cast<int32_t>(x)))
+		ok = false;
+	}
+    }
+    CHECK_TRUE(ok, "potencias de 10");
+
+    ok = true;
+    for (uint64_t x = 0; x <= 0xFFFF'FFFF; x += 9'973){ 
+	if (!check(static_cast<uint32_t>(x)) or
+	    !check(static_cast<int32_t>(x)))
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "32 bits");
+
+    ok = true;
+    for (uint64_t x = 1; x < 0xFFFF'FFFF'FFFF'FFFFull / 7; x = x * 7 + 3){ 
+	if (!check(x) or !check(static_cast<int64_t>(x)) or
+			 !check(-static_cast<int64_t>(x)))
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "64 bits");
+
+    test_limits<int8_t>("int8_t");
+    test_limits<uint8_t>("uint8_t");
+    test_limits<int16_t>("int16_t");
+    test_limits<uint16_t>("uint16_t");
+    test_limits<int32_t>("int32_t");
+    test_limits<uint32_t>("uint32_t");
+    test_limits<int64_t>("int64_t");
+    test_limits<uint64_t>("uint64_t");
+}
+
+
+void test_buffer()
+{
+    test::interface("to_chars (buffer)");
+
+    char buffer[10];
+    for (int n = 0; n < 5; ++n){
+	auto res = mtd::to_chars(buffer, buffer + n, int16_t{-1234});
+	CHECK_TRUE(res.ptr == buffer + n and 
+		   res.ec == mtd::errc::value_too_large, "value_too_large");
+    }
+
+    auto res = mtd::to_chars(buffer, buffer + 5, int16_t{-1234});
+    CHECK_TRUE(res.ptr == buffer + 5 and res.ec == mtd::errc{}, "exact size");
+    CHECK_TRUE(std::string(buffer, res.ptr) == "-1234", "exact size");
+
+    res = mtd::to_chars(buffer, buffer + 10, uint32_t{1'000'000'007});
+    CHECK_TRUE(std::string(buffer, res.ptr) == "1000000007", "uint32_t");
+
+    // int_to_cstring con buffer pequeño: escribe las últimas cifras
+    char* p = mtd::atd_::int_to_cstring(buffer, buffer + 3, uint32_t{123456});
+    CHECK_TRUE(p == buffer and std::string(buffer, buffer + 3) == "456",
+							"int_to_cstring");
+}
+
+int main()
+{
+try{
+    test::header("std_charconv");
+
+    test_div();
+    test_exhaustive();
+    test_32_64();
+    test_buffer();
+
+}catch(std::exception& e){
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+
+}
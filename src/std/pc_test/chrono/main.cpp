@@ -317,6 +317,100 @@ void test_hh_mm_ss()
 	          mtd::chrono::hours{30});
 }
 
+// Comprobamos el calendario con la libc del ordenador (gmtime_r) y con
+// std::chrono (C++20) desde el año 1600 hasta el 2400.
+void test_calendar()
+{
+    test::interface("calendar");
+
+    using namespace mtd::chrono;
+
+    int32_t z0 = std::chrono::sys_days{std::chrono::year{1600}/1/1}
+					    .time_since_epoch().count();
+    int32_t z1 = std::chrono::sys_days{std::chrono::year{2400}/12/31}
+					    .time_since_epoch().count();
+
+    bool ok_libc = true;
+    bool ok_std  = true;
+    bool ok_back = true;
+    for (int32_t z = z0; z <= z1; ++z){
+	sys_days d{days{z}};
+	year_month_day ymd{d};
+	weekday wd{d};
+
+	std::time_t t = static_cast<std::time_t>(z) * 86400;
+	std::tm tm;
+	::gmtime_r(&t, &tm);
+
+	if (int{ymd.year()} != tm.tm_year + 1900 or
+	    unsigned{ymd.month()} != unsigned(tm.tm_mon + 1) or
+	    unsigned{ymd.day()} != unsigned(tm.tm_mday) or
+	    wd.c_encoding() != unsigned(tm.tm_wday) or
+	    !ymd.ok())
+	    ok_libc = false;
+
+	std::chrono::year_month_day sd{std::chrono::sys_days{
+						    std::chrono::days{z}}};
+	if (int{sd.year()} != int{ymd.year()} or
+	    unsigned{sd.month()} != unsigned{ymd.month()} or
+	    unsigned{sd.day()} != unsigned{ymd.day()})
+	    ok_std = false;
+
+	if (sys_days{ymd} != d)
+	    ok_back = false;
+    }
+
+    CHECK_TRUE(ok_libc, "civil_from_days vs gmtime_r");
+    CHECK_TRUE(ok_std, "civil_from_days vs std::chrono");
+    CHECK_TRUE(ok_back, "days_from_civil(civil_from_days(z)) == z");
+
+// Extremos
+    bool ok_limits = true;
+    for (int y: {-32767, -32001, -1, 0, 1, 32000, 32767}){
+	for (unsigned m: {1u, 2u, 3u, 12u}){
+	    std::chrono::year_month_day sd{std::chrono::year{y}, 
+			    std::chrono::month{m}, std::chrono::day{1}};
+	    year_month_day md{year{y}, month{m}, day{1}};
+	    int32_t z = std::chrono::sys_days{sd}.time_since_epoch().count();
+
+	    if (sys_days{md}.time_since_epoch().count() != z or
+		year_month_day{sys_days{days{z}}} != md)
+		ok_limits = false;
+	}
+    }
+    CHECK_TRUE(ok_limits, "year limits");
+
+// Fechas conocidas
+    auto days_of = [](int y, unsigned m, unsigned d)
+    { return sys_days{year_month_day{year{y}, month{m}, day{d}}}
+						.time_since_epoch().count(); };
+
+    CHECK_TRUE(days_of(1970, 1, 1) == 0, "epoch");
+    CHECK_TRUE(days_of(2000, 1, 1) == 10957, "Y2K");
+    CHECK_TRUE(weekday{sys_days{days{days_of(2026, 10, 18)}}}.c_encoding() == 0,
+								    "weekday");
+
+// ok
+    CHECK_TRUE((year_month_day(year{2024}, month{2}, day{29}).ok()), "ok");
+    CHECK_TRUE((!year_month_day(year{2023}, month{2}, day{29}).ok()), "ok");
+    CHECK_TRUE((!year_month_day(year{1900}, month{2}, day{29}).ok()), "ok");
+    CHECK_TRUE((year_month_day(year{2000}, month{2}, day{29}).ok()), "ok");
+    CHECK_TRUE((!year_month_day(year{2000}, month{4}, day{31}).ok()), "ok");
+    CHECK_TRUE((!year_month_day(year{2000}, month{13}, day{1}).ok()), "ok");
+
+// weekday arithmetic
+    weekday sunday{0};
+    CHECK_TRUE((sunday + days{1}).c_encoding() == 1, "weekday +");
+    CHECK_TRUE((sunday - days{1}).c_encoding() == 6, "weekday -");
+    CHECK_TRUE((sunday + days{15}).c_encoding() == 1, "weekday +");
+    CHECK_TRUE(weekday{7} == sunday and sunday.iso_encoding() == 7, "weekday");
+
+// month
+    month m{12};
+    ++m;
+    CHECK_TRUE(unsigned{m} == 1, "month++");
+}
+
 
 int main()
 {
@@ -327,6 +421,7 @@ try{
     test_duration();
     test_time_point();
     test_hh_mm_ss();
+    test_calendar();
     test_clocks();
 
 }catch(const std::exception& e){
@@ -246,6 +246,79 @@ void test_hexadecimal()
     out << "HEX\n";
 }
 
+// Cuenta las llamadas a overflow y xsputn
+class count_streambuf : public mtd::streambuf{
+public:
+    std::string str;
+    int noverflow = 0;
+    int nxsputn = 0;
+
+    void reset() {str.clear(); noverflow = 0; nxsputn = 0;}
+
+protected:
+    virtual int_type overflow(int_type c = traits_type::eof()) override
+    { 
+	++noverflow;
+	str.push_back(static_cast<char>(c));
+	return 1;
+    }
+
+    virtual mtd::streamsize xsputn(const char_type* s, mtd::streamsize n) override
+    { 
+	++nxsputn;
+	str.append(s, n);
+	return n;
+    }
+};
+
+class count_ostream : public mtd::ostream{
+public:
+    count_ostream() : ostream{&sb_} {}
+
+    count_streambuf sb_;
+};
+
+void test_sputn()
+{
+    test::interface("sputn");
+
+    count_ostream out;
+    auto& sb = out.sb_;
+
+    out << "Hola mundo";
+    CHECK_TRUE(sb.str == "Hola mundo" and sb.nxsputn == 1 and 
+	       sb.noverflow == 0, "const char*");
+
+    sb.reset();
+    out << -12345;
+    CHECK_TRUE(sb.str == "-12345" and sb.nxsputn == 1 and 
+	       sb.noverflow == 0, "int");
+
+    sb.reset();
+    out << 'a';
+    CHECK_TRUE(sb.str == "a" and sb.nxsputn == 1, "char");
+
+    sb.reset();
+    out.put('\0');
+    out << '\0';
+    CHECK_TRUE(sb.str == std::string(2, '\0'), "'\\0'");
+
+    sb.reset();
+    out << mtd::setw(6) << mtd::setfill('*') << mtd::right << 12;
+    CHECK_TRUE(sb.str == "****12" and sb.nxsputn == 2 and
+	       sb.noverflow == 0, "right");
+
+    sb.reset();
+    out << mtd::setw(20) << mtd::left << "abc";
+    CHECK_TRUE(sb.str == "abc*****************" and sb.noverflow == 0, 
+								"left");
+    CHECK_TRUE(sb.nxsputn == 1 + 3, "left"); // 17 = 8 + 8 + 1
+
+    sb.reset();
+    out << mtd::setw(3) << "abcd";
+    CHECK_TRUE(sb.str == "abcd" and sb.nxsputn == 1, "width < len");
+}
+
 void test_bugs()
 {
 //    LCD lcd;
@@ -276,6 +349,8 @@ int main()
 try{
     test::header("ostream");
 
+    test_sputn();
+
     std::cerr << "THESE ARE NOT AUTOMATIC TEST!!!\n";
     test_ostream();
     test_fix_ostream();
@@ -39,10 +39,16 @@
  *    13/10/2019 int_to_cstring (definido en std_cstdio.h)
  *    26/09/2023 dereferenceable
  *    04/10/2024 int_to_cstring (metido en aquí para poder usarlo en atd)
+ *    18/10/2026 int_to_cstring sin divisiones (tabla de 2 cifras)
  *
  ****************************************************************************/
 #include "std_config.h"
 #include "std_cstddef.h"    // size_t, nullptr_t
+#include "std_cstdint.h"
+
+#if defined __AVR__ || __AVR
+#include <avr/pgmspace.h>   // PROGMEM
+#endif
 
 namespace STD{
 
@@ -271,6 +277,10 @@ namespace private_{
 /// El número x como cadena estará almacenado en [pc, pe).
 /// Precondición: x > 0
 /// Es el equivalente a sprintf.
+///
+/// Divide entre 10 por cada cifra: en el avr no hay división hardware, 
+/// siendo muy lento. Solo se usa si el número no entra en el buffer
+/// (escribe las cifras que entren).
 template <typename It, typename Int>
 It posint_to_cstring(It p0, It pe, Int x)
 {
@@ -286,6 +296,253 @@ It posint_to_cstring(It p0, It pe, Int x)
 
     return pc;
 }
+
+
+// uint_of_size
+// ------------
+template <size_t n>
+struct uint_of_size;
+
+template <> struct uint_of_size<1> { using type = uint8_t; };
+template <> struct uint_of_size<2> { using type = uint16_t; };
+template <> struct uint_of_size<4> { using type = uint32_t; };
+template <> struct uint_of_size<8> { using type = uint64_t; };
+
+template <typename Int>
+using uint_of_size_of = typename uint_of_size<sizeof(Int)>::type;
+
+
+// Tabla "00" "01" ... "99"
+// ------------------------
+// (RRR) Escribiendo las cifras de 2 en 2 se hace la mitad de divisiones.
+//       En el avr la guardamos en PROGMEM para no gastar 200 bytes de RAM.
+struct Digits_00_99{
+    char data[200];
+
+    constexpr Digits_00_99() : data{}
+    {
+	for (uint8_t i = 0; i < 100; ++i){
+	    data[2*i]     = '0' + i / 10;
+	    data[2*i + 1] = '0' + i % 10;
+	}
+    }
+};
+
+// Potencias de 10 de 32 bits que no entran en un uint16_t: 10^4...10^9
+// (las usamos para extraer las cifras altas restando)
+#if defined __AVR__ || __AVR
+inline constexpr Digits_00_99 digits_00_99 PROGMEM{};
+inline constexpr uint32_t pow10_32[6] PROGMEM = {
+	10'000ul, 100'000ul, 1'000'000ul, 10'000'000ul, 100'000'000ul,
+	1'000'000'000ul
+};
+
+inline char digit_00_99(uint8_t i) 
+{ return static_cast<char>(pgm_read_byte(&digits_00_99.data[i])); }
+
+inline uint32_t pow10_32_read(uint8_t i)
+{ return pgm_read_dword(&pow10_32[i]); }
+
+#else
+inline constexpr Digits_00_99 digits_00_99{};
+inline constexpr uint32_t pow10_32[6] = {
+	10'000ul, 100'000ul, 1'000'000ul, 10'000'000ul, 100'000'000ul,
+	1'000'000'000ul
+};
+
+inline char digit_00_99(uint8_t i) {return digits_00_99.data[i];}
+inline uint32_t pow10_32_read(uint8_t i) {return pow10_32[i];}
+#endif
+
+
+// Divisiones sin dividir
+// ----------------------
+// Multiplicamos por el inverso: x / d = (x * m) >> s. Las constantes se han
+// comprobado para todos los valores posibles (ver pc_test/charconv)
+inline uint8_t div100(uint8_t x)
+{ return static_cast<uint8_t>((uint16_t{x} * 41u) >> 12); }
+
+// x / 100 = (x / 4) / 25
+inline uint16_t div100(uint16_t x)
+{ return static_cast<uint16_t>((uint32_t{static_cast<uint16_t>(x >> 2)} 
+							    * 5243u) >> 17); }
+
+
+// number_of_digits
+// ----------------
+inline uint8_t number_of_digits(uint8_t x)
+{
+    if (x < 10) return 1;
+    if (x < 100) return 2;
+    return 3;
+}
+
+inline uint8_t number_of_digits(uint16_t x)
+{
+    if (x < 10) return 1;
+    if (x < 100) return 2;
+    if (x < 1'000) return 3;
+    if (x < 10'000) return 4;
+    return 5;
+}
+
+inline uint8_t number_of_digits(uint32_t x)
+{
+    if (x <= 0xFFFF)
+	return number_of_digits(static_cast<uint16_t>(x));
+
+    uint8_t n = 5;
+    for (uint8_t i = 1; i < 6 and x >= pow10_32_read(i); ++i)
+	++n;
+
+    return n;
+}
+
+inline uint8_t number_of_digits(uint64_t x)
+{
+    if (x <= 0xFFFF'FFFF)
+	return number_of_digits(static_cast<uint32_t>(x));
+
+    uint8_t n = 10;
+    uint64_t pow10 = 10'000'000'000ull;
+    while (n < 20 and x >= pow10){
+	++n;
+	pow10 *= 10;
+    }
+
+    return n;
+}
+
+
+// Escribe las 2 cifras de x < 100 en [pc - 2, pc). Devuelve pc - 2.
+template <typename It>
+inline It write_2_digits_backwards(It pc, uint8_t x)
+{
+    uint8_t i = 2*x;
+    --pc;
+    *pc = digit_00_99(i + 1);
+    --pc;
+    *pc = digit_00_99(i);
+
+    return pc;
+}
+
+// Escribe x < 100 sin ceros a la izquierda
+template <typename It>
+inline It write_last_digits_backwards(It pc, uint8_t x)
+{
+    if (x < 10){
+	--pc;
+	*pc = '0' + x;
+	return pc;
+    }
+
+    return write_2_digits_backwards(pc, x);
+}
+
+
+// uint_to_cstring_backwards
+// -------------------------
+// Escribe x terminando en pe y devuelve donde empieza. 
+// Precondición: en [p0, pe) entran todas las cifras de x.
+template <typename It>
+It uint_to_cstring_backwards(It pe, uint8_t x)
+{
+    It pc = pe;
+
+    if (x >= 100){
+	uint8_t q = div100(x);
+	pc = write_2_digits_backwards(pc, static_cast<uint8_t>(x - q * 100));
+	--pc;
+	*pc = '0' + q;
+	return pc;
+    }
+
+    return write_last_digits_backwards(pc, x);
+}
+
+template <typename It>
+It uint_to_cstring_backwards(It pe, uint16_t x)
+{
+    It pc = pe;
+
+    while (x >= 100){
+	uint16_t q = div100(x);
+	pc = write_2_digits_backwards(pc, static_cast<uint8_t>(x - q * 100));
+	x = q;
+    }
+
+    return write_last_digits_backwards(pc, static_cast<uint8_t>(x));
+}
+
+// (RRR) No hay forma barata de dividir un uint32_t entre 100 en el avr:
+//       el producto por el inverso necesita 64 bits. Las cifras de 10^9 a
+//       10^4 las sacamos restando potencias de 10 (como mucho 9 restas por
+//       cifra) y las 4 últimas (< 10000) con uint16_t.
+template <typename It>
+It uint_to_cstring_backwards(It pe, uint32_t x)
+{
+    if (x <= 0xFFFF)
+	return uint_to_cstring_backwards(pe, static_cast<uint16_t>(x));
+
+    uint8_t n = number_of_digits(x);
+    It pc = pe;
+    for (uint8_t i = 0; i < n; ++i)
+	--pc;
+
+    It p = pc;
+    for (uint8_t i = n - 5 + 1; i > 0; --i){
+	uint32_t pow10 = pow10_32_read(i - 1);
+	char d = '0';
+	while (x >= pow10){
+	    x -= pow10;
+	    ++d;
+	}
+
+	*p = d;
+	++p;
+    }
+
+    // x < 10'000: las 4 cifras con ceros a la izquierda
+    uint16_t y = static_cast<uint16_t>(x);
+    uint16_t q = div100(y);
+    It pl = write_2_digits_backwards(pe, static_cast<uint8_t>(y - q * 100));
+    write_2_digits_backwards(pl, static_cast<uint8_t>(q));
+
+    return pc;
+}
+
+// Los uint64_t no los uso en el avr: dividimos.
+template <typename It>
+It uint_to_cstring_backwards(It pe, uint64_t x)
+{
+    if (x <= 0xFFFF'FFFF)
+	return uint_to_cstring_backwards(pe, static_cast<uint32_t>(x));
+
+    It pc = pe;
+    while (x >= 100){
+	uint64_t q = x / 100;
+	pc = write_2_digits_backwards(pc, static_cast<uint8_t>(x - q * 100));
+	x = q;
+    }
+
+    return write_last_digits_backwards(pc, static_cast<uint8_t>(x));
+}
+
+
+// uint_to_cstring
+// ---------------
+/// Equivalente a posint_to_cstring sin divisiones para los enteros de 8, 16
+/// y 32 bits. Admite x == 0.
+template <typename It, typename Uint>
+It uint_to_cstring(It p0, It pe, Uint x)
+{
+    if (pe - p0 < number_of_digits(x))
+	return posint_to_cstring(p0, pe, x);
+
+    return uint_to_cstring_backwards(pe, x);
+}
+
 } // namespace private_
 
 // int_to_cstring
@@ -294,8 +551,8 @@ It posint_to_cstring(It p0, It pe, Int x)
 /// [p0, pe). Devuelve la posición pc en donde EMPIEZA el entero como cadena
 /// El número x como cadena estará almacenado en [pc, pe).
 ///
-/// Si Int es signed esta función falla para el caso en que valga
-/// std::numeric_limits::min() ya que falla el operador -x para este caso.
+/// Funciona también para std::numeric_limits::min() ya que calcula el
+/// valor absoluto como unsigned.
 /// Es el equivalente a sprintf.
 template <typename It, typename Int>
 It int_to_cstring(It p0, It pe, Int x)
@@ -303,21 +560,16 @@ It int_to_cstring(It p0, It pe, Int x)
     if (p0 == pe)
 	return p0;
 
-    It pc = pe; // = ultima posición donde insertamos una cifra
-    
-    if (x == 0){
-	--pc;
-	*pc = '0';
-	return pc;
-    }
+    using Uint = private_::uint_of_size_of<Int>;
 
-    bool negativo  = false;
+    bool negativo = false;
+    Uint ux = static_cast<Uint>(x);
     if (x < 0){
 	negativo = true;
-	x = -x;	// Esta operación falla si x == std::numeric_limits::min()!!!
+	ux = static_cast<Uint>(Uint{0} - ux);
     }
 
-    pc = private_::posint_to_cstring(p0, pe, x);
+    It pc = private_::uint_to_cstring(p0, pe, ux);
 
     if (negativo and pc != p0){
 	--pc;
@@ -0,0 +1,101 @@
+// Copyright (C) 2026 Manuel Perez
+//           mail: <manuel2perez@proton.me>
+//           https://github.com/amanuellperez/mcu
+//
+// This file is part of the MCU++ Library.
+//
+// MCU++ Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __MCU_STD_CHARCONV_H__
+#define __MCU_STD_CHARCONV_H__
+/****************************************************************************
+ *
+ * DESCRIPCION
+ *	El correspondiente a <charconv>
+ *
+ *	De momento solo implemento `to_chars` de enteros en base 10, que es
+ *	lo que se necesita para imprimir números. Se basa en
+ *	atd_::int_to_cstring que no divide (el avr no tiene división
+ *	hardware).
+ *
+ * HISTORIA
+ *    Manuel Perez
+ *    18/10/2026 to_chars (enteros en base 10)
+ *
+ ****************************************************************************/
+#include "std_config.h"
+#include "std_atd.h"
+#include "std_type_traits.h"
+
+namespace STD{
+
+// (RRR) errc está definido en <system_error>, que no tengo. De momento solo
+//       defino el error que se usa aquí.
+enum class errc : int {
+    value_too_large = 75    // EOVERFLOW
+};
+
+
+/***************************************************************************
+ *				to_chars
+ ***************************************************************************/
+struct to_chars_result{
+    char* ptr;
+    errc ec;
+
+    friend bool operator==(const to_chars_result&, 
+			   const to_chars_result&) = default;
+};
+
+// El estandar no permite convertir bool
+to_chars_result to_chars(char* first, char* last, bool value) = delete;
+
+/// Escribe value en [first, last) sin '\0' final. 
+/// Devuelve {p, errc{}} siendo p el final de lo escrito, o 
+/// {last, errc::value_too_large} si no entra.
+template <typename Int>
+    requires is_integral_v<Int>
+to_chars_result to_chars(char* first, char* last, Int value)
+{
+    using Uint = atd_::private_::uint_of_size_of<Int>;
+
+    Uint x = static_cast<Uint>(value);
+
+    if constexpr (is_signed_v<Int>){
+	if (value < 0){
+	    if (first == last)
+		return {last, errc::value_too_large};
+
+	    *first = '-';
+	    ++first;
+	    x = static_cast<Uint>(Uint{0} - x);
+	}
+    }
+
+    auto n = atd_::private_::number_of_digits(x);
+    if (last - first < n)
+	return {last, errc::value_too_large};
+
+    char* pe = first + n;
+    atd_::private_::uint_to_cstring_backwards(pe, x);
+
+    return {pe, errc{}};
+}
+
+
+}// namespace STD
+
+#endif
@@ -35,6 +35,8 @@
  *    Manuel Perez
  *	08/12/2019 v0.0
  *	21/09/2023 hh_mm_ss, treat_as_floating_point
+ *	18/10/2026 Calendario: day, month, year, weekday, year_month_day,
+ *		   sys_days
  *
  ****************************************************************************/
 #include "std_config.h"
@@ -551,6 +553,14 @@ using minutes = duration<int32_t, ratio< 60>>;
 // At least 23 bits
 using hours = duration<int32_t, ratio<3600>>;
 
+/// days
+// At least 25 bits
+using days = duration<int32_t, ratio<86400>>;
+
+/// weeks
+// At least 22 bits
+using weeks = duration<int32_t, ratio<604800>>;
+
 // syntactic sugar
 template <typename From, typename To>
 using __enable_if_is_convertible_t =
@@ -992,6 +1002,320 @@ inline constexpr hh_mm_ss<D>::precision hh_mm_ss<D>::to_duration() const noexcep
 
     
 
+
+/***************************************************************************
+ *			    CALENDARIO
+ ***************************************************************************/
+// sys_time
+// --------
+template <typename Duration>
+using sys_time = time_point<system_clock, Duration>;
+
+using sys_seconds = sys_time<seconds>;
+using sys_days    = sys_time<days>;
+
+
+namespace detail{
+// (RRR) avr-libc calcula las fechas (mktime/gmtime) con bucles que van año a
+//       año y mes a mes. Los algoritmos de Howard Hinnant
+//	 (http://howardhinnant.github.io/date_algorithms.html) son de orden
+//	 constante. Los escribo con enteros de 16/32 bits (el avr no tiene
+//	 división de 64 bits por hardware, y la de 32 ya es cara).
+//
+//	 La idea es desplazar el año para que empiece en marzo: así el día
+//	 bisiesto (29 de febrero) es el último día del año. Los años se
+//	 agrupan en eras de 400 años (146097 días) que se repiten.
+
+// Número de días desde 01/01/1970 de la fecha y/m/d.
+// Precondición: m en [1, 12], d en [1, 31]
+constexpr int32_t days_from_civil(int16_t y, uint8_t m, uint8_t d) noexcept
+{
+    // (RRR) en el avr int es de 16 bits: y - 399 y era * 400 pueden
+    //       desbordarse en los extremos.
+    const int32_t y32 = (m <= 2? int32_t{y} - 1: int32_t{y});
+
+    const int16_t era = static_cast<int16_t>((y32 >= 0 ? y32 : y32 - 399) / 400);
+
+    // [0, 399]
+    const uint16_t yoe = static_cast<uint16_t>(y32 - int32_t{era} * 400);
+
+    // [0, 365]
+    const uint16_t doy = static_cast<uint16_t>(
+				(153u * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1);
+
+    // [0, 146096]
+    const uint32_t doe = uint32_t{yoe} * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return int32_t{era} * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+
+struct Civil_date{
+    int16_t y;
+    uint8_t m;
+    uint8_t d;
+};
+
+// Fecha correspondiente a z días desde 01/01/1970
+constexpr Civil_date civil_from_days(int32_t z) noexcept
+{
+    z += 719468;
+
+    const int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+
+    // [0, 146096]
+    const uint32_t doe = static_cast<uint32_t>(z - era * 146097);
+
+    // [0, 399]
+    const uint16_t yoe = static_cast<uint16_t>(
+		(doe - doe / 1460 + doe / 36524 - doe / 146096) / 365);
+
+    // [0, 365]
+    const uint16_t doy = static_cast<uint16_t>(
+		    doe - (uint32_t{yoe} * 365 + yoe / 4 - yoe / 100));
+
+    // [0, 11] (marzo = 0)
+    const uint8_t mp = static_cast<uint8_t>((5 * doy + 2) / 153);
+
+    const uint8_t d = static_cast<uint8_t>(doy - (153 * mp + 2) / 5 + 1);
+    const uint8_t m = static_cast<uint8_t>(mp < 10 ? mp + 3 : mp - 9);
+    const int16_t y = static_cast<int16_t>(yoe + era * 400 + (m <= 2));
+
+    return Civil_date{y, m, d};
+}
+
+// Día de la semana [0, 6] (0 = domingo) de z días desde 01/01/1970
+constexpr uint8_t weekday_from_days(int32_t z) noexcept
+{
+    return static_cast<uint8_t>(z >= -4 ? (z + 4) % 7 : (z + 5) % 7 + 6);
+}
+
+constexpr bool is_leap(int16_t y) noexcept
+{ return y % 4 == 0 and (y % 100 != 0 or y % 400 == 0); }
+
+constexpr uint8_t last_day_of_month(int16_t y, uint8_t m) noexcept
+{
+    if (m == 2)
+	return is_leap(y)? 29: 28;
+
+    return (m == 4 or m == 6 or m == 9 or m == 11)? 30: 31;
+}
+
+}// namespace detail
+
+
+// day
+// ---
+class day{
+public:
+    day() = default;
+    constexpr explicit day(unsigned d) noexcept 
+			: d_{static_cast<unsigned char>(d)} { }
+
+    constexpr day& operator++() noexcept {++d_; return *this;}
+    constexpr day operator++(int) noexcept {auto tmp = *this; ++d_; return tmp;}
+    constexpr day& operator--() noexcept {--d_; return *this;}
+    constexpr day operator--(int) noexcept {auto tmp = *this; --d_; return tmp;}
+
+    constexpr day& operator+=(const days& d) noexcept
+    { d_ = static_cast<unsigned char>(d_ + d.count()); return *this;}
+
+    constexpr day& operator-=(const days& d) noexcept
+    { d_ = static_cast<unsigned char>(d_ - d.count()); return *this;}
+
+    constexpr explicit operator unsigned() const noexcept {return d_;}
+    constexpr bool ok() const noexcept {return 1 <= d_ and d_ <= 31;}
+
+private:
+    unsigned char d_;
+};
+
+constexpr bool operator==(const day& a, const day& b) noexcept
+{ return unsigned{a} == unsigned{b}; }
+
+constexpr bool operator<(const day& a, const day& b) noexcept
+{ return unsigned{a} < unsigned{b}; }
+
+
+// month
+// -----
+class month{
+public:
+    month() = default;
+    constexpr explicit month(unsigned m) noexcept 
+			: m_{static_cast<unsigned char>(m)} { }
+
+    constexpr month& operator++() noexcept 
+    {m_ = (m_ == 12? 1: m_ + 1); return *this;}
+
+    constexpr month operator++(int) noexcept 
+    {auto tmp = *this; ++(*this); return tmp;}
+
+    constexpr month& operator--() noexcept 
+    {m_ = (m_ <= 1? 12: m_ - 1); return *this;}
+
+    constexpr month operator--(int) noexcept 
+    {auto tmp = *this; --(*this); return tmp;}
+
+    constexpr explicit operator unsigned() const noexcept {return m_;}
+    constexpr bool ok() const noexcept {return 1 <= m_ and m_ <= 12;}
+
+private:
+    unsigned char m_;
+};
+
+constexpr bool operator==(const month& a, const month& b) noexcept
+{ return unsigned{a} == unsigned{b}; }
+
+constexpr bool operator<(const month& a, const month& b) noexcept
+{ return unsigned{a} < unsigned{b}; }
+
+
+// year
+// ----
+class year{
+public:
+    year() = default;
+    constexpr explicit year(int y) noexcept : y_{static_cast<short>(y)} { }
+
+    constexpr year& operator++() noexcept {++y_; return *this;}
+    constexpr year operator++(int) noexcept {auto tmp = *this; ++y_; return tmp;}
+    constexpr year& operator--() noexcept {--y_; return *this;}
+    constexpr year operator--(int) noexcept {auto tmp = *this; --y_; return tmp;}
+
+    constexpr bool is_leap() const noexcept {return detail::is_leap(y_);}
+
+    constexpr explicit operator int() const noexcept {return y_;}
+    constexpr bool ok() const noexcept {return y_ != -32768;}
+
+    static constexpr year min() noexcept {return year{-32767};}
+    static constexpr year max() noexcept {return year{32767};}
+
+private:
+    short y_;
+};
+
+constexpr bool operator==(const year& a, const year& b) noexcept
+{ return int{a} == int{b}; }
+
+constexpr bool operator<(const year& a, const year& b) noexcept
+{ return int{a} < int{b}; }
+
+
+// weekday
+// -------
+// Igual que el standard, 0 = domingo (c_encoding) y 7 = domingo
+// (iso_encoding)
+class weekday{
+public:
+    weekday() = default;
+    constexpr explicit weekday(unsigned wd) noexcept 
+		: wd_{static_cast<unsigned char>(wd == 7? 0: wd)} { }
+
+    constexpr weekday(const sys_days& d) noexcept
+	: wd_{detail::weekday_from_days(d.time_since_epoch().count())} { }
+
+    constexpr unsigned c_encoding() const noexcept {return wd_;}
+    constexpr unsigned iso_encoding() const noexcept {return wd_ == 0? 7: wd_;}
+
+    constexpr bool ok() const noexcept {return wd_ <= 6;}
+
+    constexpr weekday& operator+=(const days& d) noexcept;
+    constexpr weekday& operator-=(const days& d) noexcept 
+    { return *this += -d; }
+
+private:
+    unsigned char wd_;
+};
+
+constexpr bool operator==(const weekday& a, const weekday& b) noexcept
+{ return a.c_encoding() == b.c_encoding(); }
+
+constexpr weekday& weekday::operator+=(const days& d) noexcept
+{
+    int32_t wd = (static_cast<int32_t>(wd_) + d.count()) % 7;
+    if (wd < 0)
+	wd += 7;
+
+    wd_ = static_cast<unsigned char>(wd);
+
+    return *this;
+}
+
+constexpr weekday operator+(const weekday& a, const days& d) noexcept
+{ weekday res = a; res += d; return res; }
+
+constexpr weekday operator-(const weekday& a, const days& d) noexcept
+{ weekday res = a; res -= d; return res; }
+
+
+// year_month_day
+// --------------
+class year_month_day{
+public:
+    year_month_day() = default;
+    constexpr year_month_day(const chrono::year& y, const chrono::month& m,
+			     const chrono::day& d) noexcept
+			    : y_{y}, m_{m}, d_{d} { }
+
+    constexpr year_month_day(const sys_days& dp) noexcept;
+
+    constexpr chrono::year year() const noexcept {return y_;}
+    constexpr chrono::month month() const noexcept {return m_;}
+    constexpr chrono::day day() const noexcept {return d_;}
+
+    constexpr operator sys_days() const noexcept;
+
+    constexpr bool ok() const noexcept;
+
+private:
+    chrono::year y_;
+    chrono::month m_;
+    chrono::day d_;
+};
+
+constexpr year_month_day::year_month_day(const sys_days& dp) noexcept
+{
+    detail::Civil_date c = 
+		detail::civil_from_days(dp.time_since_epoch().count());
+
+    y_ = chrono::year{c.y};
+    m_ = chrono::month{c.m};
+    d_ = chrono::day{c.d};
+}
+
+constexpr year_month_day::operator sys_days() const noexcept
+{
+    return sys_days{days{detail::days_from_civil(
+			static_cast<int16_t>(int{y_}), 
+			static_cast<uint8_t>(unsigned{m_}),
+			static_cast<uint8_t>(unsigned{d_}))}};
+}
+
+constexpr bool year_month_day::ok() const noexcept
+{
+    if (!y_.ok() or !m_.ok() or unsigned{d_} < 1)
+	return false;
+
+    return unsigned{d_} <= detail::last_day_of_month(
+				    static_cast<int16_t>(int{y_}),
+				    static_cast<uint8_t>(unsigned{m_}));
+}
+
+constexpr bool operator==(const year_month_day& a, 
+			  const year_month_day& b) noexcept
+{ return a.year() == b.year() and a.month() == b.month() and 
+	 a.day() == b.day(); }
+
+constexpr bool operator<(const year_month_day& a, 
+			 const year_month_day& b) noexcept
+{ 
+    if (a.year() != b.year()) return a.year() < b.year();
+    if (a.month() != b.month()) return a.month() < b.month();
+    return a.day() < b.day();
+}
+
+
 }// namespace chrono
 
 
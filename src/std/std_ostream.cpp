@@ -111,66 +111,68 @@ ostream& ostream::flush()
 }
 
 
-void ostream::print_with_padding(const char* c)
+void ostream::print_with_padding(const char* c, streamsize n)
 {
     if (width_ == 0)
-	print(c);
+	print(c, n);
 
     else{
 	if (adjust_to_left())
-	    print_left(c);
+	    print_left(c, n);
 	else // observar que este caso incluye internal. (correcto???)
-	    print_right(c);
+	    print_right(c, n);
 
 	width(0);   // width es no sticky!!!
     }
 
 }
 
-void ostream::print_left(const char* c)
+void ostream::print_left(const char* c, streamsize n)
 {
-    if (print(c) == false)
+    if (print(c, n) == false)
 	return;
 
-    streamsize len = strlen(c);
-
-    if (len < width())
-	print_fill_char(width() - len);
+    if (n < width())
+	print_fill_char(width() - n);
 }
 
-void ostream::print_right(const char* c)
+void ostream::print_right(const char* c, streamsize n)
 {
-    streamsize len = strlen(c);
-
-    if (len < width())
-	if (print_fill_char(width() - len) == false)
+    if (n < width())
+	if (print_fill_char(width() - n) == false)
 	    return;
 
-    print(c);
+    print(c, n);
 }
 
 // imprime n caracteres de relleno
+// Los escribimos en bloques de fill_size caracteres.
 bool ostream::print_fill_char(streamsize n)
 {
-    for (streamsize i = 0; i < n; ++i){
-	if (is_eof(rdbuf()->sputc(fill()))){
-	    setstate(ios_base::badbit);
+    constexpr streamsize fill_size = 8;
+    char_type buf[fill_size];
+
+    streamsize len = (n < fill_size? n: fill_size);
+    for (streamsize i = 0; i < len; ++i)
+	buf[i] = fill();
+
+    while (n > 0){
+	streamsize k = (n < len? n: len);
+	if (print(buf, k) == false)
 	    return false;
-	}
+
+	n -= k;
     }
 
     return true;
 }
 
 
-bool ostream::print(const char* c)
+bool ostream::print(const char* c, streamsize n)
 {
-    while(*c){
-	if (is_eof(rdbuf()->sputc(*c))){
-	    setstate(ios_base::badbit);
-	    return false;
-	}
-	++c;
+    if (rdbuf()->sputn(c, n) != n){
+	setstate(ios_base::badbit);
+	return false;
     }
 
     return true;
@@ -183,7 +185,7 @@ ostream& operator<<(ostream& out, const char* s)
     ostream::sentry sen{out};
 
     if (sen)
-	out.print_with_padding(s); 
+	out.print_with_padding(s, strlen(s)); 
 
     return out;
 }
@@ -193,10 +195,8 @@ ostream& operator<<(ostream& out, char c)
 {
     ostream::sentry sen{out};
 
-    if (sen){
-	const char s[2] = {c, '\0'};
-	out.print_with_padding(s); 
-    }
+    if (sen)
+	out.print_with_padding(&c, 1); 
 
     return out;
 }
@@ -206,8 +206,8 @@ ostream& operator<<(ostream& out, unsigned char c)
     ostream::sentry sen{out};
 
     if (sen){
-	const char s[2] = {static_cast<char>(c), '\0'};
-	out.print_with_padding(s); 
+	const char s = static_cast<char>(c);
+	out.print_with_padding(&s, 1); 
     }
     return out;
 }
@@ -28,6 +28,7 @@
  *
  *  - HISTORIA:
  *	Manuel Perez- 24/09/2019 v0.0
+ *	18/10/2026 Escribimos con sputn y no carácter a carácter con sputc
  *
  *
  ****************************************************************************/
@@ -125,22 +126,27 @@ protected:
 private:
     // Funciones ayuda
     // ---------------
-    // Imprime la cadena. Vuelca todos los caracteres de c al streambuffer.
+    // (RRR) Todas escriben con sputn y no con sputc carácter a carácter: en
+    //       un streambuf sin buffer (UART, LCD...) cada sputc es una
+    //       llamada a overflow (virtual).
+
+    // Imprime la cadena [c, c + n). Vuelca todos los caracteres de c al
+    // streambuffer.
     // precondicion: se ha llamado al centinela
-    bool print(const char* c);
+    bool print(const char* c, streamsize n);
 
-    // Imprime la cadena c añadiendo el padding que corresponda dado por
-    // width().
+    // Imprime la cadena [c, c + n) añadiendo el padding que corresponda dado
+    // por width().
     // precondicion: se ha llamado al centinela
-    void print_with_padding(const char* c);
+    void print_with_padding(const char* c, streamsize n);
 
     // Añade el padding a la izquierda de c.
     // precondicion: se ha llamado al centinela
-    void print_left(const char* c);
+    void print_left(const char* c, streamsize n);
 
     // Añade el padding a la derecha de c.
     // precondicion: se ha llamado al centinela
-    void print_right(const char* c);
+    void print_right(const char* c, streamsize n);
 
     // Imprime n caracteres de relleno
     // precondicion: se ha llamado al centinela
@@ -179,15 +185,12 @@ ostream& ostream::operator_print(const Int& x)
     sentry sen{*this};
 
     if (sen){
-	// El +1 es para el '\0'
-	char buffer[atd_::Max_number_of_digits_of<Int>+1];
-
-        char* p = atd_::int_to_cstring(
-            buffer, buffer + atd_::Max_number_of_digits_of<Int>, x);
+	constexpr streamsize N = atd_::Max_number_of_digits_of<Int>;
+	char buffer[N];
 
-	buffer[atd_::Max_number_of_digits_of<Int>] = '\0';
+        char* p = atd_::int_to_cstring(buffer, buffer + N, x);
 
-        print_with_padding(p);
+        print_with_padding(p, buffer + N - p);
     }
 
     return *this;